@@ -1,3 +1,10 @@
+/*
+// Scratchpad for the locals and temporaries of the CLA C compiler; also
+// force references to the symbols that mark it
+*/
+CLA_SCRATCHPAD_SIZE = 0x100;
+--undef_sym=__cla_scratchpad_end
+--undef_sym=__cla_scratchpad_start
 
 MEMORY
 {
@@ -56,6 +63,9 @@ PAGE 1 :
    BOOT_RSVD       : origin = 0x000002, length = 0x0000F3     /* Part of M0, BOOT rom will use this for stack */
    RAMM1           : origin = 0x000400, length = 0x000400     /* on-chip RAM block M1 */
 
+   CLA1_MSGRAMLOW  : origin = 0x001480, length = 0x000080     /* CLA-to-CPU message RAM */
+   CLA1_MSGRAMHIGH : origin = 0x001500, length = 0x000080     /* CPU-to-CLA message RAM */
+
    RAMLS5      : origin = 0x00A800, length = 0x000800
    RAMLS6      : origin = 0x00B000, length = 0x000800
    RAMLS7      : origin = 0x00B800, length = 0x000800
@@ -85,7 +95,62 @@ SECTIONS
    ramgs0           : > RAMGS0,    PAGE = 1
    ramgs1           : > RAMGS1,    PAGE = 1
 
-   .TI.ramfunc      : LOAD = FLASH_BANK0_SEC1,
+   /* CLA program runs from LS4, CLA data and scratchpad in LS6 (see pwm_cla.c) */
+   Cla1Prog         : LOAD = FLASH_BANK0_SEC1,
+                      RUN = RAMLS4,
+                      LOAD_START(_Cla1ProgLoadStart),
+                      LOAD_SIZE(_Cla1ProgLoadSize),
+                      RUN_START(_Cla1ProgRunStart),
+                      PAGE = 0, ALIGN(4)
+   Cla1DataRam      : > RAMLS6,    PAGE = 1
+   CLAscratch       :
+                     { *.obj(CLAscratch)
+                     . += CLA_SCRATCHPAD_SIZE;
+                     *.obj(CLAscratch_end) } > RAMLS6,  PAGE = 1
+   .scratchpad      : > RAMLS6,    PAGE = 1
+   .bss_cla         : > RAMLS6,    PAGE = 1
+   .const_cla       : > RAMLS6,    PAGE = 1
+   Cla1ToCpuMsgRAM  : > CLA1_MSGRAMLOW,   PAGE = 1
+   CpuToCla1MsgRAM  : > CLA1_MSGRAMHIGH,  PAGE = 1
+
+   /* .TI.ramfunc holds the interrupt path, which the sources place there,
+      plus the driverlib accessors the ISRs call and the base checks of
+      their DEBUG asserts. Most of those are static inline and only emitted
+      out of line at --opt_level=off, where --gen_func_subsections gives
+      each a .text:_name section of its own. check_ramfuncs.py verifies the
+      placement from the map file. RAMLS4 holds the CLA program. */
+   .TI.ramfunc      : { *(.TI.ramfunc)
+                        *(.text:_EPWM_clearEventTriggerInterruptFlag)
+                        *(.text:_Interrupt_clearACKGroup)
+                        *(.text:_CPUTimer_getTimerCount)
+                        *(.text:_SCI_getTxFIFOStatus)
+                        *(.text:_SCI_getRxFIFOStatus)
+                        *(.text:_SCI_writeCharNonBlocking)
+                        *(.text:_SCI_readCharNonBlocking)
+                        *(.text:_SCI_disableInterrupt)
+                        *(.text:_SCI_clearInterruptStatus)
+                        *(.text:_SCI_getOverflowStatus)
+                        *(.text:_SCI_clearOverflowStatus)
+                        *(.text:_PWMComp_limit)
+                        *(.text:_PWMRamp_move)
+                        *(.text:_PWMChannel_getInterrupting)
+                        *(.text:_ADC_readPPBResult)
+                        *(.text:_ADC_getPPBEventStatus)
+                        *(.text:_ADC_clearPPBEventStatus)
+                        *(.text:_ADC_clearInterruptStatus)
+                        *(.text:_HRPWM_setCounterCompareValue)
+                        *(.text:_HRPWM_setTimeBasePeriod)
+                        *(.text:_EPWM_setTimeBasePeriod)
+                        *(.text:_EPWM_setCounterCompareValue)
+                        *(.text:_EPWM_disableInterrupt)
+                        *(.text:_CMPSS_getStatus)
+                        *(.text:_EPWM_setGlobalLoadOneShotLatch)
+                        *(.text:_EPWM_isBaseValid)
+                        *(.text:_CPUTimer_isBaseValid)
+                        *(.text:_ADC_isBaseValid)
+                        *(.text:_CMPSS_isBaseValid)
+                        *(.text:_SCI_isBaseValid) }
+                      LOAD = FLASH_BANK0_SEC1 | FLASH_BANK0_SEC2 | FLASH_BANK0_SEC3,
                          RUN = RAMLS0 | RAMLS1 | RAMLS2 |RAMLS3,
                          LOAD_START(_RamfuncsLoadStart),
                          LOAD_SIZE(_RamfuncsLoadSize),
@@ -1,3 +1,10 @@
+/*
+// Scratchpad for the locals and temporaries of the CLA C compiler; also
+// force references to the symbols that mark it
+*/
+CLA_SCRATCHPAD_SIZE = 0x100;
+--undef_sym=__cla_scratchpad_end
+--undef_sym=__cla_scratchpad_start
 
 MEMORY
 {
@@ -56,6 +63,9 @@ PAGE 1 :
    BOOT_RSVD       : origin = 0x000002, length = 0x0000F3     /* Part of M0, BOOT rom will use this for stack */
    RAMM1           : origin = 0x000400, length = 0x000400     /* on-chip RAM block M1 */
 
+   CLA1_MSGRAMLOW  : origin = 0x001480, length = 0x000080     /* CLA-to-CPU message RAM */
+   CLA1_MSGRAMHIGH : origin = 0x001500, length = 0x000080     /* CPU-to-CLA message RAM */
+
    RAMLS5      : origin = 0x00A800, length = 0x000800
    RAMLS6      : origin = 0x00B000, length = 0x000800
    RAMLS7      : origin = 0x00B800, length = 0x000800
@@ -71,7 +81,7 @@ SECTIONS
 {
    codestart        : > BEGIN,     PAGE = 0
    .TI.ramfunc      : > RAMM0      PAGE = 0
-   .text            : >>RAMM0 | RAMLS0 | RAMLS1 | RAMLS2 | RAMLS3 | RAMLS4,   PAGE = 0
+   .text            : >>RAMM0 | RAMLS0 | RAMLS1 | RAMLS2 | RAMLS3,   PAGE = 0
    .cinit           : > RAMM0,     PAGE = 0
    .pinit           : > RAMM0,     PAGE = 0
    .switch          : > RAMM0,     PAGE = 0
@@ -85,6 +95,19 @@ SECTIONS
 
    ramgs0           : > RAMGS0,    PAGE = 1
    ramgs1           : > RAMGS1,    PAGE = 1  
+
+   /* CLA program in LS4, CLA data and scratchpad in LS6 (see pwm_cla.c) */
+   Cla1Prog         : > RAMLS4,    PAGE = 0
+   Cla1DataRam      : > RAMLS6,    PAGE = 1
+   CLAscratch       :
+                     { *.obj(CLAscratch)
+                     . += CLA_SCRATCHPAD_SIZE;
+                     *.obj(CLAscratch_end) } > RAMLS6,  PAGE = 1
+   .scratchpad      : > RAMLS6,    PAGE = 1
+   .bss_cla         : > RAMLS6,    PAGE = 1
+   .const_cla       : > RAMLS6,    PAGE = 1
+   Cla1ToCpuMsgRAM  : > CLA1_MSGRAMLOW,   PAGE = 1
+   CpuToCla1MsgRAM  : > CLA1_MSGRAMHIGH,  PAGE = 1
 }
 
 /*
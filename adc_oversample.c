@@ -0,0 +1,145 @@
+//#############################################################################
+//
+// FILE:   adc_oversample.c
+//
+// TITLE:  Oversampled ADC acquisition through DMA ping-pong buffers.
+//
+//#############################################################################
+
+//
+// Included Files
+//
+#include "adc_oversample.h"
+
+#ifndef __cplusplus
+#pragma CODE_SECTION(ADCOversample_process, ".TI.ramfunc");
+#endif
+
+//
+// Distance between two ADC modules and between their DMA triggers
+//
+#define ADCOVERSAMPLE_ADC_STEP      (ADCB_BASE - ADCA_BASE)
+#define ADCOVERSAMPLE_TRIGGER_STEP                                            \
+    ((uint16_t)DMA_TRIGGER_ADCB1 - (uint16_t)DMA_TRIGGER_ADCA1)
+
+//*****************************************************************************
+//
+// ADCOversample_init
+//
+//*****************************************************************************
+void
+ADCOversample_init(ADCOversample_Channel *channel,
+                   const ADCOversample_Source *source, uint32_t dmaBase,
+                   uint16_t *buffer)
+{
+    uint16_t index = (uint16_t)((source->adcBase - ADCA_BASE) /
+                                ADCOVERSAMPLE_ADC_STEP);
+    uint16_t lastSOC = (uint16_t)source->firstSOC + source->samples - 1U;
+    uint16_t soc;
+    DMA_Trigger trigger;
+
+    ASSERT((source->samples != 0U) &&
+           (source->samples <= ADCOVERSAMPLE_MAX_SAMPLES) &&
+           ((source->samples & (source->samples - 1U)) == 0U));
+    ASSERT(lastSOC <= (uint16_t)ADC_SOC_NUMBER15);
+
+    channel->dmaBase = dmaBase;
+    channel->buffer = buffer;
+    channel->samples = source->samples;
+    channel->filling = 0U;
+    channel->value = 0U;
+    channel->batches = 0U;
+
+    //
+    // A batch sum of n samples is n times the average; scale it to 16
+    // times the average
+    //
+    channel->shift = ADCOVERSAMPLE_Q;
+    for(soc = source->samples; soc > 1U; soc >>= 1U)
+    {
+        channel->shift--;
+    }
+
+    //
+    // The whole batch on one trigger; the last SOC flags the batch done
+    // without waiting for the CPU to clear the flag
+    //
+    for(soc = (uint16_t)source->firstSOC; soc <= lastSOC; soc++)
+    {
+        ADC_setupSOC(source->adcBase, (ADC_SOCNumber)soc, source->trigger,
+                     source->channel, source->sampleWindow);
+    }
+    ADC_setInterruptSource(source->adcBase, source->intNumber,
+                           (ADC_SOCNumber)lastSOC);
+    ADC_enableContinuousMode(source->adcBase, source->intNumber);
+    ADC_clearInterruptStatus(source->adcBase, source->intNumber);
+    ADC_enableInterrupt(source->adcBase, source->intNumber);
+
+    DMA_stopChannel(dmaBase);
+
+    //
+    // Let the driverlib translate both halves into DMA addresses, so the
+    // ISR only has to write them back
+    //
+    DMA_configAddresses(dmaBase, &buffer[source->samples],
+                        (const void *)(uintptr_t)(source->resultBase +
+                                                  (uint32_t)source->firstSOC));
+    channel->address[1] = HWREG(dmaBase + DMA_O_DST_ADDR_SHADOW);
+    DMA_configAddresses(dmaBase, buffer,
+                        (const void *)(uintptr_t)(source->resultBase +
+                                                  (uint32_t)source->firstSOC));
+    channel->address[0] = HWREG(dmaBase + DMA_O_DST_ADDR_SHADOW);
+
+    //
+    // One batch per burst and per transfer, so every batch interrupts
+    //
+    trigger = (DMA_Trigger)((uint16_t)DMA_TRIGGER_ADCA1 +
+                            (index * ADCOVERSAMPLE_TRIGGER_STEP) +
+                            (uint16_t)source->intNumber);
+    DMA_configBurst(dmaBase, source->samples, 1, 1);
+    DMA_configTransfer(dmaBase, 1U, 1, 1);
+    DMA_configWrap(dmaBase, 0x10000U, 0, 0x10000U, 0);
+    DMA_configMode(dmaBase, trigger,
+                   DMA_CFG_ONESHOT_DISABLE | DMA_CFG_CONTINUOUS_ENABLE |
+                   DMA_CFG_SIZE_16BIT);
+    DMA_setInterruptMode(dmaBase, DMA_INT_AT_END);
+
+    DMA_clearTriggerFlag(dmaBase);
+    DMA_clearErrorFlag(dmaBase);
+    DMA_enableInterrupt(dmaBase);
+    DMA_enableTrigger(dmaBase);
+    DMA_startChannel(dmaBase);
+}
+
+//*****************************************************************************
+//
+// ADCOversample_process
+//
+//*****************************************************************************
+void
+ADCOversample_process(ADCOversample_Channel *channel)
+{
+    const uint16_t *batch = &channel->buffer[channel->filling *
+                                             channel->samples];
+    uint32_t sum = 0U;
+    uint16_t i;
+
+    //
+    // The next transfer starts from the shadow registers
+    //
+    channel->filling ^= 1U;
+    EALLOW;
+    HWREG(channel->dmaBase + DMA_O_DST_BEG_ADDR_SHADOW) =
+        channel->address[channel->filling];
+    HWREG(channel->dmaBase + DMA_O_DST_ADDR_SHADOW) =
+        channel->address[channel->filling];
+    EDIS;
+
+    for(i = 0U; i < channel->samples; i++)
+    {
+        sum += batch[i];
+    }
+
+    channel->value = (uint16_t)(sum << channel->shift);
+    channel->batches++;
+}
@@ -0,0 +1,165 @@
+//#############################################################################
+//
+// FILE:   adc_oversample.h
+//
+// TITLE:  Oversampled ADC acquisition through DMA ping-pong buffers.
+//
+//#############################################################################
+//
+// One trigger, normally the SOCA event of an ePWM module, starts a batch of
+// 1 to 16 conversions of the same input on consecutive SOCs of one ADC.
+// The SOCs share the trigger and convert in round-robin order. The end of
+// conversion of the last SOC sets an ADCINT flag in continuous mode, and
+// that flag triggers a DMA channel, which copies the batch from the result
+// registers into one half of a ping-pong buffer in one burst. The CPU never
+// reads a result register.
+//
+// Each batch is a DMA transfer of its own, and the end of the transfer
+// interrupts the CPU. The DMA channel ISR calls ADCOversample_process(),
+// which points the DMA at the other half for the next batch and averages
+// the half just filled. The averaging is a fixed number of additions and a
+// shift, so one filtered value per trigger costs the same CPU time for any
+// batch.
+//
+// Averaged values are in 1/16 ADC counts (12.4 fixed point) whatever the
+// batch size, so a 12-bit input gives 0 to 65520. Averaging n samples
+// gains up to log2(n) / 2 bits of resolution on white noise.
+//
+// The DMA only reaches GSx RAM and peripheral frame 1/2, so the buffer must
+// be placed in a GSx RAM section. The trigger period must leave the DMA ISR
+// time to run before the next batch ends.
+//
+//#############################################################################
+
+#ifndef ADC_OVERSAMPLE_H
+#define ADC_OVERSAMPLE_H
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//
+// Included Files
+//
+#include <stdint.h>
+#include "driverlib.h"
+
+//*****************************************************************************
+//
+// Largest batch and the scale of an averaged value, 2^ADCOVERSAMPLE_Q per
+// ADC count
+//
+//*****************************************************************************
+#define ADCOVERSAMPLE_MAX_SAMPLES   16U
+#define ADCOVERSAMPLE_Q             4U
+
+//*****************************************************************************
+//
+//! Input and SOCs of an oversampled signal.
+//
+//*****************************************************************************
+typedef struct
+{
+    uint32_t adcBase;           //!< ADC converting the signal
+    uint32_t resultBase;        //!< Result registers of that ADC
+    ADC_Channel channel;        //!< ADC input
+    ADC_Trigger trigger;        //!< Event that starts a batch
+    ADC_SOCNumber firstSOC;     //!< First SOC of the batch
+    ADC_IntNumber intNumber;    //!< ADCINT that triggers the DMA
+    uint16_t samples;           //!< Samples per batch, a power of two
+    uint16_t sampleWindow;      //!< Acquisition window in SYSCLK cycles
+} ADCOversample_Source;
+
+//*****************************************************************************
+//
+//! State of one oversampled signal. Initialize with ADCOversample_init().
+//
+//*****************************************************************************
+typedef struct
+{
+    uint32_t dmaBase;           //!< DMA channel moving the batches
+    const uint16_t *buffer;     //!< Ping-pong buffer, 2 x samples words
+    uint32_t address[2];        //!< DMA addresses of the two halves
+    uint16_t samples;           //!< Samples per batch
+    uint16_t shift;             //!< Scales a batch sum to 1/16 counts
+    uint16_t filling;           //!< Half the DMA is filling, 0 or 1
+    volatile uint16_t value;    //!< Latest average, 1/16 ADC counts
+    volatile uint32_t batches;  //!< Batches averaged
+} ADCOversample_Channel;
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+//*****************************************************************************
+//
+//! Sets up the SOCs, the ADCINT and the DMA channel of an oversampled
+//! signal and starts the DMA channel.
+//!
+//! \param channel is the channel to initialize.
+//! \param source is the input and SOC setup.
+//! \param dmaBase is the DMA channel base address.
+//! \param buffer is the ping-pong buffer, 2 x \e source->samples words in
+//! GSx RAM.
+//!
+//! The ADC must be powered up, with its interrupt pulse at the end of
+//! conversion, and the DMA controller initialized with
+//! DMA_initController(). The caller enables the DMA channel interrupt in
+//! the PIE and calls ADCOversample_process() from its ISR.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+ADCOversample_init(ADCOversample_Channel *channel,
+                   const ADCOversample_Source *source, uint32_t dmaBase,
+                   uint16_t *buffer);
+
+//*****************************************************************************
+//
+//! Switches the DMA to the other buffer half and averages the batch just
+//! completed.
+//!
+//! \param channel is the channel.
+//!
+//! Call from the DMA channel ISR, once per batch.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+ADCOversample_process(ADCOversample_Channel *channel);
+
+//*****************************************************************************
+//
+//! Returns the latest averaged value.
+//!
+//! \param channel is the channel.
+//!
+//! \return Returns the average of the last batch in 1/16 ADC counts.
+//
+//*****************************************************************************
+static inline uint16_t
+ADCOversample_getValue(const ADCOversample_Channel *channel)
+{
+    return(channel->value);
+}
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ADC_OVERSAMPLE_H
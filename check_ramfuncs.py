@@ -0,0 +1,275 @@
+#!/usr/bin/env python3
+###############################################################################
+#
+# FILE:   check_ramfuncs.py
+#
+# TITLE:  Post-build check that the interrupt path runs from RAM.
+#
+###############################################################################
+#
+# Reads the linker map file of a flash build and fails if any function on
+# the interrupt path runs from flash, where every fetch costs wait states.
+#
+#   python check_ramfuncs.py <map file>
+#
+# A function is located through its global symbol or, for static and
+# static inline functions, through the function subsection the compiler
+# puts it in with --gen_func_subsections. A function that appears in no
+# form was inlined and is fine, except for the interrupt routines
+# themselves, which must always be found.
+#
+# ISR_PATH lists the interrupt routines and everything they call. Keep it
+# in step with the ISRs and with the .TI.ramfunc section of
+# 28004x_generic_flash_lnk.cmd. So that it cannot drift from them, the
+# check also fails for a function the application sources place in
+# .TI.ramfunc with CODE_SECTION, or the linker command file pulls into it
+# as a .text:_name subsection, that ISR_PATH does not list, and for a
+# function ISR_PATH lists that neither places there.
+#
+###############################################################################
+
+import glob
+import os
+import re
+import sys
+
+#
+# Interrupt routines, which must be present
+#
+ISR_ROOTS = [
+    "epwmISR",
+    "adcA1ISR",
+    "dmaCh3ISR",
+    "epwm1TZISR",
+    "SCIBuffer_txISR",
+    "SCIBuffer_rxISR",
+]
+
+#
+# Functions called from the interrupt routines
+#
+ISR_PATH = ISR_ROOTS + [
+    "PWMChannel_getInterrupting",
+    "PWMMod_step",
+    "PWMLoop_step",
+    "PWMHR_setPeriodAndCompare",
+    "PWMHR_setCompare",
+    "PWMHR_setPeriod",
+    "PWMUpdate_setPeriodAndCompare",
+    "PWMUpdate_setCompare",
+    "PWMUpdate_setPeriod",
+    "PWMRamp_step",
+    "PWMRamp_stop",
+    "PWMRamp_move",
+    "PWMComp_runPI",
+    "PWMComp_run2P2Z",
+    "PWMComp_run3P3Z",
+    "PWMComp_limit",
+    "ADCOversample_process",
+    "PWMProtect_tripISR",
+    "PWMLoop_disable",
+    "ISRTiming_enter",
+    "ISRTiming_exit",
+    "ISRTiming_record",
+    "ISRTiming_getBin",
+    "SCIBuffer_isLineEnd",
+    "EPWM_clearEventTriggerInterruptFlag",
+    "Interrupt_clearACKGroup",
+    "CPUTimer_getTimerCount",
+    "SCI_getTxFIFOStatus",
+    "SCI_getRxFIFOStatus",
+    "SCI_writeCharNonBlocking",
+    "SCI_readCharNonBlocking",
+    "SCI_disableInterrupt",
+    "SCI_clearInterruptStatus",
+    "SCI_getOverflowStatus",
+    "SCI_clearOverflowStatus",
+    "ADC_readPPBResult",
+    "ADC_getPPBEventStatus",
+    "ADC_clearPPBEventStatus",
+    "ADC_clearInterruptStatus",
+    "HRPWM_setCounterCompareValue",
+    "HRPWM_setTimeBasePeriod",
+    "EPWM_setTimeBasePeriod",
+    "EPWM_setCounterCompareValue",
+    "EPWM_disableInterrupt",
+    "CMPSS_getStatus",
+    "EPWM_setGlobalLoadOneShotLatch",
+    "EPWM_isBaseValid",
+    "CPUTimer_isBaseValid",
+    "ADC_isBaseValid",
+    "CMPSS_isBaseValid",
+    "SCI_isBaseValid",
+]
+
+#
+# Application sources and linker command file, next to this script
+#
+SOURCE_DIR = os.path.dirname(os.path.abspath(__file__))
+LINKER_CMD = "28004x_generic_flash_lnk.cmd"
+
+#
+# Program flash of the F28004x
+#
+FLASH_START = 0x080000
+FLASH_END = 0x0A0000
+
+#
+# Map file lines: output section header, optionally split over two lines,
+# input section and global symbol
+#
+OUTPUT_RE = re.compile(r"^(\S+)\s+(\d+)\s+([0-9a-f]{8})\s+([0-9a-f]{8})"
+                       r"(?:\s+RUN ADDR = ([0-9a-f]{8}))?")
+OUTPUT_NAME_RE = re.compile(r"^(\.?[A-Za-z_][\w.:]*)\s*$")
+OUTPUT_CONT_RE = re.compile(r"^\*\s+(\d+)\s+([0-9a-f]{8})\s+([0-9a-f]{8})"
+                            r"(?:\s+RUN ADDR = ([0-9a-f]{8}))?")
+INPUT_RE = re.compile(r"^\s+([0-9a-f]{8})\s+([0-9a-f]{8})\s+.*"
+                      r"\(([^()]+)\)\s*$")
+SYMBOL_RE = re.compile(r"^(\d+)\s+([0-9a-f]{8})\s+(\S+)\s*$")
+
+#
+# Functions placed in RAM by the sources and by the linker command file
+#
+PRAGMA_RE = re.compile(r"^\s*#pragma\s+CODE_SECTION\s*\(\s*(\w+)\s*,"
+                       r"\s*\"\.TI\.ramfunc\"\s*\)")
+SUBSECTION_RE = re.compile(r"\(\.text:_(\w+)\)")
+
+
+def in_flash(address):
+    return FLASH_START <= address < FLASH_END
+
+
+def read_ramfuncs():
+    """Returns {function: where} for the functions the application sources
+    and the .TI.ramfunc section of the linker command file put in RAM."""
+    placed = {}
+
+    for path in sorted(glob.glob(os.path.join(SOURCE_DIR, "*.[ch]"))):
+        with open(path) as source:
+            for number, line in enumerate(source, 1):
+                match = PRAGMA_RE.match(line)
+                if match:
+                    placed.setdefault(match.group(1), "%s:%d" % (
+                        os.path.basename(path), number))
+
+    in_ramfunc = False
+    with open(os.path.join(SOURCE_DIR, LINKER_CMD)) as command:
+        for number, line in enumerate(command, 1):
+            if line.lstrip().startswith(".TI.ramfunc"):
+                in_ramfunc = True
+            if in_ramfunc:
+                for name in SUBSECTION_RE.findall(line):
+                    placed.setdefault(name, "%s:%d" % (LINKER_CMD, number))
+                if "}" in line:
+                    in_ramfunc = False
+
+    return placed
+
+
+def read_map(path):
+    """Returns {function: {(run address, where)}} for the whole map."""
+    found = {}
+    output = None
+    run_offset = 0
+    pending = None
+    in_symbols = False
+
+    with open(path) as mapfile:
+        for line in mapfile:
+            line = line.rstrip("\n")
+
+            if line.startswith("GLOBAL SYMBOLS"):
+                in_symbols = True
+                continue
+
+            if in_symbols:
+                match = SYMBOL_RE.match(line)
+                if match and match.group(1) == "0":
+                    name = match.group(3)
+                    if name.startswith("_"):
+                        found.setdefault(name[1:], set()).add(
+                            (int(match.group(2), 16), "symbol"))
+                continue
+
+            match = OUTPUT_RE.match(line)
+            if match:
+                output = match.group(1)
+                load = int(match.group(3), 16)
+                run = match.group(5)
+                run_offset = (int(run, 16) - load) if run else 0
+                pending = None
+                continue
+
+            match = OUTPUT_CONT_RE.match(line)
+            if match and pending:
+                output = pending
+                load = int(match.group(2), 16)
+                run = match.group(4)
+                run_offset = (int(run, 16) - load) if run else 0
+                pending = None
+                continue
+
+            match = OUTPUT_NAME_RE.match(line)
+            if match:
+                pending = match.group(1)
+                continue
+
+            match = INPUT_RE.match(line)
+            if match and output:
+                section = match.group(3)
+                if ":_" in section:
+                    name = section.split(":_", 1)[1]
+                    address = int(match.group(1), 16) + run_offset
+                    found.setdefault(name, set()).add(
+                        (address, "%s in %s" % (section, output)))
+
+    return found
+
+
+def main(argv):
+    if len(argv) != 2:
+        sys.stderr.write("usage: check_ramfuncs.py <map file>\n")
+        return 2
+
+    found = read_map(argv[1])
+    errors = 0
+
+    placed = read_ramfuncs()
+    for name, where in sorted(placed.items()):
+        if name not in ISR_PATH:
+            sys.stderr.write("error: %s is placed in .TI.ramfunc (%s) but "
+                             "missing from ISR_PATH\n" % (name, where))
+            errors += 1
+    for name in ISR_PATH:
+        if name not in placed:
+            sys.stderr.write("error: %s is in ISR_PATH but neither the "
+                             "sources nor %s place it in .TI.ramfunc\n"
+                             % (name, LINKER_CMD))
+            errors += 1
+
+    for name in ISR_PATH:
+        places = sorted(found.get(name, ()))
+
+        if not places and name in ISR_ROOTS:
+            sys.stderr.write("error: interrupt routine %s not found in %s\n"
+                             % (name, argv[1]))
+            errors += 1
+
+        for address, where in places:
+            if in_flash(address):
+                sys.stderr.write("error: %s runs from flash at 0x%06X (%s)\n"
+                                 % (name, address, where))
+                errors += 1
+
+    if errors:
+        sys.stderr.write("%d interrupt path placement error(s); see ISR_PATH "
+                         "and the .TI.ramfunc section of the linker command "
+                         "file\n" % errors)
+        return 1
+
+    print("check_ramfuncs: interrupt path runs from RAM")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
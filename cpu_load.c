@@ -0,0 +1,77 @@
+//#############################################################################
+//
+// FILE:   cpu_load.c
+//
+// TITLE:  CPU load meter based on idle-loop accounting.
+//
+//#############################################################################
+
+//
+// Included Files
+//
+#include "cpu_load.h"
+#include "pwm_duty.h"
+
+//*****************************************************************************
+//
+// CPULoad_init
+//
+//*****************************************************************************
+void
+CPULoad_init(CPULoad_Meter *meter, uint32_t timerBase, uint32_t window)
+{
+    meter->timerBase = timerBase;
+    meter->window = window;
+    meter->windowStart = CPUTimer_getTimerCount(timerBase);
+    meter->lastPass = meter->windowStart;
+    meter->passCost = UINT32_MAX;
+    meter->idle = 0U;
+    meter->windows = 0U;
+    meter->load = 0U;
+    meter->peak = 0U;
+}
+
+//*****************************************************************************
+//
+// CPULoad_idle
+//
+//*****************************************************************************
+bool
+CPULoad_idle(CPULoad_Meter *meter)
+{
+    uint32_t now = CPUTimer_getTimerCount(meter->timerBase);
+    uint32_t pass;
+    uint32_t elapsed;
+    uint32_t busy;
+
+    //
+    // The timer counts down
+    //
+    pass = meter->lastPass - now;
+    meter->lastPass = now;
+
+    if(pass < meter->passCost)
+    {
+        meter->passCost = pass;
+    }
+    meter->idle += meter->passCost;
+
+    elapsed = meter->windowStart - now;
+    if(elapsed < meter->window)
+    {
+        return(false);
+    }
+
+    busy = (meter->idle < elapsed) ? (elapsed - meter->idle) : 0U;
+    meter->load = (uint16_t)(((uint64_t)busy * PWMDUTY_ONE) / elapsed);
+    if(meter->load > meter->peak)
+    {
+        meter->peak = meter->load;
+    }
+
+    meter->windowStart = now;
+    meter->idle = 0U;
+    meter->windows++;
+
+    return(true);
+}
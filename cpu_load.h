@@ -0,0 +1,140 @@
+//#############################################################################
+//
+// FILE:   cpu_load.h
+//
+// TITLE:  CPU load meter based on idle-loop accounting.
+//
+//#############################################################################
+//
+// The background loop calls CPULoad_idle() once per pass in which it found
+// nothing to do. The meter time-stamps the calls with a free-running CPU
+// timer. The shortest time seen between two calls is the cost of an empty
+// pass; every pass is credited that much idle time, and whatever a pass
+// took on top of it went to interrupts or background work.
+//
+// At the end of each window the load is the busy share of the window in Q15
+// (see pwm_duty.h), so PWMDUTY_ONE means the core never got back to an
+// empty pass. The peak is the highest load of any window since
+// CPULoad_init().
+//
+// The empty pass cost is learned on the fly and only ever decreases, so
+// the first window can read low. Passes that handle a command are not
+// reported as idle and count as busy in full.
+//
+//#############################################################################
+
+#ifndef CPU_LOAD_H
+#define CPU_LOAD_H
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//
+// Included Files
+//
+#include <stdbool.h>
+#include <stdint.h>
+#include "driverlib.h"
+
+//*****************************************************************************
+//
+//! State of a load meter. Initialize with CPULoad_init().
+//
+//*****************************************************************************
+typedef struct
+{
+    uint32_t timerBase;         //!< Free-running time stamp timer
+    uint32_t window;            //!< Window length in SYSCLK cycles
+    uint32_t windowStart;       //!< Timer count at the start of the window
+    uint32_t lastPass;          //!< Timer count at the last idle pass
+    uint32_t passCost;          //!< Shortest idle pass seen, SYSCLK cycles
+    uint32_t idle;              //!< Idle cycles in the current window
+    uint32_t windows;           //!< Completed windows
+    uint16_t load;              //!< Load of the last window, Q15
+    uint16_t peak;              //!< Highest load of any window, Q15
+} CPULoad_Meter;
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+//*****************************************************************************
+//
+//! Starts a load meter.
+//!
+//! \param meter is the meter to initialize.
+//! \param timerBase is the base address of a CPU timer that is running with
+//! a period of 0xFFFFFFFF and no prescaler.
+//! \param window is the measurement window in SYSCLK cycles.
+//!
+//! Call right before entering the background loop.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+CPULoad_init(CPULoad_Meter *meter, uint32_t timerBase, uint32_t window);
+
+//*****************************************************************************
+//
+//! Accounts one idle pass of the background loop.
+//!
+//! \param meter is the meter to update.
+//!
+//! \return Returns \b true when the pass completed a window and a new load
+//! value is available.
+//
+//*****************************************************************************
+extern bool
+CPULoad_idle(CPULoad_Meter *meter);
+
+//*****************************************************************************
+//
+//! Returns the load of the last completed window.
+//!
+//! \param meter is the meter to read.
+//!
+//! \return Returns the busy share of the window in Q15, 0 before the first
+//! window completed.
+//
+//*****************************************************************************
+static inline uint16_t
+CPULoad_getLoad(const CPULoad_Meter *meter)
+{
+    return(meter->load);
+}
+
+//*****************************************************************************
+//
+//! Returns the highest load of any window.
+//!
+//! \param meter is the meter to read.
+//!
+//! \return Returns the peak load in Q15.
+//
+//*****************************************************************************
+static inline uint16_t
+CPULoad_getPeak(const CPULoad_Meter *meter)
+{
+    return(meter->peak);
+}
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CPU_LOAD_H
@@ -59,7 +59,7 @@ void
 ADC_setVREF(uint32_t base, ADC_ReferenceMode refMode,
             ADC_ReferenceVoltage refVoltage)
 {
-    uint16_t *offset;
+    uint32_t offset;
     uint16_t moduleShiftVal;
     uint16_t offsetShiftVal;
 
@@ -105,16 +105,16 @@ ADC_setVREF(uint32_t base, ADC_ReferenceMode refMode,
     }
 
     //
-    // Set up pointer to offset trim in OTP.
+    // Set up address of offset trim in OTP.
     //
-    offset = (uint16_t *)(ADC_OFFSET_TRIM_OTP + ((uint32_t)6U *
-                                                 (uint32_t)moduleShiftVal));
+    offset = ADC_OFFSET_TRIM_OTP + ((uint32_t)6U * (uint32_t)moduleShiftVal);
 
     //
     // Get offset trim from OTP and write it to the register.
     //
     EALLOW;
-    HWREGH(base + ADC_O_OFFTRIM) = (*offset >> offsetShiftVal) & 0xFFU;
+    HWREGH(base + ADC_O_OFFTRIM) = (HWREGH(offset) >> offsetShiftVal) &
+                                   0xFFU;
 
     //
     // Configure the reference mode (internal or external).
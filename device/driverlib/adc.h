@@ -93,10 +93,10 @@ extern "C"
 #define ADC_PPBTRIP_MASK     ((uint32_t)ADC_PPB1TRIPHI_LIMITHI_M |            \
                               (uint32_t)ADC_PPB1TRIPHI_HSIGN)
 
-#define ADC_INT_REF_TSSLOPE  (*(int16_t *)0x705BD)
-#define ADC_INT_REF_TSOFFSET (*(int16_t *)0x705BE)
-#define ADC_EXT_REF_TSSLOPE  (*(int16_t *)0x705BF)
-#define ADC_EXT_REF_TSOFFSET (*(int16_t *)0x705C0)
+#define ADC_INT_REF_TSSLOPE  ((int16_t)HWREGH(0x705BDUL))
+#define ADC_INT_REF_TSOFFSET ((int16_t)HWREGH(0x705BEUL))
+#define ADC_EXT_REF_TSSLOPE  ((int16_t)HWREGH(0x705BFUL))
+#define ADC_EXT_REF_TSOFFSET ((int16_t)HWREGH(0x705C0UL))
 
 #ifndef DOXYGEN_PDF_IGNORE
 //*****************************************************************************
@@ -745,7 +745,7 @@ ADC_clearInterruptStatus(uint32_t base, ADC_IntNumber adcIntNum)
 static inline uint16_t
 ADC_readResult(uint32_t resultBase, ADC_SOCNumber socNumber)
 {
-    uint16_t* resAddr;
+    uint32_t resAddr;
 
     //
     // Check the arguments.
@@ -757,12 +757,12 @@ ADC_readResult(uint32_t resultBase, ADC_SOCNumber socNumber)
     //
     // Get the address to the appropriate result.
     //
-    resAddr = (uint16_t*)(resultBase + ADC_RESULTx_OFFSET_BASE);
+    resAddr = resultBase + ADC_RESULTx_OFFSET_BASE;
 
     //
     // Return the result found at that address and offset.
     //
-    return(resAddr[socNumber]);
+    return(HWREGH(resAddr + (uint32_t)socNumber));
 }
 
 //*****************************************************************************
@@ -1018,7 +1018,7 @@ ADC_enablePPBEvent(uint32_t base, ADC_PPBNumber ppbNumber, uint16_t evtFlags)
     // Check the arguments.
     //
     ASSERT(ADC_isBaseValid(base));
-    ASSERT((evtFlags & 0x7U) == 0U);
+    ASSERT((evtFlags & ~0x7U) == 0U);
 
     //
     // Enable the specified event.
@@ -1051,7 +1051,7 @@ ADC_disablePPBEvent(uint32_t base, ADC_PPBNumber ppbNumber, uint16_t evtFlags)
     // Check the arguments.
     //
     ASSERT(ADC_isBaseValid(base));
-    ASSERT((evtFlags & 0x7U) == 0U);
+    ASSERT((evtFlags & ~0x7U) == 0U);
 
     //
     // Disable the specified event.
@@ -1086,7 +1086,7 @@ ADC_enablePPBEventInterrupt(uint32_t base, ADC_PPBNumber ppbNumber,
     // Check the arguments.
     //
     ASSERT(ADC_isBaseValid(base));
-    ASSERT((intFlags & 0x3U) == 0U);
+    ASSERT((intFlags & ~0x7U) == 0U);
 
     //
     // Enable the specified event interrupts.
@@ -1121,7 +1121,7 @@ ADC_disablePPBEventInterrupt(uint32_t base, ADC_PPBNumber ppbNumber,
     // Check the arguments.
     //
     ASSERT(ADC_isBaseValid(base));
-    ASSERT((intFlags & 0x3U) == 0U);
+    ASSERT((intFlags & ~0x7U) == 0U);
 
     //
     // Disable the specified event interrupts.
@@ -1184,7 +1184,7 @@ ADC_clearPPBEventStatus(uint32_t base, ADC_PPBNumber ppbNumber,
     // Check the arguments.
     //
     ASSERT(ADC_isBaseValid(base));
-    ASSERT((evtFlags & 0x7U) == 0U);
+    ASSERT((evtFlags & ~0x7U) == 0U);
 
     //
     // Clear the specified event interrupts.
@@ -1212,7 +1212,7 @@ ADC_clearPPBEventStatus(uint32_t base, ADC_PPBNumber ppbNumber,
 static inline int32_t
 ADC_readPPBResult(uint32_t resultBase, ADC_PPBNumber ppbNumber)
 {
-    uint32_t *ppbRegAddr;
+    uint32_t ppbRegAddr;
 
     //
     // Check the arguments.
@@ -1224,12 +1224,12 @@ ADC_readPPBResult(uint32_t resultBase, ADC_PPBNumber ppbNumber)
     //
     // Get the offset to the appropriate result.
     //
-    ppbRegAddr = (uint32_t*)(resultBase + ADC_PPBxRESULT_OFFSET_BASE);
+    ppbRegAddr = resultBase + ADC_PPBxRESULT_OFFSET_BASE;
 
     //
     // Return the result found at that address and offset.
     //
-    return((int32_t)ppbRegAddr[ppbNumber]);
+    return((int32_t)HWREG(ppbRegAddr + ((uint32_t)ppbNumber * 2U)));
 }
 
 //*****************************************************************************
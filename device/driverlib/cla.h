@@ -260,7 +260,7 @@ CLA_isBaseValid(uint32_t base)
 }
 #endif
 
-#ifdef __TMS320C28XX__ // These functions are only accessible from the C28x
+#if defined(__TMS320C28XX__) || defined(HOST_SIM) // Not for the CLA
 //*****************************************************************************
 //
 //! Map CLA Task Interrupt Vector
@@ -1036,7 +1036,7 @@ CLA_getBackgroundTaskStatus(uint32_t base, CLA_BGTaskStatus stsFlag)
     return((HWREGH(base + CLA_O_MSTSBGRND) & (uint16_t)stsFlag) != 0U);
 }
 
-#endif // #ifdef __TMS320C28XX__
+#endif // defined(__TMS320C28XX__) || defined(HOST_SIM)
 
 //
 // These functions are accessible only from the CLA (Type - 1/2)
@@ -1195,7 +1195,7 @@ CLA_forceSoftwareInterrupt(uint32_t base, uint16_t taskFlags)
 //
 // These functions can only be called from the C28x
 //
-#ifdef __TMS320C28XX__
+#if defined(__TMS320C28XX__) || defined(HOST_SIM)
 
 //*****************************************************************************
 //
@@ -1216,7 +1216,7 @@ CLA_forceSoftwareInterrupt(uint32_t base, uint16_t taskFlags)
 extern void
 CLA_setTriggerSource(CLA_TaskNumber taskNumber, CLA_Trigger trigger);
 
-#endif //#ifdef __TMS320C28XX__
+#endif // defined(__TMS320C28XX__) || defined(HOST_SIM)
 //*****************************************************************************
 //
 // Close the Doxygen group.
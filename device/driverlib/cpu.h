@@ -54,17 +54,39 @@ extern "C"
 {
 #endif
 
+#ifdef HOST_SIM
+//
+// Host build: core registers are plain variables owned by the simulator and
+// the C28x-only instructions and keywords are mapped to host equivalents.
+//
+extern volatile uint16_t IFR;
+extern volatile uint16_t IER;
+
+extern uint16_t __enable_interrupts(void);
+extern uint16_t __disable_interrupts(void);
+
+#define __interrupt
+#define EINT   ((void)__enable_interrupts())
+#define DINT   ((void)__disable_interrupts())
+#define ERTM   ((void)0)
+#define DRTM   ((void)0)
+#define ESTOP0 __builtin_trap()
+#define ESTOP1 __builtin_trap()
+#define NOP    ((void)0)
+#define IDLE   ((void)0)
+#endif // HOST_SIM
+
 //
 // External reference to the interrupt flag register (IFR) register
 //
-#ifndef __TMS320C28XX_CLA__
+#if !defined(__TMS320C28XX_CLA__) && !defined(HOST_SIM)
 extern __cregister volatile uint16_t IFR;
 #endif
 
 //
 // External reference to the interrupt enable register (IER) register
 //
-#ifndef __TMS320C28XX_CLA__
+#if !defined(__TMS320C28XX_CLA__) && !defined(HOST_SIM)
 extern __cregister volatile uint16_t IER;
 #endif
 
@@ -50,18 +50,31 @@
 void DMA_configAddresses(uint32_t base, const void *destAddr,
                          const void *srcAddr)
 {
+    uint32_t srcAddress;
+    uint32_t destAddress;
+
     // Check the arguments.
     ASSERT(DMA_isBaseValid(base));
 
+#ifdef HOST_SIM
+    // Host pointers are wider than the address registers; the simulator
+    // translates them back to simulated word addresses.
+    srcAddress = Sim_getAddress(srcAddr);
+    destAddress = Sim_getAddress(destAddr);
+#else
+    srcAddress = (uint32_t)srcAddr;
+    destAddress = (uint32_t)destAddr;
+#endif
+
     EALLOW;
 
     // Set up SOURCE address.
-    HWREG(base + DMA_O_SRC_BEG_ADDR_SHADOW) = (uint32_t)srcAddr;
-    HWREG(base + DMA_O_SRC_ADDR_SHADOW)     = (uint32_t)srcAddr;
+    HWREG(base + DMA_O_SRC_BEG_ADDR_SHADOW) = srcAddress;
+    HWREG(base + DMA_O_SRC_ADDR_SHADOW)     = srcAddress;
 
     // Set up DESTINATION address.
-    HWREG(base + DMA_O_DST_BEG_ADDR_SHADOW) = (uint32_t)destAddr;
-    HWREG(base + DMA_O_DST_ADDR_SHADOW)     = (uint32_t)destAddr;
+    HWREG(base + DMA_O_DST_BEG_ADDR_SHADOW) = destAddress;
+    HWREG(base + DMA_O_DST_ADDR_SHADOW)     = destAddress;
 
     EDIS;
 }
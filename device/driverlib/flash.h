@@ -178,7 +178,11 @@ typedef enum
 // Delay instruction that allows for register configuration to complete.
 //
 //*****************************************************************************
+#ifdef HOST_SIM
+#define    FLASH_DELAY_CONFIG
+#else
 #define    FLASH_DELAY_CONFIG     __asm(" RPT #7 || NOP")
+#endif
 
 //*****************************************************************************
 //
@@ -58,7 +58,7 @@ GPIO_setDirectionMode(uint32_t pin, GPIO_Direction pinIO)
     //
     ASSERT(GPIO_isPinValid(pin));
 
-    gpioBaseAddr = (uint32_t *)GPIOCTRL_BASE +
+    gpioBaseAddr = HWREGPTR(GPIOCTRL_BASE) +
                    ((pin / 32U) * GPIO_CTRL_REGS_STEP);
     pinMask = (uint32_t)1U << (pin % 32U);
 
@@ -96,7 +96,7 @@ GPIO_getDirectionMode(uint32_t pin)
     //
     ASSERT(GPIO_isPinValid(pin));
 
-    gpioBaseAddr = (uint32_t *)GPIOCTRL_BASE +
+    gpioBaseAddr = HWREGPTR(GPIOCTRL_BASE) +
                    ((pin / 32U) * GPIO_CTRL_REGS_STEP);
 
     return((GPIO_Direction)((gpioBaseAddr[GPIO_GPxDIR_INDEX] >>
@@ -174,7 +174,7 @@ GPIO_setPadConfig(uint32_t pin, uint32_t pinType)
     //
     ASSERT(GPIO_isPinValid(pin));
 
-    gpioBaseAddr = (uint32_t *)GPIOCTRL_BASE +
+    gpioBaseAddr = HWREGPTR(GPIOCTRL_BASE) +
                    ((pin / 32U) * GPIO_CTRL_REGS_STEP);
     pinMask = (uint32_t)1U << (pin % 32U);
 
@@ -230,7 +230,7 @@ GPIO_getPadConfig(uint32_t pin)
     //
     ASSERT(GPIO_isPinValid(pin));
 
-    gpioBaseAddr = (uint32_t *)GPIOCTRL_BASE +
+    gpioBaseAddr = HWREGPTR(GPIOCTRL_BASE) +
                    ((pin / 32U) * GPIO_CTRL_REGS_STEP);
     pinMask = (uint32_t)1U << (pin % 32U);
 
@@ -274,7 +274,7 @@ GPIO_setQualificationMode(uint32_t pin, GPIO_QualificationMode qualification)
     //
     ASSERT(GPIO_isPinValid(pin));
 
-    gpioBaseAddr = (uint32_t *)GPIOCTRL_BASE +
+    gpioBaseAddr = HWREGPTR(GPIOCTRL_BASE) +
                    ((pin / 32U) * GPIO_CTRL_REGS_STEP);
     shiftAmt = (uint32_t)GPIO_GPAQSEL1_GPIO1_S * (pin % 16U);
     qSelIndex = GPIO_GPxQSEL_INDEX + ((pin % 32U) / 16U);
@@ -308,7 +308,7 @@ GPIO_getQualificationMode(uint32_t pin)
     //
     ASSERT(GPIO_isPinValid(pin));
 
-    gpioBaseAddr = (uint32_t *)GPIOCTRL_BASE +
+    gpioBaseAddr = HWREGPTR(GPIOCTRL_BASE) +
                    ((pin / 32U) * GPIO_CTRL_REGS_STEP);
     shiftAmt = (uint32_t)GPIO_GPAQSEL1_GPIO1_S * (pin % 16U);
     qSelIndex = GPIO_GPxQSEL_INDEX + ((pin % 32U) / 16U);
@@ -351,7 +351,7 @@ GPIO_setQualificationPeriod(uint32_t pin, uint32_t divider)
     //
     // Write the divider parameter into the register.
     //
-    gpioBaseAddr = (uint32_t *)GPIOCTRL_BASE +
+    gpioBaseAddr = HWREGPTR(GPIOCTRL_BASE) +
                    ((pin / 32U) * GPIO_CTRL_REGS_STEP);
 
     EALLOW;
@@ -377,7 +377,7 @@ GPIO_setMasterCore(uint32_t pin, GPIO_CoreSelect core)
     //
     ASSERT(GPIO_isPinValid(pin));
 
-    gpioBaseAddr = (uint32_t *)GPIOCTRL_BASE +
+    gpioBaseAddr = HWREGPTR(GPIOCTRL_BASE) +
                    ((pin / 32U) * GPIO_CTRL_REGS_STEP);
     shiftAmt = (uint32_t)GPIO_GPACSEL1_GPIO1_S * (pin % 8U);
     cSelIndex = GPIO_GPxCSEL_INDEX + ((pin % 32U) / 8U);
@@ -408,7 +408,7 @@ GPIO_setAnalogMode(uint32_t pin, GPIO_AnalogMode mode)
     ASSERT((pin >= 224U) && (pin <= 247U) || (pin == 22) || (pin == 23));
 
     pinMask = (uint32_t)1U << (pin % 32U);
-    gpioBaseAddr = (uint32_t *)GPIOCTRL_BASE +
+    gpioBaseAddr = HWREGPTR(GPIOCTRL_BASE) +
                    ((pin / 32U) * GPIO_CTRL_REGS_STEP);
 
     EALLOW;
@@ -388,7 +388,7 @@ GPIO_readPin(uint32_t pin)
     //
     ASSERT(GPIO_isPinValid(pin));
 
-    gpioDataReg = (uint32_t *)GPIODATA_BASE +
+    gpioDataReg = HWREGPTR(GPIODATA_BASE) +
                   ((pin / 32U) * GPIO_DATA_REGS_STEP);
 
     return((gpioDataReg[GPIO_GPxDAT_INDEX] >> (pin % 32U)) & (uint32_t)0x1U);
@@ -421,7 +421,7 @@ GPIO_writePin(uint32_t pin, uint32_t outVal)
     //
     ASSERT(GPIO_isPinValid(pin));
 
-    gpioDataReg = (uint32_t *)GPIODATA_BASE +
+    gpioDataReg = HWREGPTR(GPIODATA_BASE) +
                   ((pin / 32U) * GPIO_DATA_REGS_STEP);
 
     pinMask = (uint32_t)1U << (pin % 32U);
@@ -461,7 +461,7 @@ GPIO_togglePin(uint32_t pin)
     //
     ASSERT(GPIO_isPinValid(pin));
 
-    gpioDataReg = (uint32_t *)GPIODATA_BASE +
+    gpioDataReg = HWREGPTR(GPIODATA_BASE) +
                   ((pin / 32U) * GPIO_DATA_REGS_STEP);
 
     gpioDataReg[GPIO_GPxTOGGLE_INDEX] = (uint32_t)1U << (pin % 32U);
@@ -487,7 +487,7 @@ GPIO_readPortData(GPIO_Port port)
     //
     // Get the starting address of the port's registers and return DATA.
     //
-    gpioDataReg = (uint32_t *)GPIODATA_BASE +
+    gpioDataReg = HWREGPTR(GPIODATA_BASE) +
                   ((uint32_t)port * GPIO_DATA_REGS_STEP);
 
     return(gpioDataReg[GPIO_GPxDAT_INDEX]);
@@ -520,7 +520,7 @@ GPIO_writePortData(GPIO_Port port, uint32_t outVal)
     //
     // Get the starting address of the port's registers and write to DATA.
     //
-    gpioDataReg = (uint32_t *)GPIODATA_BASE +
+    gpioDataReg = HWREGPTR(GPIODATA_BASE) +
                   ((uint32_t)port * GPIO_DATA_REGS_STEP);
 
     gpioDataReg[GPIO_GPxDAT_INDEX] = outVal;
@@ -553,7 +553,7 @@ GPIO_setPortPins(GPIO_Port port, uint32_t pinMask)
     //
     // Get the starting address of the port's registers and write to SET.
     //
-    gpioDataReg = (uint32_t *)GPIODATA_BASE +
+    gpioDataReg = HWREGPTR(GPIODATA_BASE) +
                   ((uint32_t)port * GPIO_DATA_REGS_STEP);
 
     gpioDataReg[GPIO_GPxSET_INDEX] = pinMask;
@@ -586,7 +586,7 @@ GPIO_clearPortPins(GPIO_Port port, uint32_t pinMask)
     //
     // Get the starting address of the port's registers and write to CLEAR.
     //
-    gpioDataReg = (uint32_t *)GPIODATA_BASE +
+    gpioDataReg = HWREGPTR(GPIODATA_BASE) +
                   ((uint32_t)port * GPIO_DATA_REGS_STEP);
 
     gpioDataReg[GPIO_GPxCLEAR_INDEX] = pinMask;
@@ -619,7 +619,7 @@ GPIO_togglePortPins(GPIO_Port port, uint32_t pinMask)
     //
     // Get the starting address of the port's registers and write to TOGGLE.
     //
-    gpioDataReg = (uint32_t *)GPIODATA_BASE +
+    gpioDataReg = HWREGPTR(GPIODATA_BASE) +
                   ((uint32_t)port * GPIO_DATA_REGS_STEP);
 
     gpioDataReg[GPIO_GPxTOGGLE_INDEX] = pinMask;
@@ -656,7 +656,7 @@ GPIO_lockPortConfig(GPIO_Port port, uint32_t pinMask)
     //
     // Get the starting address of the port's registers and write to the lock.
     //
-    gpioDataReg = (uint32_t *)GPIOCTRL_BASE +
+    gpioDataReg = HWREGPTR(GPIOCTRL_BASE) +
                   ((uint32_t)port * GPIO_CTRL_REGS_STEP);
 
     EALLOW;
@@ -691,7 +691,7 @@ GPIO_unlockPortConfig(GPIO_Port port, uint32_t pinMask)
     //
     // Get the starting address of the port's registers and write to the lock.
     //
-    gpioDataReg = (uint32_t *)GPIOCTRL_BASE +
+    gpioDataReg = HWREGPTR(GPIOCTRL_BASE) +
                   ((uint32_t)port * GPIO_CTRL_REGS_STEP);
 
     EALLOW;
@@ -730,7 +730,7 @@ GPIO_commitPortConfig(GPIO_Port port, uint32_t pinMask)
     //
     // Get the starting address of the port's registers and write to the lock.
     //
-    gpioDataReg = (uint32_t *)GPIOCTRL_BASE +
+    gpioDataReg = HWREGPTR(GPIOCTRL_BASE) +
                   ((uint32_t)port * GPIO_CTRL_REGS_STEP);
 
     EALLOW;
@@ -48,6 +48,24 @@
 // Macros for hardware access
 //
 //*****************************************************************************
+#ifdef HOST_SIM
+//
+// Host build: route all register accesses to the simulated register file.
+//
+#include "sim.h"
+#define HWREG(x)                                                              \
+        (*((volatile uint32_t *)Sim_getRegAddress((uint32_t)(x))))
+#define HWREG_BP(x)                                                           \
+        HWREG(x)
+#define HWREGH(x)                                                             \
+        (*Sim_getRegAddress((uint32_t)(x)))
+#define HWREGB(x)                                                             \
+        (*((volatile uint8_t *)Sim_getRegAddress((uint32_t)(x))))
+#define HWREGPTR(x)                                                           \
+        ((volatile uint32_t *)Sim_getRegAddress((uint32_t)(x)))
+#define __byte(x, i)                                                          \
+        (((int8_t *)(x))[(i)])
+#else
 #define HWREG(x)                                                              \
         (*((volatile uint32_t *)(x)))
 #define HWREG_BP(x)                                                           \
@@ -56,6 +74,9 @@
         (*((volatile uint16_t *)(x)))
 #define HWREGB(x)                                                             \
         __byte((int16_t *)(x),0)
+#define HWREGPTR(x)                                                           \
+        ((volatile uint32_t *)(x))
+#endif // HOST_SIM
 
 //*****************************************************************************
 //
@@ -84,7 +105,8 @@ typedef long double         float64_t;
 // prototype, it will not build in C code.
 //
 //*****************************************************************************
-#if(defined(__TMS320C28XX__) || defined(__TMS320C28XX_CLA__))
+#if(defined(__TMS320C28XX__) || defined(__TMS320C28XX_CLA__) ||              \
+    defined(HOST_SIM))
 #else
 extern int16_t &__byte(int16_t *array, uint16_t byte_index);
 extern uint32_t &__byte_peripheral_32(uint32_t *x);
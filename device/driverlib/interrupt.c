@@ -182,17 +182,28 @@ Interrupt_initVectorTable(void)
     //
     for(i = 3U; i < 224U; i++)
     {
+#ifdef HOST_SIM
+        Sim_setVector(PIEVECTTABLE_BASE + (2U * i), Interrupt_defaultHandler);
+#else
         HWREG(PIEVECTTABLE_BASE + (2U * i)) =
             (uint32_t)Interrupt_defaultHandler;
+#endif
     }
 
     //
     // NMI and ITRAP get their own handlers.
     //
+#ifdef HOST_SIM
+    Sim_setVector((uint32_t)PIEVECTTABLE_BASE + ((INT_NMI >> 16U) * 2U),
+                  Interrupt_nmiHandler);
+    Sim_setVector((uint32_t)PIEVECTTABLE_BASE + ((INT_ILLEGAL >> 16U) * 2U),
+                  Interrupt_illegalOperationHandler);
+#else
     HWREG((uint32_t)PIEVECTTABLE_BASE + ((INT_NMI >> 16U) * 2U)) =
         (uint32_t)Interrupt_nmiHandler;
     HWREG((uint32_t)PIEVECTTABLE_BASE + ((INT_ILLEGAL >> 16U) * 2U)) =
         (uint32_t)Interrupt_illegalOperationHandler;
+#endif
 
     EDIS;
 }
@@ -304,7 +304,11 @@ Interrupt_register(uint32_t interruptNumber, void (*handler)(void))
     // Copy ISR address into PIE table
     //
     EALLOW;
+#ifdef HOST_SIM
+    Sim_setVector(address, handler);
+#else
     HWREG(address) = (uint32_t)handler;
+#endif
     EDIS;
 }
 
@@ -343,7 +347,11 @@ Interrupt_unregister(uint32_t interruptNumber)
     // Copy default ISR address into PIE table
     //
     EALLOW;
+#ifdef HOST_SIM
+    Sim_setVector(address, Interrupt_defaultHandler);
+#else
     HWREG(address) = (uint32_t)Interrupt_defaultHandler;
+#endif
     EDIS;
 }
 
@@ -58,8 +58,12 @@
 //
 // SysCtl_delay()
 //
+// The host build (HOST_SIM) provides its own SysCtl_delay() in sim.c.
+//
 //*****************************************************************************
+#ifndef HOST_SIM
 SYSCTL_DELAY;
+#endif
 
 //*****************************************************************************
 //
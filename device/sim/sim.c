@@ -0,0 +1,642 @@
+//###########################################################################
+//
+// FILE:   sim.c
+//
+// TITLE:  Host-side peripheral register file simulator.
+//
+//###########################################################################
+
+//
+// clock_gettime() and CLOCK_MONOTONIC are POSIX, not ISO C
+//
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "sim.h"
+#include "driverlib.h"
+
+//
+// Register file and per-page access handlers
+//
+uint16_t *Sim_regFile;
+Sim_AccessHandler Sim_pageHandler[SIM_NUM_PAGES];
+
+//
+// CPU cost charged per register access while a handler runs, and the cost
+// charged to the running handler so far
+//
+uint16_t Sim_accessCharge;
+uint32_t Sim_handlerCycles;
+
+//
+// Simulated PIE vector table holding host function pointers
+//
+static void (*Sim_vectorTable[SIM_NUM_VECTORS])(void);
+
+//
+// Simulated CPU core registers and INTM state
+//
+volatile uint16_t IER;
+volatile uint16_t IFR;
+static uint16_t Sim_intm = 1U;
+
+//
+// Simulated time base, registered peripheral models and PIE state
+//
+static uint64_t Sim_cycles;
+static Sim_Model *Sim_models;
+static uint16_t Sim_pieAck;
+static bool Sim_inDispatch;
+static uint16_t Sim_accessCost;
+static void (*Sim_idleHook)(void);
+static Sim_InterruptStats Sim_intStats[SIM_NUM_VECTORS];
+
+//
+// Models listening on the trigger network
+//
+static Sim_TriggerHandler Sim_triggerHandlers[SIM_NUM_TRIGGER_HANDLERS];
+
+//
+// Register values that differ from zero after reset. Only registers that the
+// driverlib start-up code spins on are listed here.
+//
+typedef struct
+{
+    uint32_t address;
+    uint16_t value;
+} Sim_ResetValue;
+
+static const Sim_ResetValue Sim_resetValues[] =
+{
+    { CLKCFG_BASE + SYSCTL_O_SYSPLLSTS, SYSCTL_SYSPLLSTS_LOCKS },
+    { DCC0_BASE + DCC_O_STATUS,         DCC_STATUS_DONE        },
+};
+
+//*****************************************************************************
+//
+// Sim_allocRegFile
+//
+//*****************************************************************************
+uint16_t *
+Sim_allocRegFile(void)
+{
+    //
+    // A block this large is served by a private anonymous mapping, so the
+    // untouched parts of the address space never become resident.
+    //
+    Sim_regFile = (uint16_t *)calloc(SIM_ADDR_M + 1UL, sizeof(uint16_t));
+    if(Sim_regFile == NULL)
+    {
+        abort();
+    }
+
+    return(Sim_regFile);
+}
+
+//*****************************************************************************
+//
+// Sim_getAddress
+//
+//*****************************************************************************
+uint32_t
+Sim_getAddress(const volatile void *pointer)
+{
+    const volatile uint16_t *word = (const volatile uint16_t *)pointer;
+
+    //
+    // Device addresses cast to a pointer are already word addresses
+    //
+    if((uintptr_t)pointer <= SIM_ADDR_M)
+    {
+        return((uint32_t)(uintptr_t)pointer);
+    }
+
+    if((Sim_regFile == NULL) || (word < Sim_regFile) ||
+       (word > &Sim_regFile[SIM_ADDR_M]))
+    {
+        fprintf(stderr, "Sim_getAddress: %p is not in the simulated "
+                "address space\n", (const void *)pointer);
+        abort();
+    }
+
+    return((uint32_t)(word - Sim_regFile));
+}
+
+//*****************************************************************************
+//
+// Sim_getRAMAddress
+//
+//*****************************************************************************
+uint16_t *
+Sim_getRAMAddress(uint32_t address)
+{
+    if(Sim_regFile == NULL)
+    {
+        (void)Sim_allocRegFile();
+    }
+
+    return(&Sim_regFile[address & SIM_ADDR_M]);
+}
+
+//*****************************************************************************
+//
+// Sim_reset
+//
+//*****************************************************************************
+void
+Sim_reset(void)
+{
+    Sim_Model *model;
+    uint16_t i;
+
+    free(Sim_regFile);
+    (void)Sim_allocRegFile();
+
+    for(i = 0U; i < (sizeof(Sim_resetValues) / sizeof(Sim_resetValues[0]));
+        i++)
+    {
+        Sim_writeReg16(Sim_resetValues[i].address, Sim_resetValues[i].value);
+    }
+
+    memset(Sim_vectorTable, 0, sizeof(Sim_vectorTable));
+    memset(Sim_intStats, 0, sizeof(Sim_intStats));
+    IER = 0U;
+    IFR = 0U;
+    Sim_intm = 1U;
+    Sim_cycles = 0U;
+    Sim_pieAck = 0U;
+
+    for(model = Sim_models; model != NULL; model = model->next)
+    {
+        if(model->reset != NULL)
+        {
+            model->reset();
+        }
+    }
+}
+
+//*****************************************************************************
+//
+// Sim_attachHandler
+//
+//*****************************************************************************
+void
+Sim_attachHandler(uint32_t startAddress, uint32_t endAddress,
+                  Sim_AccessHandler handler)
+{
+    uint32_t page;
+
+    for(page = (startAddress & SIM_ADDR_M) >> SIM_PAGE_S;
+        page <= ((endAddress & SIM_ADDR_M) >> SIM_PAGE_S); page++)
+    {
+        Sim_pageHandler[page] = handler;
+    }
+}
+
+//*****************************************************************************
+//
+// Sim_readReg16 / Sim_readReg32 / Sim_writeReg16 / Sim_writeReg32
+//
+//*****************************************************************************
+static inline uint16_t *
+Sim_getStorage(uint32_t address)
+{
+    uint16_t *mem = Sim_regFile;
+
+    if(mem == NULL)
+    {
+        mem = Sim_allocRegFile();
+    }
+
+    return(&mem[address & SIM_ADDR_M]);
+}
+
+uint16_t
+Sim_readReg16(uint32_t address)
+{
+    return(*Sim_getStorage(address));
+}
+
+uint32_t
+Sim_readReg32(uint32_t address)
+{
+    return(*(uint32_t *)Sim_getStorage(address));
+}
+
+void
+Sim_writeReg16(uint32_t address, uint16_t value)
+{
+    *Sim_getStorage(address) = value;
+}
+
+void
+Sim_writeReg32(uint32_t address, uint32_t value)
+{
+    *(uint32_t *)Sim_getStorage(address) = value;
+}
+
+//*****************************************************************************
+//
+// Sim_setVector / Sim_getVector
+//
+//*****************************************************************************
+void
+Sim_setVector(uint32_t address, void (*handler)(void))
+{
+    uint32_t index = (address - PIEVECTTABLE_BASE) / 2U;
+
+    if(index < SIM_NUM_VECTORS)
+    {
+        Sim_vectorTable[index] = handler;
+    }
+}
+
+void
+(*Sim_getVector(uint32_t interruptNumber))(void)
+{
+    uint32_t index = (interruptNumber & 0xFFFF0000U) >> 16U;
+
+    return((index < SIM_NUM_VECTORS) ? Sim_vectorTable[index] : NULL);
+}
+
+//*****************************************************************************
+//
+// Sim_isGlobalInterruptEnabled
+//
+//*****************************************************************************
+bool
+Sim_isGlobalInterruptEnabled(void)
+{
+    return(Sim_intm == 0U);
+}
+
+//*****************************************************************************
+//
+// Sim_registerModel
+//
+//*****************************************************************************
+void
+Sim_registerModel(Sim_Model *model)
+{
+    Sim_Model *m;
+
+    for(m = Sim_models; m != NULL; m = m->next)
+    {
+        if(m == model)
+        {
+            return;
+        }
+    }
+
+    model->next = Sim_models;
+    Sim_models = model;
+}
+
+//*****************************************************************************
+//
+// Sim_getCycles
+//
+//*****************************************************************************
+uint64_t
+Sim_getCycles(void)
+{
+    return(Sim_cycles);
+}
+
+//*****************************************************************************
+//
+// Sim_getCPUCycles
+//
+//*****************************************************************************
+uint64_t
+Sim_getCPUCycles(void)
+{
+    return(Sim_cycles + Sim_handlerCycles);
+}
+
+//*****************************************************************************
+//
+// Sim_setAccessCost
+//
+//*****************************************************************************
+void
+Sim_setAccessCost(uint16_t cycles)
+{
+    Sim_accessCost = cycles;
+}
+
+//*****************************************************************************
+//
+// Sim_run
+//
+//*****************************************************************************
+void
+Sim_run(uint64_t cycles)
+{
+    Sim_Model *model;
+    uint64_t target = Sim_cycles + cycles;
+    uint64_t next;
+    uint64_t event;
+
+    for(;;)
+    {
+        Sim_serviceInterrupts();
+
+        //
+        // Find the earliest event of any model, bounded by the end of the run
+        //
+        next = target;
+        for(model = Sim_models; model != NULL; model = model->next)
+        {
+            event = model->nextEvent();
+            if(event < next)
+            {
+                next = event;
+            }
+        }
+
+        if(next < Sim_cycles)
+        {
+            next = Sim_cycles;
+        }
+
+        Sim_cycles = next;
+        for(model = Sim_models; model != NULL; model = model->next)
+        {
+            model->advance(next);
+        }
+
+        if(next >= target)
+        {
+            Sim_serviceInterrupts();
+            break;
+        }
+    }
+}
+
+//*****************************************************************************
+//
+// Sim_idle / Sim_setIdleHook
+//
+//*****************************************************************************
+void
+Sim_idle(void)
+{
+    Sim_run(SIM_IDLE_CYCLES);
+
+    if(Sim_idleHook != NULL)
+    {
+        Sim_idleHook();
+    }
+}
+
+void
+Sim_setIdleHook(void (*hook)(void))
+{
+    Sim_idleHook = hook;
+}
+
+//*****************************************************************************
+//
+// Sim_raiseInterrupt
+//
+//*****************************************************************************
+void
+Sim_raiseInterrupt(uint32_t interruptNumber)
+{
+    uint32_t ifrAddress;
+    uint16_t group = ((uint16_t)(interruptNumber & 0xFF00U) >> 8U) - 1U;
+    uint16_t channel = (uint16_t)(interruptNumber & 0xFFU) - 1U;
+
+    ifrAddress = PIECTRL_BASE + PIE_O_IFR1 + ((uint32_t)group * 2U);
+    Sim_writeReg16(ifrAddress, Sim_readReg16(ifrAddress) | (1U << channel));
+}
+
+//*****************************************************************************
+//
+// Sim_attachTriggerHandler / Sim_raiseTrigger
+//
+//*****************************************************************************
+void
+Sim_attachTriggerHandler(Sim_TriggerHandler handler)
+{
+    uint16_t i;
+
+    for(i = 0U; i < SIM_NUM_TRIGGER_HANDLERS; i++)
+    {
+        if((Sim_triggerHandlers[i] == NULL) ||
+           (Sim_triggerHandlers[i] == handler))
+        {
+            Sim_triggerHandlers[i] = handler;
+            return;
+        }
+    }
+
+    abort();
+}
+
+void
+Sim_raiseTrigger(uint16_t trigger)
+{
+    uint16_t i;
+
+    for(i = 0U; (i < SIM_NUM_TRIGGER_HANDLERS) &&
+                (Sim_triggerHandlers[i] != NULL); i++)
+    {
+        Sim_triggerHandlers[i](trigger);
+    }
+}
+
+//*****************************************************************************
+//
+// Sim_serviceInterrupts
+//
+//*****************************************************************************
+static uint64_t
+Sim_getHostNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return(((uint64_t)ts.tv_sec * 1000000000U) + (uint64_t)ts.tv_nsec);
+}
+
+void
+Sim_serviceInterrupts(void)
+{
+    Sim_InterruptStats *stats;
+    void (*handler)(void);
+    uint32_t ifrAddress;
+    uint64_t start;
+    uint64_t elapsed;
+    uint16_t flags;
+    uint16_t group;
+    uint16_t channel;
+    uint16_t vector;
+    bool dispatched;
+
+    //
+    // Handlers run with INTM set, as on the CPU, so never nest.
+    //
+    if(Sim_inDispatch)
+    {
+        return;
+    }
+
+    do
+    {
+        dispatched = false;
+
+        //
+        // Writes of 1 to PIEACK re-open the corresponding groups
+        //
+        Sim_pieAck &= ~Sim_readReg16(PIECTRL_BASE + PIE_O_ACK);
+        Sim_writeReg16(PIECTRL_BASE + PIE_O_ACK, 0U);
+
+        if((Sim_intm != 0U) ||
+           ((Sim_readReg16(PIECTRL_BASE + PIE_O_CTRL) & PIE_CTRL_ENPIE) == 0U))
+        {
+            break;
+        }
+
+        for(group = 0U; group < 12U; group++)
+        {
+            if(((IER & (1U << group)) == 0U) ||
+               ((Sim_pieAck & (1U << group)) != 0U))
+            {
+                continue;
+            }
+
+            ifrAddress = PIECTRL_BASE + PIE_O_IFR1 + ((uint32_t)group * 2U);
+            flags = Sim_readReg16(ifrAddress) &
+                    Sim_readReg16(ifrAddress - 1U);
+            if(flags == 0U)
+            {
+                continue;
+            }
+
+            //
+            // Lowest channel has the highest priority within a group
+            //
+            for(channel = 0U; (flags & (1U << channel)) == 0U; channel++)
+            {
+            }
+
+            Sim_writeReg16(ifrAddress,
+                           Sim_readReg16(ifrAddress) & ~(1U << channel));
+            Sim_pieAck |= 1U << group;
+
+            vector = (channel < 8U) ? (0x20U + (group * 8U) + channel) :
+                                      (0x80U + (group * 8U) + channel - 8U);
+            handler = Sim_vectorTable[vector];
+            stats = &Sim_intStats[vector];
+
+            //
+            // PIEVECT holds the address of the vector being fetched
+            //
+            Sim_writeReg16(PIECTRL_BASE + PIE_O_CTRL,
+                           (Sim_readReg16(PIECTRL_BASE + PIE_O_CTRL) &
+                            PIE_CTRL_ENPIE) |
+                           (uint16_t)((PIEVECTTABLE_BASE +
+                                       ((uint32_t)vector * 2U)) &
+                                      PIE_CTRL_PIEVECT_M));
+
+            if(handler != NULL)
+            {
+                Sim_inDispatch = true;
+                Sim_intm = 1U;
+                Sim_handlerCycles = 0U;
+                Sim_accessCharge = Sim_accessCost;
+                start = Sim_getHostNs();
+                handler();
+                elapsed = Sim_getHostNs() - start;
+                Sim_accessCharge = 0U;
+                Sim_intm = 0U;
+                Sim_inDispatch = false;
+
+                stats->cycles += Sim_handlerCycles;
+                if(Sim_handlerCycles > stats->maxCycles)
+                {
+                    stats->maxCycles = Sim_handlerCycles;
+                }
+                Sim_handlerCycles = 0U;
+
+                stats->count++;
+                stats->hostNs += elapsed;
+                if(elapsed > stats->maxHostNs)
+                {
+                    stats->maxHostNs = elapsed;
+                }
+                stats->lastCycle = Sim_cycles;
+            }
+
+            dispatched = true;
+            break;
+        }
+    } while(dispatched);
+}
+
+//*****************************************************************************
+//
+// Sim_getInterruptStats
+//
+//*****************************************************************************
+const Sim_InterruptStats *
+Sim_getInterruptStats(uint32_t interruptNumber)
+{
+    uint32_t index = (interruptNumber & 0xFFFF0000U) >> 16U;
+
+    return((index < SIM_NUM_VECTORS) ? &Sim_intStats[index] : NULL);
+}
+
+//*****************************************************************************
+//
+// Host implementations of the C28x compiler intrinsics used by driverlib.
+// EALLOW protection is not modelled.
+//
+//*****************************************************************************
+void
+__eallow(void)
+{
+}
+
+void
+__edis(void)
+{
+}
+
+uint16_t
+__enable_interrupts(void)
+{
+    uint16_t old = Sim_intm;
+
+    Sim_intm = 0U;
+
+    return(old);
+}
+
+uint16_t
+__disable_interrupts(void)
+{
+    uint16_t old = Sim_intm;
+
+    Sim_intm = 1U;
+
+    return(old);
+}
+
+//*****************************************************************************
+//
+// SysCtl_delay is hand-written assembly on the target. Simulated time is
+// advanced by the peripheral models, so the host version returns at once.
+//
+//*****************************************************************************
+void
+SysCtl_delay(uint32_t count)
+{
+    (void)count;
+}
@@ -0,0 +1,525 @@
+//###########################################################################
+//
+// FILE:   sim.h
+//
+// TITLE:  Host-side peripheral register file simulator.
+//
+//###########################################################################
+//
+// When the project is compiled for the host (gcc/clang on Linux) with
+// HOST_SIM defined, the HWREG/HWREGH/HWREG_BP/HWREGB macros in
+// inc/hw_types.h resolve to a sparse, simulated register file instead of the
+// F28004x peripheral frame. This lets driverlib and the application be
+// executed, profiled and benchmarked off-target.
+//
+// The Makefile in this directory builds the simulator, driverlib and the
+// application modules for the host and runs the host tests in test/:
+//
+//   make -C device/sim test
+//
+//###########################################################################
+
+#ifndef SIM_H
+#define SIM_H
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+//*****************************************************************************
+//
+// Geometry of the simulated register file. The C28x data space is 22 bits
+// wide and word (16-bit) addressed. The register file is one contiguous,
+// zero-filled reservation so that driverlib code that indexes from a register
+// base pointer (see HWREGPTR) works; the host OS only commits the pages the
+// code under test actually touches. Access handlers are tracked in
+// pages of SIM_PAGE_WORDS words.
+//
+//*****************************************************************************
+#define SIM_ADDR_M          0x3FFFFFUL
+#define SIM_PAGE_S          8U
+#define SIM_PAGE_WORDS      (1UL << SIM_PAGE_S)
+#define SIM_NUM_PAGES       ((SIM_ADDR_M + 1UL) >> SIM_PAGE_S)
+
+//*****************************************************************************
+//
+// Simulated RAMGS0, as in the linker command files. Host builds cannot place
+// data with DATA_SECTION, so buffers that a simulated bus master such as the
+// DMA accesses are put here with Sim_getRAMAddress() instead of in the
+// ramgs0 section.
+//
+//*****************************************************************************
+#define SIM_RAMGS0_BASE     0x00C000UL
+#define SIM_RAMGS0_WORDS    0x002000UL
+
+//*****************************************************************************
+//
+// Number of PIE vector table entries (see Interrupt_initVectorTable()).
+//
+//*****************************************************************************
+#define SIM_NUM_VECTORS     224U
+
+//*****************************************************************************
+//
+// Simulated cycles one pass of a background loop takes, see Sim_idle().
+//
+//*****************************************************************************
+#define SIM_IDLE_CYCLES     200U
+
+//*****************************************************************************
+//
+//! Peripheral model hooked into the simulated time base.
+//!
+//! Models are registered with Sim_registerModel(). Sim_run() repeatedly asks
+//! every model for the SYSCLK cycle of its next internal event and advances
+//! all of them to the earliest one, so models only do work when something
+//! observable happens.
+//
+//*****************************************************************************
+typedef struct Sim_Model
+{
+    //
+    //! Returns the absolute SYSCLK cycle of the next event, or UINT64_MAX.
+    //
+    uint64_t (*nextEvent)(void);
+
+    //
+    //! Advances the model to the given absolute SYSCLK cycle, processing
+    //! every event up to and including it.
+    //
+    void (*advance)(uint64_t cycle);
+
+    //
+    //! Restores the model to its reset state. May be NULL.
+    //
+    void (*reset)(void);
+
+    struct Sim_Model *next;
+} Sim_Model;
+
+//*****************************************************************************
+//
+//! Per-interrupt dispatch statistics collected by the simulated PIE.
+//
+//*****************************************************************************
+typedef struct
+{
+    uint32_t count;         //!< Number of times the handler was dispatched
+    uint64_t hostNs;        //!< Total host time spent in the handler
+    uint64_t maxHostNs;     //!< Longest single invocation in host time
+    uint64_t lastCycle;     //!< Simulated cycle of the last dispatch
+    uint64_t cycles;        //!< Total cycles charged to the handler
+    uint32_t maxCycles;     //!< Most cycles charged to one invocation
+} Sim_InterruptStats;
+
+//*****************************************************************************
+//
+//! Prototype of a peripheral access handler.
+//!
+//! An access handler is attached to a range of pages with
+//! Sim_attachHandler() and is invoked with the word address immediately
+//! before every HWREG/HWREGH access that falls into that range. Peripheral
+//! models use it to refresh status registers that the code under test polls.
+//
+//*****************************************************************************
+typedef void (*Sim_AccessHandler)(uint32_t address);
+
+//*****************************************************************************
+//
+//! Prototype of a trigger handler, see Sim_attachTriggerHandler().
+//!
+//! \param trigger is the trigger source, a DMA_Trigger value.
+//
+//*****************************************************************************
+typedef void (*Sim_TriggerHandler)(uint16_t trigger);
+
+//*****************************************************************************
+//
+// Maximum number of trigger handlers, one per consuming model.
+//
+//*****************************************************************************
+#define SIM_NUM_TRIGGER_HANDLERS    4U
+
+//*****************************************************************************
+//
+// Internal state used by the inline accessor below. Do not use directly.
+//
+//*****************************************************************************
+extern uint16_t *Sim_regFile;
+extern Sim_AccessHandler Sim_pageHandler[SIM_NUM_PAGES];
+extern uint16_t Sim_accessCharge;
+extern uint32_t Sim_handlerCycles;
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+//*****************************************************************************
+//
+//! \internal
+//! Reserves the backing storage of the register file.
+//!
+//! \return Returns a pointer to the zero-initialized register file.
+//
+//*****************************************************************************
+extern uint16_t *
+Sim_allocRegFile(void);
+
+//*****************************************************************************
+//
+//! Returns the host pointer backing a simulated register.
+//!
+//! \param address is the C28x word address of the register.
+//!
+//! This is the function behind the HWREG family of macros in host builds.
+//! Any access handler attached to the page is run first. 32-bit registers
+//! live at even word addresses, so the returned pointer is suitably aligned
+//! for a 32-bit access and holds the low word first, as on the C28x.
+//!
+//! \return Returns a pointer to the 16-bit storage of the register.
+//
+//*****************************************************************************
+static inline volatile uint16_t *
+Sim_getRegAddress(uint32_t address)
+{
+    Sim_AccessHandler handler;
+    uint16_t *mem = Sim_regFile;
+
+    if(mem == NULL)
+    {
+        mem = Sim_allocRegFile();
+    }
+
+    Sim_handlerCycles += Sim_accessCharge;
+
+    handler = Sim_pageHandler[(address & SIM_ADDR_M) >> SIM_PAGE_S];
+    if(handler != NULL)
+    {
+        handler(address);
+    }
+
+    return(&mem[address & SIM_ADDR_M]);
+}
+
+//*****************************************************************************
+//
+//! Returns the host pointer backing a word of simulated RAM.
+//!
+//! \param address is the C28x word address, for example one inside
+//! \b SIM_RAMGS0_BASE to \b SIM_RAMGS0_BASE + \b SIM_RAMGS0_WORDS - 1.
+//!
+//! Unlike Sim_getRegAddress(), no access handler is run and no access cost
+//! is charged. The pointer stays valid until the next Sim_reset(), which
+//! replaces the register file, and Sim_getAddress() maps it back to
+//! \e address.
+//!
+//! \return Returns a pointer to the 16-bit storage of the word.
+//
+//*****************************************************************************
+extern uint16_t *
+Sim_getRAMAddress(uint32_t address);
+
+//*****************************************************************************
+//
+//! Returns the word address of a location in the simulated address space.
+//!
+//! \param pointer is a host pointer into the register file, for example
+//! one obtained from Sim_getRegAddress(), or a register address cast to a
+//! pointer, such as <tt>(void *)(EPWM1_BASE + EPWM_O_CMPA)</tt>.
+//!
+//! The inverse of Sim_getRegAddress(). Driverlib functions that program a
+//! memory address into a peripheral, such as DMA_configAddresses(), use it
+//! in host builds, so buffers a simulated bus master accesses must live in
+//! the simulated address space. A pointer whose value is itself a word
+//! address is returned unchanged. Any other pointer aborts the simulation.
+//!
+//! \return Returns the C28x word address.
+//
+//*****************************************************************************
+extern uint32_t
+Sim_getAddress(const volatile void *pointer);
+
+//*****************************************************************************
+//
+//! Resets the simulated register file.
+//!
+//! The register file is cleared and the registers the driverlib start-up
+//! code polls (PLL lock, DCC done, ...) are loaded with values that let
+//! Device_init() complete. Attached access handlers are kept.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+Sim_reset(void);
+
+//*****************************************************************************
+//
+//! Attaches an access handler to an address range.
+//!
+//! \param startAddress is the first word address of the range.
+//! \param endAddress is the last word address of the range.
+//! \param handler is the handler, or NULL to detach.
+//!
+//! Handlers are tracked per page, so a handler receives every access to the
+//! pages spanned by the range and must check the address itself if the page
+//! is shared with another peripheral.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+Sim_attachHandler(uint32_t startAddress, uint32_t endAddress,
+                  Sim_AccessHandler handler);
+
+//*****************************************************************************
+//
+//! Reads and writes simulated registers without invoking access handlers.
+//!
+//! \param address is the C28x word address of the register.
+//! \param value is the value to write.
+//!
+//! These are meant for peripheral models and test code that need to inspect
+//! or update register state from outside the code under test.
+//
+//*****************************************************************************
+extern uint16_t
+Sim_readReg16(uint32_t address);
+extern uint32_t
+Sim_readReg32(uint32_t address);
+extern void
+Sim_writeReg16(uint32_t address, uint16_t value);
+extern void
+Sim_writeReg32(uint32_t address, uint32_t value);
+
+//*****************************************************************************
+//
+//! Stores a host function pointer into the simulated PIE vector table.
+//!
+//! \param address is the PIE vector table address of the entry.
+//! \param handler is the interrupt service routine.
+//!
+//! Host function pointers do not fit in the 32-bit vector table slots, so
+//! Interrupt_register() and friends call this in host builds.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+Sim_setVector(uint32_t address, void (*handler)(void));
+
+//*****************************************************************************
+//
+//! Returns the handler registered for an interrupt.
+//!
+//! \param interruptNumber is an INT_* value from inc/hw_ints.h.
+//!
+//! \return Returns the registered handler or NULL if none.
+//
+//*****************************************************************************
+extern void
+(*Sim_getVector(uint32_t interruptNumber))(void);
+
+//*****************************************************************************
+//
+//! Returns whether CPU interrupts are globally enabled (INTM clear).
+//
+//*****************************************************************************
+extern bool
+Sim_isGlobalInterruptEnabled(void);
+
+//*****************************************************************************
+//
+//! Registers a peripheral model with the simulated time base.
+//!
+//! \param model is the model descriptor. It must stay valid while the
+//! simulator is in use. Registering the same model twice has no effect.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+Sim_registerModel(Sim_Model *model);
+
+//*****************************************************************************
+//
+//! Returns the current simulated time in SYSCLK cycles.
+//
+//*****************************************************************************
+extern uint64_t
+Sim_getCycles(void);
+
+//*****************************************************************************
+//
+//! Returns the current simulated time as seen by the CPU.
+//!
+//! Outside of interrupt handlers this equals Sim_getCycles(). Inside a
+//! handler it also includes the cycles charged to the handler so far (see
+//! Sim_setAccessCost()). The CPU timer model counts with this time, so code
+//! that time-stamps its own execution with a CPU timer measures the charged
+//! cost, while the other peripherals still see the handler as instantaneous.
+//
+//*****************************************************************************
+extern uint64_t
+Sim_getCPUCycles(void);
+
+//*****************************************************************************
+//
+//! Sets the CPU cost of a register access made by an interrupt handler.
+//!
+//! \param cycles is the number of SYSCLK cycles charged for every HWREG
+//! family access a handler makes. 0, the default, keeps handlers free.
+//!
+//! The simulator does not execute C28x code, so this is a coarse cost model:
+//! it counts peripheral accesses, which dominate short control interrupts,
+//! and ignores everything else. It is deterministic, which makes it useful
+//! for catching interrupt cost regressions in host test runs. The setting
+//! survives Sim_reset().
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+Sim_setAccessCost(uint16_t cycles);
+
+//*****************************************************************************
+//
+//! Runs the simulation.
+//!
+//! \param cycles is the number of SYSCLK cycles to simulate.
+//!
+//! All registered models are advanced event by event. Interrupts raised by
+//! the models are dispatched to the handlers in the simulated PIE vector
+//! table as soon as they are enabled, in simulated-time order, with the
+//! PIEVECT field of PIECTRL set to the vector address as on the device.
+//! Handlers run in zero simulated time.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+Sim_run(uint64_t cycles);
+
+//*****************************************************************************
+//
+//! Lets simulated time pass in the background loop of a host build.
+//!
+//! Simulated time only advances in Sim_run(), so the background loop of an
+//! application built for the host calls this once per pass. It runs the
+//! simulation for \b SIM_IDLE_CYCLES cycles and then calls the idle hook,
+//! if one is installed with Sim_setIdleHook().
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+Sim_idle(void);
+
+//*****************************************************************************
+//
+//! Installs the function that Sim_idle() calls.
+//!
+//! \param hook is the hook, or NULL to remove it.
+//!
+//! A test drives an application through the hook: it feeds input to the
+//! simulated peripherals, checks the outputs and ends the run with exit().
+//! The setting survives Sim_reset().
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+Sim_setIdleHook(void (*hook)(void));
+
+//*****************************************************************************
+//
+//! Flags a PIE interrupt as pending.
+//!
+//! \param interruptNumber is an INT_* value from inc/hw_ints.h.
+//!
+//! The corresponding PIEIFR bit is set. The handler is dispatched by
+//! Sim_run() once PIEIER, IER and INTM allow it and the PIE group has been
+//! acknowledged.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+Sim_raiseInterrupt(uint32_t interruptNumber);
+
+//*****************************************************************************
+//
+//! Attaches a model to the on-chip trigger network.
+//!
+//! \param handler is called for every trigger raised with
+//! Sim_raiseTrigger().
+//!
+//! Models that can be started by a peripheral event, such as the DMA,
+//! attach a handler once. Handlers run in the middle of the raising model's
+//! event processing, so they should only latch the trigger and act on it
+//! from their own Sim_Model callbacks.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+Sim_attachTriggerHandler(Sim_TriggerHandler handler);
+
+//*****************************************************************************
+//
+//! Raises a trigger on the on-chip trigger network.
+//!
+//! \param trigger is the trigger source, a DMA_Trigger value such as
+//! DMA_TRIGGER_EPWM1SOCA.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+Sim_raiseTrigger(uint16_t trigger);
+
+//*****************************************************************************
+//
+//! Dispatches all pending, enabled PIE interrupts.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+Sim_serviceInterrupts(void);
+
+//*****************************************************************************
+//
+//! Returns the dispatch statistics of an interrupt.
+//!
+//! \param interruptNumber is an INT_* value from inc/hw_ints.h.
+//!
+//! \return Returns a pointer to the statistics, or NULL for an invalid
+//! interrupt number.
+//
+//*****************************************************************************
+extern const Sim_InterruptStats *
+Sim_getInterruptStats(uint32_t interruptNumber);
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SIM_H
@@ -0,0 +1,721 @@
+//###########################################################################
+//
+// FILE:   sim_adc.c
+//
+// TITLE:  ADC model for the host simulator.
+//
+//###########################################################################
+
+#include <string.h>
+#include "sim_adc.h"
+#include "driverlib.h"
+
+//
+// Distance between the ADC module bases and between their result bases
+//
+#define SIM_ADC_BASE_STEP       (ADCB_BASE - ADCA_BASE)
+#define SIM_ADC_RESULT_STEP     (ADCBRESULT_BASE - ADCARESULT_BASE)
+
+//
+// ADCINT1-4 and the PPB event, in the order of the PIE and DMA tables below
+//
+#define SIM_ADC_NUM_INTS        4U
+#define SIM_ADC_EVT             4U
+#define SIM_ADC_NUM_PPBS        4U
+
+//
+// RRPOINTER after reset: no SOC converted yet, round robin starts at SOC0
+//
+#define SIM_ADC_RRPOINTER_RESET 16U
+
+//
+// PPB trip limits are 17-bit two's complement values
+//
+#define SIM_ADC_TRIP_SIGN       0x10000L
+
+//
+// Conversion time in ADCCLK half cycles
+//
+#define SIM_ADC_CONV_HALF_CYCLES    21U
+
+typedef struct
+{
+    uint32_t base;
+    uint32_t resultBase;
+    uint16_t index;
+    bool busy;
+    bool sampled;
+    bool dirty;
+    uint16_t soc;
+    uint16_t sample;
+    uint64_t acqEnd;
+    uint64_t convEnd;
+    bool ppbValid[SIM_ADC_NUM_PPBS];
+    int32_t ppbLast[SIM_ADC_NUM_PPBS];
+    uint16_t inputs[SIM_ADC_NUM_CHANNELS];
+    Sim_ADC_Stats stats;
+} Sim_ADC_Module;
+
+static Sim_ADC_Module Sim_ADC_modules[SIM_ADC_NUM_MODULES];
+static Sim_ADC_InputHandler Sim_ADC_inputHandler;
+
+//
+// PIE interrupts and DMA triggers of ADCINT1-4 and the PPB event
+//
+static const uint32_t Sim_ADC_interrupts[SIM_ADC_NUM_MODULES][5] =
+{
+    { INT_ADCA1, INT_ADCA2, INT_ADCA3, INT_ADCA4, INT_ADCA_EVT },
+    { INT_ADCB1, INT_ADCB2, INT_ADCB3, INT_ADCB4, INT_ADCB_EVT },
+    { INT_ADCC1, INT_ADCC2, INT_ADCC3, INT_ADCC4, INT_ADCC_EVT }
+};
+
+static const uint16_t Sim_ADC_dmaTriggers[SIM_ADC_NUM_MODULES] =
+{
+    (uint16_t)DMA_TRIGGER_ADCA1,
+    (uint16_t)DMA_TRIGGER_ADCB1,
+    (uint16_t)DMA_TRIGGER_ADCC1
+};
+
+static uint64_t Sim_ADC_nextEvent(void);
+static void Sim_ADC_advance(uint64_t cycle);
+static void Sim_ADC_reset(void);
+
+static Sim_Model Sim_ADC_model =
+{
+    Sim_ADC_nextEvent,
+    Sim_ADC_advance,
+    Sim_ADC_reset,
+    NULL
+};
+
+//*****************************************************************************
+//
+// Register helpers
+//
+//*****************************************************************************
+static inline uint16_t
+Sim_ADC_read(const Sim_ADC_Module *m, uint32_t offset)
+{
+    return(Sim_readReg16(m->base + offset));
+}
+
+static inline void
+Sim_ADC_write(const Sim_ADC_Module *m, uint32_t offset, uint16_t value)
+{
+    Sim_writeReg16(m->base + offset, value);
+}
+
+static inline uint32_t
+Sim_ADC_readSOCControl(const Sim_ADC_Module *m, uint16_t soc)
+{
+    return(Sim_readReg32(m->base + ADC_O_SOC0CTL + ((uint32_t)soc * 2U)));
+}
+
+//
+// Sign-extends a 17-bit PPB trip limit
+//
+static inline int32_t
+Sim_ADC_readTripLimit(const Sim_ADC_Module *m, uint32_t offset)
+{
+    int32_t limit = (int32_t)(Sim_readReg32(m->base + offset) &
+                              ADC_PPBTRIP_MASK);
+
+    return(((limit & SIM_ADC_TRIP_SIGN) != 0) ?
+           (limit - (2 * SIM_ADC_TRIP_SIGN)) : limit);
+}
+
+//*****************************************************************************
+//
+// Latches the trigger of an SOC. A trigger that finds the SOC still pending
+// is lost and sets the SOC overflow flag.
+//
+//*****************************************************************************
+static void
+Sim_ADC_triggerSOC(Sim_ADC_Module *m, uint16_t soc)
+{
+    uint16_t bit = (uint16_t)1U << soc;
+    uint16_t flags = Sim_ADC_read(m, ADC_O_SOCFLG1);
+
+    if((flags & bit) != 0U)
+    {
+        Sim_ADC_write(m, ADC_O_SOCOVF1,
+                      Sim_ADC_read(m, ADC_O_SOCOVF1) | bit);
+        m->stats.overflows++;
+        return;
+    }
+
+    Sim_ADC_write(m, ADC_O_SOCFLG1, flags | bit);
+    m->stats.triggers++;
+    m->stats.lastTrigger = Sim_getCycles();
+}
+
+//*****************************************************************************
+//
+// Picks up the clear and force strobes software wrote since the last
+// refresh
+//
+//*****************************************************************************
+static void
+Sim_ADC_refresh(Sim_ADC_Module *m)
+{
+    uint16_t strobe;
+    uint16_t soc;
+
+    strobe = Sim_ADC_read(m, ADC_O_INTFLGCLR);
+    if(strobe != 0U)
+    {
+        Sim_ADC_write(m, ADC_O_INTFLG,
+                      Sim_ADC_read(m, ADC_O_INTFLG) & ~strobe);
+        Sim_ADC_write(m, ADC_O_INTFLGCLR, 0U);
+    }
+
+    strobe = Sim_ADC_read(m, ADC_O_INTOVFCLR);
+    if(strobe != 0U)
+    {
+        Sim_ADC_write(m, ADC_O_INTOVF,
+                      Sim_ADC_read(m, ADC_O_INTOVF) & ~strobe);
+        Sim_ADC_write(m, ADC_O_INTOVFCLR, 0U);
+    }
+
+    strobe = Sim_ADC_read(m, ADC_O_SOCOVFCLR1);
+    if(strobe != 0U)
+    {
+        Sim_ADC_write(m, ADC_O_SOCOVF1,
+                      Sim_ADC_read(m, ADC_O_SOCOVF1) & ~strobe);
+        Sim_ADC_write(m, ADC_O_SOCOVFCLR1, 0U);
+    }
+
+    strobe = Sim_ADC_read(m, ADC_O_EVTCLR);
+    if(strobe != 0U)
+    {
+        Sim_ADC_write(m, ADC_O_EVTSTAT,
+                      Sim_ADC_read(m, ADC_O_EVTSTAT) & ~strobe);
+        Sim_ADC_write(m, ADC_O_EVTCLR, 0U);
+    }
+
+    strobe = Sim_ADC_read(m, ADC_O_SOCFRC1);
+    if(strobe != 0U)
+    {
+        Sim_ADC_write(m, ADC_O_SOCFRC1, 0U);
+        for(soc = 0U; soc < SIM_ADC_NUM_SOCS; soc++)
+        {
+            if((strobe & ((uint16_t)1U << soc)) != 0U)
+            {
+                Sim_ADC_triggerSOC(m, soc);
+            }
+        }
+    }
+}
+
+static void
+Sim_ADC_publish(const Sim_ADC_Module *m)
+{
+    uint16_t ctl1 = Sim_ADC_read(m, ADC_O_CTL1) &
+                    ~(ADC_CTL1_ADCBSY | ADC_CTL1_ADCBSYCHN_M);
+
+    if(m->busy)
+    {
+        ctl1 |= ADC_CTL1_ADCBSY | (m->soc << ADC_CTL1_ADCBSYCHN_S);
+    }
+
+    Sim_ADC_write(m, ADC_O_CTL1, ctl1);
+}
+
+//*****************************************************************************
+//
+// Returns the next SOC to convert, high-priority SOCs first and the others
+// round robin after the last one converted, or SIM_ADC_NUM_SOCS if none is
+// pending
+//
+//*****************************************************************************
+static uint16_t
+Sim_ADC_arbitrate(const Sim_ADC_Module *m)
+{
+    uint16_t flags = Sim_ADC_read(m, ADC_O_SOCFLG1);
+    uint16_t priCtl = Sim_ADC_read(m, ADC_O_SOCPRICTL);
+    uint16_t priority = (priCtl & ADC_SOCPRICTL_SOCPRIORITY_M) >>
+                        ADC_SOCPRICTL_SOCPRIORITY_S;
+    uint16_t pointer = (priCtl & ADC_SOCPRICTL_RRPOINTER_M) >>
+                       ADC_SOCPRICTL_RRPOINTER_S;
+    uint16_t soc;
+    uint16_t i;
+
+    if(priority > SIM_ADC_NUM_SOCS)
+    {
+        priority = SIM_ADC_NUM_SOCS;
+    }
+
+    for(soc = 0U; soc < priority; soc++)
+    {
+        if((flags & ((uint16_t)1U << soc)) != 0U)
+        {
+            return(soc);
+        }
+    }
+
+    soc = (pointer >= SIM_ADC_NUM_SOCS) ? 0U : (pointer + 1U);
+    for(i = 0U; i < SIM_ADC_NUM_SOCS; i++)
+    {
+        soc %= SIM_ADC_NUM_SOCS;
+        if((soc >= priority) && ((flags & ((uint16_t)1U << soc)) != 0U))
+        {
+            return(soc);
+        }
+        soc++;
+    }
+
+    return(SIM_ADC_NUM_SOCS);
+}
+
+//*****************************************************************************
+//
+// Starts the conversion of an SOC at cycle 'now'
+//
+//*****************************************************************************
+static void
+Sim_ADC_start(Sim_ADC_Module *m, uint16_t soc, uint64_t now)
+{
+    uint32_t control = Sim_ADC_readSOCControl(m, soc);
+    uint16_t halfDivider;
+    uint16_t priCtl;
+
+    halfDivider = ((Sim_ADC_read(m, ADC_O_CTL2) & ADC_CTL2_PRESCALE_M) >>
+                   ADC_CTL2_PRESCALE_S) + 2U;
+
+    m->busy = true;
+    m->sampled = false;
+    m->soc = soc;
+    m->acqEnd = now + ((control & ADC_SOC0CTL_ACQPS_M) >>
+                       ADC_SOC0CTL_ACQPS_S) + 1U;
+    m->convEnd = m->acqEnd +
+                 (((SIM_ADC_CONV_HALF_CYCLES * halfDivider) + 3U) / 4U);
+
+    Sim_ADC_write(m, ADC_O_SOCFLG1, Sim_ADC_read(m, ADC_O_SOCFLG1) &
+                                    ~((uint16_t)1U << soc));
+
+    //
+    // High-priority SOCs leave the round-robin pointer alone
+    //
+    priCtl = Sim_ADC_read(m, ADC_O_SOCPRICTL);
+    if(soc >= ((priCtl & ADC_SOCPRICTL_SOCPRIORITY_M) >>
+               ADC_SOCPRICTL_SOCPRIORITY_S))
+    {
+        Sim_ADC_write(m, ADC_O_SOCPRICTL,
+                      (priCtl & ~ADC_SOCPRICTL_RRPOINTER_M) |
+                      (soc << ADC_SOCPRICTL_RRPOINTER_S));
+    }
+}
+
+//*****************************************************************************
+//
+// Samples the input of the converting SOC at the end of the acquisition
+// window
+//
+//*****************************************************************************
+static void
+Sim_ADC_sample(Sim_ADC_Module *m)
+{
+    uint16_t channel = (uint16_t)((Sim_ADC_readSOCControl(m, m->soc) &
+                                   ADC_SOC0CTL_CHSEL_M) >>
+                                  ADC_SOC0CTL_CHSEL_S);
+    uint16_t value;
+
+    if(Sim_ADC_inputHandler != NULL)
+    {
+        value = Sim_ADC_inputHandler(m->base, channel, m->acqEnd);
+    }
+    else
+    {
+        value = m->inputs[channel];
+    }
+
+    m->sample = (value > SIM_ADC_FULL_SCALE) ? SIM_ADC_FULL_SCALE : value;
+    m->sampled = true;
+}
+
+//*****************************************************************************
+//
+// Raises the ADCINTx pulses selected for the end of conversion of an SOC.
+// A pulse that finds its flag still set only sets the overflow flag, and in
+// one-shot mode is dropped.
+//
+//*****************************************************************************
+static void
+Sim_ADC_endOfConversion(Sim_ADC_Module *m, uint16_t soc)
+{
+    uint16_t select;
+    uint16_t flags;
+    uint16_t bit;
+    uint16_t n;
+
+    for(n = 0U; n < SIM_ADC_NUM_INTS; n++)
+    {
+        select = Sim_ADC_read(m, (n < 2U) ? ADC_O_INTSEL1N2 :
+                                            ADC_O_INTSEL3N4);
+        select >>= (n & 1U) * 8U;
+
+        if(((select & ADC_INTSEL1N2_INT1E) == 0U) ||
+           (((select & ADC_INTSEL1N2_INT1SEL_M) >>
+             ADC_INTSEL1N2_INT1SEL_S) != soc))
+        {
+            continue;
+        }
+
+        bit = (uint16_t)1U << n;
+        flags = Sim_ADC_read(m, ADC_O_INTFLG);
+        if((flags & bit) != 0U)
+        {
+            Sim_ADC_write(m, ADC_O_INTOVF,
+                          Sim_ADC_read(m, ADC_O_INTOVF) | bit);
+            if((select & ADC_INTSEL1N2_INT1CONT) == 0U)
+            {
+                continue;
+            }
+        }
+
+        Sim_ADC_write(m, ADC_O_INTFLG, flags | bit);
+        Sim_raiseInterrupt(Sim_ADC_interrupts[m->index][n]);
+        Sim_raiseTrigger(Sim_ADC_dmaTriggers[m->index] + n);
+        m->stats.interrupts++;
+    }
+}
+
+//*****************************************************************************
+//
+// Writes the result of the converting SOC and runs the post-processing
+// blocks attached to it
+//
+//*****************************************************************************
+static void
+Sim_ADC_writeResult(Sim_ADC_Module *m)
+{
+    uint32_t ppbOffset;
+    uint16_t config;
+    uint16_t evtIntSel;
+    uint16_t events;
+    uint16_t all = 0U;
+    int32_t result = (int32_t)m->sample;
+    int32_t ppbResult;
+    int32_t offCal;
+    bool calibrated = false;
+    uint16_t p;
+
+    //
+    // The offset correction of the first PPB attached to the SOC applies
+    // to the result register
+    //
+    for(p = 0U; p < SIM_ADC_NUM_PPBS; p++)
+    {
+        ppbOffset = (uint32_t)p * ADC_PPBxCONFIG_STEP;
+        config = Sim_ADC_read(m, ADC_O_PPB1CONFIG + ppbOffset);
+        if(((config & ADC_PPB1CONFIG_CONFIG_M) == m->soc) && !calibrated)
+        {
+            offCal = (int32_t)(Sim_ADC_read(m, ADC_O_PPB1OFFCAL + ppbOffset) &
+                               ADC_PPB1OFFCAL_OFFCAL_M);
+            if(offCal >= 0x200)
+            {
+                offCal -= 0x400;
+            }
+            result -= offCal;
+            result = (result < 0) ? 0 :
+                     ((result > (int32_t)SIM_ADC_FULL_SCALE) ?
+                      (int32_t)SIM_ADC_FULL_SCALE : result);
+            calibrated = true;
+        }
+    }
+
+    Sim_writeReg16(m->resultBase + ADC_O_RESULT0 + m->soc, (uint16_t)result);
+
+    evtIntSel = Sim_ADC_read(m, ADC_O_EVTINTSEL);
+    for(p = 0U; p < SIM_ADC_NUM_PPBS; p++)
+    {
+        ppbOffset = (uint32_t)p * ADC_PPBxCONFIG_STEP;
+        config = Sim_ADC_read(m, ADC_O_PPB1CONFIG + ppbOffset);
+        if((config & ADC_PPB1CONFIG_CONFIG_M) != m->soc)
+        {
+            continue;
+        }
+
+        ppbResult = result - (int32_t)Sim_ADC_read(m, ADC_O_PPB1OFFREF +
+                                                      ppbOffset);
+        if((config & ADC_PPB1CONFIG_TWOSCOMPEN) != 0U)
+        {
+            ppbResult = -ppbResult;
+        }
+        Sim_writeReg32(m->resultBase + ADC_O_PPB1RESULT + ((uint32_t)p * 2U),
+                       (uint32_t)ppbResult);
+
+        events = 0U;
+        if(ppbResult > Sim_ADC_readTripLimit(m, ADC_O_PPB1TRIPHI + ppbOffset))
+        {
+            events |= ADC_EVT_TRIPHI;
+        }
+        if(ppbResult < Sim_ADC_readTripLimit(m, ADC_O_PPB1TRIPLO + ppbOffset))
+        {
+            events |= ADC_EVT_TRIPLO;
+        }
+        if(m->ppbValid[p] && ((m->ppbLast[p] < 0) != (ppbResult < 0)))
+        {
+            events |= ADC_EVT_ZERO;
+        }
+        m->ppbValid[p] = true;
+        m->ppbLast[p] = ppbResult;
+
+        if(events != 0U)
+        {
+            m->stats.events++;
+        }
+        all |= (events & (evtIntSel >> (p * 4U))) << (p * 4U);
+        Sim_ADC_write(m, ADC_O_EVTSTAT, Sim_ADC_read(m, ADC_O_EVTSTAT) |
+                                        (events << (p * 4U)));
+    }
+
+    if(all != 0U)
+    {
+        Sim_raiseInterrupt(Sim_ADC_interrupts[m->index][SIM_ADC_EVT]);
+        Sim_raiseTrigger(Sim_ADC_dmaTriggers[m->index] + SIM_ADC_EVT);
+    }
+
+    m->stats.conversions++;
+    m->stats.lastResult = Sim_getCycles();
+}
+
+//*****************************************************************************
+//
+// Trigger network listener. The ePWM SOC events are numbered the same way
+// in the DMA and the ADC trigger selections.
+//
+//*****************************************************************************
+static void
+Sim_ADC_triggerHandler(uint16_t trigger)
+{
+    Sim_ADC_Module *m;
+    uint32_t select;
+    uint16_t i;
+    uint16_t soc;
+
+    if((trigger < (uint16_t)DMA_TRIGGER_EPWM1SOCA) ||
+       (trigger > (uint16_t)DMA_TRIGGER_EPWM8SOCB))
+    {
+        return;
+    }
+
+    select = (uint32_t)ADC_TRIGGER_EPWM1_SOCA +
+             (trigger - (uint16_t)DMA_TRIGGER_EPWM1SOCA);
+
+    for(i = 0U; i < SIM_ADC_NUM_MODULES; i++)
+    {
+        m = &Sim_ADC_modules[i];
+        for(soc = 0U; soc < SIM_ADC_NUM_SOCS; soc++)
+        {
+            if(((Sim_ADC_readSOCControl(m, soc) & ADC_SOC0CTL_TRIGSEL_M) >>
+                ADC_SOC0CTL_TRIGSEL_S) == select)
+            {
+                Sim_ADC_triggerSOC(m, soc);
+            }
+        }
+    }
+}
+
+//*****************************************************************************
+//
+// Sim_Model callbacks. A pending SOC of an idle, powered-up ADC is an event
+// at the current cycle; a busy ADC has its next event at the end of the
+// acquisition window or of the conversion.
+//
+//*****************************************************************************
+static uint64_t
+Sim_ADC_nextEvent(void)
+{
+    Sim_ADC_Module *m;
+    uint64_t next = UINT64_MAX;
+    uint64_t event;
+    uint16_t i;
+
+    for(i = 0U; i < SIM_ADC_NUM_MODULES; i++)
+    {
+        m = &Sim_ADC_modules[i];
+        if(m->dirty)
+        {
+            m->dirty = false;
+            Sim_ADC_refresh(m);
+        }
+
+        if(m->busy)
+        {
+            event = m->sampled ? m->convEnd : m->acqEnd;
+        }
+        else if(((Sim_ADC_read(m, ADC_O_CTL1) & ADC_CTL1_ADCPWDNZ) != 0U) &&
+                (Sim_ADC_read(m, ADC_O_SOCFLG1) != 0U))
+        {
+            event = Sim_getCycles();
+        }
+        else
+        {
+            event = UINT64_MAX;
+        }
+
+        if(event < next)
+        {
+            next = event;
+        }
+    }
+
+    return(next);
+}
+
+static void
+Sim_ADC_advance(uint64_t cycle)
+{
+    Sim_ADC_Module *m;
+    uint16_t soc;
+    uint16_t i;
+    bool late;
+
+    for(i = 0U; i < SIM_ADC_NUM_MODULES; i++)
+    {
+        m = &Sim_ADC_modules[i];
+        late = (Sim_ADC_read(m, ADC_O_CTL1) & ADC_CTL1_INTPULSEPOS) != 0U;
+
+        for(;;)
+        {
+            if(!m->busy)
+            {
+                if((Sim_ADC_read(m, ADC_O_CTL1) & ADC_CTL1_ADCPWDNZ) == 0U)
+                {
+                    break;
+                }
+                soc = Sim_ADC_arbitrate(m);
+                if(soc == SIM_ADC_NUM_SOCS)
+                {
+                    break;
+                }
+                Sim_ADC_start(m, soc, cycle);
+            }
+
+            if(!m->sampled)
+            {
+                if(m->acqEnd > cycle)
+                {
+                    break;
+                }
+                Sim_ADC_sample(m);
+                if(!late)
+                {
+                    Sim_ADC_endOfConversion(m, m->soc);
+                }
+            }
+
+            if(m->convEnd > cycle)
+            {
+                break;
+            }
+
+            //
+            // The next SOC starts as this one finishes
+            //
+            Sim_ADC_writeResult(m);
+            m->busy = false;
+            if(late)
+            {
+                Sim_ADC_endOfConversion(m, m->soc);
+            }
+        }
+
+        Sim_ADC_publish(m);
+    }
+}
+
+static void
+Sim_ADC_reset(void)
+{
+    Sim_ADC_Module *m;
+    uint16_t i;
+
+    memset(Sim_ADC_modules, 0, sizeof(Sim_ADC_modules));
+
+    for(i = 0U; i < SIM_ADC_NUM_MODULES; i++)
+    {
+        m = &Sim_ADC_modules[i];
+        m->index = i;
+        m->base = ADCA_BASE + ((uint32_t)i * SIM_ADC_BASE_STEP);
+        m->resultBase = ADCARESULT_BASE +
+                        ((uint32_t)i * SIM_ADC_RESULT_STEP);
+        Sim_ADC_write(m, ADC_O_SOCPRICTL,
+                      SIM_ADC_RRPOINTER_RESET << ADC_SOCPRICTL_RRPOINTER_S);
+    }
+}
+
+//*****************************************************************************
+//
+// Access handler for the ADC configuration pages. Strobes written by the
+// previous access are acted upon before software sees the flags; the
+// modules are marked dirty so that the strobes of this access are picked up
+// before the next event is scheduled.
+//
+//*****************************************************************************
+static void
+Sim_ADC_accessHandler(uint32_t address)
+{
+    Sim_ADC_Module *m;
+    uint16_t i;
+
+    (void)address;
+
+    for(i = 0U; i < SIM_ADC_NUM_MODULES; i++)
+    {
+        m = &Sim_ADC_modules[i];
+        Sim_ADC_refresh(m);
+        Sim_ADC_publish(m);
+        m->dirty = true;
+    }
+}
+
+//*****************************************************************************
+//
+// Sim_ADC_init
+//
+//*****************************************************************************
+void
+Sim_ADC_init(void)
+{
+    Sim_ADC_reset();
+    Sim_registerModel(&Sim_ADC_model);
+    Sim_attachHandler(ADCA_BASE,
+                      ADCA_BASE + (SIM_ADC_NUM_MODULES * SIM_ADC_BASE_STEP) -
+                      1U, Sim_ADC_accessHandler);
+    Sim_attachTriggerHandler(Sim_ADC_triggerHandler);
+}
+
+//*****************************************************************************
+//
+// Sim_ADC_setInputHandler / Sim_ADC_setInput
+//
+//*****************************************************************************
+void
+Sim_ADC_setInputHandler(Sim_ADC_InputHandler handler)
+{
+    Sim_ADC_inputHandler = handler;
+}
+
+void
+Sim_ADC_setInput(uint32_t base, uint16_t channel, uint16_t value)
+{
+    uint32_t index = (base - ADCA_BASE) / SIM_ADC_BASE_STEP;
+
+    if((index < SIM_ADC_NUM_MODULES) && (channel < SIM_ADC_NUM_CHANNELS))
+    {
+        Sim_ADC_modules[index].inputs[channel] = value;
+    }
+}
+
+//*****************************************************************************
+//
+// Sim_ADC_getStats
+//
+//*****************************************************************************
+const Sim_ADC_Stats *
+Sim_ADC_getStats(uint32_t base)
+{
+    return(&Sim_ADC_modules[(base - ADCA_BASE) / SIM_ADC_BASE_STEP].stats);
+}
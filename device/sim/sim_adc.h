@@ -0,0 +1,164 @@
+//###########################################################################
+//
+// FILE:   sim_adc.h
+//
+// TITLE:  ADC model for the host simulator.
+//
+//###########################################################################
+//
+// Models ADCA, ADCB and ADCC: SOC trigger selection from the ePWM SOCA/B
+// events and software forces, high-priority and round-robin arbitration,
+// the acquisition window and conversion time, the result registers, the
+// four ADCINT flags with continuous mode and overflow, and the four
+// post-processing blocks with offset correction, reference offset, two's
+// complement, trip high/low and zero-crossing events.
+//
+// The ADC samples its inputs through Sim_ADC_setInputHandler() or the
+// levels set with Sim_ADC_setInput(), so a test can feed synthetic
+// waveforms. An input is sampled at the end of its acquisition window. A
+// conversion takes ACQPS + 1 SYSCLK cycles for the acquisition and 10.5
+// ADCCLK cycles for the conversion, rounded up to whole SYSCLK cycles, and
+// the next SOC starts when the previous one has finished. The ADCINT pulse
+// comes at the end of the acquisition window or at the end of the
+// conversion as selected by INTPULSEPOS. ADCINTx and the PPB events raise
+// the PIE interrupts and the DMA triggers of the module.
+//
+// Not modelled: the CPU timer and GPIO triggers, burst mode, the
+// interrupt SOC triggers, ADCINTCYCLE, PPB delay time stamps, the
+// cycle-by-cycle PPB mode, the routing of the PPB events to the ePWM X-BAR
+// and the analog behavior of the converter (gain and offset errors,
+// settling and noise).
+//
+//###########################################################################
+
+#ifndef SIM_ADC_H
+#define SIM_ADC_H
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+#include "sim.h"
+
+//*****************************************************************************
+//
+// Number of ADC modules and SOCs modelled and the full-scale result.
+//
+//*****************************************************************************
+#define SIM_ADC_NUM_MODULES     3U
+#define SIM_ADC_NUM_SOCS        16U
+#define SIM_ADC_NUM_CHANNELS    16U
+#define SIM_ADC_FULL_SCALE      4095U
+
+//*****************************************************************************
+//
+//! Activity counters of one ADC module.
+//
+//*****************************************************************************
+typedef struct
+{
+    uint32_t triggers;      //!< SOC triggers accepted
+    uint32_t overflows;     //!< SOC triggers that found the SOC pending
+    uint32_t conversions;   //!< Conversions completed
+    uint32_t interrupts;    //!< ADCINT pulses raised
+    uint32_t events;        //!< PPB events raised
+    uint64_t lastTrigger;   //!< Cycle of the last SOC trigger
+    uint64_t lastResult;    //!< Cycle the last result was written
+} Sim_ADC_Stats;
+
+//*****************************************************************************
+//
+//! Prototype of an ADC input handler.
+//!
+//! \param base is the ADC base address, such as ADCA_BASE.
+//! \param channel is the input, 0 for ADCIN0 and so on.
+//! \param cycle is the simulated SYSCLK cycle at which the input is sampled.
+//!
+//! \return Returns the conversion result, 0 to SIM_ADC_FULL_SCALE. Larger
+//! values are clipped.
+//
+//*****************************************************************************
+typedef uint16_t (*Sim_ADC_InputHandler)(uint32_t base, uint16_t channel,
+                                         uint64_t cycle);
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+//*****************************************************************************
+//
+//! Attaches the ADC model to the simulator.
+//!
+//! Registers the model with Sim_registerModel(), hooks the ADC register
+//! pages and listens on the trigger network for the ePWM SOC events. Call
+//! once before Sim_reset().
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+Sim_ADC_init(void);
+
+//*****************************************************************************
+//
+//! Installs the handler that supplies the sampled input values.
+//!
+//! \param handler is the handler, or NULL to sample the levels set with
+//! Sim_ADC_setInput().
+//!
+//! The setting survives Sim_reset().
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+Sim_ADC_setInputHandler(Sim_ADC_InputHandler handler);
+
+//*****************************************************************************
+//
+//! Sets the constant level of an ADC input.
+//!
+//! \param base is the ADC base address, such as ADCA_BASE.
+//! \param channel is the input, 0 for ADCIN0 and so on.
+//! \param value is the conversion result the input produces.
+//!
+//! The levels are used while no input handler is installed. They are
+//! cleared by Sim_reset().
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+Sim_ADC_setInput(uint32_t base, uint16_t channel, uint16_t value);
+
+//*****************************************************************************
+//
+//! Returns the activity counters of an ADC module.
+//!
+//! \param base is the ADC base address, such as ADCA_BASE.
+//!
+//! \return Returns a pointer to the counters.
+//
+//*****************************************************************************
+extern const Sim_ADC_Stats *
+Sim_ADC_getStats(uint32_t base);
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SIM_ADC_H
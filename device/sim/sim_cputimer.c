@@ -0,0 +1,174 @@
+//###########################################################################
+//
+// FILE:   sim_cputimer.c
+//
+// TITLE:  CPU timer model for the host simulator.
+//
+//###########################################################################
+
+#include <string.h>
+#include "sim_cputimer.h"
+#include "driverlib.h"
+
+//
+// TCR value after reset: counting, interrupt disabled
+//
+#define SIM_CPUTIMER_TCR_RESET      0x0000U
+
+typedef struct
+{
+    uint32_t base;
+    bool running;
+    uint64_t refTime;
+    uint32_t refCount;
+} Sim_CPUTimer_Timer;
+
+static Sim_CPUTimer_Timer Sim_CPUTimer_timers[SIM_CPUTIMER_NUM_TIMERS];
+
+static uint64_t Sim_CPUTimer_nextEvent(void);
+static void Sim_CPUTimer_advance(uint64_t cycle);
+static void Sim_CPUTimer_reset(void);
+
+static Sim_Model Sim_CPUTimer_model =
+{
+    Sim_CPUTimer_nextEvent,
+    Sim_CPUTimer_advance,
+    Sim_CPUTimer_reset,
+    NULL
+};
+
+//*****************************************************************************
+//
+// SYSCLK cycles per timer tick: TDDRH:TDDR + 1
+//
+//*****************************************************************************
+static inline uint32_t
+Sim_CPUTimer_getDivider(const Sim_CPUTimer_Timer *t)
+{
+    return((((uint32_t)(Sim_readReg16(t->base + CPUTIMER_O_TPRH) &
+                        CPUTIMER_TPRH_TDDRH_M) << 8U) |
+            (Sim_readReg16(t->base + CPUTIMER_O_TPR) &
+             CPUTIMER_TPR_TDDR_M)) + 1U);
+}
+
+//*****************************************************************************
+//
+// Brings the counter up to cycle 'now' and picks up TRB and TSS writes
+//
+//*****************************************************************************
+static void
+Sim_CPUTimer_refresh(Sim_CPUTimer_Timer *t, uint64_t now)
+{
+    uint32_t divider = Sim_CPUTimer_getDivider(t);
+    uint32_t period = Sim_readReg32(t->base + CPUTIMER_O_PRD);
+    uint64_t ticks;
+    uint64_t over;
+    uint32_t count = t->refCount;
+    uint16_t tcr;
+
+    if(t->running && (now > t->refTime))
+    {
+        ticks = (now - t->refTime) / divider;
+        t->refTime += ticks * divider;
+
+        if(ticks <= count)
+        {
+            count -= (uint32_t)ticks;
+        }
+        else
+        {
+            //
+            // Wrapped through zero at least once, reloading from PRD
+            //
+            over = ticks - count - 1U;
+            count = period - (uint32_t)(over % ((uint64_t)period + 1U));
+        }
+    }
+
+    tcr = Sim_readReg16(t->base + CPUTIMER_O_TCR);
+    if((tcr & CPUTIMER_TCR_TRB) != 0U)
+    {
+        count = period;
+        tcr &= ~CPUTIMER_TCR_TRB;
+        Sim_writeReg16(t->base + CPUTIMER_O_TCR, tcr);
+    }
+
+    if(!t->running)
+    {
+        t->refTime = now;
+    }
+    t->running = (tcr & CPUTIMER_TCR_TSS) == 0U;
+    t->refCount = count;
+
+    Sim_writeReg32(t->base + CPUTIMER_O_TIM, count);
+}
+
+//*****************************************************************************
+//
+// Sim_Model callbacks. The counters are evaluated lazily on access, so the
+// model never schedules events of its own.
+//
+//*****************************************************************************
+static uint64_t
+Sim_CPUTimer_nextEvent(void)
+{
+    return(UINT64_MAX);
+}
+
+static void
+Sim_CPUTimer_advance(uint64_t cycle)
+{
+    (void)cycle;
+}
+
+static void
+Sim_CPUTimer_reset(void)
+{
+    Sim_CPUTimer_Timer *t;
+    uint16_t i;
+
+    memset(Sim_CPUTimer_timers, 0, sizeof(Sim_CPUTimer_timers));
+
+    for(i = 0U; i < SIM_CPUTIMER_NUM_TIMERS; i++)
+    {
+        t = &Sim_CPUTimer_timers[i];
+        t->base = CPUTIMER0_BASE + ((uint32_t)i * SIM_CPUTIMER_BASE_STEP);
+        t->running = true;
+        t->refCount = 0xFFFFFFFFUL;
+        Sim_writeReg32(t->base + CPUTIMER_O_TIM, 0xFFFFFFFFUL);
+        Sim_writeReg32(t->base + CPUTIMER_O_PRD, 0xFFFFFFFFUL);
+        Sim_writeReg16(t->base + CPUTIMER_O_TCR, SIM_CPUTIMER_TCR_RESET);
+    }
+}
+
+//*****************************************************************************
+//
+// Access handler
+//
+//*****************************************************************************
+static void
+Sim_CPUTimer_accessHandler(uint32_t address)
+{
+    uint32_t index = (address - CPUTIMER0_BASE) / SIM_CPUTIMER_BASE_STEP;
+
+    if((address >= CPUTIMER0_BASE) && (index < SIM_CPUTIMER_NUM_TIMERS))
+    {
+        Sim_CPUTimer_refresh(&Sim_CPUTimer_timers[index], Sim_getCPUCycles());
+    }
+}
+
+//*****************************************************************************
+//
+// Sim_CPUTimer_init
+//
+//*****************************************************************************
+void
+Sim_CPUTimer_init(void)
+{
+    Sim_CPUTimer_reset();
+    Sim_registerModel(&Sim_CPUTimer_model);
+    Sim_attachHandler(CPUTIMER0_BASE,
+                      CPUTIMER0_BASE +
+                      (SIM_CPUTIMER_NUM_TIMERS * SIM_CPUTIMER_BASE_STEP) - 1U,
+                      Sim_CPUTimer_accessHandler);
+}
@@ -0,0 +1,79 @@
+//###########################################################################
+//
+// FILE:   sim_cputimer.h
+//
+// TITLE:  CPU timer model for the host simulator.
+//
+//###########################################################################
+//
+// Models the 32-bit down counters of CPU timers 0-2 clocked from SYSCLK:
+// the TDDRH:TDDR prescaler, reload from PRD on underflow or TRB, and start
+// and stop through TSS. TIM reads back the count at the current simulated
+// cycle, so code that time-stamps with CPUTimer_getTimerCount() measures
+// simulated time.
+//
+// Inside interrupt handlers the counters run on Sim_getCPUCycles(), which
+// adds the cost charged to the handler by Sim_setAccessCost(). Entry and
+// exit time stamps taken in a handler therefore differ by that cost. A
+// timer read after the handler returns sees the count hold until simulated
+// time has caught up, since the rest of the simulator treats handlers as
+// instantaneous.
+//
+// Not modelled: TIF, timer interrupts, the emulation FREE/SOFT bits and
+// clock sources other than SYSCLK for timer 2.
+//
+//###########################################################################
+
+#ifndef SIM_CPUTIMER_H
+#define SIM_CPUTIMER_H
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+#include "sim.h"
+
+//*****************************************************************************
+//
+// Number of CPU timers modelled and the distance between their bases.
+//
+//*****************************************************************************
+#define SIM_CPUTIMER_NUM_TIMERS     3U
+#define SIM_CPUTIMER_BASE_STEP      0x8U
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+//*****************************************************************************
+//
+//! Attaches the CPU timer model to the simulator.
+//!
+//! Registers the model with Sim_registerModel() and hooks the CPU timer
+//! register page. Call once before Sim_reset().
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+Sim_CPUTimer_init(void);
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SIM_CPUTIMER_H
@@ -0,0 +1,487 @@
+//###########################################################################
+//
+// FILE:   sim_dma.c
+//
+// TITLE:  DMA model for the host simulator.
+//
+//###########################################################################
+
+#include <string.h>
+#include "sim_dma.h"
+#include "driverlib.h"
+
+//
+// Distance between two consecutive DMA channel interrupt numbers
+//
+#define SIM_DMA_INT_STEP        0x00010001UL
+
+//
+// CONTROL bits that are write-only strobes and read back as zero
+//
+#define SIM_DMA_CONTROL_STROBES (DMA_CONTROL_RUN | DMA_CONTROL_HALT |         \
+                                 DMA_CONTROL_SOFTRESET |                      \
+                                 DMA_CONTROL_PERINTFRC |                      \
+                                 DMA_CONTROL_PERINTCLR | DMA_CONTROL_ERRCLR)
+
+typedef struct
+{
+    uint32_t base;
+    bool running;
+    bool inTransfer;
+    bool pending;
+    bool overflow;
+    bool dirty;
+    uint16_t transferCount;
+    uint16_t srcWrapCount;
+    uint16_t dstWrapCount;
+    uint32_t srcBegin;
+    uint32_t src;
+    uint32_t dstBegin;
+    uint32_t dst;
+    Sim_DMA_Stats stats;
+} Sim_DMA_Channel;
+
+static Sim_DMA_Channel Sim_DMA_channels[SIM_DMA_NUM_CHANNELS];
+
+static uint64_t Sim_DMA_nextEvent(void);
+static void Sim_DMA_advance(uint64_t cycle);
+static void Sim_DMA_reset(void);
+
+static Sim_Model Sim_DMA_model =
+{
+    Sim_DMA_nextEvent,
+    Sim_DMA_advance,
+    Sim_DMA_reset,
+    NULL
+};
+
+//*****************************************************************************
+//
+// Register helpers
+//
+//*****************************************************************************
+static inline uint16_t
+Sim_DMA_read(const Sim_DMA_Channel *ch, uint32_t offset)
+{
+    return(Sim_readReg16(ch->base + offset));
+}
+
+static inline int16_t
+Sim_DMA_readStep(const Sim_DMA_Channel *ch, uint32_t offset)
+{
+    return((int16_t)Sim_readReg16(ch->base + offset));
+}
+
+static inline void
+Sim_DMA_write(const Sim_DMA_Channel *ch, uint32_t offset, uint16_t value)
+{
+    Sim_writeReg16(ch->base + offset, value);
+}
+
+//
+// Peripheral trigger selected for a channel in DMACHSRCSEL1/2
+//
+static uint16_t
+Sim_DMA_getTriggerSelect(const Sim_DMA_Channel *ch)
+{
+    uint32_t index = (ch->base - DMA_CH1_BASE) / SIM_DMA_CH_STEP;
+    uint32_t select;
+
+    if(index < 4U)
+    {
+        select = Sim_readReg32(DMACLASRCSEL_BASE + SYSCTL_O_DMACHSRCSEL1) >>
+                 (index * 8U);
+    }
+    else
+    {
+        select = Sim_readReg32(DMACLASRCSEL_BASE + SYSCTL_O_DMACHSRCSEL2) >>
+                 ((index - 4U) * 8U);
+    }
+
+    return((uint16_t)(select & 0xFFU));
+}
+
+static void
+Sim_DMA_raiseInterrupt(const Sim_DMA_Channel *ch)
+{
+    uint32_t index = (ch->base - DMA_CH1_BASE) / SIM_DMA_CH_STEP;
+
+    Sim_raiseInterrupt(INT_DMA_CH1 + (index * SIM_DMA_INT_STEP));
+}
+
+//*****************************************************************************
+//
+// Latches a trigger. A trigger that arrives while the previous one has not
+// started its burst yet is lost and sets the overflow flag.
+//
+//*****************************************************************************
+static void
+Sim_DMA_trigger(Sim_DMA_Channel *ch)
+{
+    if(ch->pending)
+    {
+        ch->overflow = true;
+        ch->stats.overflows++;
+        if((Sim_DMA_read(ch, DMA_O_MODE) & DMA_MODE_OVRINTE) != 0U)
+        {
+            Sim_DMA_raiseInterrupt(ch);
+        }
+        return;
+    }
+
+    ch->pending = true;
+    ch->stats.triggers++;
+}
+
+static void
+Sim_DMA_resetChannel(Sim_DMA_Channel *ch)
+{
+    ch->inTransfer = false;
+    ch->pending = false;
+    ch->overflow = false;
+    ch->transferCount = 0U;
+    ch->srcWrapCount = 0U;
+    ch->dstWrapCount = 0U;
+}
+
+//*****************************************************************************
+//
+// Picks up the CONTROL strobes software wrote since the last refresh
+//
+//*****************************************************************************
+static void
+Sim_DMA_refresh(Sim_DMA_Channel *ch)
+{
+    uint16_t control = Sim_DMA_read(ch, DMA_O_CONTROL);
+
+    if((control & SIM_DMA_CONTROL_STROBES) == 0U)
+    {
+        return;
+    }
+
+    if((control & DMA_CONTROL_SOFTRESET) != 0U)
+    {
+        Sim_DMA_resetChannel(ch);
+    }
+    if((control & DMA_CONTROL_HALT) != 0U)
+    {
+        ch->running = false;
+    }
+    if((control & DMA_CONTROL_RUN) != 0U)
+    {
+        ch->running = true;
+    }
+    if((control & DMA_CONTROL_PERINTCLR) != 0U)
+    {
+        ch->pending = false;
+    }
+    if((control & DMA_CONTROL_PERINTFRC) != 0U)
+    {
+        Sim_DMA_trigger(ch);
+    }
+    if((control & DMA_CONTROL_ERRCLR) != 0U)
+    {
+        ch->overflow = false;
+    }
+
+    Sim_DMA_write(ch, DMA_O_CONTROL, control & ~SIM_DMA_CONTROL_STROBES);
+}
+
+static void
+Sim_DMA_publish(const Sim_DMA_Channel *ch)
+{
+    uint16_t control = Sim_DMA_read(ch, DMA_O_CONTROL) &
+                       ~(DMA_CONTROL_PERINTFLG | DMA_CONTROL_TRANSFERSTS |
+                         DMA_CONTROL_BURSTSTS | DMA_CONTROL_RUNSTS |
+                         DMA_CONTROL_OVRFLG);
+
+    control |= ch->pending ? DMA_CONTROL_PERINTFLG : 0U;
+    control |= ch->inTransfer ? DMA_CONTROL_TRANSFERSTS : 0U;
+    control |= ch->running ? DMA_CONTROL_RUNSTS : 0U;
+    control |= ch->overflow ? DMA_CONTROL_OVRFLG : 0U;
+
+    Sim_DMA_write(ch, DMA_O_CONTROL, control);
+    Sim_DMA_write(ch, DMA_O_BURST_COUNT, 0U);
+    Sim_DMA_write(ch, DMA_O_TRANSFER_COUNT, ch->transferCount);
+    Sim_DMA_write(ch, DMA_O_SRC_WRAP_COUNT, ch->srcWrapCount);
+    Sim_DMA_write(ch, DMA_O_DST_WRAP_COUNT, ch->dstWrapCount);
+    Sim_writeReg32(ch->base + DMA_O_SRC_BEG_ADDR_ACTIVE, ch->srcBegin);
+    Sim_writeReg32(ch->base + DMA_O_SRC_ADDR_ACTIVE, ch->src);
+    Sim_writeReg32(ch->base + DMA_O_DST_BEG_ADDR_ACTIVE, ch->dstBegin);
+    Sim_writeReg32(ch->base + DMA_O_DST_ADDR_ACTIVE, ch->dst);
+}
+
+//*****************************************************************************
+//
+// Performs one burst. The first burst of a transfer copies the shadow
+// address registers to the active ones and reloads the counters.
+//
+//*****************************************************************************
+static void
+Sim_DMA_burst(Sim_DMA_Channel *ch)
+{
+    uint16_t mode = Sim_DMA_read(ch, DMA_O_MODE);
+    uint16_t size = (Sim_DMA_read(ch, DMA_O_BURST_SIZE) &
+                     DMA_BURST_SIZE_BURSTSIZE_M) + 1U;
+    bool wide = (mode & DMA_MODE_DATASIZE) != 0U;
+    uint16_t i;
+
+    if(!ch->inTransfer)
+    {
+        ch->inTransfer = true;
+        ch->srcBegin = Sim_readReg32(ch->base + DMA_O_SRC_BEG_ADDR_SHADOW);
+        ch->src = Sim_readReg32(ch->base + DMA_O_SRC_ADDR_SHADOW);
+        ch->dstBegin = Sim_readReg32(ch->base + DMA_O_DST_BEG_ADDR_SHADOW);
+        ch->dst = Sim_readReg32(ch->base + DMA_O_DST_ADDR_SHADOW);
+        ch->transferCount = Sim_DMA_read(ch, DMA_O_TRANSFER_SIZE);
+        ch->srcWrapCount = Sim_DMA_read(ch, DMA_O_SRC_WRAP_SIZE);
+        ch->dstWrapCount = Sim_DMA_read(ch, DMA_O_DST_WRAP_SIZE);
+
+        if(((mode & DMA_MODE_CHINTE) != 0U) &&
+           ((mode & DMA_MODE_CHINTMODE) == 0U))
+        {
+            Sim_DMA_raiseInterrupt(ch);
+        }
+    }
+
+    //
+    // The copies go through the same accessors as CPU accesses, so models
+    // behind the source and destination see them
+    //
+    for(i = 0U; i < size; i++)
+    {
+        if(wide)
+        {
+            *(volatile uint32_t *)Sim_getRegAddress(ch->dst & ~1UL) =
+                *(volatile uint32_t *)Sim_getRegAddress(ch->src & ~1UL);
+        }
+        else
+        {
+            *Sim_getRegAddress(ch->dst) = *Sim_getRegAddress(ch->src);
+        }
+
+        if(i < (size - 1U))
+        {
+            ch->src += (uint32_t)(int32_t)Sim_DMA_readStep(ch,
+                                                  DMA_O_SRC_BURST_STEP);
+            ch->dst += (uint32_t)(int32_t)Sim_DMA_readStep(ch,
+                                                  DMA_O_DST_BURST_STEP);
+        }
+    }
+
+    if(ch->srcWrapCount == 0U)
+    {
+        ch->srcBegin += (uint32_t)(int32_t)Sim_DMA_readStep(ch,
+                                                   DMA_O_SRC_WRAP_STEP);
+        ch->src = ch->srcBegin;
+        ch->srcWrapCount = Sim_DMA_read(ch, DMA_O_SRC_WRAP_SIZE);
+    }
+    else
+    {
+        ch->srcWrapCount--;
+        ch->src += (uint32_t)(int32_t)Sim_DMA_readStep(ch,
+                                                DMA_O_SRC_TRANSFER_STEP);
+    }
+
+    if(ch->dstWrapCount == 0U)
+    {
+        ch->dstBegin += (uint32_t)(int32_t)Sim_DMA_readStep(ch,
+                                                   DMA_O_DST_WRAP_STEP);
+        ch->dst = ch->dstBegin;
+        ch->dstWrapCount = Sim_DMA_read(ch, DMA_O_DST_WRAP_SIZE);
+    }
+    else
+    {
+        ch->dstWrapCount--;
+        ch->dst += (uint32_t)(int32_t)Sim_DMA_readStep(ch,
+                                                DMA_O_DST_TRANSFER_STEP);
+    }
+
+    ch->stats.bursts++;
+    ch->stats.lastBurst = Sim_getCycles();
+
+    if(ch->transferCount != 0U)
+    {
+        ch->transferCount--;
+        return;
+    }
+
+    //
+    // End of the transfer. In continuous mode the channel stays armed and
+    // the next trigger starts over from the shadow registers.
+    //
+    ch->inTransfer = false;
+    ch->stats.transfers++;
+
+    if(((mode & DMA_MODE_CHINTE) != 0U) &&
+       ((mode & DMA_MODE_CHINTMODE) != 0U))
+    {
+        Sim_DMA_raiseInterrupt(ch);
+    }
+
+    if((mode & DMA_MODE_CONTINUOUS) == 0U)
+    {
+        ch->running = false;
+    }
+}
+
+//*****************************************************************************
+//
+// Trigger network listener
+//
+//*****************************************************************************
+static void
+Sim_DMA_triggerHandler(uint16_t trigger)
+{
+    Sim_DMA_Channel *ch;
+    uint16_t i;
+
+    for(i = 0U; i < SIM_DMA_NUM_CHANNELS; i++)
+    {
+        ch = &Sim_DMA_channels[i];
+        if(((Sim_DMA_read(ch, DMA_O_MODE) & DMA_MODE_PERINTE) != 0U) &&
+           (Sim_DMA_getTriggerSelect(ch) == trigger))
+        {
+            Sim_DMA_trigger(ch);
+        }
+    }
+}
+
+//*****************************************************************************
+//
+// Sim_Model callbacks. A latched trigger of a running channel is an event
+// at the current cycle.
+//
+//*****************************************************************************
+static uint64_t
+Sim_DMA_nextEvent(void)
+{
+    Sim_DMA_Channel *ch;
+    uint64_t next = UINT64_MAX;
+    uint16_t i;
+
+    for(i = 0U; i < SIM_DMA_NUM_CHANNELS; i++)
+    {
+        ch = &Sim_DMA_channels[i];
+        if(ch->dirty)
+        {
+            ch->dirty = false;
+            Sim_DMA_refresh(ch);
+        }
+
+        if(ch->running && ch->pending)
+        {
+            next = Sim_getCycles();
+        }
+    }
+
+    return(next);
+}
+
+static void
+Sim_DMA_advance(uint64_t cycle)
+{
+    Sim_DMA_Channel *ch;
+    uint16_t i;
+
+    (void)cycle;
+
+    for(i = 0U; i < SIM_DMA_NUM_CHANNELS; i++)
+    {
+        ch = &Sim_DMA_channels[i];
+        if(!ch->running || !ch->pending)
+        {
+            continue;
+        }
+
+        //
+        // In one-shot mode a single trigger runs the whole transfer
+        //
+        ch->pending = false;
+        do
+        {
+            Sim_DMA_burst(ch);
+        } while(ch->inTransfer &&
+                ((Sim_DMA_read(ch, DMA_O_MODE) & DMA_MODE_ONESHOT) != 0U));
+    }
+}
+
+static void
+Sim_DMA_reset(void)
+{
+    uint16_t i;
+
+    memset(Sim_DMA_channels, 0, sizeof(Sim_DMA_channels));
+
+    for(i = 0U; i < SIM_DMA_NUM_CHANNELS; i++)
+    {
+        Sim_DMA_channels[i].base = DMA_CH1_BASE +
+                                   ((uint32_t)i * SIM_DMA_CH_STEP);
+    }
+}
+
+//*****************************************************************************
+//
+// Access handler for the DMA register page. Strobes written by the previous
+// access are acted upon and the status registers refreshed before software
+// sees them; the channels are marked dirty so that the strobes of this
+// access are picked up before the next event is scheduled.
+//
+//*****************************************************************************
+static void
+Sim_DMA_accessHandler(uint32_t address)
+{
+    Sim_DMA_Channel *ch;
+    uint16_t i;
+
+    (void)address;
+
+    //
+    // A hard reset stops every channel, the configuration is kept
+    //
+    if((Sim_readReg16(DMA_BASE + DMA_O_CTRL) & DMA_CTRL_HARDRESET) != 0U)
+    {
+        Sim_writeReg16(DMA_BASE + DMA_O_CTRL, 0U);
+        for(i = 0U; i < SIM_DMA_NUM_CHANNELS; i++)
+        {
+            Sim_DMA_resetChannel(&Sim_DMA_channels[i]);
+            Sim_DMA_channels[i].running = false;
+        }
+    }
+
+    for(i = 0U; i < SIM_DMA_NUM_CHANNELS; i++)
+    {
+        ch = &Sim_DMA_channels[i];
+        Sim_DMA_refresh(ch);
+        Sim_DMA_publish(ch);
+        ch->dirty = true;
+    }
+}
+
+//*****************************************************************************
+//
+// Sim_DMA_init
+//
+//*****************************************************************************
+void
+Sim_DMA_init(void)
+{
+    Sim_DMA_reset();
+    Sim_registerModel(&Sim_DMA_model);
+    Sim_attachHandler(DMA_BASE,
+                      DMA_CH1_BASE +
+                      (SIM_DMA_NUM_CHANNELS * SIM_DMA_CH_STEP) - 1U,
+                      Sim_DMA_accessHandler);
+    Sim_attachTriggerHandler(Sim_DMA_triggerHandler);
+}
+
+//*****************************************************************************
+//
+// Sim_DMA_getStats
+//
+//*****************************************************************************
+const Sim_DMA_Stats *
+Sim_DMA_getStats(uint32_t base)
+{
+    return(&Sim_DMA_channels[(base - DMA_CH1_BASE) / SIM_DMA_CH_STEP].stats);
+}
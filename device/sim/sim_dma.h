@@ -0,0 +1,107 @@
+//###########################################################################
+//
+// FILE:   sim_dma.h
+//
+// TITLE:  DMA model for the host simulator.
+//
+//###########################################################################
+//
+// Models the six DMA channels: peripheral trigger selection through
+// DMACHSRCSEL1/2, software triggers, burst/transfer/wrap address generation
+// with shadow-to-active reload, one-shot and continuous modes, 16- and
+// 32-bit data size, the trigger overflow flag and the channel interrupt at
+// the beginning or end of a transfer.
+//
+// Triggers arrive from other models over the simulator trigger network
+// (see Sim_raiseTrigger()). A triggered burst is performed at the cycle of
+// its trigger, as if the bus were otherwise idle, through the same accessors
+// the CPU uses, so destination peripheral models see the writes. Source and
+// destination addresses are simulated word addresses; buffers in RAM must be
+// placed in the simulated address space (see Sim_getAddress()).
+//
+// Not modelled: bus arbitration and transfer latency, channel priority
+// modes, the ADC/peripheral sync feature and emulation halt.
+//
+//###########################################################################
+
+#ifndef SIM_DMA_H
+#define SIM_DMA_H
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "sim.h"
+
+//*****************************************************************************
+//
+// Number of DMA channels modelled and the distance between their bases.
+//
+//*****************************************************************************
+#define SIM_DMA_NUM_CHANNELS    6U
+#define SIM_DMA_CH_STEP         0x20U
+
+//*****************************************************************************
+//
+//! Activity counters of one DMA channel.
+//
+//*****************************************************************************
+typedef struct
+{
+    uint32_t triggers;      //!< Triggers accepted
+    uint32_t overflows;     //!< Triggers lost while one was still pending
+    uint32_t bursts;        //!< Bursts performed
+    uint32_t transfers;     //!< Transfers completed
+    uint64_t lastBurst;     //!< Cycle of the most recent burst
+} Sim_DMA_Stats;
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+//*****************************************************************************
+//
+//! Attaches the DMA model to the simulator.
+//!
+//! Registers the model with Sim_registerModel(), hooks the DMA register
+//! pages and listens on the trigger network. Call once before Sim_reset().
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+Sim_DMA_init(void);
+
+//*****************************************************************************
+//
+//! Returns the activity counters of a channel.
+//!
+//! \param base is the DMA channel base address, DMA_CH1_BASE to
+//! DMA_CH6_BASE.
+//!
+//! \return Returns a pointer to the counters.
+//
+//*****************************************************************************
+extern const Sim_DMA_Stats *
+Sim_DMA_getStats(uint32_t base);
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SIM_DMA_H
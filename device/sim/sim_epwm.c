@@ -0,0 +1,1525 @@
+//###########################################################################
+//
+// FILE:   sim_epwm.c
+//
+// TITLE:  Cycle-approximate ePWM model for the host simulator.
+//
+//###########################################################################
+
+#include <string.h>
+#include "sim_epwm.h"
+#include "driverlib.h"
+
+//
+// Counter events, in the bit order of the AQCTLA/AQCTLB fields
+//
+#define SIM_EPWM_EV_ZRO         0x01U
+#define SIM_EPWM_EV_PRD         0x02U
+#define SIM_EPWM_EV_CAU         0x04U
+#define SIM_EPWM_EV_CAD         0x08U
+#define SIM_EPWM_EV_CBU         0x10U
+#define SIM_EPWM_EV_CBD         0x20U
+
+//
+// Counter modes (TBCTL[CTRMODE])
+//
+#define SIM_EPWM_MODE_UP        0U
+#define SIM_EPWM_MODE_DOWN      1U
+#define SIM_EPWM_MODE_UPDOWN    2U
+#define SIM_EPWM_MODE_FREEZE    3U
+
+//
+// TBCTL value after reset: counter frozen, HSPCLKDIV = /2
+//
+#define SIM_EPWM_TBCTL_RESET    0x0083U
+
+//
+// TBCLKSYNC bit in PCLKCR0 (see SYSCTL_PERIPH_CLK_TBCLKSYNC)
+//
+#define SIM_EPWM_TBCLKSYNC      0x00040000UL
+
+//
+// GLDCTL[GLDMODE] value that only loads on a software force
+//
+#define SIM_EPWM_GLD_FORCE      0xFU
+
+//
+// Distance between two consecutive ePWM interrupt numbers
+//
+#define SIM_EPWM_INT_STEP       0x00010001UL
+
+//
+// DBCTL fields: OUT_MODE bit 1 routes the rising-edge delay path to output
+// A and bit 0 the falling-edge delay path to output B; POLSEL inverts the
+// paths and IN_MODE feeds them from output B instead of A
+//
+#define SIM_EPWM_DB_OUT_A       0x0002U
+#define SIM_EPWM_DB_OUT_B       0x0001U
+#define SIM_EPWM_DB_INV_RED     0x0004U
+#define SIM_EPWM_DB_INV_FED     0x0008U
+#define SIM_EPWM_DB_IN_RED_B    0x0010U
+#define SIM_EPWM_DB_IN_FED_B    0x0020U
+
+//
+// SYNCSELECT source codes of the ePWM4 and ePWM7 sync inputs
+//
+#define SIM_EPWM_SYNC_EPWM1     0U
+#define SIM_EPWM_SYNC_EPWM4     1U
+#define SIM_EPWM_SYNC_EPWM7     2U
+
+//
+// TBCTL[SYNCOSEL] values
+//
+#define SIM_EPWM_SYNCO_SYNCI    0U
+#define SIM_EPWM_SYNCO_ZRO      1U
+#define SIM_EPWM_SYNCO_CMPB     2U
+
+//
+// An output edge waiting for its dead-band delay
+//
+typedef struct
+{
+    bool valid;
+    uint16_t level;
+    uint64_t time;
+    uint64_t fine;
+} Sim_EPWM_Edge;
+
+typedef struct
+{
+    uint32_t base;
+    bool running;
+    bool up;
+    uint16_t ctr;
+    uint16_t publishedCtr;
+    uint64_t time;
+    uint16_t prd;
+    uint16_t cmpa;
+    uint16_t cmpb;
+    uint16_t prdHR;
+    uint16_t cmpaHR;
+    uint16_t cmpbHR;
+    uint32_t hrPhase;
+    uint16_t etCount;
+    uint16_t etFlag;
+    uint16_t socCount[2];
+    uint16_t gldCount;
+    bool gldLatch;
+    bool dirty;
+    uint64_t nextTime;
+    uint64_t periods;
+    uint16_t aqLevel[2];
+    Sim_EPWM_Edge pending[2];
+    Sim_EPWM_OutputStats outputs[2];
+} Sim_EPWM_Module;
+
+static Sim_EPWM_Module Sim_EPWM_modules[SIM_EPWM_NUM_MODULES];
+static Sim_EPWM_EdgeCallback Sim_EPWM_edgeCallback;
+static uint32_t Sim_EPWM_mepSteps = SIM_EPWM_MEP_STEPS_DEFAULT;
+
+static uint64_t Sim_EPWM_nextEvent(void);
+static void Sim_EPWM_advance(uint64_t cycle);
+static void Sim_EPWM_reset(void);
+static void Sim_EPWM_syncOut(uint16_t source, uint64_t time,
+                             uint16_t visited);
+
+static Sim_Model Sim_EPWM_model =
+{
+    Sim_EPWM_nextEvent,
+    Sim_EPWM_advance,
+    Sim_EPWM_reset,
+    NULL
+};
+
+//*****************************************************************************
+//
+// Register helpers. The register file always holds what software sees, which
+// for shadowed registers is the shadow value; the active values live in the
+// module state.
+//
+//*****************************************************************************
+static inline uint16_t
+Sim_EPWM_read(const Sim_EPWM_Module *m, uint32_t offset)
+{
+    return(Sim_readReg16(m->base + offset));
+}
+
+static inline void
+Sim_EPWM_write(const Sim_EPWM_Module *m, uint32_t offset, uint16_t value)
+{
+    Sim_writeReg16(m->base + offset, value);
+}
+
+static inline uint16_t
+Sim_EPWM_getMode(const Sim_EPWM_Module *m)
+{
+    return(Sim_EPWM_read(m, EPWM_O_TBCTL) & EPWM_TBCTL_CTRMODE_M);
+}
+
+//
+// SYSCLK cycles per TBCLK: CLKDIV is 2^n, HSPCLKDIV is 1 or 2n
+//
+static inline uint32_t
+Sim_EPWM_getDivider(const Sim_EPWM_Module *m)
+{
+    uint16_t tbctl = Sim_EPWM_read(m, EPWM_O_TBCTL);
+    uint16_t clkDiv = (tbctl & EPWM_TBCTL_CLKDIV_M) >> EPWM_TBCTL_CLKDIV_S;
+    uint16_t hspDiv = (tbctl & EPWM_TBCTL_HSPCLKDIV_M) >>
+                      EPWM_TBCTL_HSPCLKDIV_S;
+
+    return((1UL << clkDiv) * ((hspDiv == 0U) ? 1UL : (2UL * hspDiv)));
+}
+
+//*****************************************************************************
+//
+// Number of TBCLK ticks from the current counter value to the next point
+// where something can happen (a compare match, zero or period).
+//
+//*****************************************************************************
+static uint32_t
+Sim_EPWM_getTicksToNext(const Sim_EPWM_Module *m)
+{
+    uint16_t mode = Sim_EPWM_getMode(m);
+    uint16_t ctr = m->ctr;
+    uint16_t target;
+
+    if(((mode == SIM_EPWM_MODE_UP) && (ctr >= m->prd)) ||
+       ((mode == SIM_EPWM_MODE_DOWN) && (ctr == 0U)))
+    {
+        //
+        // Wrap-around to zero or reload of the period
+        //
+        return(1U);
+    }
+
+    if((mode == SIM_EPWM_MODE_DOWN) ||
+       ((mode == SIM_EPWM_MODE_UPDOWN) && !m->up))
+    {
+        target = 0U;
+        if((m->cmpa < ctr) && (m->cmpa > target))
+        {
+            target = m->cmpa;
+        }
+        if((m->cmpb < ctr) && (m->cmpb > target))
+        {
+            target = m->cmpb;
+        }
+
+        return((uint32_t)ctr - target);
+    }
+
+    if(ctr >= m->prd)
+    {
+        //
+        // Up-down counter past a period that was just made shorter: turn
+        // around on the next tick.
+        //
+        return(1U);
+    }
+
+    target = m->prd;
+    if((m->cmpa > ctr) && (m->cmpa < target))
+    {
+        target = m->cmpa;
+    }
+    if((m->cmpb > ctr) && (m->cmpb < target))
+    {
+        target = m->cmpb;
+    }
+
+    return((uint32_t)target - ctr);
+}
+
+//*****************************************************************************
+//
+// Micro edge positioner. A high-resolution fraction becomes a whole number of
+// MEP steps, either scaled by the HRMSTEP scale factor of ePWM1
+// (auto-conversion) or taken as the step count directly; the delay is then
+// timed with the step size of the simulated silicon.
+//
+//*****************************************************************************
+static uint32_t
+Sim_EPWM_getMEPDelay(const Sim_EPWM_Module *m, uint16_t fraction)
+{
+    uint32_t steps = fraction;
+
+    if((Sim_EPWM_read(m, HRPWM_O_HRCNFG) & HRPWM_HRCNFG_AUTOCONV) != 0U)
+    {
+        steps = ((steps * (Sim_readReg16(EPWM1_BASE + HRPWM_O_HRMSTEP) &
+                           HRPWM_HRMSTEP_HRMSTEP_M)) + 0x80U) >> 8U;
+    }
+
+    return((uint32_t)(((uint64_t)steps << (SIM_EPWM_FINE_S + 8U)) /
+                      Sim_EPWM_mepSteps));
+}
+
+//
+// Fine offset of an edge from its TBCLK edge. MEP control of one edge
+// delays every edge of that direction; control of both edges, meant for
+// up-down counting, delays edges on the way up and advances them on the way
+// down, so a larger compare value narrows the pulse around the period.
+//
+static int64_t
+Sim_EPWM_getEdgeOffset(const Sim_EPWM_Module *m, uint16_t output,
+                       uint16_t level, uint16_t event)
+{
+    uint16_t hrcnfg = Sim_EPWM_read(m, HRPWM_O_HRCNFG);
+    uint16_t edgeMode;
+    int64_t offset = m->hrPhase;
+    int64_t delay;
+    bool phaseControl;
+
+    if(output == SIM_EPWM_OUTPUT_A)
+    {
+        edgeMode = hrcnfg & HRPWM_HRCNFG_EDGMODE_M;
+        phaseControl = (hrcnfg & HRPWM_HRCNFG_CTLMODE) != 0U;
+        delay = Sim_EPWM_getMEPDelay(m, m->cmpaHR);
+    }
+    else
+    {
+        edgeMode = (hrcnfg & HRPWM_HRCNFG_EDGMODEB_M) >>
+                   HRPWM_HRCNFG_EDGMODEB_S;
+        phaseControl = (hrcnfg & HRPWM_HRCNFG_CTLMODEB) != 0U;
+        delay = Sim_EPWM_getMEPDelay(m, m->cmpbHR);
+    }
+
+    if((edgeMode == (uint16_t)HRPWM_MEP_CTRL_DISABLE) || phaseControl)
+    {
+        return(offset);
+    }
+
+    if(edgeMode == (uint16_t)HRPWM_MEP_CTRL_RISING_AND_FALLING_EDGE)
+    {
+        if((event & (SIM_EPWM_EV_CAD | SIM_EPWM_EV_CBD)) != 0U)
+        {
+            return(offset - delay);
+        }
+        if((event & (SIM_EPWM_EV_CAU | SIM_EPWM_EV_CBU)) != 0U)
+        {
+            return(offset + delay);
+        }
+        return(offset);
+    }
+
+    if((level != 0U) ==
+       (edgeMode == (uint16_t)HRPWM_MEP_CTRL_RISING_EDGE))
+    {
+        offset += delay;
+    }
+
+    return(offset);
+}
+
+//
+// High-resolution period: the MEP stretches each period by the TBPRDHR
+// fraction (twice in up-down mode, once per slope). The stretch builds up
+// in hrPhase and whole cycles of it are moved into the time base.
+//
+static void
+Sim_EPWM_extendPeriod(Sim_EPWM_Module *m, uint16_t mode)
+{
+    uint32_t delay;
+
+    if((Sim_EPWM_read(m, HRPWM_O_HRPCTL) & HRPWM_HRPCTL_HRPE) == 0U)
+    {
+        return;
+    }
+
+    delay = Sim_EPWM_getMEPDelay(m, m->prdHR);
+    m->hrPhase += (mode == SIM_EPWM_MODE_UPDOWN) ? (2U * delay) : delay;
+    m->time += m->hrPhase >> SIM_EPWM_FINE_S;
+    m->hrPhase &= SIM_EPWM_FINE_ONE - 1U;
+}
+
+//*****************************************************************************
+//
+// Output level bookkeeping
+//
+//*****************************************************************************
+static void
+Sim_EPWM_recordEdge(Sim_EPWM_Module *m, uint16_t output, uint16_t level,
+                    uint64_t time, uint64_t fine)
+{
+    Sim_EPWM_OutputStats *out = &m->outputs[output];
+    uint64_t pulse;
+
+    if(out->level == level)
+    {
+        return;
+    }
+
+    out->level = level;
+    out->edges++;
+
+    if(level != 0U)
+    {
+        if(out->edges > 2U)
+        {
+            out->period = time - out->lastRise;
+            out->finePeriod = fine - out->fineRise;
+            pulse = time - out->lastFall;
+            if((out->minLowTime == 0U) || (pulse < out->minLowTime))
+            {
+                out->minLowTime = pulse;
+            }
+        }
+        out->lastRise = time;
+        out->fineRise = fine;
+    }
+    else
+    {
+        if(out->edges > 1U)
+        {
+            out->highTime = time - out->lastRise;
+            out->fineHighTime = fine - out->fineRise;
+            if((out->minHighTime == 0U) || (out->highTime < out->minHighTime))
+            {
+                out->minHighTime = out->highTime;
+            }
+        }
+        out->lastFall = time;
+        out->fineFall = fine;
+    }
+
+    if(Sim_EPWM_edgeCallback != NULL)
+    {
+        Sim_EPWM_edgeCallback(m->base, output, level, time);
+    }
+}
+
+//
+// Records the delayed edge of an output if it is due by the fine time
+// 'fine'
+//
+static void
+Sim_EPWM_flushEdge(Sim_EPWM_Module *m, uint16_t output, uint64_t fine)
+{
+    Sim_EPWM_Edge *edge = &m->pending[output];
+
+    if(edge->valid && (edge->fine <= fine))
+    {
+        edge->valid = false;
+        Sim_EPWM_recordEdge(m, output, edge->level, edge->time, edge->fine);
+    }
+}
+
+//
+// Delay of one dead-band path in fine time: DBRED/DBFED count TBCLK
+// cycles, or half cycles with HALFCYCLE set, and the 7-bit fraction in
+// bits 15:9 of DBREDHR/DBFEDHR goes through the MEP when HRCNFG2 selects
+// the edge. The delay registers act immediately; their shadows are not
+// modelled.
+//
+static uint64_t
+Sim_EPWM_getDeadBandDelay(const Sim_EPWM_Module *m, bool rising)
+{
+    uint16_t dbctl = Sim_EPWM_read(m, EPWM_O_DBCTL);
+    uint16_t count;
+    uint16_t fraction;
+    uint16_t mepEdge;
+    uint64_t delay;
+
+    if(rising)
+    {
+        count = Sim_EPWM_read(m, EPWM_O_DBRED) & EPWM_DBRED_DBRED_M;
+        fraction = Sim_EPWM_read(m, HRPWM_O_DBREDHR) >>
+                   HRPWM_DBREDHR_DBREDHR_S;
+        mepEdge = (uint16_t)HRPWM_DB_MEP_CTRL_RED;
+    }
+    else
+    {
+        count = Sim_EPWM_read(m, EPWM_O_DBFED) & EPWM_DBFED_DBFED_M;
+        fraction = Sim_EPWM_read(m, HRPWM_O_DBFEDHR) >>
+                   HRPWM_DBFEDHR_DBFEDHR_S;
+        mepEdge = (uint16_t)HRPWM_DB_MEP_CTRL_FED;
+    }
+
+    delay = ((uint64_t)count * Sim_EPWM_getDivider(m)) << SIM_EPWM_FINE_S;
+    if((dbctl & EPWM_DBCTL_HALFCYCLE) != 0U)
+    {
+        delay >>= 1U;
+    }
+    else
+    {
+        fraction <<= 1U;
+    }
+
+    if((Sim_EPWM_read(m, HRPWM_O_HRCNFG2) & mepEdge) != 0U)
+    {
+        delay += Sim_EPWM_getMEPDelay(m, fraction);
+    }
+
+    return(delay);
+}
+
+//
+// Drives an output from a dead-band path or straight from the action
+// qualifier. An edge that undoes a pending one cancels it, so a pulse
+// shorter than the delay never reaches the output.
+//
+static void
+Sim_EPWM_driveOutput(Sim_EPWM_Module *m, uint16_t output, uint16_t level,
+                     uint64_t fine, uint64_t delay)
+{
+    Sim_EPWM_Edge *edge = &m->pending[output];
+
+    Sim_EPWM_flushEdge(m, output, fine);
+    if(edge->valid)
+    {
+        if(edge->level == level)
+        {
+            return;
+        }
+        edge->valid = false;
+    }
+
+    if(delay == 0U)
+    {
+        Sim_EPWM_recordEdge(m, output, level, m->time, fine);
+    }
+    else
+    {
+        edge->valid = true;
+        edge->level = level;
+        edge->time = m->time + (delay >> SIM_EPWM_FINE_S);
+        edge->fine = fine + delay;
+    }
+}
+
+//
+// Passes an edge of an action qualifier output through the dead-band
+// submodule. The rising-edge delay path delays rising edges of its input,
+// the falling-edge delay path falling edges; inversion follows the delay.
+//
+static void
+Sim_EPWM_routeEdge(Sim_EPWM_Module *m, uint16_t input, uint16_t level,
+                   uint64_t fine)
+{
+    uint16_t dbctl = Sim_EPWM_read(m, EPWM_O_DBCTL);
+    uint16_t source;
+
+    if((dbctl & SIM_EPWM_DB_OUT_A) == 0U)
+    {
+        if(input == SIM_EPWM_OUTPUT_A)
+        {
+            Sim_EPWM_driveOutput(m, SIM_EPWM_OUTPUT_A, level, fine, 0U);
+        }
+    }
+    else
+    {
+        source = ((dbctl & SIM_EPWM_DB_IN_RED_B) != 0U) ?
+                 SIM_EPWM_OUTPUT_B : SIM_EPWM_OUTPUT_A;
+        if(input == source)
+        {
+            Sim_EPWM_driveOutput(m, SIM_EPWM_OUTPUT_A,
+                                 level ^ (((dbctl & SIM_EPWM_DB_INV_RED) !=
+                                           0U) ? 1U : 0U), fine,
+                                 (level != 0U) ?
+                                 Sim_EPWM_getDeadBandDelay(m, true) : 0U);
+        }
+    }
+
+    if((dbctl & SIM_EPWM_DB_OUT_B) == 0U)
+    {
+        if(input == SIM_EPWM_OUTPUT_B)
+        {
+            Sim_EPWM_driveOutput(m, SIM_EPWM_OUTPUT_B, level, fine, 0U);
+        }
+    }
+    else
+    {
+        source = ((dbctl & SIM_EPWM_DB_IN_FED_B) != 0U) ?
+                 SIM_EPWM_OUTPUT_B : SIM_EPWM_OUTPUT_A;
+        if(input == source)
+        {
+            Sim_EPWM_driveOutput(m, SIM_EPWM_OUTPUT_B,
+                                 level ^ (((dbctl & SIM_EPWM_DB_INV_FED) !=
+                                           0U) ? 1U : 0U), fine,
+                                 (level == 0U) ?
+                                 Sim_EPWM_getDeadBandDelay(m, false) : 0U);
+        }
+    }
+}
+
+static void
+Sim_EPWM_setLevel(Sim_EPWM_Module *m, uint16_t output, uint16_t level,
+                  uint16_t event)
+{
+    uint64_t fine;
+
+    if(m->aqLevel[output] == level)
+    {
+        return;
+    }
+
+    m->aqLevel[output] = level;
+    fine = (uint64_t)((int64_t)(m->time << SIM_EPWM_FINE_S) +
+                      Sim_EPWM_getEdgeOffset(m, output, level, event));
+    Sim_EPWM_routeEdge(m, output, level, fine);
+}
+
+static void
+Sim_EPWM_applyAction(const Sim_EPWM_Module *m, uint16_t output,
+                     uint16_t aqctl, uint16_t events, uint16_t event,
+                     uint16_t *level, uint16_t *source)
+{
+    uint16_t shift;
+    uint16_t action;
+
+    if((events & event) == 0U)
+    {
+        return;
+    }
+
+    for(shift = 0U; (event & (1U << shift)) == 0U; shift++)
+    {
+    }
+
+    action = (aqctl >> (shift * 2U)) & 0x3U;
+    if(action == (uint16_t)EPWM_AQ_OUTPUT_NO_CHANGE)
+    {
+        return;
+    }
+
+    if(action == (uint16_t)EPWM_AQ_OUTPUT_LOW)
+    {
+        *level = 0U;
+    }
+    else if(action == (uint16_t)EPWM_AQ_OUTPUT_HIGH)
+    {
+        *level = 1U;
+    }
+    else
+    {
+        *level = m->aqLevel[output] ^ 1U;
+    }
+    *source = event;
+}
+
+//*****************************************************************************
+//
+// Applies the action qualifier for both outputs. Coincident events are
+// taken from lowest to highest priority so the highest priority one with
+// an action wins, and the output changes once, as the hardware resolves
+// them before the output rather than passing each on.
+//
+//*****************************************************************************
+static void
+Sim_EPWM_applyActions(Sim_EPWM_Module *m, uint16_t mode, uint16_t events)
+{
+    static const uint16_t upOrder[] =
+    {
+        SIM_EPWM_EV_ZRO, SIM_EPWM_EV_CAU, SIM_EPWM_EV_CBU, SIM_EPWM_EV_PRD
+    };
+    static const uint16_t downOrder[] =
+    {
+        SIM_EPWM_EV_PRD, SIM_EPWM_EV_CAD, SIM_EPWM_EV_CBD, SIM_EPWM_EV_ZRO
+    };
+    static const uint16_t upDownOrder[] =
+    {
+        SIM_EPWM_EV_ZRO, SIM_EPWM_EV_PRD, SIM_EPWM_EV_CAU, SIM_EPWM_EV_CAD,
+        SIM_EPWM_EV_CBU, SIM_EPWM_EV_CBD
+    };
+    const uint16_t *order;
+    uint16_t count;
+    uint16_t aqctl[2];
+    uint16_t output;
+    uint16_t level;
+    uint16_t source;
+    uint16_t i;
+
+    if(mode == SIM_EPWM_MODE_UP)
+    {
+        order = upOrder;
+        count = sizeof(upOrder) / sizeof(upOrder[0]);
+    }
+    else if(mode == SIM_EPWM_MODE_DOWN)
+    {
+        order = downOrder;
+        count = sizeof(downOrder) / sizeof(downOrder[0]);
+    }
+    else
+    {
+        order = upDownOrder;
+        count = sizeof(upDownOrder) / sizeof(upDownOrder[0]);
+    }
+
+    aqctl[SIM_EPWM_OUTPUT_A] = Sim_EPWM_read(m, EPWM_O_AQCTLA);
+    aqctl[SIM_EPWM_OUTPUT_B] = Sim_EPWM_read(m, EPWM_O_AQCTLB);
+
+    for(output = SIM_EPWM_OUTPUT_A; output <= SIM_EPWM_OUTPUT_B; output++)
+    {
+        level = m->aqLevel[output];
+        source = 0U;
+        for(i = 0U; i < count; i++)
+        {
+            Sim_EPWM_applyAction(m, output, aqctl[output], events, order[i],
+                                 &level, &source);
+        }
+
+        if(source != 0U)
+        {
+            Sim_EPWM_setLevel(m, output, level, source);
+        }
+    }
+}
+
+//*****************************************************************************
+//
+// Shadow-to-active transfers on counter zero and/or period
+//
+//*****************************************************************************
+static bool
+Sim_EPWM_isLoadEvent(uint16_t loadMode, uint16_t events)
+{
+    switch(loadMode)
+    {
+        case 0U:
+            return((events & SIM_EPWM_EV_ZRO) != 0U);
+        case 1U:
+            return((events & SIM_EPWM_EV_PRD) != 0U);
+        case 2U:
+            return((events & (SIM_EPWM_EV_ZRO | SIM_EPWM_EV_PRD)) != 0U);
+        default:
+            return(false);
+    }
+}
+
+//
+// Global load strobe: GLDMODE selects the counter events (sync is not
+// modelled, so the sync variants reduce to their counter events), GLDPRD
+// prescales them and in one-shot mode a strobe only loads if software set
+// the OSHTLD latch. A forced load (GFRCLD) counts as one event.
+//
+static bool
+Sim_EPWM_isGlobalLoadStrobe(Sim_EPWM_Module *m, uint16_t events, bool force)
+{
+    uint16_t gldctl = Sim_EPWM_read(m, EPWM_O_GLDCTL);
+    uint16_t mode = (gldctl & EPWM_GLDCTL_GLDMODE_M) >> EPWM_GLDCTL_GLDMODE_S;
+    uint16_t prescale = (gldctl & EPWM_GLDCTL_GLDPRD_M) >>
+                        EPWM_GLDCTL_GLDPRD_S;
+    bool event;
+
+    if(mode == SIM_EPWM_GLD_FORCE)
+    {
+        event = force;
+    }
+    else
+    {
+        event = force ||
+                Sim_EPWM_isLoadEvent((mode > 3U) ? (mode - 4U) : mode,
+                                     events);
+    }
+
+    if(!event || (prescale == 0U))
+    {
+        return(false);
+    }
+
+    m->gldCount++;
+    if(m->gldCount < prescale)
+    {
+        return(false);
+    }
+    m->gldCount = 0U;
+
+    if((gldctl & EPWM_GLDCTL_OSHTMODE) != 0U)
+    {
+        if(!m->gldLatch)
+        {
+            return(false);
+        }
+        m->gldLatch = false;
+    }
+
+    return(true);
+}
+
+//
+// Shadow-to-active copies. The high-resolution parts sit in bits 15:8 of the
+// word below each integer register and load together with it.
+//
+static inline void
+Sim_EPWM_loadPeriod(Sim_EPWM_Module *m)
+{
+    m->prd = Sim_EPWM_read(m, EPWM_O_TBPRD);
+    m->prdHR = Sim_EPWM_read(m, HRPWM_O_TBPRDHR) >> 8U;
+}
+
+static inline void
+Sim_EPWM_loadCompareA(Sim_EPWM_Module *m)
+{
+    m->cmpa = Sim_EPWM_read(m, EPWM_O_CMPA + 1U);
+    m->cmpaHR = Sim_EPWM_read(m, EPWM_O_CMPA) >> 8U;
+}
+
+static inline void
+Sim_EPWM_loadCompareB(Sim_EPWM_Module *m)
+{
+    m->cmpb = Sim_EPWM_read(m, EPWM_O_CMPB + 1U);
+    m->cmpbHR = Sim_EPWM_read(m, EPWM_O_CMPB) >> 8U;
+}
+
+static void
+Sim_EPWM_loadShadows(Sim_EPWM_Module *m, uint16_t events, bool force)
+{
+    uint16_t tbctl = Sim_EPWM_read(m, EPWM_O_TBCTL);
+    uint16_t cmpctl = Sim_EPWM_read(m, EPWM_O_CMPCTL);
+    uint16_t global = 0U;
+    bool loadPrd;
+    bool loadA;
+    bool loadB;
+    bool strobe;
+
+    loadPrd = ((tbctl & EPWM_TBCTL_PRDLD) == 0U) &&
+              ((events & SIM_EPWM_EV_ZRO) != 0U);
+    loadA = ((cmpctl & EPWM_CMPCTL_SHDWAMODE) == 0U) &&
+            Sim_EPWM_isLoadEvent((cmpctl & EPWM_CMPCTL_LOADAMODE_M) >>
+                                 EPWM_CMPCTL_LOADAMODE_S, events);
+    loadB = ((cmpctl & EPWM_CMPCTL_SHDWBMODE) == 0U) &&
+            Sim_EPWM_isLoadEvent((cmpctl & EPWM_CMPCTL_LOADBMODE_M) >>
+                                 EPWM_CMPCTL_LOADBMODE_S, events);
+
+    //
+    // Registers selected for global load ignore their own load mode
+    //
+    if((Sim_EPWM_read(m, EPWM_O_GLDCTL) & EPWM_GLDCTL_GLD) != 0U)
+    {
+        global = Sim_EPWM_read(m, EPWM_O_GLDCFG);
+        strobe = Sim_EPWM_isGlobalLoadStrobe(m, events, force);
+
+        if((global & EPWM_GL_REGISTER_TBPRD_TBPRDHR) != 0U)
+        {
+            loadPrd = strobe && ((tbctl & EPWM_TBCTL_PRDLD) == 0U);
+        }
+        if((global & EPWM_GL_REGISTER_CMPA_CMPAHR) != 0U)
+        {
+            loadA = strobe && ((cmpctl & EPWM_CMPCTL_SHDWAMODE) == 0U);
+        }
+        if((global & EPWM_GL_REGISTER_CMPB_CMPBHR) != 0U)
+        {
+            loadB = strobe && ((cmpctl & EPWM_CMPCTL_SHDWBMODE) == 0U);
+        }
+    }
+
+    if(loadPrd)
+    {
+        Sim_EPWM_loadPeriod(m);
+    }
+    if(loadA)
+    {
+        Sim_EPWM_loadCompareA(m);
+    }
+    if(loadB)
+    {
+        Sim_EPWM_loadCompareB(m);
+    }
+}
+
+//*****************************************************************************
+//
+// Event-trigger interrupt selection and prescaling
+//
+//*****************************************************************************
+static const uint16_t Sim_EPWM_selEvents[8] =
+{
+    0U, SIM_EPWM_EV_ZRO, SIM_EPWM_EV_PRD,
+    SIM_EPWM_EV_ZRO | SIM_EPWM_EV_PRD, SIM_EPWM_EV_CAU, SIM_EPWM_EV_CAD,
+    SIM_EPWM_EV_CBU, SIM_EPWM_EV_CBD
+};
+
+//
+// ADC start-of-conversion pulses. Unlike the interrupt, a pending flag does
+// not hold off further pulses. The pulses are raised on the trigger network,
+// where the DMA (and any other consumer) picks them up. Selection 0
+// (DCxEVT1) is not modelled.
+//
+static void
+Sim_EPWM_triggerSOC(Sim_EPWM_Module *m, uint16_t events, uint16_t soc)
+{
+    uint16_t etsel = Sim_EPWM_read(m, EPWM_O_ETSEL);
+    uint16_t enable = (soc == 0U) ? EPWM_ETSEL_SOCAEN : EPWM_ETSEL_SOCBEN;
+    uint16_t select;
+    uint16_t prescale;
+    uint16_t index;
+
+    select = (soc == 0U) ?
+             ((etsel & EPWM_ETSEL_SOCASEL_M) >> EPWM_ETSEL_SOCASEL_S) :
+             ((etsel & EPWM_ETSEL_SOCBSEL_M) >> EPWM_ETSEL_SOCBSEL_S);
+
+    if(((etsel & enable) == 0U) ||
+       ((events & Sim_EPWM_selEvents[select]) == 0U))
+    {
+        return;
+    }
+
+    if((Sim_EPWM_read(m, EPWM_O_ETPS) & EPWM_ETPS_SOCPSSEL) != 0U)
+    {
+        prescale = Sim_EPWM_read(m, EPWM_O_ETSOCPS) >> (soc * 8U);
+        prescale &= EPWM_ETSOCPS_SOCAPRD2_M;
+    }
+    else
+    {
+        prescale = Sim_EPWM_read(m, EPWM_O_ETPS) >> (soc * 4U);
+        prescale = (prescale & EPWM_ETPS_SOCAPRD_M) >> EPWM_ETPS_SOCAPRD_S;
+    }
+
+    if(prescale == 0U)
+    {
+        return;
+    }
+
+    m->socCount[soc]++;
+    if(m->socCount[soc] < prescale)
+    {
+        return;
+    }
+    m->socCount[soc] = 0U;
+
+    Sim_EPWM_write(m, EPWM_O_ETFLG, Sim_EPWM_read(m, EPWM_O_ETFLG) |
+                   ((soc == 0U) ? EPWM_ETFLG_SOCA : EPWM_ETFLG_SOCB));
+
+    index = (uint16_t)((m->base - EPWM1_BASE) / SIM_EPWM_BASE_STEP);
+    Sim_raiseTrigger((uint16_t)DMA_TRIGGER_EPWM1SOCA + (index * 2U) + soc);
+}
+
+static void
+Sim_EPWM_triggerEvents(Sim_EPWM_Module *m, uint16_t events)
+{
+    uint16_t etsel = Sim_EPWM_read(m, EPWM_O_ETSEL);
+    uint16_t etps = Sim_EPWM_read(m, EPWM_O_ETPS);
+    uint16_t prescale;
+    uint16_t index;
+
+    Sim_EPWM_triggerSOC(m, events, 0U);
+    Sim_EPWM_triggerSOC(m, events, 1U);
+
+    if(((etsel & EPWM_ETSEL_INTEN) == 0U) ||
+       ((events & Sim_EPWM_selEvents[etsel & EPWM_ETSEL_INTSEL_M]) == 0U))
+    {
+        return;
+    }
+
+    if((etps & EPWM_ETPS_INTPSSEL) != 0U)
+    {
+        prescale = Sim_EPWM_read(m, EPWM_O_ETINTPS) & EPWM_ETINTPS_INTPRD2_M;
+    }
+    else
+    {
+        prescale = etps & EPWM_ETPS_INTPRD_M;
+    }
+
+    if(prescale == 0U)
+    {
+        return;
+    }
+
+    if(m->etCount < prescale)
+    {
+        m->etCount++;
+    }
+
+    //
+    // While the flag is set the counter saturates and no further interrupt
+    // is generated until software clears it through ETCLR.
+    //
+    if((m->etCount >= prescale) && (m->etFlag == 0U))
+    {
+        m->etFlag = 1U;
+        m->etCount = 0U;
+        Sim_EPWM_write(m, EPWM_O_ETFLG,
+                       Sim_EPWM_read(m, EPWM_O_ETFLG) | EPWM_ETFLG_INT);
+
+        index = (uint16_t)((m->base - EPWM1_BASE) / SIM_EPWM_BASE_STEP);
+        Sim_raiseInterrupt(INT_EPWM1 + (index * SIM_EPWM_INT_STEP));
+    }
+}
+
+//*****************************************************************************
+//
+// Moves the counter to the next event point and processes it.
+//
+//*****************************************************************************
+static void
+Sim_EPWM_step(Sim_EPWM_Module *m)
+{
+    uint16_t mode = Sim_EPWM_getMode(m);
+    uint32_t ticks = Sim_EPWM_getTicksToNext(m);
+    uint16_t events = 0U;
+    uint16_t syncOutSelect;
+
+    m->time += (uint64_t)ticks * Sim_EPWM_getDivider(m);
+
+    if(mode == SIM_EPWM_MODE_UP)
+    {
+        if(m->ctr >= m->prd)
+        {
+            m->ctr = 0U;
+            events |= SIM_EPWM_EV_ZRO;
+            m->periods++;
+        }
+        else
+        {
+            m->ctr += (uint16_t)ticks;
+        }
+
+        events |= (m->ctr == m->cmpa) ? SIM_EPWM_EV_CAU : 0U;
+        events |= (m->ctr == m->cmpb) ? SIM_EPWM_EV_CBU : 0U;
+        events |= (m->ctr == m->prd) ? SIM_EPWM_EV_PRD : 0U;
+    }
+    else if(mode == SIM_EPWM_MODE_DOWN)
+    {
+        if(m->ctr == 0U)
+        {
+            m->ctr = m->prd;
+            events |= SIM_EPWM_EV_PRD;
+            m->periods++;
+        }
+        else
+        {
+            m->ctr -= (uint16_t)ticks;
+        }
+
+        events |= (m->ctr == m->cmpa) ? SIM_EPWM_EV_CAD : 0U;
+        events |= (m->ctr == m->cmpb) ? SIM_EPWM_EV_CBD : 0U;
+        events |= (m->ctr == 0U) ? SIM_EPWM_EV_ZRO : 0U;
+    }
+    else if(m->up)
+    {
+        if(m->ctr >= m->prd)
+        {
+            m->ctr--;
+            m->up = false;
+        }
+        else
+        {
+            m->ctr += (uint16_t)ticks;
+            events |= (m->ctr == m->cmpa) ? SIM_EPWM_EV_CAU : 0U;
+            events |= (m->ctr == m->cmpb) ? SIM_EPWM_EV_CBU : 0U;
+            if(m->ctr == m->prd)
+            {
+                events |= SIM_EPWM_EV_PRD;
+                m->up = false;
+            }
+        }
+    }
+    else
+    {
+        m->ctr -= (uint16_t)ticks;
+        events |= (m->ctr == m->cmpa) ? SIM_EPWM_EV_CAD : 0U;
+        events |= (m->ctr == m->cmpb) ? SIM_EPWM_EV_CBD : 0U;
+        if(m->ctr == 0U)
+        {
+            events |= SIM_EPWM_EV_ZRO;
+            m->up = true;
+            m->periods++;
+        }
+    }
+
+    Sim_EPWM_flushEdge(m, SIM_EPWM_OUTPUT_A, m->time << SIM_EPWM_FINE_S);
+    Sim_EPWM_flushEdge(m, SIM_EPWM_OUTPUT_B, m->time << SIM_EPWM_FINE_S);
+
+    if(events == 0U)
+    {
+        return;
+    }
+
+    Sim_EPWM_applyActions(m, mode, events);
+    if((events & SIM_EPWM_EV_PRD) != 0U)
+    {
+        Sim_EPWM_extendPeriod(m, mode);
+    }
+    Sim_EPWM_loadShadows(m, events, false);
+    Sim_EPWM_triggerEvents(m, events);
+
+    syncOutSelect = (Sim_EPWM_read(m, EPWM_O_TBCTL) & EPWM_TBCTL_SYNCOSEL_M) >>
+                    EPWM_TBCTL_SYNCOSEL_S;
+    if(((syncOutSelect == SIM_EPWM_SYNCO_ZRO) &&
+        ((events & SIM_EPWM_EV_ZRO) != 0U)) ||
+       ((syncOutSelect == SIM_EPWM_SYNCO_CMPB) &&
+        ((events & (SIM_EPWM_EV_CBU | SIM_EPWM_EV_CBD)) != 0U)))
+    {
+        Sim_EPWM_syncOut((uint16_t)((m->base - EPWM1_BASE) /
+                                    SIM_EPWM_BASE_STEP), m->time, 0U);
+    }
+}
+
+//*****************************************************************************
+//
+// Moves the counter to its position at cycle 'now'. No event lies between
+// m->time and 'now', so the counter simply moved linearly.
+//
+//*****************************************************************************
+static void
+Sim_EPWM_catchUp(Sim_EPWM_Module *m, uint64_t now)
+{
+    uint16_t mode = Sim_EPWM_getMode(m);
+    uint32_t divider;
+    uint64_t elapsed;
+
+    if(m->running && (now > m->time))
+    {
+        divider = Sim_EPWM_getDivider(m);
+        elapsed = (now - m->time) / divider;
+        if(elapsed != 0U)
+        {
+            if((mode == SIM_EPWM_MODE_DOWN) ||
+               ((mode == SIM_EPWM_MODE_UPDOWN) && !m->up))
+            {
+                m->ctr -= (uint16_t)elapsed;
+            }
+            else
+            {
+                m->ctr += (uint16_t)elapsed;
+            }
+            m->time += elapsed * divider;
+        }
+    }
+}
+
+//*****************************************************************************
+//
+// Brings the module state in line with the register file at cycle 'now':
+// picks up software writes and rebases the counter to 'now'.
+//
+//*****************************************************************************
+static void
+Sim_EPWM_refresh(Sim_EPWM_Module *m, uint64_t now)
+{
+    uint16_t mode = Sim_EPWM_getMode(m);
+    uint16_t tbctl;
+    uint16_t cmpctl;
+    uint16_t gldctl2;
+    uint16_t etclr;
+    bool running;
+
+    Sim_EPWM_catchUp(m, now);
+
+    //
+    // Software wrote TBCTR since it was last published
+    //
+    if(Sim_EPWM_read(m, EPWM_O_TBCTR) != m->publishedCtr)
+    {
+        m->ctr = Sim_EPWM_read(m, EPWM_O_TBCTR);
+        m->time = now;
+    }
+
+    //
+    // Write-1-to-clear of the interrupt and SOC flags
+    //
+    etclr = Sim_EPWM_read(m, EPWM_O_ETCLR);
+    if(etclr != 0U)
+    {
+        if((etclr & EPWM_ETCLR_INT) != 0U)
+        {
+            m->etFlag = 0U;
+        }
+        Sim_EPWM_write(m, EPWM_O_ETCLR, 0U);
+        Sim_EPWM_write(m, EPWM_O_ETFLG,
+                       Sim_EPWM_read(m, EPWM_O_ETFLG) &
+                       ~(etclr & (EPWM_ETCLR_INT | EPWM_ETCLR_SOCA |
+                                  EPWM_ETCLR_SOCB)));
+    }
+
+    //
+    // GLDCTL2 bits are strobes that read back as zero: OSHTLD arms the
+    // one-shot global load, GFRCLD forces a global load event now.
+    //
+    gldctl2 = Sim_EPWM_read(m, EPWM_O_GLDCTL2);
+    if(gldctl2 != 0U)
+    {
+        Sim_EPWM_write(m, EPWM_O_GLDCTL2, 0U);
+        if((gldctl2 & EPWM_GLDCTL2_OSHTLD) != 0U)
+        {
+            m->gldLatch = true;
+        }
+        if((gldctl2 & EPWM_GLDCTL2_GFRCLD) != 0U)
+        {
+            Sim_EPWM_loadShadows(m, 0U, true);
+        }
+    }
+
+    //
+    // Registers in immediate mode take effect as soon as they are written
+    //
+    tbctl = Sim_EPWM_read(m, EPWM_O_TBCTL);
+    cmpctl = Sim_EPWM_read(m, EPWM_O_CMPCTL);
+
+    if((tbctl & EPWM_TBCTL_PRDLD) != 0U)
+    {
+        Sim_EPWM_loadPeriod(m);
+    }
+    if((cmpctl & EPWM_CMPCTL_SHDWAMODE) != 0U)
+    {
+        Sim_EPWM_loadCompareA(m);
+    }
+    if((cmpctl & EPWM_CMPCTL_SHDWBMODE) != 0U)
+    {
+        Sim_EPWM_loadCompareB(m);
+    }
+
+    //
+    // While the counter is stopped it sits at a load point, so the active
+    // registers follow the shadows until it starts.
+    //
+    if(!m->running)
+    {
+        Sim_EPWM_loadPeriod(m);
+        Sim_EPWM_loadCompareA(m);
+        Sim_EPWM_loadCompareB(m);
+    }
+
+    //
+    // The counter runs once TBCLKSYNC is set and the mode is not freeze
+    //
+    running = ((Sim_readReg32(CPUSYS_BASE + SYSCTL_O_PCLKCR0) &
+                SIM_EPWM_TBCLKSYNC) != 0U) &&
+              (mode != SIM_EPWM_MODE_FREEZE) && (m->prd != 0U);
+
+    if(!running || !m->running)
+    {
+        m->time = now;
+    }
+    m->running = running;
+}
+
+static void
+Sim_EPWM_publish(Sim_EPWM_Module *m)
+{
+    m->publishedCtr = m->ctr;
+    Sim_EPWM_write(m, EPWM_O_TBCTR, m->ctr);
+    Sim_EPWM_write(m, EPWM_O_TBSTS,
+                   (Sim_EPWM_read(m, EPWM_O_TBSTS) & ~EPWM_TBSTS_CTRDIR) |
+                   (m->up ? EPWM_TBSTS_CTRDIR : 0U));
+    Sim_EPWM_write(m, EPWM_O_GLDCTL,
+                   (Sim_EPWM_read(m, EPWM_O_GLDCTL) & ~EPWM_GLDCTL_GLDCNT_M) |
+                   (m->gldCount << EPWM_GLDCTL_GLDCNT_S));
+}
+
+static inline void
+Sim_EPWM_updateNextTime(Sim_EPWM_Module *m)
+{
+    if(!m->running)
+    {
+        m->nextTime = UINT64_MAX;
+    }
+    else
+    {
+        m->nextTime = m->time + ((uint64_t)Sim_EPWM_getTicksToNext(m) *
+                                 Sim_EPWM_getDivider(m));
+    }
+}
+
+//*****************************************************************************
+//
+// Sync chain. ePWM1 has no sync input; ePWM4 and ePWM7 take theirs from
+// SYNCSELECT and every other module from the module before it. Sources
+// other than ePWM1, ePWM4 and ePWM7 are not modelled.
+//
+//*****************************************************************************
+static int16_t
+Sim_EPWM_getSyncSource(uint16_t index)
+{
+    uint32_t select = Sim_readReg32(SYNCSOC_BASE + SYSCTL_O_SYNCSELECT);
+    uint32_t source;
+
+    if(index == 0U)
+    {
+        return(-1);
+    }
+    else if(index == 3U)
+    {
+        source = (select & SYSCTL_SYNCSELECT_EPWM4SYNCIN_M) >>
+                 SYSCTL_SYNCSELECT_EPWM4SYNCIN_S;
+    }
+    else if(index == 6U)
+    {
+        source = (select & SYSCTL_SYNCSELECT_EPWM7SYNCIN_M) >>
+                 SYSCTL_SYNCSELECT_EPWM7SYNCIN_S;
+    }
+    else
+    {
+        return((int16_t)index - 1);
+    }
+
+    switch(source)
+    {
+        case SIM_EPWM_SYNC_EPWM1:
+            return(0);
+
+        case SIM_EPWM_SYNC_EPWM4:
+            return(3);
+
+        case SIM_EPWM_SYNC_EPWM7:
+            return(6);
+
+        default:
+            return(-1);
+    }
+}
+
+//
+// A sync pulse reaches a module at 'time': events due at that cycle come
+// first, then the counter loads TBPHS and, counting up-down, the direction
+// of PHSDIR. A module passing its input on sends the pulse further down the
+// chain; 'visited' stops a pulse that comes back round.
+//
+static void
+Sim_EPWM_syncIn(uint16_t index, uint64_t time, uint16_t visited)
+{
+    Sim_EPWM_Module *m = &Sim_EPWM_modules[index];
+    uint16_t tbctl;
+
+    while(m->nextTime <= time)
+    {
+        Sim_EPWM_step(m);
+        Sim_EPWM_updateNextTime(m);
+    }
+
+    tbctl = Sim_EPWM_read(m, EPWM_O_TBCTL);
+    if(m->running && ((tbctl & EPWM_TBCTL_PHSEN) != 0U))
+    {
+        Sim_EPWM_catchUp(m, time);
+        m->ctr = (uint16_t)(Sim_readReg32(m->base + EPWM_O_TBPHS) >>
+                            EPWM_TBPHS_TBPHS_S);
+        m->time = time;
+        if(Sim_EPWM_getMode(m) == SIM_EPWM_MODE_UPDOWN)
+        {
+            m->up = (tbctl & EPWM_TBCTL_PHSDIR) != 0U;
+        }
+        Sim_EPWM_publish(m);
+        Sim_EPWM_updateNextTime(m);
+    }
+
+    if(((tbctl & EPWM_TBCTL_SYNCOSEL_M) >> EPWM_TBCTL_SYNCOSEL_S) ==
+       SIM_EPWM_SYNCO_SYNCI)
+    {
+        Sim_EPWM_syncOut(index, time, visited | (1U << index));
+    }
+}
+
+static void
+Sim_EPWM_syncOut(uint16_t source, uint64_t time, uint16_t visited)
+{
+    uint16_t i;
+
+    visited |= 1U << source;
+    for(i = 0U; i < SIM_EPWM_NUM_MODULES; i++)
+    {
+        if(((visited & (1U << i)) == 0U) &&
+           (Sim_EPWM_getSyncSource(i) == (int16_t)source))
+        {
+            Sim_EPWM_syncIn(i, time, visited);
+        }
+    }
+}
+
+//*****************************************************************************
+//
+// Sim_Model callbacks. Modules are only re-read from the register file when
+// software has touched them (dirty), everything else runs from the cached
+// time of the next event.
+//
+//*****************************************************************************
+static uint64_t
+Sim_EPWM_nextEvent(void)
+{
+    Sim_EPWM_Module *m;
+    uint64_t next = UINT64_MAX;
+    uint16_t i;
+
+    for(i = 0U; i < SIM_EPWM_NUM_MODULES; i++)
+    {
+        m = &Sim_EPWM_modules[i];
+        if(m->dirty)
+        {
+            m->dirty = false;
+            Sim_EPWM_refresh(m, Sim_getCycles());
+            Sim_EPWM_updateNextTime(m);
+        }
+
+        if(m->nextTime < next)
+        {
+            next = m->nextTime;
+        }
+    }
+
+    return(next);
+}
+
+static void
+Sim_EPWM_advance(uint64_t cycle)
+{
+    Sim_EPWM_Module *m;
+    uint16_t i;
+
+    for(i = 0U; i < SIM_EPWM_NUM_MODULES; i++)
+    {
+        m = &Sim_EPWM_modules[i];
+        while(m->nextTime <= cycle)
+        {
+            Sim_EPWM_step(m);
+            Sim_EPWM_updateNextTime(m);
+        }
+    }
+}
+
+static void
+Sim_EPWM_reset(void)
+{
+    Sim_EPWM_Module *m;
+    uint16_t i;
+
+    memset(Sim_EPWM_modules, 0, sizeof(Sim_EPWM_modules));
+
+    for(i = 0U; i < SIM_EPWM_NUM_MODULES; i++)
+    {
+        m = &Sim_EPWM_modules[i];
+        m->base = EPWM1_BASE + ((uint32_t)i * SIM_EPWM_BASE_STEP);
+        m->up = true;
+        m->dirty = true;
+        m->nextTime = UINT64_MAX;
+        Sim_EPWM_write(m, EPWM_O_TBCTL, SIM_EPWM_TBCTL_RESET);
+    }
+}
+
+//*****************************************************************************
+//
+// Access handlers. Before software touches a module its counter is brought
+// up to the current time so that TBCTR, TBSTS and ETFLG read back live
+// values; the module is then marked dirty so that whatever software writes
+// is picked up before the next event is scheduled. TBCLKSYNC lives in the
+// CPU system registers and affects every module.
+//
+//*****************************************************************************
+static void
+Sim_EPWM_accessHandler(uint32_t address)
+{
+    Sim_EPWM_Module *m;
+    uint32_t index = (address - EPWM1_BASE) / SIM_EPWM_BASE_STEP;
+
+    if(index < SIM_EPWM_NUM_MODULES)
+    {
+        m = &Sim_EPWM_modules[index];
+        Sim_EPWM_refresh(m, Sim_getCycles());
+        Sim_EPWM_publish(m);
+        m->dirty = true;
+    }
+}
+
+static void
+Sim_EPWM_sysAccessHandler(uint32_t address)
+{
+    uint16_t i;
+
+    (void)address;
+
+    for(i = 0U; i < SIM_EPWM_NUM_MODULES; i++)
+    {
+        Sim_EPWM_refresh(&Sim_EPWM_modules[i], Sim_getCycles());
+        Sim_EPWM_modules[i].dirty = true;
+    }
+}
+
+//*****************************************************************************
+//
+// Sim_EPWM_init
+//
+//*****************************************************************************
+void
+Sim_EPWM_init(void)
+{
+    Sim_EPWM_reset();
+    Sim_registerModel(&Sim_EPWM_model);
+    Sim_attachHandler(EPWM1_BASE,
+                      EPWM1_BASE +
+                      (SIM_EPWM_NUM_MODULES * SIM_EPWM_BASE_STEP) - 1U,
+                      Sim_EPWM_accessHandler);
+    Sim_attachHandler(CPUSYS_BASE + SYSCTL_O_PCLKCR0,
+                      CPUSYS_BASE + SYSCTL_O_PCLKCR0 + 1U,
+                      Sim_EPWM_sysAccessHandler);
+}
+
+//*****************************************************************************
+//
+// Sim_EPWM_getOutputStats
+//
+//*****************************************************************************
+const Sim_EPWM_OutputStats *
+Sim_EPWM_getOutputStats(uint32_t base, uint16_t output)
+{
+    uint32_t index = (base - EPWM1_BASE) / SIM_EPWM_BASE_STEP;
+
+    return(&Sim_EPWM_modules[index].outputs[output & 0x1U]);
+}
+
+//*****************************************************************************
+//
+// Sim_EPWM_getPeriodCount
+//
+//*****************************************************************************
+uint64_t
+Sim_EPWM_getPeriodCount(uint32_t base)
+{
+    return(Sim_EPWM_modules[(base - EPWM1_BASE) / SIM_EPWM_BASE_STEP].periods);
+}
+
+//*****************************************************************************
+//
+// Sim_EPWM_getActiveValues
+//
+//*****************************************************************************
+void
+Sim_EPWM_getActiveValues(uint32_t base, uint16_t *tbprd, uint16_t *cmpa,
+                         uint16_t *cmpb)
+{
+    const Sim_EPWM_Module *m;
+
+    m = &Sim_EPWM_modules[(base - EPWM1_BASE) / SIM_EPWM_BASE_STEP];
+
+    if(tbprd != NULL)
+    {
+        *tbprd = m->prd;
+    }
+    if(cmpa != NULL)
+    {
+        *cmpa = m->cmpa;
+    }
+    if(cmpb != NULL)
+    {
+        *cmpb = m->cmpb;
+    }
+}
+
+//*****************************************************************************
+//
+// Sim_EPWM_setEdgeCallback
+//
+//*****************************************************************************
+void
+Sim_EPWM_setEdgeCallback(Sim_EPWM_EdgeCallback callback)
+{
+    Sim_EPWM_edgeCallback = callback;
+}
+
+//*****************************************************************************
+//
+// Sim_EPWM_setMEPSteps
+//
+//*****************************************************************************
+void
+Sim_EPWM_setMEPSteps(uint32_t steps)
+{
+    Sim_EPWM_mepSteps = steps;
+}
+
+//*****************************************************************************
+//
+// Sim_EPWM_getMEPSteps
+//
+//*****************************************************************************
+uint32_t
+Sim_EPWM_getMEPSteps(void)
+{
+    return(Sim_EPWM_mepSteps);
+}
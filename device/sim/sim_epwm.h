@@ -0,0 +1,240 @@
+//###########################################################################
+//
+// FILE:   sim_epwm.h
+//
+// TITLE:  Cycle-approximate ePWM model for the host simulator.
+//
+//###########################################################################
+//
+// Models the time-base counter (up, down and up-down), shadow-to-active
+// transfers of TBPRD/CMPA/CMPB, individually or through the global load
+// strobe (including its prescaler and one-shot mode), the action qualifier
+// outputs for ePWMxA/B and the event-trigger interrupt and SOCA/SOCB
+// pulses with their prescalers for ePWM1-8. SOC pulses are raised on the
+// simulator trigger network (see Sim_raiseTrigger()).
+//
+// The model is event driven: it jumps straight from one counter match to the
+// next instead of ticking every TBCLK, so millions of PWM periods can be
+// simulated per second of host time.
+//
+// High-resolution duty and period control is modelled as well: CMPAHR,
+// CMPBHR and TBPRDHR load together with their integer registers, and the
+// micro edge positioner (MEP) moves the edges it controls by a whole number
+// of MEP steps. The MEP step size of the simulated silicon is set with
+// Sim_EPWM_setMEPSteps(); auto-conversion uses the scale factor software
+// wrote to HRMSTEP of ePWM1, so a stale calibration shows up as an error in
+// the edge positions. These fine edge times are reported next to the SYSCLK
+// edge times in Sim_EPWM_OutputStats.
+//
+// The dead-band submodule sits between the action qualifier and the
+// statistics: its input selection, rising and falling-edge delays,
+// polarity and output routing (DBCTL OUT_MODE, POLSEL, IN_MODE), half-cycle
+// clocking and the high-resolution delays through the MEP. A pulse shorter
+// than its delay is swallowed as on the silicon. Delayed edges carry their
+// own times, but reach the edge callback only with the next counter event
+// of the module.
+//
+// The sync chain links the modules as on the silicon: ePWM4 and ePWM7 take
+// their sync input from SYNCSELECT, every other module from the module
+// before it. A module sends a sync pulse on counter zero or CMPB, or passes
+// its input on, as TBCTL[SYNCOSEL] selects. With PHSEN set a sync pulse
+// loads TBPHS into the counter, and in up-down mode PHSDIR into its
+// direction, in the cycle of the pulse.
+//
+// Not modelled: dead-band shadow loads and output swap, chopper, trip
+// zones, digital compare, CMPC/CMPD, sync pulses from software, eCAP or
+// external pins, sync-triggered global loads, TBPHSHR, separate HRLOAD
+// events and software forcing.
+//
+//###########################################################################
+
+#ifndef SIM_EPWM_H
+#define SIM_EPWM_H
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "sim.h"
+
+//*****************************************************************************
+//
+// Number of ePWM modules modelled and the distance between their bases.
+//
+//*****************************************************************************
+#define SIM_EPWM_NUM_MODULES    8U
+#define SIM_EPWM_BASE_STEP      0x100U
+
+//*****************************************************************************
+//
+// Values that can be passed to Sim_EPWM_getOutputStats() as the output
+// parameter.
+//
+//*****************************************************************************
+#define SIM_EPWM_OUTPUT_A       0U
+#define SIM_EPWM_OUTPUT_B       1U
+
+//*****************************************************************************
+//
+// Fine edge times are in units of 2^-SIM_EPWM_FINE_S SYSCLK cycles.
+//
+//*****************************************************************************
+#define SIM_EPWM_FINE_S         16U
+#define SIM_EPWM_FINE_ONE       (1UL << SIM_EPWM_FINE_S)
+
+//*****************************************************************************
+//
+// MEP steps per SYSCLK cycle of the simulated silicon after reset, Q8: a
+// 150 ps step at a 100 MHz SYSCLK.
+//
+//*****************************************************************************
+#define SIM_EPWM_MEP_STEPS_DEFAULT  17067UL
+
+//*****************************************************************************
+//
+//! Edge statistics of one ePWM output. Times are in SYSCLK cycles, fine
+//! times in 2^-SIM_EPWM_FINE_S SYSCLK cycles and include the MEP delays.
+//
+//*****************************************************************************
+typedef struct
+{
+    uint16_t level;         //!< Current output level
+    uint32_t edges;         //!< Number of edges seen since reset
+    uint64_t lastRise;      //!< Cycle of the most recent rising edge
+    uint64_t lastFall;      //!< Cycle of the most recent falling edge
+    uint64_t period;        //!< Rising edge to rising edge of last cycle
+    uint64_t highTime;      //!< High time of the last complete pulse
+    uint64_t minHighTime;   //!< Shortest high pulse seen since reset
+    uint64_t minLowTime;    //!< Shortest low pulse seen since reset
+    uint64_t fineRise;      //!< Fine time of the most recent rising edge
+    uint64_t fineFall;      //!< Fine time of the most recent falling edge
+    uint64_t finePeriod;    //!< Fine rising edge to rising edge
+    uint64_t fineHighTime;  //!< Fine high time of the last complete pulse
+} Sim_EPWM_OutputStats;
+
+//*****************************************************************************
+//
+//! Prototype of an optional edge callback.
+//!
+//! \param base is the ePWM base address.
+//! \param output is SIM_EPWM_OUTPUT_A or SIM_EPWM_OUTPUT_B.
+//! \param level is the new output level.
+//! \param cycle is the simulated SYSCLK cycle of the edge.
+//
+//*****************************************************************************
+typedef void (*Sim_EPWM_EdgeCallback)(uint32_t base, uint16_t output,
+                                      uint16_t level, uint64_t cycle);
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+//*****************************************************************************
+//
+//! Attaches the ePWM model to the simulator.
+//!
+//! Registers the model with Sim_registerModel() and hooks the ePWM register
+//! pages so that TBCTR, TBSTS and ETFLG read back live values. Call once
+//! before Sim_reset().
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+Sim_EPWM_init(void);
+
+//*****************************************************************************
+//
+//! Returns the edge statistics of an ePWM output.
+//!
+//! \param base is the ePWM base address.
+//! \param output is SIM_EPWM_OUTPUT_A or SIM_EPWM_OUTPUT_B.
+//!
+//! \return Returns a pointer to the statistics.
+//
+//*****************************************************************************
+extern const Sim_EPWM_OutputStats *
+Sim_EPWM_getOutputStats(uint32_t base, uint16_t output);
+
+//*****************************************************************************
+//
+//! Returns the number of time-base periods completed by a module.
+//!
+//! \param base is the ePWM base address.
+//
+//*****************************************************************************
+extern uint64_t
+Sim_EPWM_getPeriodCount(uint32_t base);
+
+//*****************************************************************************
+//
+//! Returns the active (not shadow) period and compare values of a module.
+//!
+//! \param base is the ePWM base address.
+//! \param tbprd, cmpa, cmpb receive the active values. Any may be NULL.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+Sim_EPWM_getActiveValues(uint32_t base, uint16_t *tbprd, uint16_t *cmpa,
+                         uint16_t *cmpb);
+
+//*****************************************************************************
+//
+//! Installs a callback that is invoked on every ePWM output edge.
+//!
+//! \param callback is the callback, or NULL to remove it.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+Sim_EPWM_setEdgeCallback(Sim_EPWM_EdgeCallback callback);
+
+//*****************************************************************************
+//
+//! Sets the MEP step size of the simulated silicon.
+//!
+//! \param steps is the number of MEP steps per SYSCLK cycle in Q8.
+//!
+//! The step size of real silicon drifts with temperature and voltage; this
+//! lets a test move it and check that calibration follows. The setting
+//! survives Sim_reset().
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+Sim_EPWM_setMEPSteps(uint32_t steps);
+
+//*****************************************************************************
+//
+//! Returns the MEP step size of the simulated silicon.
+//!
+//! \return Returns the number of MEP steps per SYSCLK cycle in Q8.
+//
+//*****************************************************************************
+extern uint32_t
+Sim_EPWM_getMEPSteps(void);
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SIM_EPWM_H
@@ -0,0 +1,564 @@
+//###########################################################################
+//
+// FILE:   sim_sci.c
+//
+// TITLE:  SCI model with FIFOs for the host simulator.
+//
+//###########################################################################
+
+#include <string.h>
+#include "sim_sci.h"
+#include "driverlib.h"
+
+//
+// FIFO register values after reset
+//
+#define SIM_SCI_FFTX_RESET      0xA000U
+#define SIM_SCI_FFRX_RESET      0x201FU
+
+//
+// Distance between the SCI ports
+//
+#define SIM_SCI_BASE_STEP       (SCIB_BASE - SCIA_BASE)
+
+typedef struct
+{
+    uint32_t base;
+    uint32_t rxInterrupt;
+    uint32_t txInterrupt;
+    bool dirty;
+    bool txPending;
+
+    uint16_t txFifo[SIM_SCI_FIFO_DEPTH];
+    uint16_t txHead;
+    uint16_t txCount;
+    bool txBusy;
+    uint16_t txShift;
+    uint64_t txDoneTime;
+
+    uint16_t rxFifo[SIM_SCI_FIFO_DEPTH];
+    uint16_t rxHead;
+    uint16_t rxCount;
+    bool rxOverflow;
+
+    uint16_t rxQueue[SIM_SCI_RX_QUEUE_SIZE];
+    uint16_t rxQueueHead;
+    uint16_t rxQueueCount;
+    uint64_t rxNextTime;
+
+    bool txFlag;
+    bool rxFlag;
+    bool txLine;
+    bool rxLine;
+
+    Sim_SCI_Stats stats;
+} Sim_SCI_Port;
+
+static Sim_SCI_Port Sim_SCI_ports[SIM_SCI_NUM_PORTS];
+static Sim_SCI_TxCallback Sim_SCI_txCallback;
+
+static uint64_t Sim_SCI_nextEvent(void);
+static void Sim_SCI_advance(uint64_t cycle);
+static void Sim_SCI_reset(void);
+
+static Sim_Model Sim_SCI_model =
+{
+    Sim_SCI_nextEvent,
+    Sim_SCI_advance,
+    Sim_SCI_reset,
+    NULL
+};
+
+//*****************************************************************************
+//
+// Register helpers
+//
+//*****************************************************************************
+static inline uint16_t
+Sim_SCI_read(const Sim_SCI_Port *p, uint32_t offset)
+{
+    return(Sim_readReg16(p->base + offset));
+}
+
+static inline void
+Sim_SCI_write(const Sim_SCI_Port *p, uint32_t offset, uint16_t value)
+{
+    Sim_writeReg16(p->base + offset, value);
+}
+
+static inline Sim_SCI_Port *
+Sim_SCI_getPort(uint32_t base)
+{
+    return(&Sim_SCI_ports[((base - SCIA_BASE) / SIM_SCI_BASE_STEP) &
+                         (SIM_SCI_NUM_PORTS - 1U)]);
+}
+
+//
+// The channels run when neither SWRESET nor SCIRST hold them in reset
+//
+static inline bool
+Sim_SCI_isTxEnabled(const Sim_SCI_Port *p)
+{
+    return(((Sim_SCI_read(p, SCI_O_CTL1) &
+             (SCI_CTL1_SWRESET | SCI_CTL1_TXENA)) ==
+            (SCI_CTL1_SWRESET | SCI_CTL1_TXENA)) &&
+           ((Sim_SCI_read(p, SCI_O_FFTX) &
+             (SCI_FFTX_SCIRST | SCI_FFTX_TXFIFORESET)) ==
+            (SCI_FFTX_SCIRST | SCI_FFTX_TXFIFORESET)));
+}
+
+static inline bool
+Sim_SCI_isRxEnabled(const Sim_SCI_Port *p)
+{
+    return(((Sim_SCI_read(p, SCI_O_CTL1) &
+             (SCI_CTL1_SWRESET | SCI_CTL1_RXENA)) ==
+            (SCI_CTL1_SWRESET | SCI_CTL1_RXENA)) &&
+           ((Sim_SCI_read(p, SCI_O_FFTX) & SCI_FFTX_SCIRST) != 0U) &&
+           ((Sim_SCI_read(p, SCI_O_FFRX) & SCI_FFRX_RXFIFORESET) != 0U));
+}
+
+//*****************************************************************************
+//
+// SYSCLK cycles per character: start bit, data bits, optional parity and
+// one or two stop bits, each lasting 8 * (BRR + 1) LSPCLK cycles.
+//
+//*****************************************************************************
+static uint64_t
+Sim_SCI_getCharTime(const Sim_SCI_Port *p)
+{
+    uint16_t ccr = Sim_SCI_read(p, SCI_O_CCR);
+    uint32_t brr = ((uint32_t)Sim_SCI_read(p, SCI_O_HBAUD) << 8U) |
+                   Sim_SCI_read(p, SCI_O_LBAUD);
+    uint16_t lspDiv = Sim_readReg16(CLKCFG_BASE + SYSCTL_O_LOSPCP) &
+                      SYSCTL_LOSPCP_LSPCLKDIV_M;
+    uint32_t bits;
+
+    bits = 1U + ((ccr & SCI_CCR_SCICHAR_M) + 1U) +
+           (((ccr & SCI_CCR_PARITYENA) != 0U) ? 1U : 0U) +
+           (((ccr & SCI_CCR_STOPBITS) != 0U) ? 2U : 1U);
+
+    return((uint64_t)bits * 8U * (brr + 1U) *
+           ((lspDiv == 0U) ? 1U : (2U * lspDiv)));
+}
+
+//*****************************************************************************
+//
+// Receive FIFO
+//
+//*****************************************************************************
+static void
+Sim_SCI_pushRx(Sim_SCI_Port *p, uint16_t data)
+{
+    if(!Sim_SCI_isRxEnabled(p))
+    {
+        return;
+    }
+
+    if(p->rxCount == SIM_SCI_FIFO_DEPTH)
+    {
+        p->rxOverflow = true;
+        p->stats.rxOverflows++;
+        return;
+    }
+
+    p->rxFifo[(p->rxHead + p->rxCount) % SIM_SCI_FIFO_DEPTH] = data;
+    p->rxCount++;
+    p->stats.rxChars++;
+}
+
+//*****************************************************************************
+//
+// Starts shifting out the next character if the transmitter is idle
+//
+//*****************************************************************************
+static void
+Sim_SCI_startTx(Sim_SCI_Port *p, uint64_t now)
+{
+    if(p->txBusy || (p->txCount == 0U) || !Sim_SCI_isTxEnabled(p))
+    {
+        return;
+    }
+
+    p->txShift = p->txFifo[p->txHead];
+    p->txHead = (p->txHead + 1U) % SIM_SCI_FIFO_DEPTH;
+    p->txCount--;
+    p->txBusy = true;
+    p->txDoneTime = now + Sim_SCI_getCharTime(p);
+}
+
+//*****************************************************************************
+//
+// Evaluates the FIFO level conditions and raises the PIE interrupts on a
+// rising edge of (flag && enable), then mirrors the state into the status
+// bits software reads.
+//
+//*****************************************************************************
+static void
+Sim_SCI_update(Sim_SCI_Port *p)
+{
+    uint16_t fftx = Sim_SCI_read(p, SCI_O_FFTX);
+    uint16_t ffrx = Sim_SCI_read(p, SCI_O_FFRX);
+    uint16_t ctl2;
+    uint16_t rxst;
+    bool line;
+
+    if(p->txCount <= (fftx & SCI_FFTX_TXFFIL_M))
+    {
+        p->txFlag = true;
+    }
+    if(p->rxCount >= (ffrx & SCI_FFRX_RXFFIL_M))
+    {
+        p->rxFlag = true;
+    }
+
+    line = p->txFlag && ((fftx & SCI_FFTX_TXFFIENA) != 0U);
+    if(line && !p->txLine)
+    {
+        Sim_raiseInterrupt(p->txInterrupt);
+    }
+    p->txLine = line;
+
+    line = p->rxFlag && ((ffrx & SCI_FFRX_RXFFIENA) != 0U);
+    if(line && !p->rxLine)
+    {
+        Sim_raiseInterrupt(p->rxInterrupt);
+    }
+    p->rxLine = line;
+
+    fftx &= ~(SCI_FFTX_TXFFST_M | SCI_FFTX_TXFFINT);
+    fftx |= (uint16_t)(p->txCount << SCI_FFTX_TXFFST_S) |
+            (p->txFlag ? SCI_FFTX_TXFFINT : 0U);
+    Sim_SCI_write(p, SCI_O_FFTX, fftx);
+
+    ffrx &= ~(SCI_FFRX_RXFFST_M | SCI_FFRX_RXFFINT | SCI_FFRX_RXFFOVF);
+    ffrx |= (uint16_t)(p->rxCount << SCI_FFRX_RXFFST_S) |
+            (p->rxFlag ? SCI_FFRX_RXFFINT : 0U) |
+            (p->rxOverflow ? SCI_FFRX_RXFFOVF : 0U);
+    Sim_SCI_write(p, SCI_O_FFRX, ffrx);
+
+    ctl2 = Sim_SCI_read(p, SCI_O_CTL2) &
+           ~(SCI_CTL2_TXRDY | SCI_CTL2_TXEMPTY);
+    if(p->txCount < SIM_SCI_FIFO_DEPTH)
+    {
+        ctl2 |= SCI_CTL2_TXRDY;
+    }
+    if((p->txCount == 0U) && !p->txBusy)
+    {
+        ctl2 |= SCI_CTL2_TXEMPTY;
+    }
+    Sim_SCI_write(p, SCI_O_CTL2, ctl2);
+
+    rxst = Sim_SCI_read(p, SCI_O_RXST) & ~SCI_RXST_RXRDY;
+    Sim_SCI_write(p, SCI_O_RXST,
+                  rxst | ((p->rxCount != 0U) ? SCI_RXST_RXRDY : 0U));
+}
+
+//*****************************************************************************
+//
+// Picks up what software wrote since the last access: the pending SCITXBUF
+// write, the write-1-to-clear bits and the FIFO/channel resets.
+//
+//*****************************************************************************
+static void
+Sim_SCI_refresh(Sim_SCI_Port *p, uint64_t now)
+{
+    uint16_t fftx;
+    uint16_t ffrx;
+
+    if(p->txPending)
+    {
+        p->txPending = false;
+        if(Sim_SCI_isTxEnabled(p) && (p->txCount < SIM_SCI_FIFO_DEPTH))
+        {
+            p->txFifo[(p->txHead + p->txCount) % SIM_SCI_FIFO_DEPTH] =
+                Sim_SCI_read(p, SCI_O_TXBUF) & SCI_TXBUF_TXDT_M;
+            p->txCount++;
+        }
+        else
+        {
+            p->stats.txDropped++;
+        }
+    }
+
+    fftx = Sim_SCI_read(p, SCI_O_FFTX);
+    if((fftx & SCI_FFTX_TXFFINTCLR) != 0U)
+    {
+        p->txFlag = false;
+        p->txLine = false;
+        fftx &= ~SCI_FFTX_TXFFINTCLR;
+    }
+    if((fftx & SCI_FFTX_TXFIFORESET) == 0U)
+    {
+        p->txCount = 0U;
+    }
+    if((fftx & SCI_FFTX_SCIRST) == 0U)
+    {
+        p->txCount = 0U;
+        p->rxCount = 0U;
+        p->txBusy = false;
+    }
+    Sim_SCI_write(p, SCI_O_FFTX, fftx);
+
+    ffrx = Sim_SCI_read(p, SCI_O_FFRX);
+    if((ffrx & SCI_FFRX_RXFFINTCLR) != 0U)
+    {
+        p->rxFlag = false;
+        p->rxLine = false;
+        ffrx &= ~SCI_FFRX_RXFFINTCLR;
+    }
+    if((ffrx & SCI_FFRX_RXFFOVRCLR) != 0U)
+    {
+        p->rxOverflow = false;
+        ffrx &= ~SCI_FFRX_RXFFOVRCLR;
+    }
+    if((ffrx & SCI_FFRX_RXFIFORESET) == 0U)
+    {
+        p->rxCount = 0U;
+    }
+    Sim_SCI_write(p, SCI_O_FFRX, ffrx);
+
+    if((Sim_SCI_read(p, SCI_O_CTL1) & SCI_CTL1_SWRESET) == 0U)
+    {
+        p->txBusy = false;
+        p->rxOverflow = false;
+    }
+
+    Sim_SCI_startTx(p, now);
+    Sim_SCI_update(p);
+}
+
+//*****************************************************************************
+//
+// Time of the next character boundary of a port
+//
+//*****************************************************************************
+static inline uint64_t
+Sim_SCI_getNextTime(const Sim_SCI_Port *p)
+{
+    uint64_t next = UINT64_MAX;
+
+    if(p->txBusy)
+    {
+        next = p->txDoneTime;
+    }
+    if((p->rxQueueCount != 0U) && (p->rxNextTime < next))
+    {
+        next = p->rxNextTime;
+    }
+
+    return(next);
+}
+
+//*****************************************************************************
+//
+// Sim_Model callbacks
+//
+//*****************************************************************************
+static uint64_t
+Sim_SCI_nextEvent(void)
+{
+    Sim_SCI_Port *p;
+    uint64_t next = UINT64_MAX;
+    uint64_t event;
+    uint16_t i;
+
+    for(i = 0U; i < SIM_SCI_NUM_PORTS; i++)
+    {
+        p = &Sim_SCI_ports[i];
+        if(p->dirty)
+        {
+            p->dirty = false;
+            Sim_SCI_refresh(p, Sim_getCycles());
+        }
+
+        event = Sim_SCI_getNextTime(p);
+        if(event < next)
+        {
+            next = event;
+        }
+    }
+
+    return(next);
+}
+
+static void
+Sim_SCI_advance(uint64_t cycle)
+{
+    Sim_SCI_Port *p;
+    uint16_t data;
+    uint16_t i;
+
+    for(i = 0U; i < SIM_SCI_NUM_PORTS; i++)
+    {
+        p = &Sim_SCI_ports[i];
+        while(Sim_SCI_getNextTime(p) <= cycle)
+        {
+            if(p->txBusy && (p->txDoneTime <= cycle) &&
+               ((p->rxQueueCount == 0U) || (p->txDoneTime <= p->rxNextTime)))
+            {
+                p->txBusy = false;
+                p->stats.txChars++;
+                p->stats.lastTxCycle = p->txDoneTime;
+
+                if((Sim_SCI_read(p, SCI_O_CCR) & SCI_CCR_LOOPBKENA) != 0U)
+                {
+                    Sim_SCI_pushRx(p, p->txShift);
+                }
+                else if(Sim_SCI_txCallback != NULL)
+                {
+                    Sim_SCI_txCallback(p->base, p->txShift, p->txDoneTime);
+                }
+
+                Sim_SCI_startTx(p, p->txDoneTime);
+            }
+            else
+            {
+                data = p->rxQueue[p->rxQueueHead];
+                p->rxQueueHead = (p->rxQueueHead + 1U) % SIM_SCI_RX_QUEUE_SIZE;
+                p->rxQueueCount--;
+                Sim_SCI_pushRx(p, data);
+
+                if(p->rxQueueCount != 0U)
+                {
+                    p->rxNextTime += Sim_SCI_getCharTime(p);
+                }
+            }
+
+            Sim_SCI_update(p);
+        }
+    }
+}
+
+static void
+Sim_SCI_reset(void)
+{
+    Sim_SCI_Port *p;
+    uint16_t i;
+
+    memset(Sim_SCI_ports, 0, sizeof(Sim_SCI_ports));
+
+    for(i = 0U; i < SIM_SCI_NUM_PORTS; i++)
+    {
+        p = &Sim_SCI_ports[i];
+        p->base = SCIA_BASE + ((uint32_t)i * SIM_SCI_BASE_STEP);
+        p->rxInterrupt = (i == 0U) ? INT_SCIA_RX : INT_SCIB_RX;
+        p->txInterrupt = (i == 0U) ? INT_SCIA_TX : INT_SCIB_TX;
+        p->dirty = true;
+        Sim_SCI_write(p, SCI_O_FFTX, SIM_SCI_FFTX_RESET);
+        Sim_SCI_write(p, SCI_O_FFRX, SIM_SCI_FFRX_RESET);
+    }
+}
+
+//*****************************************************************************
+//
+// Access handler. Status is brought up to date before software reads it; a
+// read of SCIRXBUF pops the receive FIFO and a write of SCITXBUF is queued
+// once the write has landed, on the next access or simulation step.
+//
+//*****************************************************************************
+static void
+Sim_SCI_accessHandler(uint32_t address)
+{
+    Sim_SCI_Port *p;
+    uint32_t offset;
+
+    if((address < SCIA_BASE) ||
+       (address >= (SCIA_BASE + (SIM_SCI_NUM_PORTS * SIM_SCI_BASE_STEP))))
+    {
+        return;
+    }
+
+    p = Sim_SCI_getPort(address);
+    offset = address - p->base;
+
+    Sim_SCI_refresh(p, Sim_getCycles());
+
+    if((offset == SCI_O_RXBUF) && (p->rxCount != 0U))
+    {
+        Sim_SCI_write(p, SCI_O_RXBUF, p->rxFifo[p->rxHead]);
+        p->rxHead = (p->rxHead + 1U) % SIM_SCI_FIFO_DEPTH;
+        p->rxCount--;
+        Sim_SCI_update(p);
+    }
+    else if(offset == SCI_O_TXBUF)
+    {
+        p->txPending = true;
+    }
+
+    p->dirty = true;
+}
+
+//*****************************************************************************
+//
+// Sim_SCI_init
+//
+//*****************************************************************************
+void
+Sim_SCI_init(void)
+{
+    Sim_SCI_reset();
+    Sim_registerModel(&Sim_SCI_model);
+    Sim_attachHandler(SCIA_BASE,
+                      SCIA_BASE + (SIM_SCI_NUM_PORTS * SIM_SCI_BASE_STEP) - 1U,
+                      Sim_SCI_accessHandler);
+}
+
+//*****************************************************************************
+//
+// Sim_SCI_receive
+//
+//*****************************************************************************
+uint16_t
+Sim_SCI_receive(uint32_t base, const uint16_t *data, uint16_t length)
+{
+    Sim_SCI_Port *p = Sim_SCI_getPort(base);
+    uint16_t i;
+
+    for(i = 0U; (i < length) && (p->rxQueueCount < SIM_SCI_RX_QUEUE_SIZE);
+        i++)
+    {
+        if(p->rxQueueCount == 0U)
+        {
+            p->rxNextTime = Sim_getCycles() + Sim_SCI_getCharTime(p);
+        }
+
+        p->rxQueue[(p->rxQueueHead + p->rxQueueCount) %
+                   SIM_SCI_RX_QUEUE_SIZE] = data[i] & SCI_RXBUF_SAR_M;
+        p->rxQueueCount++;
+    }
+
+    return(i);
+}
+
+//*****************************************************************************
+//
+// Sim_SCI_getCharCycles
+//
+//*****************************************************************************
+uint64_t
+Sim_SCI_getCharCycles(uint32_t base)
+{
+    return(Sim_SCI_getCharTime(Sim_SCI_getPort(base)));
+}
+
+//*****************************************************************************
+//
+// Sim_SCI_getStats
+//
+//*****************************************************************************
+const Sim_SCI_Stats *
+Sim_SCI_getStats(uint32_t base)
+{
+    return(&Sim_SCI_getPort(base)->stats);
+}
+
+//*****************************************************************************
+//
+// Sim_SCI_setTxCallback
+//
+//*****************************************************************************
+void
+Sim_SCI_setTxCallback(Sim_SCI_TxCallback callback)
+{
+    Sim_SCI_txCallback = callback;
+}
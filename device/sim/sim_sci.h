@@ -0,0 +1,158 @@
+//###########################################################################
+//
+// FILE:   sim_sci.h
+//
+// TITLE:  SCI model with FIFOs for the host simulator.
+//
+//###########################################################################
+//
+// Models SCIA and SCIB in FIFO (enhancement) mode: the 16-deep transmit and
+// receive FIFOs, character timing derived from the baud rate, LSPCLK divider
+// and frame format, the TXFF/RXFF level interrupts, receive FIFO overflow
+// and internal loopback.
+//
+// Transmitted characters are handed to an optional callback. Characters for
+// the receiver are queued with Sim_SCI_receive() and arrive one character
+// time apart, as they would on the wire.
+//
+// Not modelled: non-FIFO mode, TXRDY/RXRDY interrupts, parity, framing and
+// break errors, autobaud, address/idle-line multiprocessor modes and
+// FFTXDLY.
+//
+//###########################################################################
+
+#ifndef SIM_SCI_H
+#define SIM_SCI_H
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "sim.h"
+
+//*****************************************************************************
+//
+// Number of SCI ports modelled, FIFO depth and the number of characters that
+// can be queued for the receiver with Sim_SCI_receive().
+//
+//*****************************************************************************
+#define SIM_SCI_NUM_PORTS       2U
+#define SIM_SCI_FIFO_DEPTH      16U
+#define SIM_SCI_RX_QUEUE_SIZE   1024U
+
+//*****************************************************************************
+//
+//! Traffic counters of one SCI port.
+//
+//*****************************************************************************
+typedef struct
+{
+    uint32_t txChars;       //!< Characters shifted out of the transmitter
+    uint32_t txDropped;     //!< Writes to SCITXBUF while the TX FIFO was full
+    uint32_t rxChars;       //!< Characters placed in the receive FIFO
+    uint32_t rxOverflows;   //!< Characters lost to a full receive FIFO
+    uint64_t lastTxCycle;   //!< Cycle the last character finished shifting
+} Sim_SCI_Stats;
+
+//*****************************************************************************
+//
+//! Prototype of an optional transmit callback.
+//!
+//! \param base is the SCI base address.
+//! \param data is the transmitted character.
+//! \param cycle is the simulated SYSCLK cycle its stop bit completed.
+//
+//*****************************************************************************
+typedef void (*Sim_SCI_TxCallback)(uint32_t base, uint16_t data,
+                                   uint64_t cycle);
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+//*****************************************************************************
+//
+//! Attaches the SCI model to the simulator.
+//!
+//! Registers the model with Sim_registerModel() and hooks the SCI register
+//! page. Call once before Sim_reset().
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+Sim_SCI_init(void);
+
+//*****************************************************************************
+//
+//! Queues characters for the receiver of a port.
+//!
+//! \param base is the SCI base address.
+//! \param data is the characters to receive.
+//! \param length is the number of characters.
+//!
+//! The first character completes one character time after the current
+//! simulated cycle, or after the last character still queued.
+//!
+//! \return Returns the number of characters queued, which is less than
+//! \e length if the queue is full.
+//
+//*****************************************************************************
+extern uint16_t
+Sim_SCI_receive(uint32_t base, const uint16_t *data, uint16_t length);
+
+//*****************************************************************************
+//
+//! Returns the number of SYSCLK cycles one character takes on the wire with
+//! the current baud rate and frame format of a port.
+//!
+//! \param base is the SCI base address.
+//
+//*****************************************************************************
+extern uint64_t
+Sim_SCI_getCharCycles(uint32_t base);
+
+//*****************************************************************************
+//
+//! Returns the traffic counters of a port.
+//!
+//! \param base is the SCI base address.
+//!
+//! \return Returns a pointer to the counters.
+//
+//*****************************************************************************
+extern const Sim_SCI_Stats *
+Sim_SCI_getStats(uint32_t base);
+
+//*****************************************************************************
+//
+//! Installs a callback that is invoked for every transmitted character.
+//!
+//! \param callback is the callback, or NULL to remove it.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+Sim_SCI_setTxCallback(Sim_SCI_TxCallback callback);
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SIM_SCI_H
@@ -0,0 +1,48 @@
+//###########################################################################
+//
+// FILE:   sim_sfo.c
+//
+// TITLE:  Host stand-in for the HRPWM scale factor optimizer library.
+//
+//###########################################################################
+
+#include "sim_sfo.h"
+#include "sim_epwm.h"
+#include "driverlib.h"
+
+//
+// Scale factor result, normally defined by the application
+//
+__attribute__((weak)) int MEP_ScaleFactor;
+
+static uint16_t Sim_SFO_calls;
+
+//*****************************************************************************
+//
+// SFO
+//
+//*****************************************************************************
+int
+SFO(void)
+{
+    uint32_t scaleFactor;
+
+    Sim_SFO_calls++;
+    if(Sim_SFO_calls < SIM_SFO_CALLS)
+    {
+        return(SIM_SFO_INCOMPLETE);
+    }
+    Sim_SFO_calls = 0U;
+
+    scaleFactor = (Sim_EPWM_getMEPSteps() + 0x80U) >> 8U;
+    MEP_ScaleFactor = (int)scaleFactor;
+
+    if(scaleFactor > HRPWM_HRMSTEP_HRMSTEP_M)
+    {
+        return(SIM_SFO_ERROR);
+    }
+
+    Sim_writeReg16(EPWM1_BASE + HRPWM_O_HRMSTEP, (uint16_t)scaleFactor);
+
+    return(SIM_SFO_COMPLETE);
+}
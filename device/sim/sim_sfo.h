@@ -0,0 +1,86 @@
+//###########################################################################
+//
+// FILE:   sim_sfo.h
+//
+// TITLE:  Host stand-in for the HRPWM scale factor optimizer library.
+//
+//###########################################################################
+//
+// On the target, the MEP scale factor is measured by SFO(), which comes with
+// the HRPWM calibration library of C2000Ware and drives the calibration
+// logic powered by HRPWR[CALPWRON]. Neither exists on the host, so this file
+// provides an SFO() with the same contract for the simulator:
+//
+// - Each call does one slice of the measurement and returns
+//   SIM_SFO_INCOMPLETE until a measurement is complete.
+// - On completion, MEP_ScaleFactor holds the number of MEP steps per SYSCLK
+//   cycle of the simulated silicon (see Sim_EPWM_setMEPSteps()), rounded to
+//   nearest, HRMSTEP of ePWM1 is updated for auto-conversion and
+//   SIM_SFO_COMPLETE is returned.
+// - A scale factor above 255 does not fit HRMSTEP; SIM_SFO_ERROR is
+//   returned and HRMSTEP is left alone.
+//
+// MEP_ScaleFactor is defined by the application, as the library expects. A
+// weak definition here keeps host builds without HRPWM code linking.
+//
+//###########################################################################
+
+#ifndef SIM_SFO_H
+#define SIM_SFO_H
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+#include "sim.h"
+
+//*****************************************************************************
+//
+// Values returned by SFO(), matching the calibration library.
+//
+//*****************************************************************************
+#define SIM_SFO_INCOMPLETE      0
+#define SIM_SFO_COMPLETE        1
+#define SIM_SFO_ERROR           2
+
+//*****************************************************************************
+//
+// Number of SFO() calls one measurement takes.
+//
+//*****************************************************************************
+#define SIM_SFO_CALLS           4U
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+//*****************************************************************************
+//
+//! Runs one slice of the MEP scale factor measurement.
+//!
+//! \return Returns \b SIM_SFO_INCOMPLETE, \b SIM_SFO_COMPLETE or
+//! \b SIM_SFO_ERROR.
+//
+//*****************************************************************************
+extern int
+SFO(void);
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SIM_SFO_H
@@ -0,0 +1,177 @@
+//###########################################################################
+//
+// FILE:   bench_comp.c
+//
+// TITLE:  Step response and speed of the PI and 2P2Z/3P3Z compensators.
+//
+//###########################################################################
+//
+// Prints the settling time to within 1%, the overshoot and the samples
+// spent at the output limit of each compensator of test_comp.c on the
+// same first-order plant, for a reference inside the output range and one
+// that drives the output into its limit, and then the host time per step.
+//
+//###########################################################################
+
+//
+// Included Files
+//
+#include "test.h"
+#include <stdlib.h>
+#include "pwm_comp.h"
+
+//
+// Defines
+//
+#define OUTPUT_MAX          4095
+#define PLANT_TAU           12.0
+#define STEP_SAMPLES        3000U
+#define SPEED_STEPS         10000000UL
+
+//
+// Typedefs
+//
+typedef int32_t (*RunFunction)(void *state, int32_t error);
+
+//
+// Globals
+//
+static const PWMComp_Coeffs coeffs2P2Z =
+{
+    PWMCOMP_Q16(0.6), PWMCOMP_Q16(-0.5), 0, 0, PWMCOMP_Q16(1.0), 0, 0
+};
+static const PWMComp_Coeffs coeffs3P3Z =
+{
+    PWMCOMP_Q16(1.2), PWMCOMP_Q16(-1.96), PWMCOMP_Q16(0.98),
+    PWMCOMP_Q16(-0.15), PWMCOMP_Q16(1.3), PWMCOMP_Q16(-0.32),
+    PWMCOMP_Q16(0.02)
+};
+
+//
+// Function Prototypes
+//
+static int32_t runPI(void *state, int32_t error);
+static int32_t run2P2Z(void *state, int32_t error);
+static int32_t run3P3Z(void *state, int32_t error);
+static void printStepResponse(const char *name, RunFunction run, void *state,
+                              int32_t reference);
+static void printSpeed(const char *name, RunFunction run, void *state);
+
+//
+// Main
+//
+int main(void)
+{
+    PWMComp_PI pi;
+    PWMComp_Filter filter2P2Z;
+    PWMComp_Filter filter3P3Z;
+    int32_t reference;
+
+    PWMComp_initPI(&pi, PWMCOMP_Q16(0.5), PWMCOMP_Q16(0.1), 0, OUTPUT_MAX);
+    PWMComp_initFilter(&filter2P2Z, &coeffs2P2Z, 0, OUTPUT_MAX);
+    PWMComp_initFilter(&filter3P3Z, &coeffs3P3Z, 0, OUTPUT_MAX);
+
+    for(reference = 1000; reference <= 4000; reference += 3000)
+    {
+        PWMComp_resetPI(&pi, 0);
+        printStepResponse("PI", &runPI, &pi, reference);
+        PWMComp_resetFilter(&filter2P2Z, 0);
+        printStepResponse("2P2Z", &run2P2Z, &filter2P2Z, reference);
+        PWMComp_resetFilter(&filter3P3Z, 0);
+        printStepResponse("3P3Z", &run3P3Z, &filter3P3Z, reference);
+    }
+
+    printSpeed("PI", &runPI, &pi);
+    printSpeed("2P2Z", &run2P2Z, &filter2P2Z);
+    printSpeed("3P3Z", &run3P3Z, &filter3P3Z);
+
+    return(0);
+}
+
+//
+// runPI, run2P2Z, run3P3Z - Run one step of a compensator
+//
+static int32_t runPI(void *state, int32_t error)
+{
+    return(PWMComp_runPI((PWMComp_PI *)state, error));
+}
+
+static int32_t run2P2Z(void *state, int32_t error)
+{
+    return(PWMComp_run2P2Z((PWMComp_Filter *)state, error));
+}
+
+static int32_t run3P3Z(void *state, int32_t error)
+{
+    return(PWMComp_run3P3Z((PWMComp_Filter *)state, error));
+}
+
+//
+// printStepResponse - Regulates the plant from 0 to a reference and prints
+// how it got there
+//
+static void printStepResponse(const char *name, RunFunction run, void *state,
+                              int32_t reference)
+{
+    double plant = 0.0;
+    double peak = 0.0;
+    int32_t settle = -1;
+    uint32_t saturated = 0U;
+    int32_t output;
+    uint32_t i;
+
+    for(i = 0U; i < STEP_SAMPLES; i++)
+    {
+        output = run(state, reference - (int32_t)(plant + 0.5));
+        if(output == OUTPUT_MAX)
+        {
+            saturated++;
+        }
+
+        plant += ((double)output - plant) / PLANT_TAU;
+        if(plant > peak)
+        {
+            peak = plant;
+        }
+
+        if(abs((int32_t)(plant + 0.5) - reference) <= (reference / 100))
+        {
+            if(settle < 0)
+            {
+                settle = (int32_t)i;
+            }
+        }
+        else
+        {
+            settle = -1;
+        }
+    }
+
+    printf("%-4s step to %4ld: settles in %3ld samples, overshoot %.2f%%, "
+           "%3lu samples at the limit, ends at %.1f\n", name, (long)reference,
+           (long)settle, (peak - reference) * 100.0 / reference,
+           (unsigned long)saturated, plant);
+}
+
+//
+// printSpeed - Prints the host time per step on a varying error
+//
+static void printSpeed(const char *name, RunFunction run, void *state)
+{
+    volatile int32_t sink = 0;
+    uint32_t i;
+    double start;
+
+    start = Test_getSeconds();
+    for(i = 0U; i < SPEED_STEPS; i++)
+    {
+        sink += run(state, (int32_t)(i & 1023U) - 512);
+    }
+
+    printf("%-4s %.1f ns per step on the host\n", name,
+           (Test_getSeconds() - start) / SPEED_STEPS * 1.0e9);
+}
+
+//
+// End of File
+//
@@ -0,0 +1,83 @@
+//###########################################################################
+//
+// FILE:   bench_duty.c
+//
+// TITLE:  Speed of the Q15 duty conversion against the double one.
+//
+//###########################################################################
+//
+// Prints the host time per compare count of PWMDuty_toCount() and of the
+// double precision period * duty it replaced, over periods 500 to 1500 and
+// every 64th duty value. The host has a double precision FPU; the C28x
+// emulates double in the run-time support library, so on target the gap
+// is wider than shown here.
+//
+//###########################################################################
+
+//
+// Included Files
+//
+#include "test.h"
+#include "pwm_duty.h"
+
+//
+// Defines
+//
+#define ROUNDS              200U
+#define PERIOD_MIN          500U
+#define PERIOD_MAX          1500U
+#define DUTY_STRIDE         64U
+
+//
+// Main
+//
+int main(void)
+{
+    volatile uint16_t period;
+    volatile double track;
+    uint32_t sink = 0U;
+    uint32_t count = 0U;
+    uint32_t d;
+    uint16_t i;
+    double start;
+    double fixedTime;
+    double doubleTime;
+
+    start = Test_getSeconds();
+    for(i = 0U; i < ROUNDS; i++)
+    {
+        for(period = PERIOD_MIN; period <= PERIOD_MAX; period++)
+        {
+            for(d = 0U; d <= PWMDUTY_ONE; d += DUTY_STRIDE)
+            {
+                sink += PWMDuty_toCount(period, (uint16_t)d);
+                count++;
+            }
+        }
+    }
+    fixedTime = Test_getSeconds() - start;
+
+    start = Test_getSeconds();
+    for(i = 0U; i < ROUNDS; i++)
+    {
+        for(period = PERIOD_MIN; period <= PERIOD_MAX; period++)
+        {
+            for(d = 0U; d <= PWMDUTY_ONE; d += DUTY_STRIDE)
+            {
+                track = (double)d / PWMDUTY_ONE;
+                sink += (uint16_t)(period * track);
+            }
+        }
+    }
+    doubleTime = Test_getSeconds() - start;
+
+    printf("Q15: %.2f ns per count, double: %.2f ns per count "
+           "(checksum %lu)\n", fixedTime / count * 1.0e9,
+           doubleTime / count * 1.0e9, (unsigned long)sink);
+
+    return(0);
+}
+
+//
+// End of File
+//
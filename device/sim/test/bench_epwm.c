@@ -0,0 +1,87 @@
+//###########################################################################
+//
+// FILE:   bench_epwm.c
+//
+// TITLE:  Simulation speed of the ePWM model.
+//
+//###########################################################################
+//
+// Runs ePWM5 in the up-down configuration of the application, with an
+// interrupt on every third period, for 10 s of simulated time and prints
+// how many PWM periods the model simulates per second of host time.
+//
+//###########################################################################
+
+//
+// Included Files
+//
+#include "test.h"
+
+//
+// Defines
+//
+#define SIM_SECONDS     10UL
+#define SYSCLK_HZ       100000000UL
+
+//
+// Function Prototypes
+//
+static void epwm5ISR(void);
+
+//
+// Main
+//
+int main(void)
+{
+    uint64_t periods;
+    double start;
+    double seconds;
+
+    Test_initSim();
+    Interrupt_register(INT_EPWM5, &epwm5ISR);
+
+    SysCtl_disablePeripheral(SYSCTL_PERIPH_CLK_TBCLKSYNC);
+    EPWM_setTimeBasePeriod(EPWM5_BASE, 850U);
+    EPWM_setTimeBaseCounter(EPWM5_BASE, 0U);
+    EPWM_setCounterCompareValue(EPWM5_BASE, EPWM_COUNTER_COMPARE_A, 425U);
+    EPWM_setTimeBaseCounterMode(EPWM5_BASE, EPWM_COUNTER_MODE_UP_DOWN);
+    EPWM_setClockPrescaler(EPWM5_BASE, EPWM_CLOCK_DIVIDER_1,
+                           EPWM_HSCLOCK_DIVIDER_1);
+    EPWM_setActionQualifierAction(EPWM5_BASE, EPWM_AQ_OUTPUT_A,
+                                  EPWM_AQ_OUTPUT_HIGH,
+                                  EPWM_AQ_OUTPUT_ON_TIMEBASE_UP_CMPA);
+    EPWM_setActionQualifierAction(EPWM5_BASE, EPWM_AQ_OUTPUT_A,
+                                  EPWM_AQ_OUTPUT_LOW,
+                                  EPWM_AQ_OUTPUT_ON_TIMEBASE_DOWN_CMPA);
+    EPWM_setInterruptSource(EPWM5_BASE, EPWM_INT_TBCTR_ZERO);
+    EPWM_setInterruptEventCount(EPWM5_BASE, 3U);
+    EPWM_enableInterrupt(EPWM5_BASE);
+    SysCtl_enablePeripheral(SYSCTL_PERIPH_CLK_TBCLKSYNC);
+    Interrupt_enable(INT_EPWM5);
+    EINT;
+
+    start = Test_getSeconds();
+    Sim_run(SIM_SECONDS * SYSCLK_HZ);
+    seconds = Test_getSeconds() - start;
+
+    periods = Sim_EPWM_getPeriodCount(EPWM5_BASE);
+    printf("ePWM model: %llu periods, %lu interrupts in %.3f s: "
+           "%.2f million periods/s\n", (unsigned long long)periods,
+           (unsigned long)Sim_getInterruptStats(INT_EPWM5)->count, seconds,
+           (double)periods / seconds / 1.0e6);
+
+    return(0);
+}
+
+//
+// epwm5ISR - Acknowledges the interrupt
+//
+static void epwm5ISR(void)
+{
+    EPWM_clearEventTriggerInterruptFlag(EPWM5_BASE);
+    Interrupt_clearACKGroup(INTERRUPT_ACK_GROUP3);
+}
+
+//
+// End of File
+//
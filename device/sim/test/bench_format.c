@@ -0,0 +1,133 @@
+//###########################################################################
+//
+// FILE:   bench_format.c
+//
+// TITLE:  Speed of the number formatters next to snprintf().
+//
+//###########################################################################
+//
+// Prints the host time of one call of each SCIFormat function and of the
+// snprintf() conversion it replaces, over the same spread of 32-bit
+// values. These are host times only and say nothing about the C28x; the
+// formatters are there to keep the run-time support printf out of the
+// image, not to beat the host C library.
+//
+//###########################################################################
+
+//
+// Included Files
+//
+#include "test.h"
+#include "sci_format.h"
+
+//
+// Defines
+//
+#define CALLS           5000000UL
+#define REFERENCE_SIZE  64U
+
+//
+// Globals
+//
+static volatile uint32_t sink;
+
+//
+// Function Prototypes
+//
+static int32_t getValue(uint32_t i);
+static void report(const char *name, double seconds, double printfSeconds);
+
+//
+// Main
+//
+int main(void)
+{
+    char result[SCIFORMAT_BUFFER_SIZE];
+    char reference[REFERENCE_SIZE];
+    double start;
+    double seconds;
+    uint32_t i;
+
+    start = Test_getSeconds();
+    for(i = 0U; i < CALLS; i++)
+    {
+        sink += SCIFormat_unsigned(result, (uint32_t)getValue(i), 0U, 0U);
+    }
+    seconds = Test_getSeconds() - start;
+    start = Test_getSeconds();
+    for(i = 0U; i < CALLS; i++)
+    {
+        sink += (uint32_t)snprintf(reference, sizeof(reference), "%lu",
+                                   (unsigned long)(uint32_t)getValue(i));
+    }
+    report("unsigned / %lu", seconds, Test_getSeconds() - start);
+
+    start = Test_getSeconds();
+    for(i = 0U; i < CALLS; i++)
+    {
+        sink += SCIFormat_signed(result, getValue(i), 0U, 0U);
+    }
+    seconds = Test_getSeconds() - start;
+    start = Test_getSeconds();
+    for(i = 0U; i < CALLS; i++)
+    {
+        sink += (uint32_t)snprintf(reference, sizeof(reference), "%ld",
+                                   (long)getValue(i));
+    }
+    report("signed / %ld", seconds, Test_getSeconds() - start);
+
+    start = Test_getSeconds();
+    for(i = 0U; i < CALLS; i++)
+    {
+        sink += SCIFormat_hex(result, (uint32_t)getValue(i), 8U,
+                              SCIFORMAT_ZERO);
+    }
+    seconds = Test_getSeconds() - start;
+    start = Test_getSeconds();
+    for(i = 0U; i < CALLS; i++)
+    {
+        sink += (uint32_t)snprintf(reference, sizeof(reference), "%08lx",
+                                   (unsigned long)(uint32_t)getValue(i));
+    }
+    report("hex / %08lx", seconds, Test_getSeconds() - start);
+
+    //
+    // Duty cycles and the like: Q15 values to three fractional digits
+    //
+    start = Test_getSeconds();
+    for(i = 0U; i < CALLS; i++)
+    {
+        sink += SCIFormat_q(result, getValue(i) >> 8, 15U, 3U, 0U, 0U);
+    }
+    seconds = Test_getSeconds() - start;
+    start = Test_getSeconds();
+    for(i = 0U; i < CALLS; i++)
+    {
+        sink += (uint32_t)snprintf(reference, sizeof(reference), "%.3f",
+                                   (double)(getValue(i) >> 8) / 32768.0);
+    }
+    report("Q15 / %.3f", seconds, Test_getSeconds() - start);
+
+    return(0);
+}
+
+//
+// getValue - Spreads the call index over the whole 32-bit range
+//
+static int32_t getValue(uint32_t i)
+{
+    return((int32_t)(i * 2654435761UL));
+}
+
+//
+// report - Prints the time per call of a formatter and of snprintf()
+//
+static void report(const char *name, double seconds, double printfSeconds)
+{
+    printf("%-14s %6.1f ns per call, snprintf() %6.1f ns\n", name,
+           seconds / CALLS * 1.0e9, printfSeconds / CALLS * 1.0e9);
+}
+
+//
+// End of File
+//
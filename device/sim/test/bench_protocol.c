@@ -0,0 +1,213 @@
+//###########################################################################
+//
+// FILE:   bench_protocol.c
+//
+// TITLE:  Command rate and latency of the binary protocol.
+//
+//###########################################################################
+//
+// Prints how many frames per second Protocol_decodeByte() decodes on the
+// host, then runs the application and sends it GET_STATUS commands over
+// the simulated SCIA, each as soon as the answer to the previous one is
+// complete. Reported in simulated time are the commands answered per
+// second, the reaction time from the last command byte to the first answer
+// byte on the wire, and the round trip to the last answer byte.
+//
+//###########################################################################
+
+//
+// Included Files
+//
+#include "test.h"
+#include <stdlib.h>
+
+//
+// The application, with its main() renamed so that this file can run it
+//
+#define main appMain
+#include "pwm5a5b_on_PCBRev1.c"
+#undef main
+
+//
+// Defines
+//
+#define DECODE_FRAMES       1000000UL
+#define COMMANDS            50U
+#define WARM_UP_CYCLES      (DEVICE_SYSCLK_FREQ / 10U)
+
+//
+// Globals
+//
+static Protocol_Decoder answerDecoder;
+static bool waiting;
+static bool answerStarted;
+static uint32_t answers;
+static uint64_t commandEnd;
+static uint64_t firstCommand;
+static uint64_t reactionTotal;
+static uint64_t reactionMax;
+static uint64_t roundTripTotal;
+static uint64_t roundTripMax;
+
+//
+// Function Prototypes
+//
+static void benchDecoder(void);
+static void sendCommand(void);
+static void txCallback(uint32_t base, uint16_t data, uint64_t cycle);
+
+//
+// Main
+//
+int main(void)
+{
+    benchDecoder();
+
+    Sim_CPUTimer_init();
+    Sim_DMA_init();
+    Sim_EPWM_init();
+    Sim_ADC_init();
+    Sim_SCI_init();
+    Sim_reset();
+
+    Protocol_initDecoder(&answerDecoder);
+    Sim_SCI_setTxCallback(&txCallback);
+    Sim_setIdleHook(&sendCommand);
+    appMain();
+
+    return(1);
+}
+
+//
+// benchDecoder - Measures the host decode rate of status-sized frames
+//
+static void benchDecoder(void)
+{
+    Protocol_Decoder decoder;
+    uint16_t payload[PROTOCOL_MAX_PAYLOAD] = { 5U };
+    uint16_t buffer[PROTOCOL_MAX_FRAME];
+    uint16_t length;
+    uint32_t frames = 0U;
+    uint32_t i;
+    uint16_t j;
+    double start;
+    double seconds;
+
+    length = Protocol_encodeFrame(PROTOCOL_OP_STATUS, payload, 29U, buffer);
+    Protocol_initDecoder(&decoder);
+
+    start = Test_getSeconds();
+    for(i = 0U; i < DECODE_FRAMES; i++)
+    {
+        for(j = 0U; j < length; j++)
+        {
+            if(Protocol_decodeByte(&decoder, buffer[j]) ==
+               PROTOCOL_DECODE_FRAME)
+            {
+                frames++;
+            }
+        }
+    }
+    seconds = Test_getSeconds() - start;
+
+    printf("decoder: %.2f million %u-byte frames/s on the host\n",
+           (double)frames / seconds / 1.0e6, (unsigned int)length);
+}
+
+//
+// sendCommand - Sends the next command once the previous one is answered,
+// and reports after the last one
+//
+static void sendCommand(void)
+{
+    uint16_t payload[1] = { 5U };
+    uint16_t buffer[PROTOCOL_MAX_FRAME];
+    uint16_t length;
+    double seconds;
+
+    //
+    // The first command waits for the menu of the start-up to go out
+    //
+    if(waiting || (Sim_getCycles() < WARM_UP_CYCLES) ||
+       ((answers == 0U) && !SCIBuffer_isTxIdle()))
+    {
+        return;
+    }
+
+    if(answers == COMMANDS)
+    {
+        seconds = (double)(Sim_getCycles() - firstCommand) /
+                  (double)DEVICE_SYSCLK_FREQ;
+        printf("commands: %lu GET_STATUS answered at %.0f baud, "
+               "%.1f commands/s\n", (unsigned long)answers,
+               10.0 * DEVICE_SYSCLK_FREQ /
+               (double)Sim_SCI_getCharCycles(SCIA_BASE),
+               (double)answers / seconds);
+        printf("reaction: mean %.1f us, max %.1f us\n",
+               (double)reactionTotal / answers /
+               (DEVICE_SYSCLK_FREQ / 1.0e6),
+               (double)reactionMax / (DEVICE_SYSCLK_FREQ / 1.0e6));
+        printf("round trip: mean %.2f ms, max %.2f ms\n",
+               (double)roundTripTotal / answers /
+               (DEVICE_SYSCLK_FREQ / 1.0e3),
+               (double)roundTripMax / (DEVICE_SYSCLK_FREQ / 1.0e3));
+        exit(0);
+    }
+
+    if(answers == 0U)
+    {
+        firstCommand = Sim_getCycles();
+    }
+
+    //
+    // The last byte completes one character time per byte from now
+    //
+    length = Protocol_encodeFrame(PROTOCOL_OP_GET_STATUS, payload, 1U,
+                                  buffer);
+    (void)Sim_SCI_receive(SCIA_BASE, buffer, length);
+    commandEnd = Sim_getCycles() +
+                 ((uint64_t)length * Sim_SCI_getCharCycles(SCIA_BASE));
+    waiting = true;
+    answerStarted = false;
+}
+
+//
+// txCallback - Times the answer to the outstanding command
+//
+static void txCallback(uint32_t base, uint16_t data, uint64_t cycle)
+{
+    uint64_t elapsed;
+
+    if(!waiting || (base != SCIA_BASE))
+    {
+        return;
+    }
+
+    if(!answerStarted && (data == PROTOCOL_SOF))
+    {
+        answerStarted = true;
+        elapsed = cycle - Sim_SCI_getCharCycles(base) - commandEnd;
+        reactionTotal += elapsed;
+        if(elapsed > reactionMax)
+        {
+            reactionMax = elapsed;
+        }
+    }
+
+    if((Protocol_decodeByte(&answerDecoder, data) == PROTOCOL_DECODE_FRAME) &&
+       (answerDecoder.frame.opcode == PROTOCOL_OP_STATUS))
+    {
+        elapsed = cycle - commandEnd;
+        roundTripTotal += elapsed;
+        if(elapsed > roundTripMax)
+        {
+            roundTripMax = elapsed;
+        }
+        answers++;
+        waiting = false;
+    }
+}
+
+//
+// End of File
+//
@@ -0,0 +1,108 @@
+//###########################################################################
+//
+// FILE:   bench_sci_buffer.c
+//
+// TITLE:  Enqueue latency and throughput of the SCI transmit buffer.
+//
+//###########################################################################
+//
+// Queues the menu screen of the application every 10 ms at 9600 baud, so
+// that the ring never runs empty, and prints how long one
+// SCIBuffer_writeString() of the screen takes on the host and how many
+// characters per second of simulated time leave the port, next to what the
+// line allows.
+//
+//###########################################################################
+
+//
+// Included Files
+//
+#include "test.h"
+#include "sci_buffer.h"
+
+//
+// Defines
+//
+#define ROUNDS          200U
+
+//
+// Globals
+//
+static const char screen[] =
+    "\r\n\nChoose an option: \n\r\n 1. Change duty cycle \n"
+    "\r\n 2. Change frequency \n\r\n 3. Power off \r\n\nEnter number: ";
+static uint32_t sentCount;
+static uint64_t firstCycle;
+static uint64_t lastCycle;
+
+//
+// Function Prototypes
+//
+static void txCallback(uint32_t base, uint16_t data, uint64_t cycle);
+
+//
+// Main
+//
+int main(void)
+{
+    double start;
+    double elapsed;
+    double total = 0.0;
+    double longest = 0.0;
+    double lineRate;
+    uint16_t i;
+
+    Test_initSim();
+    Test_initSCI(SCIA_BASE, 9600U);
+    Sim_SCI_setTxCallback(&txCallback);
+    SCIBuffer_init(SCIA_BASE);
+    EINT;
+
+    for(i = 0U; i < ROUNDS; i++)
+    {
+        start = Test_getSeconds();
+        (void)SCIBuffer_writeString(screen);
+        elapsed = Test_getSeconds() - start;
+
+        total += elapsed;
+        if(elapsed > longest)
+        {
+            longest = elapsed;
+        }
+
+        Sim_run(DEVICE_SYSCLK_FREQ / 100U);
+    }
+
+    lineRate = (double)DEVICE_SYSCLK_FREQ /
+               (double)Sim_SCI_getCharCycles(SCIA_BASE);
+    printf("enqueue of a %u-character screen: mean %.0f ns, max %.0f ns\n",
+           (unsigned int)(sizeof(screen) - 1U), total / ROUNDS * 1.0e9,
+           longest * 1.0e9);
+    printf("throughput: %.1f characters/s of %.1f the line allows, "
+           "%lu dropped\n",
+           (double)(sentCount - 1U) * DEVICE_SYSCLK_FREQ /
+           (double)(lastCycle - firstCycle), lineRate,
+           (unsigned long)SCIBuffer_getTxOverflowCount());
+
+    return(0);
+}
+
+//
+// txCallback - Notes when the first and the last character went out
+//
+static void txCallback(uint32_t base, uint16_t data, uint64_t cycle)
+{
+    (void)base;
+    (void)data;
+
+    if(sentCount == 0U)
+    {
+        firstCycle = cycle;
+    }
+    lastCycle = cycle;
+    sentCount++;
+}
+
+//
+// End of File
+//
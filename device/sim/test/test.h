@@ -0,0 +1,132 @@
+//###########################################################################
+//
+// FILE:   test.h
+//
+// TITLE:  Shared helpers of the host tests and benchmarks.
+//
+//###########################################################################
+//
+// Every program in this directory is built by the Makefile one level up.
+// A test counts the checks that fail with TEST_CHECK() and returns
+// Test_report() from main(), so that make test fails when any check does.
+//
+//###########################################################################
+
+#ifndef TEST_H
+#define TEST_H
+
+//
+// clock_gettime() and CLOCK_MONOTONIC are POSIX, not ISO C. Include this
+// header before any other.
+//
+#define _POSIX_C_SOURCE 199309L
+
+//
+// Included Files
+//
+#include <stdio.h>
+#include <time.h>
+#include "driverlib.h"
+#include "device.h"
+#include "sim.h"
+#include "sim_adc.h"
+#include "sim_cputimer.h"
+#include "sim_dma.h"
+#include "sim_epwm.h"
+#include "sim_sci.h"
+
+//*****************************************************************************
+//
+// Number of checks that failed so far
+//
+//*****************************************************************************
+static unsigned long Test_failures;
+
+//*****************************************************************************
+//
+// Checks a condition, and reports it with its location if it is false
+//
+//*****************************************************************************
+#define TEST_CHECK(condition)                                                 \
+    do                                                                        \
+    {                                                                         \
+        if(!(condition))                                                      \
+        {                                                                     \
+            Test_failures++;                                                  \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__,          \
+                   #condition);                                               \
+        }                                                                     \
+    } while(0)
+
+//*****************************************************************************
+//
+// Attaches every peripheral model, resets the simulator and runs the device
+// start-up code with the PIE initialized, as the application does
+//
+//*****************************************************************************
+static inline void
+Test_initSim(void)
+{
+    Sim_CPUTimer_init();
+    Sim_DMA_init();
+    Sim_EPWM_init();
+    Sim_ADC_init();
+    Sim_SCI_init();
+    Sim_reset();
+
+    Device_init();
+    Interrupt_initModule();
+    Interrupt_initVectorTable();
+}
+
+//*****************************************************************************
+//
+// Sets an SCI port up for 8N1 with FIFOs, as the application sets up SCIA
+//
+//*****************************************************************************
+static inline void
+Test_initSCI(uint32_t base, uint32_t baud)
+{
+    SCI_performSoftwareReset(base);
+    SCI_setConfig(base, DEVICE_LSPCLK_FREQ, baud,
+                  (SCI_CONFIG_WLEN_8 | SCI_CONFIG_STOP_ONE |
+                   SCI_CONFIG_PAR_NONE));
+    SCI_resetChannels(base);
+    SCI_resetRxFIFO(base);
+    SCI_resetTxFIFO(base);
+    SCI_clearInterruptStatus(base, SCI_INT_TXFF | SCI_INT_RXFF);
+    SCI_enableFIFO(base);
+    SCI_enableModule(base);
+    SCI_performSoftwareReset(base);
+}
+
+//*****************************************************************************
+//
+// Returns a monotonic host time in seconds, for the benchmarks
+//
+//*****************************************************************************
+static inline double
+Test_getSeconds(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return((double)now.tv_sec + ((double)now.tv_nsec * 1.0e-9));
+}
+
+//*****************************************************************************
+//
+// Prints the result of a test and returns its exit status
+//
+//*****************************************************************************
+static inline int
+Test_report(const char *name)
+{
+    printf("%s: %s (%lu failed checks)\n", name,
+           (Test_failures == 0UL) ? "PASS" : "FAIL", Test_failures);
+
+    return((Test_failures == 0UL) ? 0 : 1);
+}
+
+#endif // TEST_H
@@ -0,0 +1,191 @@
+//###########################################################################
+//
+// FILE:   test_app.c
+//
+// TITLE:  Start-up and menu of the application in the simulator.
+//
+//###########################################################################
+//
+// Runs the application's main() as it is, up to its background loop and
+// then for 50 ms of simulated time, long enough for the start-up ramp of
+// ePWM5 to finish and the menu to go out. Checks that every output and the
+// interrupt, DMA and SCI traffic the application sets up are alive.
+//
+// Then sends ePWM5 a raw dead-band command, which it must refuse and
+// leave its complementary pair as it is, sets the ePWM5 compare values
+// with a protocol command and lowers the frequency with the menu, which
+// must keep the duty cycle the command set rather than the one the menu
+// last set.
+//
+//###########################################################################
+
+//
+// Included Files
+//
+#include "test.h"
+#include <stdlib.h>
+
+//
+// The application, with its main() renamed so that this file can run it
+//
+#define main appMain
+#include "pwm5a5b_on_PCBRev1.c"
+#undef main
+
+//
+// Defines
+//
+#define RUN_PASSES      25000U  // Background loop passes, 50 ms in all
+#define MENU_CYCLES     (DEVICE_SYSCLK_FREQ / 25U)  // 40 ms, 22 characters
+#define ACK_CYCLES      (2U * DEVICE_SYSCLK_FREQ)   // Behind the menu text
+#define COMMAND_CMPA    (EPWM5_TIMER_TBPRD / 4U)
+
+//
+// Globals
+//
+static uint32_t passes;
+static uint64_t commandCycle;
+static uint16_t deadBandControl;
+static uint16_t deadBandResult = 0xFFFFU;
+static Protocol_Decoder answerDecoder;
+
+//
+// Function Prototypes
+//
+static void checkRunning(void);
+static void checkMenu(void);
+static void txCallback(uint32_t base, uint16_t data, uint64_t cycle);
+
+//
+// Main
+//
+int main(void)
+{
+    Sim_CPUTimer_init();
+    Sim_DMA_init();
+    Sim_EPWM_init();
+    Sim_ADC_init();
+    Sim_SCI_init();
+    Sim_reset();
+
+    Sim_setIdleHook(&checkRunning);
+    appMain();
+
+    //
+    // The background loop never returns
+    //
+    return(1);
+}
+
+//
+// checkRunning - Lets the application run, then checks it and sends the
+// command and menu keys
+//
+static void checkRunning(void)
+{
+    uint16_t payload[5];
+    uint16_t buffer[12U + (2U * PROTOCOL_OVERHEAD)];
+    uint16_t length;
+    uint16_t i;
+
+    passes++;
+    if(passes < RUN_PASSES)
+    {
+        return;
+    }
+
+    for(i = 0U; i < NUM_CHANNELS; i++)
+    {
+        TEST_CHECK(Sim_EPWM_getOutputStats(channelConfig[i].base,
+                                           SIM_EPWM_OUTPUT_A)->edges != 0U);
+        TEST_CHECK(Sim_EPWM_getOutputStats(channelConfig[i].base,
+                                           SIM_EPWM_OUTPUT_B)->edges != 0U);
+    }
+
+#if MODULATION_ENGINE == MODULATION_ENGINE_DMA
+    TEST_CHECK(Sim_DMA_getStats(EPWM1_STREAM_DMA_BASE)->bursts != 0U);
+    TEST_CHECK(Sim_DMA_getStats(EPWM2_STREAM_DMA_BASE)->bursts != 0U);
+#endif
+    TEST_CHECK(Sim_DMA_getStats(OVERSAMPLE_DMA_BASE)->transfers != 0U);
+    TEST_CHECK(Sim_getInterruptStats(INT_EPWM5)->count != 0U);
+
+    //
+    // The menu went out on the SCI
+    //
+    TEST_CHECK(Sim_SCI_getStats(SCIA_BASE)->txChars != 0U);
+
+    //
+    // PROTOCOL_OP_SET_DEADBAND with both delays 0, which would bypass the
+    // dead band; PROTOCOL_OP_SET_DUTY; then "2" for the frequency menu and
+    // "1" for a 50 count longer period
+    //
+    deadBandControl = HWREGH(EPWM5_BASE + EPWM_O_DBCTL);
+    payload[0] = 5U;
+    Protocol_putUint16(&payload[1], 0U);
+    Protocol_putUint16(&payload[3], 0U);
+    length = Protocol_encodeFrame(PROTOCOL_OP_SET_DEADBAND, payload, 5U,
+                                  buffer);
+    Protocol_putUint16(&payload[1], COMMAND_CMPA);
+    Protocol_putUint16(&payload[3], COMMAND_CMPA);
+    length += Protocol_encodeFrame(PROTOCOL_OP_SET_DUTY, payload, 5U,
+                                   &buffer[length]);
+    buffer[length] = (uint16_t)'2';
+    buffer[length + 1U] = (uint16_t)'1';
+    (void)Sim_SCI_receive(SCIA_BASE, buffer, length + 2U);
+    commandCycle = Sim_getCycles();
+    Protocol_initDecoder(&answerDecoder);
+    Sim_SCI_setTxCallback(&txCallback);
+    Sim_setIdleHook(&checkMenu);
+}
+
+//
+// checkMenu - Checks the answer to the dead-band command and the ePWM5
+// setpoints the menu ramps to, and ends the test
+//
+static void checkMenu(void)
+{
+    const PWMRamp_Channel *ramp = &epwmChannels[CHANNEL_EPWM5].ramp;
+    uint32_t period = PWMHR_COUNT(EPWM5_TIMER_TBPRD + 50U);
+    uint32_t compare;
+    uint64_t elapsed = Sim_getCycles() - commandCycle;
+
+    if((elapsed < MENU_CYCLES) ||
+       ((deadBandResult == 0xFFFFU) && (elapsed < ACK_CYCLES)))
+    {
+        return;
+    }
+
+    TEST_CHECK(deadBandResult == PROTOCOL_RESULT_BAD_MODULE);
+    TEST_CHECK(HWREGH(EPWM5_BASE + EPWM_O_DBCTL) == deadBandControl);
+    TEST_CHECK((deadBandControl & EPWM_DBCTL_OUT_MODE_M) != 0U);
+
+    compare = PWMHR_dutyToCount(period,
+                                PWMDuty_fromCount(EPWM5_TIMER_TBPRD,
+                                                  COMMAND_CMPA));
+    TEST_CHECK(ramp->targetPeriod == period);
+    TEST_CHECK(ramp->targetA == compare);
+    TEST_CHECK(ramp->targetB == compare);
+
+    exit(Test_report("test_app"));
+}
+
+//
+// txCallback - Records the result the application answers the dead-band
+// command with
+//
+static void txCallback(uint32_t base, uint16_t data, uint64_t cycle)
+{
+    (void)cycle;
+
+    if((base == SCIA_BASE) &&
+       (Protocol_decodeByte(&answerDecoder, data) == PROTOCOL_DECODE_FRAME) &&
+       (answerDecoder.frame.opcode == PROTOCOL_OP_ACK) &&
+       (answerDecoder.frame.payload[0] == PROTOCOL_OP_SET_DEADBAND))
+    {
+        deadBandResult = answerDecoder.frame.payload[1];
+    }
+}
+
+//
+// End of File
+//
@@ -0,0 +1,332 @@
+//###########################################################################
+//
+// FILE:   test_channel.c
+//
+// TITLE:  Table-driven ePWM set-up against the per-module one it replaced.
+//
+//###########################################################################
+//
+// Runs the set-up of the application, PWMChannel_init() from channelConfig
+// followed by initModulation() and initEPWM5(), and keeps the registers of
+// ePWM1, ePWM2 and ePWM5 and of the two DMA stream channels. It then resets
+// the simulator and runs copies of initEPWM1(), initEPWM2() and initEPWM5()
+// as they were before the table, and checks that both leave every one of
+// those registers with the same value.
+//
+// The two differ in the order of some writes only: the table writes each
+// action qualifier register at once and sets the interrupt event count
+// before it enables the interrupt, and ePWM5 gets its actions before its
+// global loads, MEP and dead band. None of those writes depend on each
+// other while the time base clock is stopped.
+//
+//###########################################################################
+
+//
+// Included Files
+//
+#include "test.h"
+
+//
+// The application, with its main() renamed so that its set-up functions
+// can be called alone
+//
+#define main appMain
+#include "pwm5a5b_on_PCBRev1.c"
+#undef main
+
+#if MODULATION_ENGINE != MODULATION_ENGINE_DMA
+#error "The reference set-up below covers the DMA modulation engine only"
+#endif
+
+//
+// Defines
+//
+#define NUM_MODULES         3U
+#define EPWM_WORDS          0x100U
+#define DMA_WORDS           0x40U
+#define NUM_DMA_CHANNELS    2U
+
+//
+// Globals
+//
+static const uint32_t modules[NUM_MODULES] =
+{
+    EPWM1_BASE, EPWM2_BASE, EPWM5_BASE
+};
+static const uint32_t dmaChannels[NUM_DMA_CHANNELS] =
+{
+    EPWM1_STREAM_DMA_BASE, EPWM2_STREAM_DMA_BASE
+};
+static uint16_t tableRegs[NUM_MODULES][EPWM_WORDS];
+static uint16_t tableDMA[NUM_DMA_CHANNELS][DMA_WORDS];
+
+//
+// Function Prototypes
+//
+static void initDevice(void);
+static void refInitEPWM1(void);
+static void refInitEPWM2(void);
+static void refInitEPWM5(void);
+
+//
+// Main
+//
+int main(void)
+{
+    uint16_t differences = 0U;
+    uint16_t value;
+    uint16_t i;
+    uint16_t j;
+
+    Sim_CPUTimer_init();
+    Sim_DMA_init();
+    Sim_EPWM_init();
+    Sim_ADC_init();
+    Sim_SCI_init();
+
+    //
+    // The table, as the application sets it up
+    //
+    initDevice();
+    PWMChannel_init(epwmChannels, channelConfig, NUM_CHANNELS);
+    initModulation();
+    initEPWM5();
+
+    for(i = 0U; i < NUM_MODULES; i++)
+    {
+        for(j = 0U; j < EPWM_WORDS; j++)
+        {
+            tableRegs[i][j] = HWREGH(modules[i] + j);
+        }
+    }
+    for(i = 0U; i < NUM_DMA_CHANNELS; i++)
+    {
+        for(j = 0U; j < DMA_WORDS; j++)
+        {
+            tableDMA[i][j] = HWREGH(dmaChannels[i] + j);
+        }
+    }
+
+    //
+    // The functions the table replaced, from the same reset
+    //
+    initDevice();
+    refInitEPWM1();
+    refInitEPWM2();
+    refInitEPWM5();
+
+    for(i = 0U; i < NUM_MODULES; i++)
+    {
+        for(j = 0U; j < EPWM_WORDS; j++)
+        {
+            value = HWREGH(modules[i] + j);
+            if(value != tableRegs[i][j])
+            {
+                printf("ePWM at 0x%05lX, offset 0x%02X: table 0x%04X, "
+                       "reference 0x%04X\n", (unsigned long)modules[i], j,
+                       tableRegs[i][j], value);
+                differences++;
+            }
+        }
+    }
+    for(i = 0U; i < NUM_DMA_CHANNELS; i++)
+    {
+        for(j = 0U; j < DMA_WORDS; j++)
+        {
+            value = HWREGH(dmaChannels[i] + j);
+            if(value != tableDMA[i][j])
+            {
+                printf("DMA at 0x%05lX, offset 0x%02X: table 0x%04X, "
+                       "reference 0x%04X\n", (unsigned long)dmaChannels[i],
+                       j, tableDMA[i][j], value);
+                differences++;
+            }
+        }
+    }
+    TEST_CHECK(differences == 0U);
+
+    //
+    // The compare values are where the tables start, so nothing jumps
+    // when the time base clock starts
+    //
+    TEST_CHECK(EPWM_getCounterCompareValue(EPWM5_BASE,
+                                           EPWM_COUNTER_COMPARE_A) ==
+               EPWM5_MIN_CMPA);
+    TEST_CHECK(EPWM_getTimeBasePeriod(EPWM5_BASE) == EPWM5_TIMER_TBPRD);
+
+    return(Test_report("test_channel"));
+}
+
+//
+// initDevice - Resets the simulator and runs the start-up of the
+// application up to the ePWM set-up
+//
+static void initDevice(void)
+{
+    Sim_reset();
+
+    Device_init();
+    Interrupt_initModule();
+    Interrupt_initVectorTable();
+    SysCtl_disablePeripheral(SYSCTL_PERIPH_CLK_TBCLKSYNC);
+    DMA_initController();
+    DMA_setEmulationMode(DMA_EMULATION_FREE_RUN);
+
+    while(PWMHR_calibrate() == PWMHR_CAL_INCOMPLETE)
+    {
+    }
+}
+
+//
+// refInitEPWM1 - initEPWM1() as it was before the table
+//
+static void refInitEPWM1(void)
+{
+    EPWM_setTimeBasePeriod(EPWM1_BASE, EPWM1_TIMER_TBPRD);
+    EPWM_setPhaseShift(EPWM1_BASE, 0U);
+    EPWM_setTimeBaseCounter(EPWM1_BASE, 0U);
+
+    EPWM_setCounterCompareValue(EPWM1_BASE, EPWM_COUNTER_COMPARE_A,
+                                EPWM1_MIN_CMPA);
+    EPWM_setCounterCompareValue(EPWM1_BASE, EPWM_COUNTER_COMPARE_B,
+                                EPWM1_MAX_CMPB);
+
+    EPWM_setTimeBaseCounterMode(EPWM1_BASE, EPWM_COUNTER_MODE_UP_DOWN);
+    EPWM_disablePhaseShiftLoad(EPWM1_BASE);
+    EPWM_setClockPrescaler(EPWM1_BASE, EPWM_CLOCK_DIVIDER_1,
+                           EPWM_HSCLOCK_DIVIDER_1);
+
+    EPWM_setCounterCompareShadowLoadMode(EPWM1_BASE, EPWM_COUNTER_COMPARE_A,
+                                         EPWM_COMP_LOAD_ON_CNTR_ZERO);
+    EPWM_setCounterCompareShadowLoadMode(EPWM1_BASE, EPWM_COUNTER_COMPARE_B,
+                                         EPWM_COMP_LOAD_ON_CNTR_ZERO);
+
+    EPWM_setActionQualifierAction(EPWM1_BASE, EPWM_AQ_OUTPUT_A,
+                                  EPWM_AQ_OUTPUT_HIGH,
+                                  EPWM_AQ_OUTPUT_ON_TIMEBASE_UP_CMPA);
+    EPWM_setActionQualifierAction(EPWM1_BASE, EPWM_AQ_OUTPUT_A,
+                                  EPWM_AQ_OUTPUT_LOW,
+                                  EPWM_AQ_OUTPUT_ON_TIMEBASE_DOWN_CMPA);
+    EPWM_setActionQualifierAction(EPWM1_BASE, EPWM_AQ_OUTPUT_B,
+                                  EPWM_AQ_OUTPUT_HIGH,
+                                  EPWM_AQ_OUTPUT_ON_TIMEBASE_UP_CMPB);
+    EPWM_setActionQualifierAction(EPWM1_BASE, EPWM_AQ_OUTPUT_B,
+                                  EPWM_AQ_OUTPUT_LOW,
+                                  EPWM_AQ_OUTPUT_ON_TIMEBASE_DOWN_CMPB);
+
+    EPWM_setInterruptSource(EPWM1_BASE, EPWM_INT_TBCTR_ZERO);
+    EPWM_setInterruptEventCount(EPWM1_BASE, 1U);
+
+    PWMMod_fillSine(sineTable, MODULATION_TABLE_LENGTH,
+                    EPWM1_MIN_CMPA, EPWM1_MAX_CMPA);
+    PWMStream_fillFromTable(epwm1StreamBuffer, sineTable,
+                            MODULATION_TABLE_LENGTH,
+                            MODULATION_TABLE_LENGTH / 2U);
+    PWMStream_init(EPWM1_STREAM_DMA_BASE, EPWM1_BASE, epwm1StreamBuffer,
+                   MODULATION_TABLE_LENGTH);
+}
+
+//
+// refInitEPWM2 - initEPWM2() as it was before the table
+//
+static void refInitEPWM2(void)
+{
+    EPWM_setTimeBasePeriod(EPWM2_BASE, EPWM2_TIMER_TBPRD);
+    EPWM_setPhaseShift(EPWM2_BASE, 0U);
+    EPWM_setTimeBaseCounter(EPWM2_BASE, 0U);
+
+    EPWM_setCounterCompareValue(EPWM2_BASE, EPWM_COUNTER_COMPARE_A,
+                                EPWM2_MIN_CMPA);
+    EPWM_setCounterCompareValue(EPWM2_BASE, EPWM_COUNTER_COMPARE_B,
+                                EPWM2_MIN_CMPB);
+
+    EPWM_setTimeBaseCounterMode(EPWM2_BASE, EPWM_COUNTER_MODE_UP_DOWN);
+    EPWM_disablePhaseShiftLoad(EPWM2_BASE);
+    EPWM_setClockPrescaler(EPWM2_BASE, EPWM_CLOCK_DIVIDER_1,
+                           EPWM_HSCLOCK_DIVIDER_1);
+
+    EPWM_setCounterCompareShadowLoadMode(EPWM2_BASE, EPWM_COUNTER_COMPARE_A,
+                                         EPWM_COMP_LOAD_ON_CNTR_ZERO);
+    EPWM_setCounterCompareShadowLoadMode(EPWM2_BASE, EPWM_COUNTER_COMPARE_B,
+                                         EPWM_COMP_LOAD_ON_CNTR_ZERO);
+
+    EPWM_setActionQualifierAction(EPWM2_BASE, EPWM_AQ_OUTPUT_A,
+                                  EPWM_AQ_OUTPUT_HIGH,
+                                  EPWM_AQ_OUTPUT_ON_TIMEBASE_UP_CMPA);
+    EPWM_setActionQualifierAction(EPWM2_BASE, EPWM_AQ_OUTPUT_A,
+                                  EPWM_AQ_OUTPUT_LOW,
+                                  EPWM_AQ_OUTPUT_ON_TIMEBASE_DOWN_CMPB);
+    EPWM_setActionQualifierAction(EPWM2_BASE, EPWM_AQ_OUTPUT_B,
+                                  EPWM_AQ_OUTPUT_LOW,
+                                  EPWM_AQ_OUTPUT_ON_TIMEBASE_ZERO);
+    EPWM_setActionQualifierAction(EPWM2_BASE, EPWM_AQ_OUTPUT_B,
+                                  EPWM_AQ_OUTPUT_HIGH,
+                                  EPWM_AQ_OUTPUT_ON_TIMEBASE_PERIOD);
+
+    EPWM_setInterruptSource(EPWM2_BASE, EPWM_INT_TBCTR_ZERO);
+    EPWM_setInterruptEventCount(EPWM2_BASE, 1U);
+
+    PWMMod_fillTriangle(triangleTable, MODULATION_TABLE_LENGTH,
+                        EPWM2_MIN_CMPA, EPWM2_MAX_CMPA);
+    PWMStream_fillFromTable(epwm2StreamBuffer, triangleTable,
+                            MODULATION_TABLE_LENGTH, 0U);
+    PWMStream_init(EPWM2_STREAM_DMA_BASE, EPWM2_BASE, epwm2StreamBuffer,
+                   MODULATION_TABLE_LENGTH);
+}
+
+//
+// refInitEPWM5 - initEPWM5() as it was before the table
+//
+static void refInitEPWM5(void)
+{
+    EPWM_setTimeBasePeriod(EPWM5_BASE, EPWM5_TIMER_TBPRD);
+    EPWM_setPhaseShift(EPWM5_BASE, 0U);
+    EPWM_setTimeBaseCounter(EPWM5_BASE, 0U);
+
+    EPWM_setCounterCompareValue(EPWM5_BASE, EPWM_COUNTER_COMPARE_A,
+                                EPWM5_MIN_CMPA);
+    EPWM_setCounterCompareValue(EPWM5_BASE, EPWM_COUNTER_COMPARE_B,
+                                EPWM5_MAX_CMPB);
+
+    EPWM_setTimeBaseCounterMode(EPWM5_BASE, EPWM_COUNTER_MODE_UP_DOWN);
+    EPWM_disablePhaseShiftLoad(EPWM5_BASE);
+    EPWM_setClockPrescaler(EPWM5_BASE, EPWM_CLOCK_DIVIDER_1,
+                           EPWM_HSCLOCK_DIVIDER_1);
+
+    EPWM_setCounterCompareShadowLoadMode(EPWM5_BASE, EPWM_COUNTER_COMPARE_A,
+                                         EPWM_COMP_LOAD_ON_CNTR_ZERO);
+    EPWM_setCounterCompareShadowLoadMode(EPWM5_BASE, EPWM_COUNTER_COMPARE_B,
+                                         EPWM_COMP_LOAD_ON_CNTR_ZERO);
+
+    PWMUpdate_init(EPWM5_BASE);
+    PWMHR_init(EPWM5_BASE);
+    PWMDeadband_init(EPWM5_BASE);
+    PWMDeadband_setDelay(EPWM5_BASE,
+                         PWMDeadband_nsToDelay(DEADBAND_CLOCK_FREQ,
+                                               DEADBAND_RISING_NS),
+                         PWMDeadband_nsToDelay(DEADBAND_CLOCK_FREQ,
+                                               DEADBAND_FALLING_NS),
+                         false);
+    PWMDeadband_enable(EPWM5_BASE);
+
+    EPWM_setActionQualifierAction(EPWM5_BASE, EPWM_AQ_OUTPUT_A,
+                                  EPWM_AQ_OUTPUT_HIGH,
+                                  EPWM_AQ_OUTPUT_ON_TIMEBASE_UP_CMPA);
+    EPWM_setActionQualifierAction(EPWM5_BASE, EPWM_AQ_OUTPUT_A,
+                                  EPWM_AQ_OUTPUT_LOW,
+                                  EPWM_AQ_OUTPUT_ON_TIMEBASE_DOWN_CMPA);
+    EPWM_setActionQualifierAction(EPWM5_BASE, EPWM_AQ_OUTPUT_B,
+                                  EPWM_AQ_OUTPUT_LOW,
+                                  EPWM_AQ_OUTPUT_ON_TIMEBASE_UP_CMPB);
+    EPWM_setActionQualifierAction(EPWM5_BASE, EPWM_AQ_OUTPUT_B,
+                                  EPWM_AQ_OUTPUT_HIGH,
+                                  EPWM_AQ_OUTPUT_ON_TIMEBASE_DOWN_CMPB);
+
+    EPWM_setInterruptSource(EPWM5_BASE, EPWM_INT_TBCTR_ZERO);
+    EPWM_enableInterrupt(EPWM5_BASE);
+    EPWM_setInterruptEventCount(EPWM5_BASE, 1U);
+}
+
+//
+// End of File
+//
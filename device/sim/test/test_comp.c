@@ -0,0 +1,313 @@
+//###########################################################################
+//
+// FILE:   test_comp.c
+//
+// TITLE:  PI and 2P2Z/3P3Z compensators: arithmetic, step response and
+//         anti-windup.
+//
+//###########################################################################
+//
+// The step responses regulate a first-order plant, y += (u - y) / 12 per
+// sample, with the output limited to 0 .. 4095. A reference of 1000 keeps
+// the output inside its range; one of 4000 drives it into the upper limit
+// on the way up, where a compensator that winds up would overshoot.
+//
+//###########################################################################
+
+//
+// Included Files
+//
+#include "test.h"
+#include <stdlib.h>
+#include "pwm_comp.h"
+
+//
+// Defines
+//
+#define OUTPUT_MAX          4095
+#define PLANT_TAU           12.0
+#define STEP_SAMPLES        3000U
+#define WINDUP_SAMPLES      10000U
+
+//
+// Typedefs
+//
+typedef int32_t (*RunFunction)(void *state, int32_t error);
+
+typedef struct
+{
+    int32_t settle;             // Samples until within 1% for good
+    double overshoot;           // Peak above the reference, percent
+    uint32_t saturated;         // Samples with the output at its limit
+    double final;               // Plant output at the end
+} StepResult;
+
+//
+// Globals
+//
+static const PWMComp_Coeffs coeffs2P2Z =
+{
+    //
+    // PI with Kp = 0.5 and Ki = 0.1 in direct form
+    //
+    PWMCOMP_Q16(0.6), PWMCOMP_Q16(-0.5), 0, 0, PWMCOMP_Q16(1.0), 0, 0
+};
+static const PWMComp_Coeffs coeffs3P3Z =
+{
+    //
+    // Twice that PI, with zeros at 0.5 and 0.3 and poles at 0.2 and 0.1
+    //
+    PWMCOMP_Q16(1.2), PWMCOMP_Q16(-1.96), PWMCOMP_Q16(0.98),
+    PWMCOMP_Q16(-0.15), PWMCOMP_Q16(1.3), PWMCOMP_Q16(-0.32),
+    PWMCOMP_Q16(0.02)
+};
+
+//
+// Function Prototypes
+//
+static int32_t runPI(void *state, int32_t error);
+static int32_t run2P2Z(void *state, int32_t error);
+static int32_t run3P3Z(void *state, int32_t error);
+static void getStepResponse(RunFunction run, void *state, int32_t reference,
+                            StepResult *result);
+static void checkStepResponse(RunFunction run, void *state,
+                              int32_t reference, int32_t maxSettle,
+                              double maxOvershoot);
+static uint32_t getRecoverySteps(RunFunction run, void *state);
+
+//
+// Main
+//
+int main(void)
+{
+    PWMComp_PI pi;
+    PWMComp_Filter filter;
+    int32_t output = 0;
+    int32_t maxDifference = 0;
+    int32_t error;
+    uint32_t i;
+
+    //
+    // Gains convert as Q16, and a reset output comes back with no error
+    //
+    TEST_CHECK(PWMCOMP_Q16(0.5) == 32768);
+    TEST_CHECK(PWMCOMP_Q16(-2.0) == -131072);
+    PWMComp_initPI(&pi, PWMCOMP_Q16(0.5), PWMCOMP_Q16(0.1), 0, 1000);
+    PWMComp_resetPI(&pi, 500);
+    TEST_CHECK(PWMComp_runPI(&pi, 0) == 500);
+
+    //
+    // The integrator keeps the fraction, so an error of 1 at Ki = 0.01
+    // moves the output by 10 in 1000 steps
+    //
+    PWMComp_initPI(&pi, 0, PWMCOMP_Q16(0.01), 0, 1000);
+    PWMComp_resetPI(&pi, 100);
+    for(i = 0U; i < 1000U; i++)
+    {
+        output = PWMComp_runPI(&pi, 1);
+    }
+    TEST_CHECK(output == 110);
+
+    //
+    // Negative gains, and new limits take effect at the next step
+    //
+    PWMComp_initPI(&pi, PWMCOMP_Q16(-16.0), PWMCOMP_Q16(-2.0), 1000, 200000);
+    PWMComp_resetPI(&pi, 50000);
+    TEST_CHECK(PWMComp_runPI(&pi, 10) == (50000 - 160 - 20));
+    PWMComp_setPILimits(&pi, 60000, 70000);
+    TEST_CHECK(PWMComp_runPI(&pi, 0) == 60000);
+
+    //
+    // Limits below zero: the integrator starts, clamps and resets at them
+    //
+    PWMComp_initPI(&pi, PWMCOMP_Q16(1.0), PWMCOMP_Q16(0.5), -3000, -1000);
+    TEST_CHECK(pi.integral == ((int64_t)-3000 * PWMCOMP_ONE));
+    TEST_CHECK(PWMComp_runPI(&pi, -100) == -3000);
+    TEST_CHECK(pi.integral == ((int64_t)-3000 * PWMCOMP_ONE));
+    TEST_CHECK(PWMComp_runPI(&pi, 100) == (-3000 + 50 + 100));
+    PWMComp_setPILimits(&pi, -2000, -1500);
+    TEST_CHECK(PWMComp_runPI(&pi, 0) == -2000);
+    PWMComp_resetPI(&pi, -5000);
+    TEST_CHECK(PWMComp_runPI(&pi, 0) == -2000);
+    PWMComp_resetPI(&pi, -1700);
+    TEST_CHECK(PWMComp_runPI(&pi, 0) == -1700);
+
+    //
+    // The 2P2Z with PI coefficients follows the PI to within its state
+    // rounding on random errors
+    //
+    PWMComp_initPI(&pi, PWMCOMP_Q16(0.5), PWMCOMP_Q16(0.1), -100000, 100000);
+    PWMComp_resetPI(&pi, 0);
+    PWMComp_initFilter(&filter, &coeffs2P2Z, -100000, 100000);
+    PWMComp_resetFilter(&filter, 0);
+    srand(1U);
+    for(i = 0U; i < 2000U; i++)
+    {
+        error = (rand() % 2001) - 1000;
+        output = PWMComp_run2P2Z(&filter, error) - PWMComp_runPI(&pi, error);
+        if(abs(output) > maxDifference)
+        {
+            maxDifference = abs(output);
+        }
+    }
+    TEST_CHECK(maxDifference <= 32);
+
+    //
+    // Step responses, inside the output range and into its limit
+    //
+    PWMComp_initPI(&pi, PWMCOMP_Q16(0.5), PWMCOMP_Q16(0.1), 0, OUTPUT_MAX);
+    checkStepResponse(&runPI, &pi, 1000, 100, 10.0);
+    checkStepResponse(&runPI, &pi, 4000, 100, 3.0);
+    PWMComp_initFilter(&filter, &coeffs2P2Z, 0, OUTPUT_MAX);
+    checkStepResponse(&run2P2Z, &filter, 1000, 100, 10.0);
+    checkStepResponse(&run2P2Z, &filter, 4000, 100, 3.0);
+    PWMComp_initFilter(&filter, &coeffs3P3Z, 0, OUTPUT_MAX);
+    checkStepResponse(&run3P3Z, &filter, 1000, 150, 10.0);
+    checkStepResponse(&run3P3Z, &filter, 4000, 150, 3.0);
+
+    //
+    // After a long time at the limit the output leaves it as soon as the
+    // error changes sign
+    //
+    PWMComp_initPI(&pi, PWMCOMP_Q16(0.5), PWMCOMP_Q16(0.1), 0, OUTPUT_MAX);
+    TEST_CHECK(getRecoverySteps(&runPI, &pi) == 1U);
+    PWMComp_initFilter(&filter, &coeffs2P2Z, 0, OUTPUT_MAX);
+    TEST_CHECK(getRecoverySteps(&run2P2Z, &filter) == 1U);
+    PWMComp_initFilter(&filter, &coeffs3P3Z, 0, OUTPUT_MAX);
+    TEST_CHECK(getRecoverySteps(&run3P3Z, &filter) <= 3U);
+
+    return(Test_report("test_comp"));
+}
+
+//
+// runPI, run2P2Z, run3P3Z - Run one step of a compensator
+//
+static int32_t runPI(void *state, int32_t error)
+{
+    return(PWMComp_runPI((PWMComp_PI *)state, error));
+}
+
+static int32_t run2P2Z(void *state, int32_t error)
+{
+    return(PWMComp_run2P2Z((PWMComp_Filter *)state, error));
+}
+
+static int32_t run3P3Z(void *state, int32_t error)
+{
+    return(PWMComp_run3P3Z((PWMComp_Filter *)state, error));
+}
+
+//
+// getStepResponse - Regulates the plant from 0 to a reference
+//
+static void getStepResponse(RunFunction run, void *state, int32_t reference,
+                            StepResult *result)
+{
+    double plant = 0.0;
+    double peak = 0.0;
+    int32_t output;
+    int32_t sample;
+    uint32_t i;
+
+    result->settle = -1;
+    result->saturated = 0U;
+
+    for(i = 0U; i < STEP_SAMPLES; i++)
+    {
+        output = run(state, reference - (int32_t)(plant + 0.5));
+        if(output == OUTPUT_MAX)
+        {
+            result->saturated++;
+        }
+
+        plant += ((double)output - plant) / PLANT_TAU;
+        if(plant > peak)
+        {
+            peak = plant;
+        }
+
+        sample = (int32_t)(plant + 0.5);
+        if(abs(sample - reference) <= (reference / 100))
+        {
+            if(result->settle < 0)
+            {
+                result->settle = (int32_t)i;
+            }
+        }
+        else
+        {
+            result->settle = -1;
+        }
+    }
+
+    result->overshoot = (peak - reference) * 100.0 / reference;
+    result->final = plant;
+}
+
+//
+// checkStepResponse - Checks the settling time and the overshoot of a step
+// from a reset compensator
+//
+static void checkStepResponse(RunFunction run, void *state,
+                              int32_t reference, int32_t maxSettle,
+                              double maxOvershoot)
+{
+    StepResult result;
+
+    if(run == &runPI)
+    {
+        PWMComp_resetPI((PWMComp_PI *)state, 0);
+    }
+    else
+    {
+        PWMComp_resetFilter((PWMComp_Filter *)state, 0);
+    }
+
+    getStepResponse(run, state, reference, &result);
+    TEST_CHECK(result.settle >= 0);
+    TEST_CHECK(result.settle <= maxSettle);
+    TEST_CHECK(result.overshoot <= maxOvershoot);
+    if(reference > 2000)
+    {
+        TEST_CHECK(result.saturated > 0U);
+    }
+}
+
+//
+// getRecoverySteps - Holds the output at its upper limit for a long time,
+// then reverses the error and returns the steps until the output leaves the
+// limit
+//
+static uint32_t getRecoverySteps(RunFunction run, void *state)
+{
+    uint32_t i;
+
+    if(run == &runPI)
+    {
+        PWMComp_resetPI((PWMComp_PI *)state, 0);
+    }
+    else
+    {
+        PWMComp_resetFilter((PWMComp_Filter *)state, 0);
+    }
+
+    for(i = 0U; i < WINDUP_SAMPLES; i++)
+    {
+        (void)run(state, 1000);
+    }
+    TEST_CHECK(run(state, 1000) == OUTPUT_MAX);
+
+    for(i = 1U; i < 100U; i++)
+    {
+        if(run(state, -10) < OUTPUT_MAX)
+        {
+            return(i);
+        }
+    }
+
+    return(i);
+}
+
+//
+// End of File
+//
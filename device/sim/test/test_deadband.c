@@ -0,0 +1,274 @@
+//###########################################################################
+//
+// FILE:   test_deadband.c
+//
+// TITLE:  Edge timing of the complementary ePWM5A/5B pair.
+//
+//###########################################################################
+//
+// Sets ePWM5 up as the application does, with a 50% duty in up-down count,
+// and times every edge of ePWM5A and ePWM5B to the fine resolution of the
+// ePWM model. With the dead band on, each output must rise exactly one
+// delay after the other fell, RED before A and FED before B, and the two
+// must never be high together. Delays are rounded to half a count without
+// high resolution and placed to within one MEP step with it.
+//
+//###########################################################################
+
+//
+// Included Files
+//
+#include "test.h"
+#include "pwm_deadband.h"
+#include "pwm_hr.h"
+#include "pwm_update.h"
+
+//
+// Defines
+//
+#define PERIOD              850U
+#define COMPARE             425U
+#define SETTLE_CYCLES       4000U
+#define MEASURE_CYCLES      20000U
+
+//
+// Edge timing of one measurement, in fine cycles
+//
+typedef struct
+{
+    uint32_t pulses;            // Pulses seen on each output, the fewer
+    int64_t minGap[2];          // Shortest gap before each output rose
+    int64_t maxGap[2];          // Longest gap before each output rose
+    uint32_t overlaps;          // Rises while the other output was high
+} EdgeTiming;
+
+//
+// Globals
+//
+static EdgeTiming timing;
+static uint32_t risesA;
+static uint32_t risesB;
+
+//
+// Function Prototypes
+//
+static void edgeCallback(uint32_t base, uint16_t output, uint16_t level,
+                         uint64_t cycle);
+static void measure(void);
+static void checkDelays(uint32_t rising, uint32_t falling,
+                        int64_t tolerance);
+static int64_t getFine(uint32_t delay);
+
+//
+// Main
+//
+int main(void)
+{
+    const Sim_EPWM_OutputStats *statsA;
+    const Sim_EPWM_OutputStats *statsB;
+    uint32_t rising;
+    uint32_t falling;
+    uint32_t edges;
+
+    Test_initSim();
+    Sim_EPWM_setEdgeCallback(&edgeCallback);
+
+    SysCtl_disablePeripheral(SYSCTL_PERIPH_CLK_TBCLKSYNC);
+    EPWM_setTimeBasePeriod(EPWM5_BASE, PERIOD);
+    EPWM_setTimeBaseCounter(EPWM5_BASE, 0U);
+    EPWM_setCounterCompareValue(EPWM5_BASE, EPWM_COUNTER_COMPARE_A, COMPARE);
+    EPWM_setCounterCompareValue(EPWM5_BASE, EPWM_COUNTER_COMPARE_B, COMPARE);
+    EPWM_setTimeBaseCounterMode(EPWM5_BASE, EPWM_COUNTER_MODE_UP_DOWN);
+    EPWM_setClockPrescaler(EPWM5_BASE, EPWM_CLOCK_DIVIDER_1,
+                           EPWM_HSCLOCK_DIVIDER_1);
+    PWMUpdate_init(EPWM5_BASE);
+    EPWM_setActionQualifierAction(EPWM5_BASE, EPWM_AQ_OUTPUT_A,
+                                  EPWM_AQ_OUTPUT_HIGH,
+                                  EPWM_AQ_OUTPUT_ON_TIMEBASE_UP_CMPA);
+    EPWM_setActionQualifierAction(EPWM5_BASE, EPWM_AQ_OUTPUT_A,
+                                  EPWM_AQ_OUTPUT_LOW,
+                                  EPWM_AQ_OUTPUT_ON_TIMEBASE_DOWN_CMPA);
+    EPWM_setActionQualifierAction(EPWM5_BASE, EPWM_AQ_OUTPUT_B,
+                                  EPWM_AQ_OUTPUT_LOW,
+                                  EPWM_AQ_OUTPUT_ON_TIMEBASE_UP_CMPB);
+    EPWM_setActionQualifierAction(EPWM5_BASE, EPWM_AQ_OUTPUT_B,
+                                  EPWM_AQ_OUTPUT_HIGH,
+                                  EPWM_AQ_OUTPUT_ON_TIMEBASE_DOWN_CMPB);
+    PWMHR_init(EPWM5_BASE);
+    PWMDeadband_init(EPWM5_BASE);
+    SysCtl_enablePeripheral(SYSCTL_PERIPH_CLK_TBCLKSYNC);
+
+    while(PWMHR_calibrate() == PWMHR_CAL_INCOMPLETE)
+    {
+    }
+
+    statsA = Sim_EPWM_getOutputStats(EPWM5_BASE, SIM_EPWM_OUTPUT_A);
+    statsB = Sim_EPWM_getOutputStats(EPWM5_BASE, SIM_EPWM_OUTPUT_B);
+
+    //
+    // Bypassed, the outputs switch together
+    //
+    TEST_CHECK(!PWMDeadband_isEnabled(EPWM5_BASE));
+    measure();
+    TEST_CHECK(timing.pulses > 10U);
+    TEST_CHECK(statsA->fineRise == statsB->fineFall);
+    TEST_CHECK(statsA->fineFall == statsB->fineRise);
+
+    //
+    // 100 ns RED and 200 ns FED are whole counts, 10 and 20
+    //
+    rising = PWMDeadband_nsToDelay(DEVICE_SYSCLK_FREQ, 100U);
+    falling = PWMDeadband_nsToDelay(DEVICE_SYSCLK_FREQ, 200U);
+    TEST_CHECK(rising == PWMHR_COUNT(10U));
+    TEST_CHECK(falling == PWMHR_COUNT(20U));
+    PWMDeadband_setDelay(EPWM5_BASE, rising, falling, false);
+    PWMDeadband_enable(EPWM5_BASE);
+    TEST_CHECK(PWMDeadband_isEnabled(EPWM5_BASE));
+    checkDelays(rising, falling, 0);
+    TEST_CHECK(statsA->fineHighTime == (uint64_t)getFine(PWMHR_COUNT(
+                                           (2U * (PERIOD - COMPARE)) - 10U)));
+    TEST_CHECK(statsB->fineHighTime == (uint64_t)getFine(PWMHR_COUNT(
+                                           (2U * COMPARE) - 20U)));
+
+    //
+    // 103 ns and 57 ns round to the nearest half count without high
+    // resolution, 10.5 and 5.5
+    //
+    rising = PWMDeadband_nsToDelay(DEVICE_SYSCLK_FREQ, 103U);
+    falling = PWMDeadband_nsToDelay(DEVICE_SYSCLK_FREQ, 57U);
+    PWMDeadband_setDelay(EPWM5_BASE, rising, falling, false);
+    checkDelays(PWMHR_COUNT(21U) / 2U, PWMHR_COUNT(11U) / 2U, 0);
+
+    //
+    // With high resolution the MEP places them to within one of its steps
+    //
+    PWMDeadband_setDelay(EPWM5_BASE, rising, falling, true);
+    checkDelays(rising, falling,
+                (int64_t)((SIM_EPWM_FINE_ONE * 256U) /
+                          Sim_EPWM_getMEPSteps()));
+
+    //
+    // A pulse on A shorter than RED is swallowed and B stays on
+    //
+    PWMDeadband_setDelay(EPWM5_BASE, PWMHR_COUNT(20U), 0U, false);
+    PWMUpdate_setCompare(EPWM5_BASE, PERIOD - 5U, PERIOD - 5U);
+    Sim_run(SETTLE_CYCLES);
+    edges = statsA->edges;
+    Sim_run(MEASURE_CYCLES);
+    TEST_CHECK(statsA->edges == edges);
+    TEST_CHECK(statsA->level == 0U);
+    TEST_CHECK(statsB->level == 1U);
+
+    //
+    // Disabled again, the action qualifier drives both outputs
+    //
+    PWMDeadband_disable(EPWM5_BASE);
+    PWMUpdate_setCompare(EPWM5_BASE, COMPARE, COMPARE);
+    TEST_CHECK(!PWMDeadband_isEnabled(EPWM5_BASE));
+    measure();
+    TEST_CHECK(statsA->fineRise == statsB->fineFall);
+    TEST_CHECK(statsA->fineFall == statsB->fineRise);
+    TEST_CHECK(statsA->fineHighTime == (uint64_t)getFine(PWMHR_COUNT(
+                                           2U * (PERIOD - COMPARE))));
+
+    return(Test_report("test_deadband"));
+}
+
+//
+// edgeCallback - Times each rising edge of ePWM5A and ePWM5B from the last
+// falling edge of the other output
+//
+static void edgeCallback(uint32_t base, uint16_t output, uint16_t level,
+                         uint64_t cycle)
+{
+    const Sim_EPWM_OutputStats *self;
+    const Sim_EPWM_OutputStats *other;
+    int64_t gap;
+
+    (void)cycle;
+
+    if((base != EPWM5_BASE) || (level == 0U))
+    {
+        return;
+    }
+
+    self = Sim_EPWM_getOutputStats(base, output);
+    other = Sim_EPWM_getOutputStats(base, output ^ 1U);
+    gap = (int64_t)self->fineRise - (int64_t)other->fineFall;
+
+    if(other->level != 0U)
+    {
+        timing.overlaps++;
+    }
+    if(gap < timing.minGap[output])
+    {
+        timing.minGap[output] = gap;
+    }
+    if(gap > timing.maxGap[output])
+    {
+        timing.maxGap[output] = gap;
+    }
+
+    if(output == SIM_EPWM_OUTPUT_A)
+    {
+        risesA++;
+    }
+    else
+    {
+        risesB++;
+    }
+}
+
+//
+// measure - Lets a change take effect and times the edges that follow
+//
+static void measure(void)
+{
+    uint16_t i;
+
+    Sim_run(SETTLE_CYCLES);
+
+    for(i = 0U; i < 2U; i++)
+    {
+        timing.minGap[i] = INT64_MAX;
+        timing.maxGap[i] = INT64_MIN;
+    }
+    timing.overlaps = 0U;
+    risesA = 0U;
+    risesB = 0U;
+
+    Sim_run(MEASURE_CYCLES);
+
+    timing.pulses = (risesA < risesB) ? risesA : risesB;
+}
+
+//
+// checkDelays - Checks that A rises RED after B fell and B rises FED after
+// A fell, on every edge and without overlap
+//
+static void checkDelays(uint32_t rising, uint32_t falling, int64_t tolerance)
+{
+    measure();
+    TEST_CHECK(timing.pulses > 10U);
+    TEST_CHECK(timing.overlaps == 0U);
+    TEST_CHECK(timing.minGap[SIM_EPWM_OUTPUT_A] >= (getFine(rising) -
+                                                    tolerance));
+    TEST_CHECK(timing.maxGap[SIM_EPWM_OUTPUT_A] <= (getFine(rising) +
+                                                    tolerance));
+    TEST_CHECK(timing.minGap[SIM_EPWM_OUTPUT_B] >= (getFine(falling) -
+                                                    tolerance));
+    TEST_CHECK(timing.maxGap[SIM_EPWM_OUTPUT_B] <= (getFine(falling) +
+                                                    tolerance));
+}
+
+//
+// getFine - Converts HR counts to the fine cycles of the ePWM model
+//
+static int64_t getFine(uint32_t delay)
+{
+    return(((int64_t)delay * (int64_t)SIM_EPWM_FINE_ONE) / 256);
+}
+
+//
+// End of File
+//
@@ -0,0 +1,143 @@
+//###########################################################################
+//
+// FILE:   test_duty.c
+//
+// TITLE:  Q15 duty cycle conversion against double precision.
+//
+//###########################################################################
+
+//
+// Included Files
+//
+#include "test.h"
+#include <math.h>
+#include <stdlib.h>
+#include "pwm_duty.h"
+
+//
+// Defines
+//
+#define PERIOD_MIN          500U
+#define PERIOD_MAX          1500U
+#define DUTY_STEP           PWMDUTY_Q15(0.005)
+#define DUTY_MAX            PWMDUTY_Q15(0.90)
+
+//
+// Function Prototypes
+//
+static uint16_t getRoundedCount(uint16_t period, double duty);
+
+//
+// Main
+//
+int main(void)
+{
+    uint32_t mismatches = 0U;
+    uint32_t roundTrips = 0U;
+    uint32_t drifts = 0U;
+    uint16_t upCounts[DUTY_MAX / DUTY_STEP];
+    uint16_t period;
+    uint16_t duty;
+    uint16_t count;
+    uint16_t steps;
+    uint16_t i;
+    uint32_t d;
+    double track;
+
+    //
+    // Every duty value at every period rounds as period * duty does in
+    // double precision, which holds the product exactly
+    //
+    for(period = PERIOD_MIN; period <= PERIOD_MAX; period++)
+    {
+        for(d = 0U; d <= PWMDUTY_ONE; d++)
+        {
+            if(PWMDuty_toCount(period, (uint16_t)d) !=
+               getRoundedCount(period, (double)d / PWMDUTY_ONE))
+            {
+                mismatches++;
+            }
+        }
+
+        //
+        // Duty cycles above 100% give the period, and every count survives
+        // the way back through a duty cycle
+        //
+        TEST_CHECK(PWMDuty_toCount(period, 0xFFFFU) == period);
+        for(count = 0U; count <= period; count++)
+        {
+            if(PWMDuty_toCount(period, PWMDuty_fromCount(period, count)) !=
+               count)
+            {
+                roundTrips++;
+            }
+        }
+    }
+    TEST_CHECK(mismatches == 0U);
+    TEST_CHECK(roundTrips == 0U);
+    TEST_CHECK(PWMDuty_fromCount(0U, 10U) == 0U);
+
+    //
+    // Every duty cycle the menu reaches from 50% by whole steps: the counts
+    // on the way back down repeat those on the way up, and stay within a
+    // count of a duty cycle tracked in double precision with the same steps.
+    // Past the last whole step the limits hold.
+    //
+    for(period = PERIOD_MIN; period <= PERIOD_MAX; period++)
+    {
+        duty = PWMDUTY_Q15(0.5);
+        track = 0.5;
+        steps = 0U;
+        while((duty + DUTY_STEP) <= DUTY_MAX)
+        {
+            upCounts[steps] = PWMDuty_toCount(period, duty);
+            if(abs((int)upCounts[steps] - (int)getRoundedCount(period, track)) >
+               1)
+            {
+                drifts++;
+            }
+            duty = PWMDuty_step(duty, (int16_t)DUTY_STEP, 0U, DUTY_MAX);
+            track += 0.005;
+            steps++;
+        }
+
+        for(i = steps; i > 0U; i--)
+        {
+            duty = PWMDuty_step(duty, -(int16_t)DUTY_STEP, 0U, DUTY_MAX);
+            track -= 0.005;
+            TEST_CHECK(PWMDuty_toCount(period, duty) == upCounts[i - 1U]);
+            if(abs((int)PWMDuty_toCount(period, duty) -
+                   (int)getRoundedCount(period, track)) > 1)
+            {
+                drifts++;
+            }
+        }
+        TEST_CHECK(duty == PWMDUTY_Q15(0.5));
+
+        for(i = 0U; i <= (DUTY_MAX / DUTY_STEP); i++)
+        {
+            duty = PWMDuty_step(duty, (int16_t)DUTY_STEP, 0U, DUTY_MAX);
+        }
+        TEST_CHECK(duty == DUTY_MAX);
+        for(i = 0U; i <= (DUTY_MAX / DUTY_STEP); i++)
+        {
+            duty = PWMDuty_step(duty, -(int16_t)DUTY_STEP, 0U, DUTY_MAX);
+        }
+        TEST_CHECK(PWMDuty_toCount(period, duty) == 0U);
+    }
+    TEST_CHECK(drifts == 0U);
+
+    return(Test_report("test_duty"));
+}
+
+//
+// getRoundedCount - Returns period * duty rounded to nearest, ties up
+//
+static uint16_t getRoundedCount(uint16_t period, double duty)
+{
+    return((uint16_t)floor(((double)period * duty) + 0.5));
+}
+
+//
+// End of File
+//
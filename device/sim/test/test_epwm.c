@@ -0,0 +1,151 @@
+//###########################################################################
+//
+// FILE:   test_epwm.c
+//
+// TITLE:  Time base, action qualifier and interrupts of the ePWM model.
+//
+//###########################################################################
+
+//
+// Included Files
+//
+#include "test.h"
+
+//
+// Globals
+//
+static uint32_t epwm5Interrupts;
+
+//
+// Function Prototypes
+//
+static void initModule(uint32_t base, EPWM_TimeBaseCountMode mode,
+                       uint16_t period, uint16_t compare);
+static void epwm5ISR(void);
+
+//
+// Main
+//
+int main(void)
+{
+    const Sim_EPWM_OutputStats *stats;
+    uint16_t compare;
+
+    //
+    // Up-down: a period of 2 * TBPRD, high from CMPA up to CMPA down
+    //
+    Test_initSim();
+    SysCtl_disablePeripheral(SYSCTL_PERIPH_CLK_TBCLKSYNC);
+    initModule(EPWM5_BASE, EPWM_COUNTER_MODE_UP_DOWN, 850U, 425U);
+    EPWM_setActionQualifierAction(EPWM5_BASE, EPWM_AQ_OUTPUT_A,
+                                  EPWM_AQ_OUTPUT_HIGH,
+                                  EPWM_AQ_OUTPUT_ON_TIMEBASE_UP_CMPA);
+    EPWM_setActionQualifierAction(EPWM5_BASE, EPWM_AQ_OUTPUT_A,
+                                  EPWM_AQ_OUTPUT_LOW,
+                                  EPWM_AQ_OUTPUT_ON_TIMEBASE_DOWN_CMPA);
+
+    //
+    // Up: a period of TBPRD + 1, high from zero to CMPA
+    //
+    initModule(EPWM1_BASE, EPWM_COUNTER_MODE_UP, 999U, 250U);
+    EPWM_setActionQualifierAction(EPWM1_BASE, EPWM_AQ_OUTPUT_A,
+                                  EPWM_AQ_OUTPUT_HIGH,
+                                  EPWM_AQ_OUTPUT_ON_TIMEBASE_ZERO);
+    EPWM_setActionQualifierAction(EPWM1_BASE, EPWM_AQ_OUTPUT_A,
+                                  EPWM_AQ_OUTPUT_LOW,
+                                  EPWM_AQ_OUTPUT_ON_TIMEBASE_UP_CMPA);
+
+    //
+    // Down with TBCLK = SYSCLK / 4: high from TBPRD down to CMPA
+    //
+    initModule(EPWM2_BASE, EPWM_COUNTER_MODE_DOWN, 499U, 100U);
+    EPWM_setClockPrescaler(EPWM2_BASE, EPWM_CLOCK_DIVIDER_4,
+                           EPWM_HSCLOCK_DIVIDER_1);
+    EPWM_setActionQualifierAction(EPWM2_BASE, EPWM_AQ_OUTPUT_A,
+                                  EPWM_AQ_OUTPUT_HIGH,
+                                  EPWM_AQ_OUTPUT_ON_TIMEBASE_PERIOD);
+    EPWM_setActionQualifierAction(EPWM2_BASE, EPWM_AQ_OUTPUT_A,
+                                  EPWM_AQ_OUTPUT_LOW,
+                                  EPWM_AQ_OUTPUT_ON_TIMEBASE_DOWN_CMPA);
+
+    //
+    // Interrupt of ePWM5 on every third counter zero
+    //
+    Interrupt_register(INT_EPWM5, &epwm5ISR);
+    EPWM_setInterruptSource(EPWM5_BASE, EPWM_INT_TBCTR_ZERO);
+    EPWM_setInterruptEventCount(EPWM5_BASE, 3U);
+    EPWM_enableInterrupt(EPWM5_BASE);
+    Interrupt_enable(INT_EPWM5);
+    EINT;
+
+    SysCtl_enablePeripheral(SYSCTL_PERIPH_CLK_TBCLKSYNC);
+    Sim_run(1700UL * 3000UL);
+
+    stats = Sim_EPWM_getOutputStats(EPWM5_BASE, SIM_EPWM_OUTPUT_A);
+    TEST_CHECK(stats->period == 1700U);
+    TEST_CHECK(stats->highTime == 850U);
+    TEST_CHECK(Sim_EPWM_getPeriodCount(EPWM5_BASE) == 3000U);
+    TEST_CHECK(epwm5Interrupts == 1000U);
+
+    stats = Sim_EPWM_getOutputStats(EPWM1_BASE, SIM_EPWM_OUTPUT_A);
+    TEST_CHECK(stats->period == 1000U);
+    TEST_CHECK(stats->highTime == 250U);
+
+    stats = Sim_EPWM_getOutputStats(EPWM2_BASE, SIM_EPWM_OUTPUT_A);
+    TEST_CHECK(stats->period == 2000U);
+    TEST_CHECK(stats->highTime == (4U * (499U - 100U)));
+
+    //
+    // A shadowed compare write takes effect at the next counter zero, not
+    // in the period it was written in
+    //
+    Sim_run(500U);
+    EPWM_setCounterCompareValue(EPWM1_BASE, EPWM_COUNTER_COMPARE_A, 600U);
+    Sim_EPWM_getActiveValues(EPWM1_BASE, NULL, &compare, NULL);
+    TEST_CHECK(compare == 250U);
+    Sim_run(1000U);
+    Sim_EPWM_getActiveValues(EPWM1_BASE, NULL, &compare, NULL);
+    TEST_CHECK(compare == 600U);
+    Sim_run(2000U);
+    stats = Sim_EPWM_getOutputStats(EPWM1_BASE, SIM_EPWM_OUTPUT_A);
+    TEST_CHECK(stats->highTime == 600U);
+
+    //
+    // TBCTR reads back the live counter
+    //
+    TEST_CHECK(HWREGH(EPWM1_BASE + EPWM_O_TBCTR) ==
+               (uint16_t)(Sim_getCycles() % 1000U));
+
+    return(Test_report("test_epwm"));
+}
+
+//
+// initModule - Sets up the time base and compare A of a module
+//
+static void initModule(uint32_t base, EPWM_TimeBaseCountMode mode,
+                       uint16_t period, uint16_t compare)
+{
+    EPWM_setTimeBasePeriod(base, period);
+    EPWM_setPhaseShift(base, 0U);
+    EPWM_setTimeBaseCounter(base, 0U);
+    EPWM_setCounterCompareValue(base, EPWM_COUNTER_COMPARE_A, compare);
+    EPWM_setTimeBaseCounterMode(base, mode);
+    EPWM_setClockPrescaler(base, EPWM_CLOCK_DIVIDER_1,
+                           EPWM_HSCLOCK_DIVIDER_1);
+    EPWM_setCounterCompareShadowLoadMode(base, EPWM_COUNTER_COMPARE_A,
+                                         EPWM_COMP_LOAD_ON_CNTR_ZERO);
+}
+
+//
+// epwm5ISR - Counts the interrupts of ePWM5
+//
+static void epwm5ISR(void)
+{
+    epwm5Interrupts++;
+    EPWM_clearEventTriggerInterruptFlag(EPWM5_BASE);
+    Interrupt_clearACKGroup(INTERRUPT_ACK_GROUP3);
+}
+
+//
+// End of File
+//
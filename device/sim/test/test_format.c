@@ -0,0 +1,317 @@
+//###########################################################################
+//
+// FILE:   test_format.c
+//
+// TITLE:  Number formatters against the printf family.
+//
+//###########################################################################
+//
+// Formats random numbers, widths and flags, and the edge values of every
+// type, with the SCIFormat functions and with snprintf() and checks that
+// the characters and the returned length agree. Fixed-point values are
+// compared with snprintf() of their integer and fractional parts, and
+// binary fixed-point values with snprintf() of %.nf, except at exact
+// halves: snprintf() rounds those to even and SCIFormat_q() away from
+// zero, so there the magnitude is rounded in integers first. The queued
+// variants must send the same characters through the simulated SCIA.
+//
+//###########################################################################
+
+//
+// Included Files
+//
+#include "test.h"
+#include <string.h>
+#include "sci_buffer.h"
+#include "sci_format.h"
+
+//
+// Defines
+//
+#define CASES           400000UL
+#define REFERENCE_SIZE  64U
+#define NUM_EDGES       11U
+#define SENT_SIZE       256U
+
+//
+// Globals
+//
+static const uint32_t edges[NUM_EDGES] =
+{
+    0UL, 1UL, 9UL, 10UL, 99UL, 100UL, 999999999UL, 1000000000UL,
+    0x7FFFFFFFUL, 0x80000000UL, 0xFFFFFFFFUL
+};
+static uint32_t randomState = 1U;
+static unsigned long mismatches;
+static char sent[SENT_SIZE];
+static uint16_t sentCount;
+
+//
+// Function Prototypes
+//
+static uint32_t getRandom(void);
+static uint32_t getValue(void);
+static void makeFormat(char *format, uint16_t flags, uint16_t width,
+                       const char *conversion);
+static void formatFixed(char *out, int32_t value, uint64_t magnitude,
+                        uint16_t fraction, uint16_t width, uint16_t flags);
+static void compare(const char *kind, uint32_t value, const char *expected,
+                    const char *result, uint16_t length);
+static void txCallback(uint32_t base, uint16_t data, uint64_t cycle);
+
+//
+// Main
+//
+int main(void)
+{
+    char expected[REFERENCE_SIZE];
+    char result[SCIFORMAT_BUFFER_SIZE];
+    char format[16];
+    uint64_t magnitude;
+    uint64_t scale;
+    uint32_t value;
+    uint32_t i;
+    uint16_t width;
+    uint16_t flags;
+    uint16_t fraction;
+    uint16_t qBits;
+    uint16_t length;
+    uint16_t j;
+
+    for(i = 0U; i < CASES; i++)
+    {
+        value = getValue();
+        width = (uint16_t)(getRandom() % (SCIFORMAT_MAX_WIDTH + 1U));
+        flags = (uint16_t)(getRandom() & 0xFU);
+
+        //
+        // Unsigned and hexadecimal have no sign to force
+        //
+        makeFormat(format, flags & ~SCIFORMAT_PLUS, width, "lu");
+        snprintf(expected, sizeof(expected), format, (unsigned long)value);
+        length = SCIFormat_unsigned(result, value, width,
+                                    flags & ~(SCIFORMAT_PLUS |
+                                              SCIFORMAT_UPPER));
+        compare("unsigned", value, expected, result, length);
+
+        makeFormat(format, flags, width, "ld");
+        snprintf(expected, sizeof(expected), format, (long)(int32_t)value);
+        length = SCIFormat_signed(result, (int32_t)value, width,
+                                  flags & ~SCIFORMAT_UPPER);
+        compare("signed", value, expected, result, length);
+
+        makeFormat(format, flags & ~SCIFORMAT_PLUS, width,
+                   ((flags & SCIFORMAT_UPPER) != 0U) ? "lX" : "lx");
+        snprintf(expected, sizeof(expected), format, (unsigned long)value);
+        length = SCIFormat_hex(result, value, width, flags & ~SCIFORMAT_PLUS);
+        compare("hex", value, expected, result, length);
+
+        //
+        // Decimal fixed point
+        //
+        fraction = (uint16_t)(getRandom() % (SCIFORMAT_MAX_FRACTION + 1U));
+        magnitude = (uint64_t)(((int32_t)value < 0) ?
+                               -(int64_t)(int32_t)value : (int64_t)value);
+        formatFixed(expected, (int32_t)value, magnitude, fraction, width,
+                    flags & ~SCIFORMAT_UPPER);
+        length = SCIFormat_fixed(result, (int32_t)value, fraction, width,
+                                 flags & ~SCIFORMAT_UPPER);
+        compare("fixed", value, expected, result, length);
+
+        //
+        // Binary fixed point
+        //
+        qBits = (uint16_t)(getRandom() % (SCIFORMAT_MAX_Q + 1U));
+        fraction = (uint16_t)(getRandom() % (SCIFORMAT_MAX_Q_FRACTION + 1U));
+        for(scale = 1U, j = 0U; j < fraction; j++)
+        {
+            scale *= 10U;
+        }
+        magnitude *= scale;
+        if((qBits != 0U) &&
+           ((magnitude & ((1ULL << qBits) - 1U)) == (1ULL << (qBits - 1U))))
+        {
+            magnitude = (magnitude + (1ULL << (qBits - 1U))) >> qBits;
+            formatFixed(expected, (int32_t)value, magnitude, fraction, width,
+                        flags & ~SCIFORMAT_UPPER);
+        }
+        else
+        {
+            makeFormat(format, flags & ~SCIFORMAT_UPPER, width, "");
+            sprintf(&format[strlen(format)], ".%uf", (unsigned int)fraction);
+            snprintf(expected, sizeof(expected), format,
+                     (double)(int32_t)value / (double)(1UL << qBits));
+        }
+        length = SCIFormat_q(result, (int32_t)value, qBits, fraction, width,
+                             flags & ~SCIFORMAT_UPPER);
+        compare("q", value, expected, result, length);
+    }
+    TEST_CHECK(mismatches == 0UL);
+
+    //
+    // The queued variants send what the array variants return
+    //
+    Test_initSim();
+    Test_initSCI(SCIA_BASE, 115200U);
+    Sim_SCI_setTxCallback(&txCallback);
+    SCIBuffer_init(SCIA_BASE);
+    EINT;
+
+    length = SCIFormat_writeUnsigned(4294967295UL, 12U, 0U);
+    length += SCIFormat_writeSigned(-2147483647L - 1L, 0U, 0U);
+    length += SCIFormat_writeHex(0xBEEFUL, 8U,
+                                 SCIFORMAT_ZERO | SCIFORMAT_UPPER);
+    length += SCIFormat_writeFixed(-5L, 3U, 8U, SCIFORMAT_LEFT);
+    length += SCIFormat_writeQ(24576L, 15U, 3U, 0U, SCIFORMAT_PLUS);
+    while(!SCIBuffer_isTxIdle())
+    {
+        Sim_run(DEVICE_SYSCLK_FREQ / 1000U);
+    }
+    sent[sentCount] = '\0';
+    TEST_CHECK(strcmp(sent, "  4294967295-21474836480000BEEF-0.005  "
+                            "+0.750") == 0);
+    TEST_CHECK(sentCount == length);
+
+    return(Test_report("test_format"));
+}
+
+//
+// getRandom - Returns the next value of a 32-bit xorshift generator
+//
+static uint32_t getRandom(void)
+{
+    randomState ^= randomState << 13U;
+    randomState ^= randomState >> 17U;
+    randomState ^= randomState << 5U;
+
+    return(randomState);
+}
+
+//
+// getValue - Returns a random number of random size, a small signed one or
+// an edge value
+//
+static uint32_t getValue(void)
+{
+    switch(getRandom() % 4U)
+    {
+        case 0U:
+            return(getRandom());
+
+        case 1U:
+            return(getRandom() >> (getRandom() % 32U));
+
+        case 2U:
+            return((uint32_t)((int32_t)(getRandom() % 2001U) - 1000));
+
+        default:
+            return(edges[getRandom() % NUM_EDGES]);
+    }
+}
+
+//
+// makeFormat - Writes the printf conversion with the same flags and width
+//
+static void makeFormat(char *format, uint16_t flags, uint16_t width,
+                       const char *conversion)
+{
+    sprintf(format, "%%%s%s%s%u%s",
+            ((flags & SCIFORMAT_LEFT) != 0U) ? "-" : "",
+            ((flags & SCIFORMAT_PLUS) != 0U) ? "+" : "",
+            ((flags & SCIFORMAT_ZERO) != 0U) ? "0" : "",
+            (unsigned int)width, conversion);
+}
+
+//
+// formatFixed - Formats the magnitude of a value in units of its last
+// fractional digit with snprintf(), signed and padded as printf would
+//
+static void formatFixed(char *out, int32_t value, uint64_t magnitude,
+                        uint16_t fraction, uint16_t width, uint16_t flags)
+{
+    char number[REFERENCE_SIZE];
+    const char *sign;
+    uint64_t scale = 1U;
+    uint16_t length;
+    uint16_t pad;
+    uint16_t j;
+
+    for(j = 0U; j < fraction; j++)
+    {
+        scale *= 10U;
+    }
+
+    sign = (value < 0) ? "-" : (((flags & SCIFORMAT_PLUS) != 0U) ? "+" : "");
+    if(fraction == 0U)
+    {
+        snprintf(number, sizeof(number), "%llu",
+                 (unsigned long long)magnitude);
+    }
+    else
+    {
+        snprintf(number, sizeof(number), "%llu.%0*llu",
+                 (unsigned long long)(magnitude / scale), (int)fraction,
+                 (unsigned long long)(magnitude % scale));
+    }
+
+    length = (uint16_t)(strlen(sign) + strlen(number));
+    pad = (width > length) ? (uint16_t)(width - length) : (uint16_t)0U;
+    out[0] = '\0';
+    if((flags & (SCIFORMAT_LEFT | SCIFORMAT_ZERO)) == 0U)
+    {
+        memset(out, ' ', pad);
+        out[pad] = '\0';
+    }
+    strcat(out, sign);
+    if((flags & (SCIFORMAT_LEFT | SCIFORMAT_ZERO)) == SCIFORMAT_ZERO)
+    {
+        length = (uint16_t)strlen(out);
+        memset(&out[length], '0', pad);
+        out[length + pad] = '\0';
+    }
+    strcat(out, number);
+    if((flags & SCIFORMAT_LEFT) != 0U)
+    {
+        length = (uint16_t)strlen(out);
+        memset(&out[length], ' ', pad);
+        out[length + pad] = '\0';
+    }
+}
+
+//
+// compare - Counts and shows the first few results that differ from the
+// reference
+//
+static void compare(const char *kind, uint32_t value, const char *expected,
+                    const char *result, uint16_t length)
+{
+    if((strcmp(expected, result) != 0) || (length != strlen(result)))
+    {
+        if(mismatches < 20UL)
+        {
+            printf("%s of 0x%08lX: expected \"%s\", got \"%s\" (%u)\n", kind,
+                   (unsigned long)value, expected, result,
+                   (unsigned int)length);
+        }
+        mismatches++;
+    }
+}
+
+//
+// txCallback - Records the characters the SCI model shifts out
+//
+static void txCallback(uint32_t base, uint16_t data, uint64_t cycle)
+{
+    (void)base;
+    (void)cycle;
+
+    if(sentCount < (SENT_SIZE - 1U))
+    {
+        sent[sentCount] = (char)data;
+        sentCount++;
+    }
+}
+
+//
+// End of File
+//
@@ -0,0 +1,365 @@
+//###########################################################################
+//
+// FILE:   test_hr.c
+//
+// TITLE:  Effective resolution of the high-resolution ePWM control.
+//
+//###########################################################################
+//
+// Runs ePWM5 as the application does, up-down at TBPRD = 850 with the MEP
+// moving both edges of ePWM5A, and measures the width of its pulse from
+// the fine edge times of the ePWM model. The pulse is centred on the
+// period, so each edge sits half the width error away from where the HR
+// compare value puts it.
+//
+// - The 256 fractions of one count must give one distinct edge per MEP
+//   step of the count, each within 0.025 cycles of where it belongs.
+// - A sweep of every Q15 duty cycle over ten counts must give a distinct,
+//   monotonic pulse width per duty value, within the same error.
+// - With the step size of the simulated silicon drifted by 20%, the stale
+//   scale factor must show as a large edge error, and PWMHR_calibrate()
+//   must bring it back.
+// - PWMHR_periodFromFrequency() must round like the exact quotient, clamp
+//   at both ends, and give the frequency asked for on the output.
+//
+//###########################################################################
+
+//
+// Included Files
+//
+#include "test.h"
+#include <math.h>
+#include "pwm_hr.h"
+#include "pwm_update.h"
+
+//
+// Defines
+//
+#define PERIOD              850U
+#define SETTLE_CYCLES       (4U * 2U * PERIOD)  // Four periods
+#define SWEEP_COUNT         425U        // Compare of the fraction sweep
+#define DUTY_FIRST_COUNT    400U        // Counts of the duty sweep
+#define DUTY_LAST_COUNT     410U
+#define MAX_EDGE_ERROR      0.025       // SYSCLK cycles
+#define DRIFT_EDGE_ERROR    0.1         // SYSCLK cycles
+#define FREQUENCIES         2000U
+#define WINDOW_CYCLES       2000000U
+#define FREQUENCY_PPM       10.0
+
+//
+// Globals
+//
+static uint64_t lastRise;
+static uint64_t lastWidth;
+static uint32_t widths;
+static uint32_t rises;
+static uint64_t firstRise;
+static uint32_t randomState = 1U;
+
+//
+// Function Prototypes
+//
+static uint32_t getRandom(void);
+static void edgeCallback(uint32_t base, uint16_t output, uint16_t level,
+                         uint64_t cycle);
+static void initEPWM5(void);
+static void calibrate(void);
+static double getEdgeError(uint32_t compare);
+static double sweepFraction(uint32_t *distinct);
+static void checkDutySweep(void);
+static void checkDrift(void);
+static void checkFrequency(void);
+
+//
+// Main
+//
+int main(void)
+{
+    uint32_t distinct;
+
+    Test_initSim();
+    Sim_EPWM_setEdgeCallback(&edgeCallback);
+    initEPWM5();
+    calibrate();
+    TEST_CHECK(PWMHR_getScaleFactor() ==
+               ((SIM_EPWM_MEP_STEPS_DEFAULT + 0x80U) >> 8U));
+
+    //
+    // One edge per MEP step of a count, 67 at the default step size
+    //
+    TEST_CHECK(sweepFraction(&distinct) < MAX_EDGE_ERROR);
+    TEST_CHECK(distinct ==
+               (((SIM_EPWM_MEP_STEPS_DEFAULT + 0x80U) >> 8U) + 1U));
+
+    checkDutySweep();
+    checkDrift();
+    checkFrequency();
+
+    return(Test_report("test_hr"));
+}
+
+//
+// getRandom - Returns the next value of a 32-bit xorshift generator
+//
+static uint32_t getRandom(void)
+{
+    randomState ^= randomState << 13U;
+    randomState ^= randomState >> 17U;
+    randomState ^= randomState << 5U;
+
+    return(randomState);
+}
+
+//
+// edgeCallback - Records the fine width of each ePWM5A pulse and counts
+// its rising edges
+//
+static void edgeCallback(uint32_t base, uint16_t output, uint16_t level,
+                         uint64_t cycle)
+{
+    const Sim_EPWM_OutputStats *stats;
+
+    (void)cycle;
+
+    if((base != EPWM5_BASE) || (output != SIM_EPWM_OUTPUT_A))
+    {
+        return;
+    }
+
+    stats = Sim_EPWM_getOutputStats(base, output);
+    if(level != 0U)
+    {
+        lastRise = stats->fineRise;
+        if(rises == 0U)
+        {
+            firstRise = lastRise;
+        }
+        rises++;
+    }
+    else if(lastRise != 0U)
+    {
+        lastWidth = stats->fineFall - lastRise;
+        widths++;
+    }
+}
+
+//
+// initEPWM5 - Sets ePWM5 up for high-resolution control as the application
+// does: up-down count, ePWM5A high between the CMPA matches
+//
+static void initEPWM5(void)
+{
+    SysCtl_disablePeripheral(SYSCTL_PERIPH_CLK_TBCLKSYNC);
+    EPWM_setTimeBasePeriod(EPWM5_BASE, PERIOD);
+    EPWM_setTimeBaseCounter(EPWM5_BASE, 0U);
+    EPWM_setTimeBaseCounterMode(EPWM5_BASE, EPWM_COUNTER_MODE_UP_DOWN);
+    EPWM_setClockPrescaler(EPWM5_BASE, EPWM_CLOCK_DIVIDER_1,
+                           EPWM_HSCLOCK_DIVIDER_1);
+    EPWM_setCounterCompareValue(EPWM5_BASE, EPWM_COUNTER_COMPARE_A,
+                                SWEEP_COUNT);
+    EPWM_setCounterCompareValue(EPWM5_BASE, EPWM_COUNTER_COMPARE_B,
+                                SWEEP_COUNT);
+    EPWM_setActionQualifierAction(EPWM5_BASE, EPWM_AQ_OUTPUT_A,
+                                  EPWM_AQ_OUTPUT_HIGH,
+                                  EPWM_AQ_OUTPUT_ON_TIMEBASE_UP_CMPA);
+    EPWM_setActionQualifierAction(EPWM5_BASE, EPWM_AQ_OUTPUT_A,
+                                  EPWM_AQ_OUTPUT_LOW,
+                                  EPWM_AQ_OUTPUT_ON_TIMEBASE_DOWN_CMPA);
+    PWMUpdate_init(EPWM5_BASE);
+    PWMHR_init(EPWM5_BASE);
+    SysCtl_enablePeripheral(SYSCTL_PERIPH_CLK_TBCLKSYNC);
+}
+
+//
+// calibrate - Runs the scale factor calibration until it completes
+//
+static void calibrate(void)
+{
+    uint16_t status;
+
+    do
+    {
+        status = PWMHR_calibrate();
+    }
+    while(status == PWMHR_CAL_INCOMPLETE);
+
+    TEST_CHECK(status == PWMHR_CAL_COMPLETE);
+}
+
+//
+// getEdgeError - Loads a compare value and returns how far, in SYSCLK
+// cycles, each edge of the pulse is from where the value puts it
+//
+static double getEdgeError(uint32_t compare)
+{
+    int64_t ideal;
+
+    PWMHR_setPeriodAndCompare(EPWM5_BASE, PWMHR_COUNT(PERIOD), compare,
+                              compare);
+    widths = 0U;
+    Sim_run(SETTLE_CYCLES);
+    TEST_CHECK(widths >= 2U);
+
+    //
+    // 2 * (TBPRD - CMPA) counts, in fine time
+    //
+    ideal = 2 * ((int64_t)PWMHR_COUNT(PERIOD) - (int64_t)compare) *
+            (SIM_EPWM_FINE_ONE >> PWMHR_COUNT_S);
+
+    return(fabs((double)((int64_t)lastWidth - ideal)) / 2.0 /
+           SIM_EPWM_FINE_ONE);
+}
+
+//
+// sweepFraction - Steps CMPAHR through one count and returns the worst
+// edge error and the number of distinct pulse widths
+//
+static double sweepFraction(uint32_t *distinct)
+{
+    uint64_t previous = 0U;
+    double error;
+    double worst = 0.0;
+    uint32_t fraction;
+
+    *distinct = 0U;
+    for(fraction = 0U; fraction < PWMHR_COUNT_ONE; fraction++)
+    {
+        error = getEdgeError(PWMHR_COUNT(SWEEP_COUNT) + fraction);
+        worst = fmax(worst, error);
+        if((fraction == 0U) || (lastWidth != previous))
+        {
+            (*distinct)++;
+        }
+        previous = lastWidth;
+    }
+
+    return(worst);
+}
+
+//
+// checkDutySweep - Steps every Q15 duty cycle whose compare value lies in
+// ten counts and checks that each one moves the edges
+//
+static void checkDutySweep(void)
+{
+    uint32_t period = PWMHR_COUNT(PERIOD);
+    uint32_t compare;
+    uint64_t previous = 0U;
+    uint32_t steps = 0U;
+    uint32_t errors = 0U;
+    double worst = 0.0;
+    uint16_t duty;
+
+    duty = (uint16_t)(((uint32_t)DUTY_FIRST_COUNT * PWMDUTY_ONE) / PERIOD);
+    for(;; duty++)
+    {
+        compare = PWMHR_dutyToCount(period, duty);
+        if(compare >= PWMHR_COUNT(DUTY_LAST_COUNT))
+        {
+            break;
+        }
+        if(compare < PWMHR_COUNT(DUTY_FIRST_COUNT))
+        {
+            continue;
+        }
+
+        worst = fmax(worst, getEdgeError(compare));
+        if((steps != 0U) && (lastWidth >= previous))
+        {
+            errors++;
+        }
+        previous = lastWidth;
+        steps++;
+    }
+
+    //
+    // 32768 / 850 = 38.6 duty values per count, all of them distinct
+    //
+    TEST_CHECK(errors == 0U);
+    TEST_CHECK(steps >= (38U * (DUTY_LAST_COUNT - DUTY_FIRST_COUNT)));
+    TEST_CHECK(worst < MAX_EDGE_ERROR);
+}
+
+//
+// checkDrift - Drifts the MEP step size of the simulated silicon and
+// checks that calibration takes the edge error back down
+//
+static void checkDrift(void)
+{
+    uint32_t distinct;
+    uint32_t steps = (SIM_EPWM_MEP_STEPS_DEFAULT * 6U) / 5U;
+
+    Sim_EPWM_setMEPSteps(steps);
+    TEST_CHECK(sweepFraction(&distinct) > DRIFT_EDGE_ERROR);
+
+    calibrate();
+    TEST_CHECK(PWMHR_getScaleFactor() == ((steps + 0x80U) >> 8U));
+    TEST_CHECK(sweepFraction(&distinct) < MAX_EDGE_ERROR);
+    TEST_CHECK(distinct == (((steps + 0x80U) >> 8U) + 1U));
+
+    Sim_EPWM_setMEPSteps(SIM_EPWM_MEP_STEPS_DEFAULT);
+    calibrate();
+}
+
+//
+// checkFrequency - Checks the period conversion against the exact quotient
+// and on the output
+//
+static void checkFrequency(void)
+{
+    uint32_t frequency;
+    uint32_t period;
+    uint32_t errors = 0U;
+    uint32_t i;
+    double expected;
+    double measured;
+
+    for(i = 0U; i < FREQUENCIES; i++)
+    {
+        frequency = 1000U + (getRandom() % 999000U);
+        expected = floor(((double)DEVICE_SYSCLK_FREQ * PWMHR_COUNT_ONE /
+                          (2.0 * frequency)) + 0.5);
+        if(PWMHR_periodFromFrequency(DEVICE_SYSCLK_FREQ, frequency) !=
+           (uint32_t)expected)
+        {
+            errors++;
+        }
+    }
+    TEST_CHECK(errors == 0U);
+
+    //
+    // Out of range: no frequency, below the longest period and above the
+    // shortest
+    //
+    TEST_CHECK(PWMHR_periodFromFrequency(DEVICE_SYSCLK_FREQ, 0U) ==
+               PWMHR_COUNT_MAX);
+    TEST_CHECK(PWMHR_periodFromFrequency(DEVICE_SYSCLK_FREQ, 100U) ==
+               PWMHR_COUNT_MAX);
+    TEST_CHECK(PWMHR_periodFromFrequency(DEVICE_SYSCLK_FREQ,
+                                         DEVICE_SYSCLK_FREQ / 2U) ==
+               PWMHR_COUNT(2U));
+
+    //
+    // The application's 58.8 kHz and a frequency whose period has a
+    // fraction, measured over whole periods of the output
+    //
+    for(i = 0U; i < 2U; i++)
+    {
+        frequency = (i == 0U) ? 58800U : 61234U;
+        period = PWMHR_periodFromFrequency(DEVICE_SYSCLK_FREQ, frequency);
+        PWMHR_setPeriodAndCompare(EPWM5_BASE, period, period / 2U,
+                                  period / 2U);
+        Sim_run(SETTLE_CYCLES);
+
+        rises = 0U;
+        Sim_run(WINDOW_CYCLES);
+        measured = (double)(rises - 1U) * DEVICE_SYSCLK_FREQ *
+                   SIM_EPWM_FINE_ONE / (double)(lastRise - firstRise);
+        TEST_CHECK((fabs(measured - frequency) / frequency) <
+                   (FREQUENCY_PPM * 1.0e-6));
+    }
+}
+
+//
+// End of File
+//
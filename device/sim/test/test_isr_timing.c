@@ -0,0 +1,330 @@
+//###########################################################################
+//
+// FILE:   test_isr_timing.c
+//
+// TITLE:  ISR execution time measurement of the application on the host.
+//
+//###########################################################################
+//
+// Runs the application with every register access of an interrupt handler
+// charged ACCESS_COST cycles (see Sim_setAccessCost()), so the probe of
+// the ePWM5 ISR measures a cost known in advance:
+//
+// - With no ramp in progress the ISR makes three accesses between the two
+//   time stamps: the interrupt flag clear, the PIE acknowledge and the exit
+//   time stamp itself. Every run must then take exactly 3 * ACCESS_COST
+//   cycles and land in the histogram bin of that value.
+// - Before the entry time stamp the ISR reads PIECTRL and TBCTR, and the
+//   entry time stamp is charged before it samples, so the simulator charges
+//   the handler 3 * ACCESS_COST cycles that the probe does not see. Over
+//   any window the two totals must differ by exactly that per run, also
+//   while a period ramp adds its register writes.
+//
+// The statistics are also read back over the protocol with
+// PROTOCOL_OP_GET_ISR_STATS, and the reply must carry the same values.
+//
+//###########################################################################
+
+//
+// Included Files
+//
+#include "test.h"
+#include <stdlib.h>
+
+//
+// The application, with its main() renamed so that this file can run it
+//
+#define main appMain
+#include "pwm5a5b_on_PCBRev1.c"
+#undef main
+
+//
+// Defines
+//
+#define MS                  (DEVICE_SYSCLK_FREQ / 1000U)
+#define IDLE_TIME           (40U * MS)  // After the start-up ramp
+#define IDLE_CHECK_TIME     (50U * MS)
+//
+// The menu the application draws after its start-up ramp holds the 9600
+// baud transmitter for about 170 ms, so replies queue behind it
+//
+#define REPLY_TIMEOUT       (400U * MS)
+#define RAMP_TIMEOUT        (600U * MS)
+#define ACCESS_COST         10U
+#define IDLE_ACCESSES       3U          // Probed accesses of an idle run
+#define ENTRY_ACCESSES      3U          // Charged accesses before entry
+#define IDLE_DURATION       (IDLE_ACCESSES * ACCESS_COST)
+#define IDLE_BIN            4U          // 16 <= 30 < 32
+#define RAMP_PERIOD         (EPWM5_TIMER_TBPRD + 50U)
+
+//
+// Globals
+//
+static Protocol_Decoder replyDecoder;
+static ISRTiming_Probe *probe;
+static uint32_t dispatches;
+static uint64_t charged;
+static uint32_t replyCount = 0xFFFFFFFFU;
+static uint32_t replyMin;
+static uint32_t replyMax;
+static uint32_t replyMean;
+static uint32_t requestCount;
+static uint16_t periodResult = 0xFFFFU;
+static uint16_t step;
+
+//
+// Function Prototypes
+//
+static uint32_t getUint32(const uint16_t *payload);
+static void sendCommand(uint16_t opcode, uint16_t value, uint16_t length);
+static void startWindow(void);
+static void checkWindow(void);
+static void checkTiming(void);
+static void txCallback(uint32_t base, uint16_t data, uint64_t cycle);
+
+//
+// Main
+//
+int main(void)
+{
+    Sim_CPUTimer_init();
+    Sim_DMA_init();
+    Sim_EPWM_init();
+    Sim_ADC_init();
+    Sim_SCI_init();
+    Sim_reset();
+    Sim_setAccessCost(ACCESS_COST);
+
+    Protocol_initDecoder(&replyDecoder);
+    Sim_SCI_setTxCallback(&txCallback);
+    Sim_setIdleHook(&checkTiming);
+    appMain();
+
+    //
+    // The background loop never returns
+    //
+    return(1);
+}
+
+//
+// getUint32 - Reads a 32-bit value from four payload bytes, low byte first
+//
+static uint32_t getUint32(const uint16_t *payload)
+{
+    return((uint32_t)Protocol_getUint16(&payload[0]) |
+           ((uint32_t)Protocol_getUint16(&payload[2]) << 16U));
+}
+
+//
+// sendCommand - Sends a command for ePWM5 with a one or two byte argument
+//
+static void sendCommand(uint16_t opcode, uint16_t value, uint16_t length)
+{
+    uint16_t payload[3];
+    uint16_t buffer[3U + PROTOCOL_OVERHEAD];
+
+    payload[0] = 5U;
+    Protocol_putUint16(&payload[1], value);
+    length = Protocol_encodeFrame(opcode, payload, length + 1U, buffer);
+    (void)Sim_SCI_receive(SCIA_BASE, buffer, length);
+}
+
+//
+// startWindow - Clears the probe and notes the simulator's count of the
+// ISR. The ISR cannot run while the idle hook does.
+//
+static void startWindow(void)
+{
+    const Sim_InterruptStats *stats = Sim_getInterruptStats(INT_EPWM5);
+
+    ISRTiming_reset(probe);
+    dispatches = stats->count;
+    charged = stats->cycles;
+}
+
+//
+// checkWindow - Checks the probe against the cycles the simulator charged
+// the ISR since startWindow()
+//
+static void checkWindow(void)
+{
+    const Sim_InterruptStats *stats = Sim_getInterruptStats(INT_EPWM5);
+    uint32_t total = 0U;
+    uint16_t bin;
+
+    for(bin = 0U; bin < ISRTIMING_BINS; bin++)
+    {
+        total += probe->duration.histogram[bin];
+    }
+
+    TEST_CHECK(probe->duration.count == (stats->count - dispatches));
+    TEST_CHECK(probe->latency.count == probe->duration.count);
+    TEST_CHECK(total == probe->duration.count);
+    TEST_CHECK((stats->cycles - charged) ==
+               (probe->duration.sum + ((uint64_t)ENTRY_ACCESSES *
+                                       ACCESS_COST * probe->duration.count)));
+}
+
+//
+// checkTiming - Steps through the scenario and checks the probe at each
+// step
+//
+static void checkTiming(void)
+{
+    const PWMRamp_Channel *ramp = &epwmChannels[CHANNEL_EPWM5].ramp;
+    uint64_t now = Sim_getCycles();
+    uint16_t bin;
+
+    switch(step)
+    {
+        case 0U:
+            if(now >= IDLE_TIME)
+            {
+                probe = getISRProbe(EPWM5_BASE);
+                TEST_CHECK(probe != NULL);
+                if(probe == NULL)
+                {
+                    exit(Test_report("test_isr_timing"));
+                }
+                TEST_CHECK(!PWMRamp_isActive(ramp));
+                TEST_CHECK(ISRTiming_overhead == 0U);
+                startWindow();
+                step++;
+            }
+            break;
+
+        case 1U:
+            if(now >= IDLE_CHECK_TIME)
+            {
+                //
+                // One run per period, every one of them the same
+                //
+                checkWindow();
+                TEST_CHECK(probe->duration.count >=
+                           ((IDLE_CHECK_TIME - IDLE_TIME) /
+                            (2U * EPWM5_TIMER_TBPRD)));
+                TEST_CHECK(probe->duration.min == IDLE_DURATION);
+                TEST_CHECK(probe->duration.max == IDLE_DURATION);
+                TEST_CHECK(ISRTiming_getMean(&probe->duration) ==
+                           IDLE_DURATION);
+                for(bin = 0U; bin < ISRTIMING_BINS; bin++)
+                {
+                    TEST_CHECK(probe->duration.histogram[bin] ==
+                               ((bin == IDLE_BIN) ?
+                                probe->duration.count : 0U));
+                }
+
+                //
+                // The interrupt is taken at counter zero, with nothing to
+                // wait for
+                //
+                TEST_CHECK(probe->latency.max == 0U);
+                TEST_CHECK(probe->latency.histogram[0] ==
+                           probe->latency.count);
+
+                requestCount = probe->duration.count;
+                sendCommand(PROTOCOL_OP_GET_ISR_STATS, PROTOCOL_ISR_DURATION,
+                            1U);
+                step++;
+            }
+            break;
+
+        case 2U:
+            if(replyCount != 0xFFFFFFFFU)
+            {
+                //
+                // The reply was built some runs after the request
+                //
+                TEST_CHECK(replyCount > requestCount);
+                TEST_CHECK(replyCount <= probe->duration.count);
+                TEST_CHECK(replyMin == IDLE_DURATION);
+                TEST_CHECK(replyMax == IDLE_DURATION);
+                TEST_CHECK(replyMean == IDLE_DURATION);
+
+                startWindow();
+                sendCommand(PROTOCOL_OP_SET_PERIOD, RAMP_PERIOD, 2U);
+                step++;
+            }
+            else if(now >= REPLY_TIMEOUT)
+            {
+                TEST_CHECK(replyCount != 0xFFFFFFFFU);
+                exit(Test_report("test_isr_timing"));
+            }
+            break;
+
+        case 3U:
+            if(periodResult != 0xFFFFU)
+            {
+                TEST_CHECK(periodResult == PROTOCOL_RESULT_OK);
+                step++;
+            }
+            else if(now >= RAMP_TIMEOUT)
+            {
+                TEST_CHECK(periodResult != 0xFFFFU);
+                exit(Test_report("test_isr_timing"));
+            }
+            break;
+
+        default:
+            if(!PWMRamp_isActive(ramp) || (now >= RAMP_TIMEOUT))
+            {
+                //
+                // One dearer run per period step, the idle runs before and
+                // after the ramp still cost the same, and the dearest run
+                // is the one the simulator charged most
+                //
+                TEST_CHECK(!PWMRamp_isActive(ramp));
+                TEST_CHECK(EPWM_getTimeBasePeriod(EPWM5_BASE) ==
+                           RAMP_PERIOD);
+                checkWindow();
+                TEST_CHECK(probe->duration.min == IDLE_DURATION);
+                TEST_CHECK(probe->duration.max > IDLE_DURATION);
+                TEST_CHECK((probe->duration.max +
+                            (ENTRY_ACCESSES * ACCESS_COST)) ==
+                           Sim_getInterruptStats(INT_EPWM5)->maxCycles);
+                TEST_CHECK((probe->duration.count -
+                            probe->duration.histogram[IDLE_BIN]) ==
+                           (RAMP_PERIOD - EPWM5_TIMER_TBPRD));
+
+                exit(Test_report("test_isr_timing"));
+            }
+            break;
+    }
+}
+
+//
+// txCallback - Decodes the ISR_STATS reply of the application and its
+// answer to the period command
+//
+static void txCallback(uint32_t base, uint16_t data, uint64_t cycle)
+{
+    const Protocol_Frame *frame = &replyDecoder.frame;
+
+    (void)cycle;
+
+    if((base != SCIA_BASE) ||
+       (Protocol_decodeByte(&replyDecoder, data) != PROTOCOL_DECODE_FRAME))
+    {
+        return;
+    }
+
+    if(frame->opcode == PROTOCOL_OP_ISR_STATS)
+    {
+        TEST_CHECK(frame->length == 18U);
+        TEST_CHECK(frame->payload[0] == 5U);
+        TEST_CHECK(frame->payload[1] == PROTOCOL_ISR_DURATION);
+        replyMin = getUint32(&frame->payload[6]);
+        replyMax = getUint32(&frame->payload[10]);
+        replyMean = getUint32(&frame->payload[14]);
+        replyCount = getUint32(&frame->payload[2]);
+    }
+    else if((frame->opcode == PROTOCOL_OP_ACK) &&
+            (frame->payload[0] == PROTOCOL_OP_SET_PERIOD))
+    {
+        periodResult = frame->payload[1];
+    }
+}
+
+//
+// End of File
+//
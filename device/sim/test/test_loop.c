@@ -0,0 +1,258 @@
+//###########################################################################
+//
+// FILE:   test_loop.c
+//
+// TITLE:  Closed-loop regulation of the application on synthetic samples.
+//
+//###########################################################################
+//
+// Runs the application with the ADC inputs fed by a first-order model of
+// the output stage: the output voltage follows 4000 ADC counts times the
+// duty of ePWM5A with a 200 us time constant, and the output current is a
+// 5 kHz sine of 1000 counts around its offset. The loop is closed over the
+// protocol and regulates the voltage through the application's own
+// control ISR. A current spike and then a voltage spike, each outside the
+// PPB limits for a sample or two, must open the loop, latch their fault
+// and move the compare value to its safe setting.
+//
+//###########################################################################
+
+//
+// Included Files
+//
+#include "test.h"
+#include <math.h>
+#include <stdlib.h>
+
+//
+// The application, with its main() renamed so that this file can run it
+//
+#define main appMain
+#include "pwm5a5b_on_PCBRev1.c"
+#undef main
+
+//
+// Defines
+//
+// A command takes about 10 ms to arrive at 9600 baud, so the loop is
+// checked 20 ms after each one
+//
+#define MS                  (DEVICE_SYSCLK_FREQ / 1000U)
+#define CLOSE_TIME          (40U * MS)  // After the start-up ramp
+#define CURRENT_SPIKE_TIME  (70U * MS)
+#define REOPEN_TIME         (72U * MS)
+#define VOLTAGE_SPIKE_TIME  (90U * MS)
+#define END_TIME            (92U * MS)
+#define SPIKE_CYCLES        2000U       // 20 us, one or two samples
+#define REFERENCE           3000
+#define TOLERANCE           30
+#define PLANT_GAIN          4000.0
+#define PLANT_TAU           20000.0     // 200 us in SYSCLK cycles
+#define PI                  3.14159265358979
+
+//
+// Globals
+//
+static double plantVoltage;
+static uint64_t plantCycle;
+static uint64_t currentSpike = ~0ULL;
+static uint64_t voltageSpike = ~0ULL;
+static uint16_t step;
+static uint32_t compareErrors;
+
+//
+// Function Prototypes
+//
+static uint16_t sampleInput(uint32_t base, uint16_t channel, uint64_t cycle);
+static void sendSetLoop(uint16_t enable);
+static void checkLoop(void);
+static void finish(void);
+
+//
+// Main
+//
+int main(void)
+{
+    Sim_CPUTimer_init();
+    Sim_DMA_init();
+    Sim_EPWM_init();
+    Sim_ADC_init();
+    Sim_SCI_init();
+    Sim_reset();
+
+    Sim_ADC_setInputHandler(&sampleInput);
+    Sim_setIdleHook(&checkLoop);
+    appMain();
+
+    //
+    // The background loop never returns
+    //
+    return(1);
+}
+
+//
+// sampleInput - Returns the output voltage and current of the model
+//
+static uint16_t sampleInput(uint32_t base, uint16_t channel, uint64_t cycle)
+{
+    uint16_t compare;
+    double duty;
+    double value;
+
+    (void)channel;
+
+    //
+    // ePWM5A is set on the up match and cleared on the down match
+    //
+    compare = (uint16_t)(Sim_readReg32(EPWM5_BASE + EPWM_O_CMPA) >> 16U);
+    duty = (double)(EPWM5_TIMER_TBPRD - compare) / EPWM5_TIMER_TBPRD;
+    plantVoltage += ((PLANT_GAIN * duty) - plantVoltage) *
+                    fmin((double)(cycle - plantCycle) / PLANT_TAU, 1.0);
+    plantCycle = cycle;
+
+    if(base == ADCB_BASE)
+    {
+        value = plantVoltage;
+        if((cycle >= voltageSpike) && (cycle < (voltageSpike + SPIKE_CYCLES)))
+        {
+            value += 1000.0;
+        }
+    }
+    else
+    {
+        value = loopCurrentSense.offset +
+                (1000.0 * sin(2.0 * PI * 5000.0 * (double)cycle /
+                              DEVICE_SYSCLK_FREQ));
+        if((cycle >= currentSpike) && (cycle < (currentSpike + SPIKE_CYCLES)))
+        {
+            value += 1600.0;
+        }
+    }
+
+    return((uint16_t)fmax(fmin(value + 0.5, 4095.0), 0.0));
+}
+
+//
+// sendSetLoop - Sends the command that closes or opens the loop of ePWM5
+//
+static void sendSetLoop(uint16_t enable)
+{
+    uint16_t payload[4];
+    uint16_t buffer[4U + PROTOCOL_OVERHEAD];
+    uint16_t length;
+
+    payload[0] = 5U;
+    Protocol_putUint16(&payload[1], (uint16_t)REFERENCE);
+    payload[3] = enable;
+    length = Protocol_encodeFrame(PROTOCOL_OP_SET_LOOP, payload, 4U, buffer);
+    (void)Sim_SCI_receive(SCIA_BASE, buffer, length);
+}
+
+//
+// checkLoop - Steps through the scenario and checks the loop at each step
+//
+static void checkLoop(void)
+{
+    uint64_t now = Sim_getCycles();
+    uint16_t compare;
+
+    //
+    // While the loop is closed the compare value stays in its range
+    //
+    if(PWMLoop_isEnabled(&outputLoop))
+    {
+        compare = (uint16_t)(Sim_readReg32(EPWM5_BASE + EPWM_O_CMPA) >> 16U);
+        if((compare < (outputLoop.limits.min >> 8U)) ||
+           (compare > (outputLoop.limits.max >> 8U)))
+        {
+            compareErrors++;
+        }
+    }
+
+    switch(step)
+    {
+        case 0U:
+            if(now >= CLOSE_TIME)
+            {
+                TEST_CHECK(!PWMLoop_isEnabled(&outputLoop));
+                sendSetLoop(1U);
+                step++;
+            }
+            break;
+
+        case 1U:
+            if(now >= CURRENT_SPIKE_TIME)
+            {
+                //
+                // Settled on the reference, with the current swinging inside
+                // its limits
+                //
+                TEST_CHECK(PWMLoop_isEnabled(&outputLoop));
+                TEST_CHECK(abs(outputLoop.lastVoltage - REFERENCE) <=
+                           TOLERANCE);
+                TEST_CHECK(outputLoop.faults == 0U);
+                TEST_CHECK(outputLoop.trips == 0U);
+                TEST_CHECK(outputLoop.runs > 1000U);
+                TEST_CHECK(outputLoop.maxLatency < EPWM5_TIMER_TBPRD);
+                currentSpike = now;
+                step++;
+            }
+            break;
+
+        case 2U:
+            if(now >= REOPEN_TIME)
+            {
+                TEST_CHECK(!PWMLoop_isEnabled(&outputLoop));
+                TEST_CHECK(outputLoop.faults == PWMLOOP_FAULT_CURRENT);
+                TEST_CHECK(outputLoop.trips >= 1U);
+                TEST_CHECK(outputLoop.compare == outputLoop.limits.safe);
+                sendSetLoop(1U);
+                step++;
+            }
+            break;
+
+        case 3U:
+            if(now >= VOLTAGE_SPIKE_TIME)
+            {
+                TEST_CHECK(PWMLoop_isEnabled(&outputLoop));
+                TEST_CHECK(outputLoop.faults == 0U);
+                TEST_CHECK(abs(outputLoop.lastVoltage - REFERENCE) <=
+                           TOLERANCE);
+                voltageSpike = now;
+                step++;
+            }
+            break;
+
+        default:
+            if(now >= END_TIME)
+            {
+                TEST_CHECK(!PWMLoop_isEnabled(&outputLoop));
+                TEST_CHECK(outputLoop.faults == PWMLOOP_FAULT_VOLTAGE);
+                TEST_CHECK(outputLoop.compare == outputLoop.limits.safe);
+                finish();
+            }
+            break;
+    }
+}
+
+//
+// finish - Checks that every sample pair ran the control ISR and ends
+// the test
+//
+static void finish(void)
+{
+    const Sim_ADC_Stats *stats = Sim_ADC_getStats(ADCA_BASE);
+
+    TEST_CHECK(compareErrors == 0U);
+    TEST_CHECK(stats->overflows == 0U);
+    TEST_CHECK(Sim_ADC_getStats(ADCB_BASE)->overflows == 0U);
+    TEST_CHECK(Sim_getInterruptStats(INT_ADCA1)->count + 1U >=
+               stats->interrupts);
+    TEST_CHECK(Sim_getInterruptStats(INT_ADCA1)->count <= stats->interrupts);
+
+    exit(Test_report("test_loop"));
+}
+
+//
+// End of File
+//
@@ -0,0 +1,233 @@
+//###########################################################################
+//
+// FILE:   test_phase.c
+//
+// TITLE:  Phase-locked ePWM modules through the sync chain.
+//
+//###########################################################################
+//
+// Locks ePWM2, and ePWM3 for three phases, to ePWM1 with PWMPhase and
+// weighs the number of A outputs that are high by how long it lasts. Two
+// phases at 50% duty 180 degrees apart, and three at one third 120 degrees
+// apart, must add up to exactly one output high at every moment. The
+// rising edges of the followers must lag ePWM1 by their phase, also
+// beyond 180 degrees and after a change of period.
+//
+//###########################################################################
+
+//
+// Included Files
+//
+#include "test.h"
+#include <string.h>
+#include "pwm_phase.h"
+#include "pwm_update.h"
+
+//
+// Defines
+//
+#define NUM_MODULES         3U
+#define SETTLE_CYCLES       20000U
+#define MEASURE_CYCLES      400000U
+
+//
+// Globals
+//
+static const uint32_t modules[NUM_MODULES] =
+{
+    EPWM1_BASE, EPWM2_BASE, EPWM3_BASE
+};
+static PWMPhase_Group group;
+static uint16_t numModules;
+static uint16_t levels[NUM_MODULES];
+static uint64_t lastEdge;
+static uint64_t highCycles[NUM_MODULES + 1U];
+static bool isMeasuring;
+
+//
+// Function Prototypes
+//
+static void initModule(uint32_t base, uint16_t period, uint16_t compare);
+static void edgeCallback(uint32_t base, uint16_t output, uint16_t level,
+                         uint64_t cycle);
+static void measure(void);
+static uint64_t getLag(uint32_t base);
+
+//
+// Main
+//
+int main(void)
+{
+    uint16_t i;
+
+    Sim_EPWM_setEdgeCallback(&edgeCallback);
+
+    //
+    // Two phases, 50% duty
+    //
+    Test_initSim();
+    numModules = 2U;
+    SysCtl_disablePeripheral(SYSCTL_PERIPH_CLK_TBCLKSYNC);
+    for(i = 0U; i < numModules; i++)
+    {
+        initModule(modules[i], 2000U, 1000U);
+    }
+    PWMPhase_init(&group, EPWM1_BASE, &modules[1], 1U);
+    PWMPhase_setPhase(&group, 0U, 18000U);
+    SysCtl_enablePeripheral(SYSCTL_PERIPH_CLK_TBCLKSYNC);
+
+    measure();
+    TEST_CHECK(highCycles[1] == MEASURE_CYCLES);
+    TEST_CHECK(getLag(EPWM2_BASE) == 2000U);
+
+    //
+    // 90 degrees overlaps the outputs for a quarter period each way, and
+    // 270 degrees lags by three quarters
+    //
+    PWMPhase_setPhase(&group, 0U, 9000U);
+    measure();
+    TEST_CHECK(highCycles[2] == (MEASURE_CYCLES / 4U));
+    TEST_CHECK(getLag(EPWM2_BASE) == 1000U);
+    PWMPhase_setPhase(&group, 0U, 27000U);
+    measure();
+    TEST_CHECK(highCycles[2] == (MEASURE_CYCLES / 4U));
+    TEST_CHECK(getLag(EPWM2_BASE) == 3000U);
+
+    //
+    // The phase follows a change of period
+    //
+    PWMPhase_setPhase(&group, 0U, 18000U);
+    for(i = 0U; i < numModules; i++)
+    {
+        PWMUpdate_setPeriodAndCompare(modules[i], 1000U, 500U, 500U);
+    }
+    PWMPhase_setPeriod(&group, 1000U);
+    measure();
+    TEST_CHECK(highCycles[1] == MEASURE_CYCLES);
+    TEST_CHECK(getLag(EPWM2_BASE) == 1000U);
+
+    //
+    // Three phases, one third duty
+    //
+    Test_initSim();
+    memset(levels, 0, sizeof(levels));
+    numModules = 3U;
+    SysCtl_disablePeripheral(SYSCTL_PERIPH_CLK_TBCLKSYNC);
+    for(i = 0U; i < numModules; i++)
+    {
+        initModule(modules[i], 1500U, 1000U);
+    }
+    PWMPhase_init(&group, EPWM1_BASE, &modules[1], 2U);
+    PWMPhase_setPhase(&group, 0U, 12000U);
+    PWMPhase_setPhase(&group, 1U, 24000U);
+    SysCtl_enablePeripheral(SYSCTL_PERIPH_CLK_TBCLKSYNC);
+
+    measure();
+    TEST_CHECK(highCycles[1] == MEASURE_CYCLES);
+    TEST_CHECK(getLag(EPWM2_BASE) == 1000U);
+    TEST_CHECK(getLag(EPWM3_BASE) == 2000U);
+
+    return(Test_report("test_phase"));
+}
+
+//
+// initModule - Sets a module up for up-down count, with output A high from
+// CMPA up to CMPA down
+//
+static void initModule(uint32_t base, uint16_t period, uint16_t compare)
+{
+    EPWM_setTimeBasePeriod(base, period);
+    EPWM_setTimeBaseCounter(base, 0U);
+    EPWM_setCounterCompareValue(base, EPWM_COUNTER_COMPARE_A, compare);
+    EPWM_setCounterCompareValue(base, EPWM_COUNTER_COMPARE_B, compare);
+    EPWM_setTimeBaseCounterMode(base, EPWM_COUNTER_MODE_UP_DOWN);
+    EPWM_setClockPrescaler(base, EPWM_CLOCK_DIVIDER_1,
+                           EPWM_HSCLOCK_DIVIDER_1);
+    PWMUpdate_init(base);
+    EPWM_setActionQualifierAction(base, EPWM_AQ_OUTPUT_A,
+                                  EPWM_AQ_OUTPUT_HIGH,
+                                  EPWM_AQ_OUTPUT_ON_TIMEBASE_UP_CMPA);
+    EPWM_setActionQualifierAction(base, EPWM_AQ_OUTPUT_A,
+                                  EPWM_AQ_OUTPUT_LOW,
+                                  EPWM_AQ_OUTPUT_ON_TIMEBASE_DOWN_CMPA);
+}
+
+//
+// edgeCallback - Adds the time since the last edge to the number of A
+// outputs that were high during it
+//
+static void edgeCallback(uint32_t base, uint16_t output, uint16_t level,
+                         uint64_t cycle)
+{
+    uint16_t sum = 0U;
+    uint16_t i;
+
+    if(output != SIM_EPWM_OUTPUT_A)
+    {
+        return;
+    }
+
+    for(i = 0U; i < numModules; i++)
+    {
+        sum += levels[i];
+    }
+    if(isMeasuring)
+    {
+        highCycles[sum] += cycle - lastEdge;
+    }
+    lastEdge = cycle;
+
+    for(i = 0U; i < numModules; i++)
+    {
+        if(modules[i] == base)
+        {
+            levels[i] = level;
+        }
+    }
+}
+
+//
+// measure - Lets a change take effect, then weighs the outputs high
+//
+static void measure(void)
+{
+    uint16_t sum = 0U;
+    uint16_t i;
+
+    Sim_run(SETTLE_CYCLES);
+
+    memset(highCycles, 0, sizeof(highCycles));
+    lastEdge = Sim_getCycles();
+    isMeasuring = true;
+    Sim_run(MEASURE_CYCLES);
+    isMeasuring = false;
+
+    //
+    // The time since the last edge
+    //
+    for(i = 0U; i < numModules; i++)
+    {
+        sum += levels[i];
+    }
+    highCycles[sum] += Sim_getCycles() - lastEdge;
+}
+
+//
+// getLag - Returns how far the last rising edge of a follower lags that of
+// ePWM1, within one period
+//
+static uint64_t getLag(uint32_t base)
+{
+    const Sim_EPWM_OutputStats *master;
+    const Sim_EPWM_OutputStats *follower;
+
+    master = Sim_EPWM_getOutputStats(EPWM1_BASE, SIM_EPWM_OUTPUT_A);
+    follower = Sim_EPWM_getOutputStats(base, SIM_EPWM_OUTPUT_A);
+
+    return(((follower->lastRise + (4U * follower->period)) -
+            master->lastRise) % follower->period);
+}
+
+//
+// End of File
+//
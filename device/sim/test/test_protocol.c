@@ -0,0 +1,213 @@
+//###########################################################################
+//
+// FILE:   test_protocol.c
+//
+// TITLE:  Frame encoder and decoder, alone and through the simulated SCI.
+//
+//###########################################################################
+
+//
+// Included Files
+//
+#include "test.h"
+#include "protocol.h"
+#include "sci_buffer.h"
+
+//
+// Defines
+//
+#define CODEC_FRAMES        10000U
+#define LOOPBACK_FRAMES     200U
+
+//
+// Globals
+//
+static uint32_t randomState = 1U;
+
+//
+// Function Prototypes
+//
+static uint16_t getRandom(void);
+static uint16_t makeFrame(Protocol_Frame *frame, uint16_t *buffer);
+static bool isSameFrame(const Protocol_Frame *a, const Protocol_Frame *b);
+
+//
+// Main
+//
+int main(void)
+{
+    static const char check[] = "123456789";
+    Protocol_Decoder decoder;
+    Protocol_Frame sentFrames[LOOPBACK_FRAMES];
+    Protocol_Frame frame;
+    uint16_t buffer[PROTOCOL_MAX_FRAME];
+    uint16_t length;
+    uint16_t crc = 0xFFFFU;
+    uint16_t data;
+    uint32_t frames;
+    uint32_t received;
+    uint32_t i;
+    uint16_t j;
+    Protocol_DecodeStatus status;
+
+    //
+    // CRC16/CCITT-FALSE check value
+    //
+    for(i = 0U; check[i] != '\0'; i++)
+    {
+        crc = Protocol_updateCRC(crc, (uint16_t)check[i]);
+    }
+    TEST_CHECK(crc == 0x29B1U);
+
+    //
+    // Random frames decode to what was encoded, with menu key presses
+    // between them passed through as idle bytes
+    //
+    Protocol_initDecoder(&decoder);
+    for(i = 0U; i < CODEC_FRAMES; i++)
+    {
+        TEST_CHECK(Protocol_decodeByte(&decoder, '1') ==
+                   PROTOCOL_DECODE_IDLE);
+
+        length = makeFrame(&frame, buffer);
+        for(j = 0U; j < (length - 1U); j++)
+        {
+            TEST_CHECK(Protocol_decodeByte(&decoder, buffer[j]) ==
+                       PROTOCOL_DECODE_BUSY);
+        }
+        TEST_CHECK(Protocol_decodeByte(&decoder, buffer[length - 1U]) ==
+                   PROTOCOL_DECODE_FRAME);
+        TEST_CHECK(isSameFrame(&decoder.frame, &frame));
+    }
+    TEST_CHECK(decoder.errors == 0U);
+
+    //
+    // A corrupted frame is discarded and counted, and the next one decodes
+    //
+    length = makeFrame(&frame, buffer);
+    buffer[2] ^= 0x01U;
+    status = PROTOCOL_DECODE_IDLE;
+    for(j = 0U; j < length; j++)
+    {
+        status = Protocol_decodeByte(&decoder, buffer[j]);
+    }
+    TEST_CHECK(status == PROTOCOL_DECODE_ERROR);
+    TEST_CHECK(decoder.errors == 1U);
+    length = makeFrame(&frame, buffer);
+    for(j = 0U; j < length; j++)
+    {
+        status = Protocol_decodeByte(&decoder, buffer[j]);
+    }
+    TEST_CHECK(status == PROTOCOL_DECODE_FRAME);
+
+    //
+    // A length beyond the largest payload is rejected at once, and payloads
+    // that long are not encoded
+    //
+    TEST_CHECK(Protocol_decodeByte(&decoder, PROTOCOL_SOF) ==
+               PROTOCOL_DECODE_BUSY);
+    TEST_CHECK(Protocol_decodeByte(&decoder, PROTOCOL_MAX_PAYLOAD + 1U) ==
+               PROTOCOL_DECODE_ERROR);
+    TEST_CHECK(Protocol_encodeFrame(PROTOCOL_OP_ACK, buffer,
+                                    PROTOCOL_MAX_PAYLOAD + 1U, buffer) == 0U);
+
+    //
+    // Loopback through the simulated SCIA: frames are queued for
+    // transmission, shifted out, received on the same port and decoded
+    //
+    Test_initSim();
+    Test_initSCI(SCIA_BASE, 115200U);
+    SCI_enableLoopback(SCIA_BASE);
+    SCIBuffer_init(SCIA_BASE);
+    EINT;
+
+    Protocol_initDecoder(&decoder);
+    frames = 0U;
+    received = 0U;
+    while((received < LOOPBACK_FRAMES) &&
+          (Sim_getCycles() < (10UL * DEVICE_SYSCLK_FREQ)))
+    {
+        if((frames < LOOPBACK_FRAMES) &&
+           (SCIBuffer_getTxFree() >= PROTOCOL_MAX_FRAME))
+        {
+            length = makeFrame(&sentFrames[frames], buffer);
+            TEST_CHECK(SCIBuffer_write(buffer, length) == length);
+            frames++;
+        }
+
+        Sim_run(DEVICE_SYSCLK_FREQ / 10000U);
+
+        while(SCIBuffer_readChar(&data))
+        {
+            if(Protocol_decodeByte(&decoder, data) == PROTOCOL_DECODE_FRAME)
+            {
+                TEST_CHECK(isSameFrame(&decoder.frame,
+                                       &sentFrames[received]));
+                received++;
+            }
+        }
+    }
+    TEST_CHECK(received == LOOPBACK_FRAMES);
+    TEST_CHECK(decoder.errors == 0U);
+    TEST_CHECK(SCIBuffer_getRxOverrunCount() == 0U);
+    TEST_CHECK(SCIBuffer_getTxOverflowCount() == 0U);
+
+    return(Test_report("test_protocol"));
+}
+
+//
+// getRandom - Returns the next value of a 32-bit xorshift generator
+//
+static uint16_t getRandom(void)
+{
+    randomState ^= randomState << 13U;
+    randomState ^= randomState >> 17U;
+    randomState ^= randomState << 5U;
+
+    return((uint16_t)(randomState >> 8U));
+}
+
+//
+// makeFrame - Encodes a frame with a random opcode and payload
+//
+static uint16_t makeFrame(Protocol_Frame *frame, uint16_t *buffer)
+{
+    uint16_t i;
+
+    frame->opcode = getRandom() & 0xFFU;
+    frame->length = getRandom() % (PROTOCOL_MAX_PAYLOAD + 1U);
+    for(i = 0U; i < frame->length; i++)
+    {
+        frame->payload[i] = getRandom() & 0xFFU;
+    }
+
+    return(Protocol_encodeFrame(frame->opcode, frame->payload, frame->length,
+                                buffer));
+}
+
+//
+// isSameFrame - Compares opcode, length and payload of two frames
+//
+static bool isSameFrame(const Protocol_Frame *a, const Protocol_Frame *b)
+{
+    uint16_t i;
+
+    if((a->opcode != b->opcode) || (a->length != b->length))
+    {
+        return(false);
+    }
+
+    for(i = 0U; i < a->length; i++)
+    {
+        if(a->payload[i] != b->payload[i])
+        {
+            return(false);
+        }
+    }
+
+    return(true);
+}
+
+//
+// End of File
+//
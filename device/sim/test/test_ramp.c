@@ -0,0 +1,454 @@
+//###########################################################################
+//
+// FILE:   test_ramp.c
+//
+// TITLE:  Slew-rate limited setpoint ramps on three modules at once.
+//
+//###########################################################################
+//
+// Runs three ramp channels side by side, each stepped from the counter
+// zero interrupt of its module:
+//
+//   ePWM5  high-resolution period and compare values, interrupt left on;
+//          the period ramps down through CMPA, which must follow it
+//   ePWM1  period only, interrupt borrowed for the ramp
+//   ePWM2  compare values only, interrupt borrowed for the ramp
+//
+// Each interrupt reads the values that have just loaded, before the ramp
+// writes the next ones, and checks at every load that:
+//
+// - the active registers hold the values the ramp wrote in the period
+//   before,
+// - no register moved more than its step since the last load, except a
+//   compare value held at the period, which moves with the period,
+// - CMPA and CMPB are no larger than TBPRD,
+// - registers the channel does not own keep their values.
+//
+// Every ramp must land exactly on its targets after as many loads as its
+// longest move needs, and a borrowed interrupt must not run again once its
+// ramp is done.
+//
+//###########################################################################
+
+//
+// Included Files
+//
+#include "test.h"
+#include "pwm_hr.h"
+#include "pwm_ramp.h"
+#include "pwm_update.h"
+
+//
+// Defines
+//
+#define NUM_MODULES         3U
+#define TIMEOUT_CYCLES      5000000U
+#define IDLE_PERIODS        10U
+#define IDLE_CYCLES         (IDLE_PERIODS * 2U * 1101U) // Longest period
+
+//
+// Set-up and ramp of one module. Period and compare values are in HR
+// counts.
+//
+typedef struct
+{
+    uint32_t base;
+    uint32_t interruptNumber;
+    uint16_t registers;
+    bool highResolution;
+    bool interruptOn;
+    uint32_t period;
+    uint32_t compareA;
+    uint32_t compareB;
+    uint32_t periodStep;
+    uint32_t compareStep;
+    uint32_t targetPeriod;
+    uint32_t targetA;
+    uint32_t targetB;
+} RampCase;
+
+//
+// Values seen at the last load of one module and the checks that failed
+//
+typedef struct
+{
+    uint32_t period;
+    uint32_t compareA;
+    uint32_t compareB;
+    uint32_t loads;
+    uint32_t steps;
+    uint32_t idleRuns;
+    uint32_t loadErrors;
+    uint32_t stepErrors;
+    uint32_t limitErrors;
+    uint32_t ownerErrors;
+} RampState;
+
+//
+// Globals
+//
+static const RampCase cases[NUM_MODULES] =
+{
+    {
+        EPWM5_BASE, INT_EPWM5, PWMRAMP_PERIOD | PWMRAMP_COMPARE, true, true,
+        PWMHR_COUNT(850U), PWMHR_COUNT(700U), PWMHR_COUNT(200U),
+        PWMHR_COUNT(1U), PWMHR_COUNT(1U) / 4U,
+        PWMHR_COUNT(500U) + 64U, PWMHR_COUNT(400U) + 192U,
+        PWMHR_COUNT(300U) + 37U
+    },
+    {
+        EPWM1_BASE, INT_EPWM1, PWMRAMP_PERIOD, false, false,
+        PWMHR_COUNT(1000U), PWMHR_COUNT(300U), PWMHR_COUNT(700U),
+        PWMHR_COUNT(2U), PWMHR_COUNT(1U),
+        PWMHR_COUNT(1101U), PWMHR_COUNT(300U), PWMHR_COUNT(700U)
+    },
+    {
+        EPWM2_BASE, INT_EPWM2, PWMRAMP_COMPARE, false, false,
+        PWMHR_COUNT(600U), PWMHR_COUNT(100U), PWMHR_COUNT(500U),
+        PWMHR_COUNT(1U), PWMHR_COUNT(3U),
+        PWMHR_COUNT(600U), PWMHR_COUNT(450U), PWMHR_COUNT(150U)
+    }
+};
+static PWMRamp_Channel ramps[NUM_MODULES];
+static RampState states[NUM_MODULES];
+
+//
+// Function Prototypes
+//
+static void initModule(uint16_t index);
+static uint32_t getDistance(uint32_t from, uint32_t to);
+static uint32_t getSteps(uint32_t from, uint32_t to, uint32_t step);
+static bool isCompareStep(uint32_t from, uint32_t to, uint32_t period,
+                          const RampCase *rampCase);
+static void checkLoad(uint16_t index);
+static __interrupt void epwm5ISR(void);
+static __interrupt void epwm1ISR(void);
+static __interrupt void epwm2ISR(void);
+
+//
+// Main
+//
+int main(void)
+{
+    const RampCase *rampCase;
+    const RampState *state;
+    uint32_t expected;
+    uint32_t idleRuns[NUM_MODULES];
+    uint64_t elapsed = 0U;
+    uint32_t base;
+    uint32_t targetA;
+    uint32_t targetB;
+    uint16_t activePeriod;
+    uint16_t activeA;
+    uint16_t activeB;
+    uint16_t i;
+
+    Test_initSim();
+    SysCtl_disablePeripheral(SYSCTL_PERIPH_CLK_TBCLKSYNC);
+    for(i = 0U; i < NUM_MODULES; i++)
+    {
+        initModule(i);
+    }
+    while(PWMHR_calibrate() == PWMHR_CAL_INCOMPLETE)
+    {
+    }
+
+    Interrupt_register(INT_EPWM5, &epwm5ISR);
+    Interrupt_register(INT_EPWM1, &epwm1ISR);
+    Interrupt_register(INT_EPWM2, &epwm2ISR);
+    for(i = 0U; i < NUM_MODULES; i++)
+    {
+        rampCase = &cases[i];
+        PWMRamp_initChannel(&ramps[i], rampCase->base, rampCase->registers,
+                            rampCase->periodStep, rampCase->compareStep);
+        TEST_CHECK(ramps[i].highResolution == rampCase->highResolution);
+        TEST_CHECK(ramps[i].ownsInterrupt == !rampCase->interruptOn);
+        Interrupt_enable(rampCase->interruptNumber);
+    }
+    EINT;
+
+    //
+    // Each channel is given targets for the registers it owns only
+    //
+    PWMRamp_start(&ramps[0], cases[0].targetPeriod, cases[0].targetA,
+                  cases[0].targetB);
+    PWMRamp_startPeriod(&ramps[1], cases[1].targetPeriod);
+    PWMRamp_startCompare(&ramps[2], cases[2].targetA, cases[2].targetB);
+    for(i = 0U; i < NUM_MODULES; i++)
+    {
+        TEST_CHECK(PWMRamp_isActive(&ramps[i]));
+        TEST_CHECK((HWREGH(cases[i].base + EPWM_O_ETSEL) &
+                    EPWM_ETSEL_INTEN) != 0U);
+    }
+    SysCtl_enablePeripheral(SYSCTL_PERIPH_CLK_TBCLKSYNC);
+
+    while((PWMRamp_isActive(&ramps[0]) || PWMRamp_isActive(&ramps[1]) ||
+           PWMRamp_isActive(&ramps[2])) && (elapsed < TIMEOUT_CYCLES))
+    {
+        Sim_run(1000U);
+        elapsed += 1000U;
+    }
+
+    for(i = 0U; i < NUM_MODULES; i++)
+    {
+        rampCase = &cases[i];
+        state = &states[i];
+
+        TEST_CHECK(!PWMRamp_isActive(&ramps[i]));
+        TEST_CHECK(state->loadErrors == 0U);
+        TEST_CHECK(state->stepErrors == 0U);
+        TEST_CHECK(state->limitErrors == 0U);
+        TEST_CHECK(state->ownerErrors == 0U);
+
+        //
+        // One step per period, as many as the longest move needs
+        //
+        expected = getSteps(rampCase->period, rampCase->targetPeriod,
+                            rampCase->periodStep);
+        if((rampCase->registers & PWMRAMP_COMPARE) != 0U)
+        {
+            if(getSteps(rampCase->compareA, rampCase->targetA,
+                        rampCase->compareStep) > expected)
+            {
+                expected = getSteps(rampCase->compareA, rampCase->targetA,
+                                    rampCase->compareStep);
+            }
+            if(getSteps(rampCase->compareB, rampCase->targetB,
+                        rampCase->compareStep) > expected)
+            {
+                expected = getSteps(rampCase->compareB, rampCase->targetB,
+                                    rampCase->compareStep);
+            }
+        }
+        TEST_CHECK(state->steps == expected);
+
+        idleRuns[i] = state->idleRuns;
+    }
+
+    //
+    // The last step loads at the next counter zero, without an interrupt
+    // on the modules that gave theirs back; after that all three rest on
+    // their targets
+    //
+    Sim_run(IDLE_CYCLES);
+    for(i = 0U; i < NUM_MODULES; i++)
+    {
+        rampCase = &cases[i];
+        base = rampCase->base;
+
+        if((rampCase->registers & PWMRAMP_COMPARE) == 0U)
+        {
+            targetA = rampCase->compareA;
+            targetB = rampCase->compareB;
+        }
+        else
+        {
+            targetA = rampCase->targetA;
+            targetB = rampCase->targetB;
+        }
+        Sim_EPWM_getActiveValues(base, &activePeriod, &activeA, &activeB);
+        TEST_CHECK(HRPWM_getTimeBasePeriod(base) == rampCase->targetPeriod);
+        TEST_CHECK(HRPWM_getCounterCompareValue(base,
+                                                HRPWM_COUNTER_COMPARE_A) ==
+                   targetA);
+        TEST_CHECK(HRPWM_getCounterCompareValue(base,
+                                                HRPWM_COUNTER_COMPARE_B) ==
+                   targetB);
+        TEST_CHECK(activePeriod ==
+                   (rampCase->targetPeriod >> PWMHR_COUNT_S));
+        TEST_CHECK(activeA == (targetA >> PWMHR_COUNT_S));
+        TEST_CHECK(activeB == (targetB >> PWMHR_COUNT_S));
+
+        //
+        // A borrowed interrupt is off again; one left on keeps running
+        //
+        TEST_CHECK(((HWREGH(rampCase->base + EPWM_O_ETSEL) &
+                     EPWM_ETSEL_INTEN) != 0U) == rampCase->interruptOn);
+        if(rampCase->interruptOn)
+        {
+            TEST_CHECK((states[i].idleRuns - idleRuns[i]) >= IDLE_PERIODS);
+        }
+        else
+        {
+            TEST_CHECK(states[i].idleRuns == 0U);
+        }
+    }
+
+    return(Test_report("test_ramp"));
+}
+
+//
+// initModule - Sets a module up in up-down count at its start values with
+// global loads on counter zero, and the MEP where the case asks for it
+//
+static void initModule(uint16_t index)
+{
+    const RampCase *rampCase = &cases[index];
+    uint32_t base = rampCase->base;
+
+    EPWM_setTimeBasePeriod(base, (uint16_t)(rampCase->period >>
+                                            PWMHR_COUNT_S));
+    EPWM_setTimeBaseCounter(base, 0U);
+    EPWM_setTimeBaseCounterMode(base, EPWM_COUNTER_MODE_UP_DOWN);
+    EPWM_setClockPrescaler(base, EPWM_CLOCK_DIVIDER_1,
+                           EPWM_HSCLOCK_DIVIDER_1);
+    EPWM_setCounterCompareValue(base, EPWM_COUNTER_COMPARE_A,
+                                (uint16_t)(rampCase->compareA >>
+                                           PWMHR_COUNT_S));
+    EPWM_setCounterCompareValue(base, EPWM_COUNTER_COMPARE_B,
+                                (uint16_t)(rampCase->compareB >>
+                                           PWMHR_COUNT_S));
+    EPWM_setCounterCompareShadowLoadMode(base, EPWM_COUNTER_COMPARE_A,
+                                         EPWM_COMP_LOAD_ON_CNTR_ZERO);
+    EPWM_setCounterCompareShadowLoadMode(base, EPWM_COUNTER_COMPARE_B,
+                                         EPWM_COMP_LOAD_ON_CNTR_ZERO);
+    PWMUpdate_init(base);
+    if(rampCase->highResolution)
+    {
+        PWMHR_init(base);
+    }
+
+    EPWM_setInterruptSource(base, EPWM_INT_TBCTR_ZERO);
+    EPWM_setInterruptEventCount(base, 1U);
+    if(rampCase->interruptOn)
+    {
+        EPWM_enableInterrupt(base);
+    }
+
+    states[index].period = rampCase->period;
+    states[index].compareA = rampCase->compareA;
+    states[index].compareB = rampCase->compareB;
+}
+
+//
+// getDistance - Returns how far apart two values are
+//
+static uint32_t getDistance(uint32_t from, uint32_t to)
+{
+    return((from > to) ? (from - to) : (to - from));
+}
+
+//
+// getSteps - Returns the number of steps a move takes
+//
+static uint32_t getSteps(uint32_t from, uint32_t to, uint32_t step)
+{
+    return((getDistance(from, to) + step - 1U) / step);
+}
+
+//
+// isCompareStep - Tells whether a compare value moved by no more than its
+// step, or by no more than the period step while it is held at the period
+//
+static bool isCompareStep(uint32_t from, uint32_t to, uint32_t period,
+                          const RampCase *rampCase)
+{
+    if(getDistance(from, to) <= rampCase->compareStep)
+    {
+        return(true);
+    }
+
+    return(((from == period) || (to == period)) &&
+           (getDistance(from, to) <= rampCase->periodStep));
+}
+
+//
+// checkLoad - Checks the values that loaded at this counter zero against
+// the ones of the last load, then steps the ramp
+//
+static void checkLoad(uint16_t index)
+{
+    const RampCase *rampCase = &cases[index];
+    RampState *state = &states[index];
+    PWMRamp_Channel *ramp = &ramps[index];
+    uint32_t base = rampCase->base;
+    uint32_t period;
+    uint32_t compareA;
+    uint32_t compareB;
+    uint16_t activePeriod;
+    uint16_t activeA;
+    uint16_t activeB;
+
+    period = HRPWM_getTimeBasePeriod(base);
+    compareA = HRPWM_getCounterCompareValue(base, HRPWM_COUNTER_COMPARE_A);
+    compareB = HRPWM_getCounterCompareValue(base, HRPWM_COUNTER_COMPARE_B);
+    Sim_EPWM_getActiveValues(base, &activePeriod, &activeA, &activeB);
+    state->loads++;
+
+    //
+    // What the last step wrote is what loaded
+    //
+    if((activePeriod != (period >> PWMHR_COUNT_S)) ||
+       (activeA != (compareA >> PWMHR_COUNT_S)) ||
+       (activeB != (compareB >> PWMHR_COUNT_S)))
+    {
+        state->loadErrors++;
+    }
+
+    if((getDistance(state->period, period) > rampCase->periodStep) ||
+       !isCompareStep(state->compareA, compareA, period, rampCase) ||
+       !isCompareStep(state->compareB, compareB, period, rampCase))
+    {
+        state->stepErrors++;
+    }
+
+    if((compareA > period) || (compareB > period) ||
+       (activeA > activePeriod) || (activeB > activePeriod))
+    {
+        state->limitErrors++;
+    }
+
+    if((((rampCase->registers & PWMRAMP_PERIOD) == 0U) &&
+        (period != rampCase->period)) ||
+       (((rampCase->registers & PWMRAMP_COMPARE) == 0U) &&
+        ((compareA != rampCase->compareA) ||
+         (compareB != rampCase->compareB))))
+    {
+        state->ownerErrors++;
+    }
+
+    state->period = period;
+    state->compareA = compareA;
+    state->compareB = compareB;
+
+    if(PWMRamp_isActive(ramp))
+    {
+        PWMRamp_step(ramp);
+        state->steps++;
+    }
+    else
+    {
+        state->idleRuns++;
+    }
+
+    EPWM_clearEventTriggerInterruptFlag(base);
+    Interrupt_clearACKGroup(INTERRUPT_ACK_GROUP3);
+}
+
+//
+// epwm5ISR - Counter zero interrupt of ePWM5
+//
+static __interrupt void epwm5ISR(void)
+{
+    checkLoad(0U);
+}
+
+//
+// epwm1ISR - Counter zero interrupt of ePWM1
+//
+static __interrupt void epwm1ISR(void)
+{
+    checkLoad(1U);
+}
+
+//
+// epwm2ISR - Counter zero interrupt of ePWM2
+//
+static __interrupt void epwm2ISR(void)
+{
+    checkLoad(2U);
+}
+
+//
+// End of File
+//
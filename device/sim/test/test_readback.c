@@ -0,0 +1,432 @@
+//###########################################################################
+//
+// FILE:   test_readback.c
+//
+// TITLE:  Frequency and duty read back from the registers against the
+//         simulated outputs.
+//
+//###########################################################################
+//
+// Sets ePWM3 and ePWM4 up with random counter modes, periods, prescalers,
+// compare values and action qualifier maps, half of them with a random
+// dead-band routing and delays, and checks the PWMReadback results
+// against the high time and the periods the ePWM model produces over a
+// whole number of periods. The outputs are forced low before the actions
+// are written, so that the level they start from is known.
+//
+// Left out are toggle actions, whose level depends on the period the
+// output starts in, and compare values of 0 and TBPRD in up-down count,
+// where the model orders coincident events differently from the
+// priorities of the technical reference manual.
+//
+// ePWM5 is then set up as the application runs it: up-down count, the MEP
+// moving both edges by the CMPAHR and CMPBHR fractions, a high-resolution
+// period and ePWM5B as the complement of ePWM5A with dead time. Random
+// fractions and delays must read back to within one Q15 step of the duty
+// and 20 ppm of the frequency measured from the fine edge times.
+//
+//###########################################################################
+
+//
+// Included Files
+//
+#include "test.h"
+#include <math.h>
+#include "pwm_deadband.h"
+#include "pwm_hr.h"
+#include "pwm_readback.h"
+
+//
+// Defines
+//
+#define RANDOM_CONFIGS      400U
+#define HR_CONFIGS          40U
+#define SETTLE_CYCLES       20000U
+#define WINDOW_CYCLES       200000U
+#define HR_WINDOW_CYCLES    2000000U
+#define HR_PERIOD           850U
+#define HR_MIN_COMPARE      20U
+#define FREQUENCY_TOLERANCE 0.0011
+#define HR_FREQUENCY_PPM    20.0
+
+//
+// Fine edge times of one output over a measurement
+//
+typedef struct
+{
+    uint16_t level;             // Level after the last edge
+    uint64_t lastEdge;          // Fine time of the last edge
+    uint64_t highTime;          // Fine high time so far
+    uint32_t rises;             // Rising edges so far
+    uint64_t firstRise;         // Fine time of the first rising edge
+    uint64_t highAtFirstRise;   // High time up to the first rising edge
+    uint64_t highAtLastRise;    // High time up to the last rising edge
+} OutputTiming;
+
+//
+// Globals
+//
+static uint32_t measuredBase;
+static OutputTiming timing[2];
+static uint32_t randomState = 1U;
+
+//
+// Function Prototypes
+//
+static uint32_t getRandom(void);
+static uint16_t getActions(void);
+static void edgeCallback(uint32_t base, uint16_t output, uint16_t level,
+                         uint64_t cycle);
+static void measure(uint32_t base, uint32_t cycles);
+static void checkRandom(uint32_t base);
+static void checkHighResolution(void);
+
+//
+// Main
+//
+int main(void)
+{
+    uint16_t i;
+
+    Test_initSim();
+    Sim_EPWM_setEdgeCallback(&edgeCallback);
+
+    for(i = 0U; i < RANDOM_CONFIGS; i++)
+    {
+        checkRandom(((i & 1U) == 0U) ? EPWM3_BASE : EPWM4_BASE);
+    }
+
+    checkHighResolution();
+
+    return(Test_report("test_readback"));
+}
+
+//
+// getRandom - Returns the next value of a 32-bit xorshift generator
+//
+static uint32_t getRandom(void)
+{
+    randomState ^= randomState << 13U;
+    randomState ^= randomState >> 17U;
+    randomState ^= randomState << 5U;
+
+    return(randomState);
+}
+
+//
+// getActions - Returns a random action qualifier map without toggles
+//
+static uint16_t getActions(void)
+{
+    uint16_t actions = 0U;
+    uint16_t i;
+
+    for(i = 0U; i < 6U; i++)
+    {
+        actions |= (uint16_t)((getRandom() % 3U) << (2U * i));
+    }
+
+    return(actions);
+}
+
+//
+// edgeCallback - Adds up the fine high time of the measured module
+//
+static void edgeCallback(uint32_t base, uint16_t output, uint16_t level,
+                         uint64_t cycle)
+{
+    const Sim_EPWM_OutputStats *stats;
+    OutputTiming *t = &timing[output];
+    uint64_t fine;
+
+    (void)cycle;
+
+    if(base != measuredBase)
+    {
+        return;
+    }
+
+    stats = Sim_EPWM_getOutputStats(base, output);
+    fine = (level != 0U) ? stats->fineRise : stats->fineFall;
+    if(t->level != 0U)
+    {
+        t->highTime += fine - t->lastEdge;
+    }
+    t->lastEdge = fine;
+    t->level = level;
+
+    if(level != 0U)
+    {
+        if(t->rises == 0U)
+        {
+            t->firstRise = fine;
+            t->highAtFirstRise = t->highTime;
+        }
+        t->highAtLastRise = t->highTime;
+        t->rises++;
+    }
+}
+
+//
+// measure - Records the edges of both outputs of a module for a number of
+// cycles
+//
+static void measure(uint32_t base, uint32_t cycles)
+{
+    uint64_t end;
+    uint16_t i;
+
+    for(i = 0U; i < 2U; i++)
+    {
+        timing[i].level = Sim_EPWM_getOutputStats(base, i)->level;
+        timing[i].lastEdge = Sim_getCycles() << SIM_EPWM_FINE_S;
+        timing[i].highTime = 0U;
+        timing[i].rises = 0U;
+    }
+
+    measuredBase = base;
+    Sim_run(cycles);
+    measuredBase = 0U;
+
+    end = Sim_getCycles() << SIM_EPWM_FINE_S;
+    for(i = 0U; i < 2U; i++)
+    {
+        if(timing[i].level != 0U)
+        {
+            timing[i].highTime += end - timing[i].lastEdge;
+        }
+    }
+}
+
+//
+// checkRandom - Compares the readback of one random configuration with the
+// simulated outputs
+//
+static void checkRandom(uint32_t base)
+{
+    PWMReadback_Channel readback;
+    uint16_t mode;
+    uint16_t period;
+    uint16_t compareA;
+    uint16_t compareB;
+    uint16_t clockDivider;
+    uint16_t highSpeedDivider;
+    uint16_t deadBand;
+    uint16_t duty[2];
+    uint16_t i;
+    uint32_t cycles;
+    uint32_t periods;
+    double frequency;
+    double measured;
+
+    //
+    // Compare values beyond TBPRD never match; 0 and TBPRD are drawn more
+    // often than the rest
+    //
+    do
+    {
+        mode = (uint16_t)(getRandom() % 3U);
+        period = (uint16_t)(3U + (getRandom() % 200U));
+        compareA = (uint16_t)(getRandom() % (period + 3U));
+        compareB = (uint16_t)(getRandom() % (period + 3U));
+        if((getRandom() % 5U) == 0U)
+        {
+            compareA = ((getRandom() & 1U) != 0U) ? 0U : period;
+        }
+        if((getRandom() % 5U) == 0U)
+        {
+            compareB = ((getRandom() & 1U) != 0U) ? 0U : period;
+        }
+    } while((mode == (uint16_t)EPWM_COUNTER_MODE_UP_DOWN) &&
+            ((compareA == 0U) || (compareA == period) ||
+             (compareB == 0U) || (compareB == period)));
+    clockDivider = (uint16_t)(getRandom() % 3U);
+    highSpeedDivider = (uint16_t)(getRandom() % 3U);
+
+    SysCtl_disablePeripheral(SYSCTL_PERIPH_CLK_TBCLKSYNC);
+    EPWM_setTimeBasePeriod(base, period);
+    EPWM_setTimeBaseCounter(base, 0U);
+    EPWM_disableCounterCompareShadowLoadMode(base, EPWM_COUNTER_COMPARE_A);
+    EPWM_disableCounterCompareShadowLoadMode(base, EPWM_COUNTER_COMPARE_B);
+    EPWM_setCounterCompareValue(base, EPWM_COUNTER_COMPARE_A, compareA);
+    EPWM_setCounterCompareValue(base, EPWM_COUNTER_COMPARE_B, compareB);
+    EPWM_setTimeBaseCounterMode(base, (EPWM_TimeBaseCountMode)mode);
+    EPWM_setClockPrescaler(base, (EPWM_ClockDivider)clockDivider,
+                           (EPWM_HSClockDivider)highSpeedDivider);
+
+    //
+    // On every other configuration a random dead-band routing with delays
+    // of up to a whole period
+    //
+    deadBand = 0U;
+    if((getRandom() & 1U) != 0U)
+    {
+        deadBand = (uint16_t)(getRandom() & (EPWM_DBCTL_OUT_MODE_M |
+                                             EPWM_DBCTL_POLSEL_M |
+                                             EPWM_DBCTL_IN_MODE_M));
+        if((getRandom() & 1U) != 0U)
+        {
+            deadBand |= EPWM_DBCTL_HALFCYCLE;
+        }
+        HWREGH(base + EPWM_O_DBRED) = (uint16_t)(getRandom() % (period + 1U));
+        HWREGH(base + EPWM_O_DBFED) = (uint16_t)(getRandom() % (period + 1U));
+    }
+    HWREGH(base + EPWM_O_DBCTL) = deadBand;
+
+    //
+    // The model routes edges through the dead band as they happen, so the
+    // outputs are driven high and then low through the new routing before
+    // the random actions take over
+    //
+    HWREGH(base + EPWM_O_AQCTLA) = 0xAAAU;
+    HWREGH(base + EPWM_O_AQCTLB) = 0xAAAU;
+    SysCtl_enablePeripheral(SYSCTL_PERIPH_CLK_TBCLKSYNC);
+    Sim_run(SETTLE_CYCLES);
+    HWREGH(base + EPWM_O_AQCTLA) = 0x555U;
+    HWREGH(base + EPWM_O_AQCTLB) = 0x555U;
+    Sim_run(SETTLE_CYCLES);
+
+    HWREGH(base + EPWM_O_AQCTLA) = getActions();
+    HWREGH(base + EPWM_O_AQCTLB) = getActions();
+    Sim_run(SETTLE_CYCLES);
+
+    //
+    // A whole number of periods, so that where the window starts does not
+    // matter
+    //
+    cycles = ((mode == (uint16_t)EPWM_COUNTER_MODE_UP_DOWN) ?
+              (2UL * period) : ((uint32_t)period + 1UL)) << clockDivider;
+    if(highSpeedDivider != 0U)
+    {
+        cycles *= 2U * highSpeedDivider;
+    }
+    periods = (WINDOW_CYCLES + cycles - 1U) / cycles;
+
+    PWMReadback_init(&readback, base, DEVICE_SYSCLK_FREQ);
+    measure(base, periods * cycles);
+
+    frequency = (double)readback.frequency +
+                ((double)readback.frequencyMilliHz / 1000.0);
+    measured = (double)periods * DEVICE_SYSCLK_FREQ /
+               (double)(periods * cycles);
+    TEST_CHECK(fabs(frequency - measured) < FREQUENCY_TOLERANCE);
+
+    duty[0] = readback.dutyA;
+    duty[1] = readback.dutyB;
+    for(i = 0U; i < 2U; i++)
+    {
+        measured = (double)timing[i].highTime * PWMREADBACK_DUTY_ONE /
+                   ((double)periods * cycles * SIM_EPWM_FINE_ONE);
+        if(fabs(measured - duty[i]) > 0.5)
+        {
+            printf("duty %c: mode %u, TBPRD %u, CMPA %u, CMPB %u, "
+                   "AQCTLA 0x%03X, AQCTLB 0x%03X, DBCTL 0x%04X, "
+                   "DBRED %u, DBFED %u: read %u, simulated %.1f\n",
+                   'A' + i, mode, period, compareA, compareB,
+                   readback.actionA, readback.actionB, readback.deadBand,
+                   readback.risingDelay, readback.fallingDelay, duty[i],
+                   measured);
+        }
+        TEST_CHECK(fabs(measured - duty[i]) <= 0.5);
+    }
+}
+
+//
+// checkHighResolution - Compares the readback of ePWM5 as the application
+// runs it, with random fractions, periods and dead time
+//
+static void checkHighResolution(void)
+{
+    PWMReadback_Channel readback;
+    uint32_t period;
+    uint32_t compare;
+    uint32_t rising;
+    uint32_t falling;
+    uint16_t duty[2];
+    uint16_t i;
+    uint16_t j;
+    uint64_t span;
+    double frequency;
+    double measured;
+
+    SysCtl_disablePeripheral(SYSCTL_PERIPH_CLK_TBCLKSYNC);
+    EPWM_setTimeBasePeriod(EPWM5_BASE, HR_PERIOD);
+    EPWM_setTimeBaseCounter(EPWM5_BASE, 0U);
+    EPWM_setTimeBaseCounterMode(EPWM5_BASE, EPWM_COUNTER_MODE_UP_DOWN);
+    EPWM_setClockPrescaler(EPWM5_BASE, EPWM_CLOCK_DIVIDER_1,
+                           EPWM_HSCLOCK_DIVIDER_1);
+    EPWM_setCounterCompareShadowLoadMode(EPWM5_BASE, EPWM_COUNTER_COMPARE_A,
+                                         EPWM_COMP_LOAD_ON_CNTR_ZERO);
+    EPWM_setCounterCompareShadowLoadMode(EPWM5_BASE, EPWM_COUNTER_COMPARE_B,
+                                         EPWM_COMP_LOAD_ON_CNTR_ZERO);
+    HWREGH(EPWM5_BASE + EPWM_O_AQCTLA) = EPWM_AQ_OUTPUT_HIGH_UP_CMPA |
+                                         EPWM_AQ_OUTPUT_LOW_DOWN_CMPA;
+    HWREGH(EPWM5_BASE + EPWM_O_AQCTLB) = EPWM_AQ_OUTPUT_LOW_UP_CMPB |
+                                         EPWM_AQ_OUTPUT_HIGH_DOWN_CMPB;
+    PWMHR_init(EPWM5_BASE);
+    PWMDeadband_init(EPWM5_BASE);
+    PWMDeadband_enable(EPWM5_BASE);
+    SysCtl_enablePeripheral(SYSCTL_PERIPH_CLK_TBCLKSYNC);
+
+    while(PWMHR_calibrate() == PWMHR_CAL_INCOMPLETE)
+    {
+    }
+
+    PWMReadback_init(&readback, EPWM5_BASE, DEVICE_SYSCLK_FREQ);
+
+    for(i = 0U; i < HR_CONFIGS; i++)
+    {
+        period = PWMHR_COUNT(HR_PERIOD) + (getRandom() % PWMHR_COUNT_ONE);
+        compare = PWMHR_COUNT(HR_MIN_COMPARE) +
+                  (getRandom() %
+                   PWMHR_COUNT(HR_PERIOD - (2U * HR_MIN_COMPARE)));
+        rising = getRandom() % PWMHR_COUNT(HR_MIN_COMPARE);
+        falling = getRandom() % PWMHR_COUNT(HR_MIN_COMPARE);
+        PWMHR_setPeriodAndCompare(EPWM5_BASE, period, compare, compare);
+        PWMDeadband_setDelay(EPWM5_BASE, rising, falling, false);
+        Sim_run(SETTLE_CYCLES);
+
+        TEST_CHECK(PWMReadback_update(&readback));
+        measure(EPWM5_BASE, HR_WINDOW_CYCLES);
+
+        //
+        // One pulse per period on each output: from its first rising edge
+        // to its last is a whole number of periods
+        //
+        duty[0] = readback.dutyA;
+        duty[1] = readback.dutyB;
+        for(j = 0U; j < 2U; j++)
+        {
+            TEST_CHECK(timing[j].rises > 100U);
+            span = Sim_EPWM_getOutputStats(EPWM5_BASE, j)->fineRise -
+                   timing[j].firstRise;
+            measured = (double)(timing[j].highAtLastRise -
+                                timing[j].highAtFirstRise) *
+                       PWMREADBACK_DUTY_ONE / (double)span;
+            TEST_CHECK(fabs(measured - duty[j]) <= 1.0);
+
+            if(j == 0U)
+            {
+                frequency = (double)readback.frequency +
+                            ((double)readback.frequencyMilliHz / 1000.0);
+                measured = (double)(timing[j].rises - 1U) *
+                           DEVICE_SYSCLK_FREQ * SIM_EPWM_FINE_ONE /
+                           (double)span;
+                TEST_CHECK((fabs(frequency - measured) / measured) <
+                           (HR_FREQUENCY_PPM * 1.0e-6));
+            }
+        }
+    }
+
+    //
+    // Output swap is not worked out
+    //
+    HWREGH(EPWM5_BASE + EPWM_O_DBCTL) |= EPWM_DBCTL_OUTSWAP_M;
+    TEST_CHECK(PWMReadback_update(&readback));
+    TEST_CHECK(readback.dutyA == PWMREADBACK_DUTY_UNKNOWN);
+    TEST_CHECK(readback.dutyB == PWMREADBACK_DUTY_UNKNOWN);
+}
+
+//
+// End of File
+//
@@ -0,0 +1,236 @@
+//###########################################################################
+//
+// FILE:   test_sci_buffer.c
+//
+// TITLE:  Interrupt-driven SCI transmit and receive buffering.
+//
+//###########################################################################
+//
+// Sends menu screens and an oversized block through the transmit ring, and
+// feeds text into the receive ring through the simulated SCIA: peeking,
+// reading, whole lines only, and characters lost to a full ring or to a
+// hardware FIFO that was not serviced.
+//
+//###########################################################################
+
+//
+// Included Files
+//
+#include "test.h"
+#include <string.h>
+#include "sci_buffer.h"
+
+//
+// Defines
+//
+#define SCREEN_ROUNDS   50U
+#define SENT_SIZE       8192U
+#define LINE_SIZE       16U
+#define EXCESS          10U     // Characters sent beyond the receive ring
+
+//
+// Globals
+//
+static const char screen[] =
+    "\r\n\nChoose an option: \n\r\n 1. Change duty cycle \n"
+    "\r\n 2. Change frequency \n\r\n 3. Power off \r\n\nEnter number: ";
+static char sent[SENT_SIZE];
+static uint32_t sentCount;
+
+//
+// Function Prototypes
+//
+static void txCallback(uint32_t base, uint16_t data, uint64_t cycle);
+static void drain(void);
+static void receive(const char *text);
+static void checkReceive(void);
+
+//
+// Main
+//
+int main(void)
+{
+    char expected[SENT_SIZE];
+    uint32_t expectedCount = 0U;
+    uint16_t block[SCIBUFFER_TX_SIZE + 100U];
+    uint16_t queued;
+    uint16_t i;
+
+    Test_initSim();
+    Test_initSCI(SCIA_BASE, 9600U);
+    Sim_SCI_setTxCallback(&txCallback);
+    SCIBuffer_init(SCIA_BASE);
+    EINT;
+
+    TEST_CHECK(SCIBuffer_isTxIdle());
+    TEST_CHECK(SCIBuffer_getTxFree() == SCIBUFFER_TX_SIZE);
+
+    //
+    // Screens queued while the previous one is still going out arrive
+    // complete and in order
+    //
+    for(i = 0U; i < SCREEN_ROUNDS; i++)
+    {
+        queued = SCIBuffer_writeString(screen);
+        TEST_CHECK(queued == (sizeof(screen) - 1U));
+        memcpy(&expected[expectedCount], screen, queued);
+        expectedCount += queued;
+        Sim_run(DEVICE_SYSCLK_FREQ / 8U);
+    }
+    drain();
+    TEST_CHECK(sentCount == expectedCount);
+    TEST_CHECK(memcmp(sent, expected, expectedCount) == 0);
+    TEST_CHECK(SCIBuffer_getTxOverflowCount() == 0U);
+
+    //
+    // A write that does not fit is cut short, and the characters dropped
+    // are counted
+    //
+    for(i = 0U; i < (sizeof(block) / sizeof(block[0])); i++)
+    {
+        block[i] = (uint16_t)('a' + (i % 26U));
+    }
+    sentCount = 0U;
+    queued = SCIBuffer_write(block, sizeof(block) / sizeof(block[0]));
+    TEST_CHECK(queued < (sizeof(block) / sizeof(block[0])));
+    TEST_CHECK(SCIBuffer_getTxOverflowCount() ==
+               ((sizeof(block) / sizeof(block[0])) - queued));
+    drain();
+    TEST_CHECK(sentCount == queued);
+    for(i = 0U; i < sentCount; i++)
+    {
+        TEST_CHECK(sent[i] == (char)block[i]);
+    }
+
+    checkReceive();
+
+    return(Test_report("test_sci_buffer"));
+}
+
+//
+// txCallback - Records the characters the SCI model shifts out
+//
+static void txCallback(uint32_t base, uint16_t data, uint64_t cycle)
+{
+    (void)base;
+    (void)cycle;
+
+    if(sentCount < SENT_SIZE)
+    {
+        sent[sentCount] = (char)data;
+    }
+    sentCount++;
+}
+
+//
+// drain - Runs the simulation until everything queued went out
+//
+static void drain(void)
+{
+    while(!SCIBuffer_isTxIdle())
+    {
+        Sim_run(DEVICE_SYSCLK_FREQ / 1000U);
+    }
+}
+
+//
+// receive - Feeds text into the SCIA receiver and runs until it arrived
+//
+static void receive(const char *text)
+{
+    uint16_t data[SIM_SCI_FIFO_DEPTH * 8U];
+    uint16_t length = (uint16_t)strlen(text);
+    uint16_t i;
+
+    for(i = 0U; i < length; i++)
+    {
+        data[i] = (uint16_t)text[i];
+    }
+    (void)Sim_SCI_receive(SCIA_BASE, data, length);
+    Sim_run((length + 1U) * Sim_SCI_getCharCycles(SCIA_BASE));
+}
+
+//
+// checkReceive - Reads received characters back in every way the receive
+// ring offers
+//
+static void checkReceive(void)
+{
+    char text[SCIBUFFER_RX_SIZE + EXCESS + 1U];
+    char line[LINE_SIZE];
+    uint16_t data[SCIBUFFER_RX_SIZE];
+    uint16_t c = 0U;
+    uint16_t i;
+
+    TEST_CHECK(!SCIBuffer_peekChar(&c));
+    TEST_CHECK(!SCIBuffer_readChar(&c));
+    TEST_CHECK(SCIBuffer_read(data, 4U) == 0U);
+
+    //
+    // Peeking leaves the character for the next read
+    //
+    receive("xyz");
+    TEST_CHECK(SCIBuffer_getRxCount() == 3U);
+    TEST_CHECK(SCIBuffer_peekChar(&c) && (c == (uint16_t)'x'));
+    TEST_CHECK(SCIBuffer_peekChar(&c) && (c == (uint16_t)'x'));
+    TEST_CHECK(SCIBuffer_getRxCount() == 3U);
+    TEST_CHECK(SCIBuffer_readChar(&c) && (c == (uint16_t)'x'));
+    TEST_CHECK(SCIBuffer_read(data, 4U) == 2U);
+    TEST_CHECK((data[0] == (uint16_t)'y') && (data[1] == (uint16_t)'z'));
+    TEST_CHECK(SCIBuffer_getRxCount() == 0U);
+
+    //
+    // Lines come out only once complete, without their terminators and
+    // without the empty line of a CR/LF pair; a long line is cut to the
+    // buffer
+    //
+    receive("set 5");
+    TEST_CHECK(!SCIBuffer_readLine(line, sizeof(line)));
+    TEST_CHECK(SCIBuffer_getRxCount() == 5U);
+    receive("0\r\nabcdefghijklmnopqrstuvwxyz\nrest");
+    TEST_CHECK(SCIBuffer_readLine(line, sizeof(line)));
+    TEST_CHECK(strcmp(line, "set 50") == 0);
+    TEST_CHECK(SCIBuffer_readLine(line, sizeof(line)));
+    TEST_CHECK(strcmp(line, "abcdefghijklmno") == 0);
+    TEST_CHECK(!SCIBuffer_readLine(line, sizeof(line)));
+    TEST_CHECK(SCIBuffer_read(data, 4U) == 4U);
+    TEST_CHECK(SCIBuffer_getRxOverrunCount() == 0U);
+
+    //
+    // Characters beyond a full ring are dropped and counted; the ring keeps
+    // the first ones
+    //
+    for(i = 0U; i < (SCIBUFFER_RX_SIZE + EXCESS); i++)
+    {
+        text[i] = (char)('a' + (i % 26U));
+    }
+    text[i] = '\0';
+    receive(text);
+    TEST_CHECK(SCIBuffer_getRxCount() == SCIBUFFER_RX_SIZE);
+    TEST_CHECK(SCIBuffer_getRxOverrunCount() == EXCESS);
+    TEST_CHECK(SCIBuffer_read(data, SCIBUFFER_RX_SIZE) == SCIBUFFER_RX_SIZE);
+    for(i = 0U; i < SCIBUFFER_RX_SIZE; i++)
+    {
+        TEST_CHECK(data[i] == (uint16_t)text[i]);
+    }
+    TEST_CHECK(!SCIBuffer_readChar(&c));
+
+    //
+    // With interrupts held off the hardware FIFO overflows; the interrupt
+    // counts that once when it runs and keeps the characters the FIFO held
+    //
+    DINT;
+    receive("0123456789abcdefXYZ");
+    EINT;
+    Sim_run(Sim_SCI_getCharCycles(SCIA_BASE));
+    TEST_CHECK(SCIBuffer_getRxOverrunCount() == (EXCESS + 1U));
+    TEST_CHECK(SCIBuffer_getRxCount() == SIM_SCI_FIFO_DEPTH);
+    TEST_CHECK(SCIBuffer_read(data, SCIBUFFER_RX_SIZE) ==
+               SIM_SCI_FIFO_DEPTH);
+    TEST_CHECK((data[0] == (uint16_t)'0') &&
+               (data[SIM_SCI_FIFO_DEPTH - 1U] == (uint16_t)'f'));
+}
+
+//
+// End of File
+//
@@ -0,0 +1,121 @@
+//###########################################################################
+//
+// FILE:   test_sim.c
+//
+// TITLE:  Register file, address translation and PIE of the simulator.
+//
+//###########################################################################
+
+//
+// Included Files
+//
+#include "test.h"
+
+//
+// Globals
+//
+static uint32_t handlerCalls;
+static uint32_t idleCalls;
+
+//
+// Function Prototypes
+//
+static void epwm5ISR(void);
+static void idleHook(void);
+
+//
+// Main
+//
+int main(void)
+{
+    uint32_t address = EPWM5_BASE + EPWM_O_TBPRD;
+    uint64_t start;
+
+    Test_initSim();
+
+    //
+    // Device_init() returned, so the start-up registers it polls read back
+    // their reset values; driverlib writes read back unchanged
+    //
+    TEST_CHECK((HWREGH(CLKCFG_BASE + SYSCTL_O_SYSPLLSTS) &
+                SYSCTL_SYSPLLSTS_LOCKS) != 0U);
+    EPWM_setTimeBasePeriod(EPWM5_BASE, 850U);
+    TEST_CHECK(EPWM_getTimeBasePeriod(EPWM5_BASE) == 850U);
+    TEST_CHECK(Sim_readReg16(address) == 850U);
+
+    //
+    // 32-bit registers hold the low word first, as on the C28x
+    //
+    HWREG(EPWM5_BASE + EPWM_O_CMPA) = 0x12345678UL;
+    TEST_CHECK(HWREGH(EPWM5_BASE + EPWM_O_CMPA) == 0x5678U);
+    TEST_CHECK(HWREGH(EPWM5_BASE + EPWM_O_CMPA + 1U) == 0x1234U);
+    TEST_CHECK(Sim_readReg32(EPWM5_BASE + EPWM_O_CMPA) == 0x12345678UL);
+
+    //
+    // Register pointers, device addresses cast to pointers and simulated
+    // RAM all translate back to their word addresses
+    //
+    TEST_CHECK(Sim_getAddress(Sim_getRegAddress(address)) == address);
+    TEST_CHECK(Sim_getAddress((const void *)(uintptr_t)address) == address);
+    TEST_CHECK(Sim_getAddress(Sim_getRAMAddress(SIM_RAMGS0_BASE + 5U)) ==
+               SIM_RAMGS0_BASE + 5U);
+    *Sim_getRAMAddress(SIM_RAMGS0_BASE) = 0xBEEFU;
+    TEST_CHECK(Sim_readReg16(SIM_RAMGS0_BASE) == 0xBEEFU);
+
+    //
+    // A pending PIE interrupt dispatches once interrupts are enabled, and
+    // only once per acknowledge of its group
+    //
+    Interrupt_register(INT_EPWM5, &epwm5ISR);
+    Interrupt_enable(INT_EPWM5);
+    Sim_raiseInterrupt(INT_EPWM5);
+    Sim_run(1U);
+    TEST_CHECK(handlerCalls == 0U);
+    EINT;
+    Sim_run(1U);
+    TEST_CHECK(handlerCalls == 1U);
+    TEST_CHECK(Sim_getVector(INT_EPWM5) == &epwm5ISR);
+    TEST_CHECK(Sim_getInterruptStats(INT_EPWM5)->count == 1U);
+
+    //
+    // The background loop of a host build lets time pass and calls the hook
+    //
+    Sim_setIdleHook(&idleHook);
+    start = Sim_getCycles();
+    Sim_idle();
+    Sim_idle();
+    TEST_CHECK(idleCalls == 2U);
+    TEST_CHECK(Sim_getCycles() == (start + (2U * SIM_IDLE_CYCLES)));
+    Sim_setIdleHook(NULL);
+
+    //
+    // A reset clears the registers and the time base
+    //
+    Sim_reset();
+    TEST_CHECK(Sim_readReg16(address) == 0U);
+    TEST_CHECK(Sim_readReg16(SIM_RAMGS0_BASE) == 0U);
+    TEST_CHECK(Sim_getCycles() == 0U);
+
+    return(Test_report("test_sim"));
+}
+
+//
+// epwm5ISR - Counts the calls and acknowledges the PIE group
+//
+static void epwm5ISR(void)
+{
+    handlerCalls++;
+    Interrupt_clearACKGroup(INTERRUPT_ACK_GROUP3);
+}
+
+//
+// idleHook - Counts the passes of the background loop
+//
+static void idleHook(void)
+{
+    idleCalls++;
+}
+
+//
+// End of File
+//
@@ -0,0 +1,147 @@
+//###########################################################################
+//
+// FILE:   test_stream.c
+//
+// TITLE:  DMA streaming of compare pairs into an ePWM module.
+//
+//###########################################################################
+//
+// Streams a sine table into ePWM1 from simulated GS RAM for 25000 periods
+// of 40 us and reads the compare registers back once per period. Each
+// period must hold the next pair of the buffer, in order and wrapping at
+// its end, with the pair of the period before it active, one DMA burst per
+// period and no CPU interrupt.
+//
+//###########################################################################
+
+//
+// Included Files
+//
+#include "test.h"
+#include "pwm_modulation.h"
+#include "pwm_stream.h"
+
+//
+// Defines
+//
+#define TABLE_LENGTH        256U
+#define OFFSET_B            128U
+#define STREAM_PERIOD       2000U
+#define PERIODS             25000U
+
+//
+// Function Prototypes
+//
+static uint16_t findPair(const uint16_t *buffer, uint16_t compareA,
+                         uint16_t compareB);
+
+//
+// Main
+//
+int main(void)
+{
+    uint16_t table[TABLE_LENGTH];
+    uint16_t *buffer;
+    uint16_t compareA;
+    uint16_t compareB;
+    uint16_t activeA;
+    uint16_t lastA = 0U;
+    uint16_t first = TABLE_LENGTH;
+    uint16_t index;
+    uint32_t mismatches = 0U;
+    uint32_t i;
+    const Sim_DMA_Stats *stats;
+
+    Test_initSim();
+
+    //
+    // The pairs interleave CMPA and CMPB, with CMPB half a table ahead
+    //
+    buffer = Sim_getRAMAddress(SIM_RAMGS0_BASE);
+    PWMMod_fillSine(table, TABLE_LENGTH, 50U, STREAM_PERIOD - 50U);
+    PWMStream_fillFromTable(buffer, table, TABLE_LENGTH, OFFSET_B);
+    for(i = 0U; i < TABLE_LENGTH; i++)
+    {
+        TEST_CHECK(buffer[2U * i] == table[i]);
+        TEST_CHECK(buffer[(2U * i) + 1U] ==
+                   table[(i + OFFSET_B) % TABLE_LENGTH]);
+    }
+
+    SysCtl_disablePeripheral(SYSCTL_PERIPH_CLK_TBCLKSYNC);
+    DMA_initController();
+    DMA_setEmulationMode(DMA_EMULATION_FREE_RUN);
+    EPWM_setTimeBasePeriod(EPWM1_BASE, STREAM_PERIOD);
+    EPWM_setTimeBaseCounter(EPWM1_BASE, 0U);
+    EPWM_setTimeBaseCounterMode(EPWM1_BASE, EPWM_COUNTER_MODE_UP_DOWN);
+    EPWM_setClockPrescaler(EPWM1_BASE, EPWM_CLOCK_DIVIDER_1,
+                           EPWM_HSCLOCK_DIVIDER_1);
+    EPWM_setCounterCompareShadowLoadMode(EPWM1_BASE, EPWM_COUNTER_COMPARE_A,
+                                         EPWM_COMP_LOAD_ON_CNTR_ZERO);
+    EPWM_setCounterCompareShadowLoadMode(EPWM1_BASE, EPWM_COUNTER_COMPARE_B,
+                                         EPWM_COMP_LOAD_ON_CNTR_ZERO);
+    PWMStream_init(DMA_CH1_BASE, EPWM1_BASE, buffer, TABLE_LENGTH);
+    SysCtl_enablePeripheral(SYSCTL_PERIPH_CLK_TBCLKSYNC);
+    EINT;
+
+    //
+    // Sample every period shortly after its counter-zero transfer
+    //
+    Sim_run(100U);
+    for(i = 0U; i < PERIODS; i++)
+    {
+        Sim_run(2U * STREAM_PERIOD);
+
+        compareA = HWREGH(EPWM1_BASE + EPWM_O_CMPA + 1U);
+        compareB = HWREGH(EPWM1_BASE + EPWM_O_CMPB + 1U);
+        Sim_EPWM_getActiveValues(EPWM1_BASE, NULL, &activeA, NULL);
+
+        if(first == TABLE_LENGTH)
+        {
+            first = findPair(buffer, compareA, compareB);
+            TEST_CHECK(first < TABLE_LENGTH);
+        }
+        index = (uint16_t)((first + i) % TABLE_LENGTH);
+
+        if((compareA != buffer[2U * index]) ||
+           (compareB != buffer[(2U * index) + 1U]) ||
+           ((i > 0U) && (activeA != lastA)))
+        {
+            mismatches++;
+        }
+        lastA = compareA;
+    }
+    TEST_CHECK(mismatches == 0U);
+
+    stats = Sim_DMA_getStats(DMA_CH1_BASE);
+    TEST_CHECK(stats->overflows == 0U);
+    TEST_CHECK(stats->bursts >= PERIODS);
+    TEST_CHECK(stats->bursts <= (PERIODS + 1U));
+    TEST_CHECK(Sim_getInterruptStats(INT_DMA_CH1)->count == 0U);
+
+    return(Test_report("test_stream"));
+}
+
+//
+// findPair - Returns the index of a compare pair in the buffer, or
+// TABLE_LENGTH if it is not there
+//
+static uint16_t findPair(const uint16_t *buffer, uint16_t compareA,
+                         uint16_t compareB)
+{
+    uint16_t i;
+
+    for(i = 0U; i < TABLE_LENGTH; i++)
+    {
+        if((buffer[2U * i] == compareA) &&
+           (buffer[(2U * i) + 1U] == compareB))
+        {
+            return(i);
+        }
+    }
+
+    return(TABLE_LENGTH);
+}
+
+//
+// End of File
+//
@@ -0,0 +1,209 @@
+//###########################################################################
+//
+// FILE:   test_update.c
+//
+// TITLE:  Period and compare updates without runt pulses.
+//
+//###########################################################################
+//
+// Sends ePWM5 4000 period and compare updates at random times, switching
+// between 10% and 90% duty so that a compare from one update and a period
+// from another would give a pulse no update asked for. Every pulse of
+// output A must come from one commanded period and compare pair, with the
+// high time that pair gives. The same updates written as three separate
+// registers must show such runt pulses, so that the check is known to
+// catch them.
+//
+//###########################################################################
+
+//
+// Included Files
+//
+#include "test.h"
+#include "pwm_duty.h"
+#include "pwm_update.h"
+
+//
+// Defines
+//
+#define UPDATES             4000U
+#define HISTORY             4U
+
+//
+// Globals
+//
+static uint16_t commandPeriod[UPDATES + 1U];
+static uint16_t commandCompare[UPDATES + 1U];
+static uint32_t commands;
+static uint32_t pulses;
+static uint32_t runts;
+static uint32_t widthErrors;
+static uint32_t randomState;
+
+//
+// Function Prototypes
+//
+static uint32_t getRandom(void);
+static void edgeCallback(uint32_t base, uint16_t output, uint16_t level,
+                         uint64_t cycle);
+static void runUpdates(bool isAtomic);
+
+//
+// Main
+//
+int main(void)
+{
+    Sim_EPWM_setEdgeCallback(&edgeCallback);
+
+    runUpdates(true);
+    TEST_CHECK(pulses > UPDATES);
+    TEST_CHECK(runts == 0U);
+    TEST_CHECK(widthErrors == 0U);
+    TEST_CHECK(Sim_EPWM_getOutputStats(EPWM5_BASE,
+                                       SIM_EPWM_OUTPUT_A)->minHighTime >=
+               (2U * (500U - PWMDuty_toCount(500U, PWMDUTY_Q15(0.9)))));
+
+    runUpdates(false);
+    TEST_CHECK(runts > 0U);
+
+    return(Test_report("test_update"));
+}
+
+//
+// getRandom - Returns the next value of a 32-bit xorshift generator
+//
+static uint32_t getRandom(void)
+{
+    randomState ^= randomState << 13U;
+    randomState ^= randomState >> 17U;
+    randomState ^= randomState << 5U;
+
+    return(randomState >> 8U);
+}
+
+//
+// edgeCallback - Checks every pulse of ePWM5A against the recent commands
+//
+static void edgeCallback(uint32_t base, uint16_t output, uint16_t level,
+                         uint64_t cycle)
+{
+    uint16_t period;
+    uint16_t compare;
+    bool isCommanded = false;
+    uint32_t i;
+
+    (void)cycle;
+
+    if((base != EPWM5_BASE) || (output != SIM_EPWM_OUTPUT_A) ||
+       (level != 0U))
+    {
+        return;
+    }
+
+    pulses++;
+    Sim_EPWM_getActiveValues(base, &period, &compare, NULL);
+
+    //
+    // Up-down count: high from CMPA counting up to CMPA counting down
+    //
+    if(Sim_EPWM_getOutputStats(base, output)->highTime !=
+       (2U * (uint64_t)(period - compare)))
+    {
+        widthErrors++;
+    }
+
+    for(i = commands; (i > 0U) && ((commands - i) < HISTORY); i--)
+    {
+        if((commandPeriod[i - 1U] == period) &&
+           (commandCompare[i - 1U] == compare))
+        {
+            isCommanded = true;
+        }
+    }
+    if(!isCommanded)
+    {
+        runts++;
+    }
+}
+
+//
+// runUpdates - Sets ePWM5 up as the application does and updates it at
+// random times, through PWMUpdate or by separate register writes
+//
+static void runUpdates(bool isAtomic)
+{
+    uint16_t period;
+    uint16_t compare;
+    uint32_t i;
+
+    Test_initSim();
+
+    SysCtl_disablePeripheral(SYSCTL_PERIPH_CLK_TBCLKSYNC);
+    EPWM_setTimeBasePeriod(EPWM5_BASE, 850U);
+    EPWM_setTimeBaseCounter(EPWM5_BASE, 0U);
+    EPWM_setCounterCompareValue(EPWM5_BASE, EPWM_COUNTER_COMPARE_A, 425U);
+    EPWM_setCounterCompareValue(EPWM5_BASE, EPWM_COUNTER_COMPARE_B, 425U);
+    EPWM_setTimeBaseCounterMode(EPWM5_BASE, EPWM_COUNTER_MODE_UP_DOWN);
+    EPWM_setClockPrescaler(EPWM5_BASE, EPWM_CLOCK_DIVIDER_1,
+                           EPWM_HSCLOCK_DIVIDER_1);
+    EPWM_setCounterCompareShadowLoadMode(EPWM5_BASE, EPWM_COUNTER_COMPARE_A,
+                                         EPWM_COMP_LOAD_ON_CNTR_ZERO);
+    EPWM_setCounterCompareShadowLoadMode(EPWM5_BASE, EPWM_COUNTER_COMPARE_B,
+                                         EPWM_COMP_LOAD_ON_CNTR_ZERO);
+    EPWM_setActionQualifierAction(EPWM5_BASE, EPWM_AQ_OUTPUT_A,
+                                  EPWM_AQ_OUTPUT_HIGH,
+                                  EPWM_AQ_OUTPUT_ON_TIMEBASE_UP_CMPA);
+    EPWM_setActionQualifierAction(EPWM5_BASE, EPWM_AQ_OUTPUT_A,
+                                  EPWM_AQ_OUTPUT_LOW,
+                                  EPWM_AQ_OUTPUT_ON_TIMEBASE_DOWN_CMPA);
+    if(isAtomic)
+    {
+        PWMUpdate_init(EPWM5_BASE);
+    }
+    SysCtl_enablePeripheral(SYSCTL_PERIPH_CLK_TBCLKSYNC);
+
+    commandPeriod[0] = 850U;
+    commandCompare[0] = 425U;
+    commands = 1U;
+    pulses = 0U;
+    runts = 0U;
+    widthErrors = 0U;
+    randomState = 1U;
+
+    for(i = 0U; i < UPDATES; i++)
+    {
+        Sim_run(1000U + (getRandom() % 3000U));
+
+        period = 500U + (50U * (uint16_t)(getRandom() % 21U));
+        compare = PWMDuty_toCount(period, ((getRandom() & 1U) != 0U) ?
+                                          PWMDUTY_Q15(0.9) :
+                                          PWMDUTY_Q15(0.1));
+        commandPeriod[commands] = period;
+        commandCompare[commands] = compare;
+        commands++;
+
+        if(isAtomic)
+        {
+            PWMUpdate_setPeriodAndCompare(EPWM5_BASE, period, compare,
+                                          compare);
+        }
+        else
+        {
+            //
+            // A few instructions apart, as an ISR would write them
+            //
+            EPWM_setCounterCompareValue(EPWM5_BASE, EPWM_COUNTER_COMPARE_A,
+                                        compare);
+            Sim_run(40U);
+            EPWM_setCounterCompareValue(EPWM5_BASE, EPWM_COUNTER_COMPARE_B,
+                                        compare);
+            Sim_run(40U);
+            EPWM_setTimeBasePeriod(EPWM5_BASE, period);
+        }
+    }
+    Sim_run(10000U);
+}
+
+//
+// End of File
+//
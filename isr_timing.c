@@ -0,0 +1,148 @@
+//#############################################################################
+//
+// FILE:   isr_timing.c
+//
+// TITLE:  Execution time and latency measurement of interrupt routines.
+//
+//#############################################################################
+
+//
+// Included Files
+//
+#include "isr_timing.h"
+
+#ifndef __cplusplus
+#pragma CODE_SECTION(ISRTiming_getBin, ".TI.ramfunc");
+#pragma CODE_SECTION(ISRTiming_record, ".TI.ramfunc");
+#endif
+
+//
+// Time stamp timer and the cost of one read of it
+//
+uint32_t ISRTiming_timerBase;
+uint32_t ISRTiming_overhead;
+
+//*****************************************************************************
+//
+// ISRTiming_getBin
+//
+// Returns the histogram bin of a value, floor(log2(value)) limited to the
+// last bin
+//
+//*****************************************************************************
+static inline uint16_t
+ISRTiming_getBin(uint32_t value)
+{
+    uint16_t bin = 0U;
+
+    while((value > 1U) && (bin < (ISRTIMING_BINS - 1U)))
+    {
+        value >>= 1U;
+        bin++;
+    }
+
+    return(bin);
+}
+
+//*****************************************************************************
+//
+// ISRTiming_init
+//
+//*****************************************************************************
+void
+ISRTiming_init(uint32_t timerBase)
+{
+    uint32_t first;
+    uint32_t second;
+
+    ISRTiming_timerBase = timerBase;
+
+    //
+    // Two reads back to back differ by the cost of one read, which every
+    // entry-exit pair contains on top of the ISR body
+    //
+    first = CPUTimer_getTimerCount(timerBase);
+    second = CPUTimer_getTimerCount(timerBase);
+    ISRTiming_overhead = first - second;
+}
+
+//*****************************************************************************
+//
+// ISRTiming_initProbe
+//
+//*****************************************************************************
+void
+ISRTiming_initProbe(ISRTiming_Probe *probe, uint32_t base)
+{
+    probe->base = base;
+    probe->entry = 0U;
+    probe->counter = 0U;
+    ISRTiming_reset(probe);
+}
+
+//*****************************************************************************
+//
+// ISRTiming_reset
+//
+//*****************************************************************************
+void
+ISRTiming_reset(ISRTiming_Probe *probe)
+{
+    ISRTiming_Stats *stats[2];
+    uint16_t i;
+    uint16_t bin;
+
+    stats[0] = &probe->duration;
+    stats[1] = &probe->latency;
+
+    for(i = 0U; i < 2U; i++)
+    {
+        stats[i]->count = 0U;
+        stats[i]->min = UINT32_MAX;
+        stats[i]->max = 0U;
+        stats[i]->sum = 0U;
+
+        for(bin = 0U; bin < ISRTIMING_BINS; bin++)
+        {
+            stats[i]->histogram[bin] = 0U;
+        }
+    }
+}
+
+//*****************************************************************************
+//
+// ISRTiming_record
+//
+//*****************************************************************************
+void
+ISRTiming_record(ISRTiming_Stats *stats, uint32_t value)
+{
+    if(value < stats->min)
+    {
+        stats->min = value;
+    }
+    if(value > stats->max)
+    {
+        stats->max = value;
+    }
+
+    stats->count++;
+    stats->sum += value;
+    stats->histogram[ISRTiming_getBin(value)]++;
+}
+
+//*****************************************************************************
+//
+// ISRTiming_getMean
+//
+//*****************************************************************************
+uint32_t
+ISRTiming_getMean(const ISRTiming_Stats *stats)
+{
+    if(stats->count == 0U)
+    {
+        return(0U);
+    }
+
+    return((uint32_t)(stats->sum / stats->count));
+}
@@ -0,0 +1,241 @@
+//#############################################################################
+//
+// FILE:   isr_timing.h
+//
+// TITLE:  Execution time and latency measurement of interrupt routines.
+//
+//#############################################################################
+//
+// An ISR brackets its body with ISRTIMING_ENTER() and ISRTIMING_EXIT(). The
+// pair samples a free-running CPU timer, which counts SYSCLK cycles down,
+// and records two values per run:
+//
+//   duration  SYSCLK cycles from entry to exit, less the cost of one timer
+//             read measured by ISRTiming_init()
+//   latency   TBCNT of the ePWM module at entry, the TBCLK counts since the
+//             counter-zero event that raised the interrupt
+//
+// The latency assumes an ePWM interrupt on TBCTR_ZERO in up or up-down
+// count mode, as configured in this example. It covers the PIE and CPU
+// interrupt response and any time the interrupt waited behind another one.
+//
+// For each value the probe keeps the count, minimum, maximum, sum and a
+// log2 histogram in RAM: bin 0 counts values 0 and 1, bin k counts values
+// in [2^k, 2^(k+1)) and the last bin everything from 2^(ISRTIMING_BINS - 1)
+// upwards. Recording happens after the exit sample and is not part of the
+// duration.
+//
+// The statistics are updated by the ISR. Readers in the background loop
+// copy them with the interrupt disabled to get a consistent set.
+//
+// Setting ISRTIMING_ENABLE to 0 compiles the macros out. In the host
+// simulator the CPU timer counts the cycles charged by Sim_setAccessCost(),
+// so the same instrumentation reports a deterministic cost per ISR there.
+//
+//#############################################################################
+
+#ifndef ISR_TIMING_H
+#define ISR_TIMING_H
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//
+// Included Files
+//
+#include <stdint.h>
+#include "driverlib.h"
+
+#ifndef __cplusplus
+#pragma CODE_SECTION(ISRTiming_enter, ".TI.ramfunc");
+#pragma CODE_SECTION(ISRTiming_exit, ".TI.ramfunc");
+#endif
+
+//*****************************************************************************
+//
+// Instrumentation switch and histogram size
+//
+//*****************************************************************************
+#ifndef ISRTIMING_ENABLE
+#define ISRTIMING_ENABLE        1U
+#endif
+
+#define ISRTIMING_BINS          16U
+
+//*****************************************************************************
+//
+//! Statistics of one measured value.
+//
+//*****************************************************************************
+typedef struct
+{
+    uint32_t count;                         //!< Values recorded
+    uint32_t min;                           //!< Smallest value
+    uint32_t max;                           //!< Largest value
+    uint64_t sum;                           //!< Sum of all values
+    uint32_t histogram[ISRTIMING_BINS];     //!< log2 histogram
+} ISRTiming_Stats;
+
+//*****************************************************************************
+//
+//! Measurement state of one ISR. Initialize with ISRTiming_initProbe().
+//
+//*****************************************************************************
+typedef struct
+{
+    uint32_t base;                  //!< ePWM module raising the interrupt
+    uint32_t entry;                 //!< Timer count sampled at entry
+    uint16_t counter;               //!< TBCTR sampled at entry
+    ISRTiming_Stats duration;       //!< Execution time in SYSCLK cycles
+    ISRTiming_Stats latency;        //!< Entry latency in TBCLK counts
+} ISRTiming_Probe;
+
+//*****************************************************************************
+//
+// Time stamp timer and the cost of one read of it, set by ISRTiming_init()
+//
+//*****************************************************************************
+extern uint32_t ISRTiming_timerBase;
+extern uint32_t ISRTiming_overhead;
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+//*****************************************************************************
+//
+//! Selects the time stamp timer and measures the cost of reading it.
+//!
+//! \param timerBase is the base address of a CPU timer that is running with
+//! a period of 0xFFFFFFFF and no prescaler.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+ISRTiming_init(uint32_t timerBase);
+
+//*****************************************************************************
+//
+//! Prepares a probe for an ISR.
+//!
+//! \param probe is the probe to initialize.
+//! \param base is the base address of the ePWM module whose interrupt the
+//! ISR serves.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+ISRTiming_initProbe(ISRTiming_Probe *probe, uint32_t base);
+
+//*****************************************************************************
+//
+//! Clears the statistics of a probe.
+//!
+//! \param probe is the probe to clear.
+//!
+//! Call with the interrupt of the ISR disabled.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+ISRTiming_reset(ISRTiming_Probe *probe);
+
+//*****************************************************************************
+//
+//! Adds a value to a set of statistics.
+//!
+//! \param stats is the statistics to update.
+//! \param value is the value to record.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+ISRTiming_record(ISRTiming_Stats *stats, uint32_t value);
+
+//*****************************************************************************
+//
+//! Returns the mean of the recorded values.
+//!
+//! \param stats is the statistics to evaluate.
+//!
+//! \return Returns the mean rounded down, or 0 if nothing was recorded.
+//
+//*****************************************************************************
+extern uint32_t
+ISRTiming_getMean(const ISRTiming_Stats *stats);
+
+//*****************************************************************************
+//
+//! Samples the ISR entry. Use ISRTIMING_ENTER() instead.
+//
+//*****************************************************************************
+static inline void
+ISRTiming_enter(ISRTiming_Probe *probe)
+{
+    //
+    // The counter goes first so that its read counts towards the latency
+    // only, not towards the duration
+    //
+    probe->counter = HWREGH(probe->base + EPWM_O_TBCTR);
+    probe->entry = CPUTimer_getTimerCount(ISRTiming_timerBase);
+}
+
+//*****************************************************************************
+//
+//! Samples the ISR exit and records both values. Use ISRTIMING_EXIT()
+//! instead.
+//
+//*****************************************************************************
+static inline void
+ISRTiming_exit(ISRTiming_Probe *probe)
+{
+    //
+    // The timer counts down
+    //
+    uint32_t elapsed = probe->entry -
+                       CPUTimer_getTimerCount(ISRTiming_timerBase);
+
+    elapsed = (elapsed > ISRTiming_overhead) ?
+              (elapsed - ISRTiming_overhead) : 0U;
+
+    ISRTiming_record(&probe->duration, elapsed);
+    ISRTiming_record(&probe->latency, probe->counter);
+}
+
+//*****************************************************************************
+//
+//! Marks the start and the end of a measured ISR. ISRTIMING_ENTER() goes
+//! first in the ISR, ISRTIMING_EXIT() after the PIE acknowledge.
+//
+//*****************************************************************************
+#if ISRTIMING_ENABLE
+#define ISRTIMING_ENTER(probe)  ISRTiming_enter(probe)
+#define ISRTIMING_EXIT(probe)   ISRTiming_exit(probe)
+#else
+#define ISRTIMING_ENTER(probe)  ((void)(probe))
+#define ISRTIMING_EXIT(probe)   ((void)(probe))
+#endif
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ISR_TIMING_H
@@ -0,0 +1,388 @@
+//#############################################################################
+//
+// FILE:   protocol.h
+//
+// TITLE:  Framed binary command and telemetry protocol.
+//
+//#############################################################################
+//
+// Every frame on the wire is
+//
+//   SOF | LEN | OPCODE | PAYLOAD[LEN] | CRC16 (high byte first)
+//
+// with SOF = 0xA5 and the CRC16/CCITT-FALSE (polynomial 0x1021, initial
+// value 0xFFFF) computed over LEN, OPCODE and the payload. Multi-byte
+// payload fields are little-endian. Each byte is carried in the low 8 bits
+// of a 16-bit word, matching both the C28x char size and the SCI data
+// registers, so the same encoder and decoder build on the target and on a
+// host PC.
+//
+// Commands are answered with an ACK frame carrying the command opcode and a
+// PROTOCOL_RESULT_* code. STATUS frames are sent on request and, once
+// enabled with PROTOCOL_OP_SET_STREAM, periodically.
+//
+//   Opcode                      Payload
+//   PROTOCOL_OP_SET_PERIOD      module, TBPRD(2)
+//   PROTOCOL_OP_SET_DUTY        module, CMPA(2), CMPB(2)
+//   PROTOCOL_OP_SET_PHASE       module, TBPHS(2)
+//   PROTOCOL_OP_SET_DEADBAND    module, DBRED(2), DBFED(2)
+//   PROTOCOL_OP_GET_STATUS      module
+//   PROTOCOL_OP_SET_STREAM      module, interval in ms(2), 0 to stop
+//   PROTOCOL_OP_GET_TIMING      module
+//   PROTOCOL_OP_GET_ISR_STATS   module, kind
+//   PROTOCOL_OP_GET_ISR_HISTOGRAM
+//                               module, kind, first bin
+//   PROTOCOL_OP_CLEAR_ISR_STATS module
+//   PROTOCOL_OP_SET_LOOP        module, reference(2), enable
+//   PROTOCOL_OP_GET_LOOP        module
+//   PROTOCOL_OP_GET_FAULT       module
+//   PROTOCOL_OP_CLEAR_FAULT     module
+//   PROTOCOL_OP_SET_DEAD_TIME   module, rising ns(2), falling ns(2), mode
+//   PROTOCOL_OP_SET_PHASE_ANGLE module, phase in 0.01 degree(2)
+//   PROTOCOL_OP_ACK             opcode, result
+//   PROTOCOL_OP_STATUS          module, TBPRD(2), CMPA(2), CMPB(2),
+//                               TBPHS(2), DBRED(2), DBFED(2), errors(2),
+//                               load(2), peak load(2), frequency(4),
+//                               frequency mHz(2), duty A(2), duty B(2)
+//   PROTOCOL_OP_TIMING          module, last(2), max(2), count(2)
+//   PROTOCOL_OP_ISR_STATS       module, kind, count(4), min(4), max(4),
+//                               mean(4)
+//   PROTOCOL_OP_ISR_HISTOGRAM   module, kind, first bin, bins(4) x n
+//   PROTOCOL_OP_LOOP            module, flags, reference(2), current(2),
+//                               voltage(2), CMPA(2), trips(2),
+//                               average voltage(2)
+//   PROTOCOL_OP_FAULT           module, flags, trips(2)
+//
+// The load fields of a STATUS frame are the CPU load of the last
+// measurement window and the highest load since reset, both in Q15 (32768
+// is a fully loaded core; see cpu_load.h). The frequency fields give the
+// output frequency of the module in whole Hz and the mHz above, and the
+// duty fields the high time of ePWMxA and ePWMxB per period in Q15, all
+// computed from the module registers as the frame is sent (see
+// pwm_readback.h). A duty field of 0xFFFF means the duty cannot be worked
+// out from the registers.
+//
+// A TIMING frame answers PROTOCOL_OP_GET_TIMING with the latest and largest
+// update latency of the module and the number of updates measured, low 16
+// bits. A module without measurements is answered with an ACK frame
+// carrying PROTOCOL_RESULT_BAD_MODULE.
+//
+// ISR_STATS and ISR_HISTOGRAM frames report the interrupt service routine
+// of the module as measured by isr_timing.h. The kind selects the
+// execution time in SYSCLK cycles (PROTOCOL_ISR_DURATION) or the entry
+// latency in TBCLK counts (PROTOCOL_ISR_LATENCY). A histogram frame carries
+// the bins from the first one requested up to PROTOCOL_ISR_BINS_PER_FRAME
+// bins or the last bin, whichever comes first. PROTOCOL_OP_CLEAR_ISR_STATS
+// restarts both measurements of the module. A module without an
+// instrumented ISR is answered with PROTOCOL_RESULT_BAD_MODULE.
+//
+// PROTOCOL_OP_SET_LOOP closes the output regulation of the module on the
+// voltage reference, a signed value in ADC counts, when enable is 1, and
+// opens it when enable is 0. The reference must lie within the voltage
+// trip limits. While the loop is closed SET_PERIOD and SET_DUTY on the
+// module are answered with PROTOCOL_RESULT_BAD_VALUE. A LOOP frame answers
+// PROTOCOL_OP_GET_LOOP with PROTOCOL_LOOP_* flags, the reference, the
+// latest current and voltage samples after offset removal, all signed ADC
+// counts, the CMPA value in whole TBCLK counts, the number of samples that
+// tripped a limit and the oversampled output voltage in 1/16 ADC counts
+// (see adc_oversample.h). The TIMING frame of the module reports the
+// sample-to-update latency of the loop. A module without a loop is
+// answered with PROTOCOL_RESULT_BAD_MODULE.
+//
+// A comparator trips all outputs on overcurrent in hardware and holds them
+// low (see pwm_protect.h). A FAULT frame answers PROTOCOL_OP_GET_FAULT with
+// PROTOCOL_FAULT_* flags and the number of trips since reset.
+// PROTOCOL_OP_CLEAR_FAULT opens the loop, moves the loop module to its
+// lowest duty and releases the outputs; while the current is still beyond
+// a threshold it is answered with PROTOCOL_RESULT_FAULT_ACTIVE and the
+// outputs stay low. Both commands accept any module.
+//
+// PROTOCOL_OP_SET_DEAD_TIME makes ePWMxB the complement of ePWMxA with
+// dead time (see pwm_deadband.h): ePWMxA turns on the rising time after
+// ePWMxB turned off and ePWMxB the falling time after ePWMxA turned off.
+// The mode is a PROTOCOL_DEAD_TIME_* value; PROTOCOL_DEAD_TIME_OFF returns
+// the outputs to their own compare edges and ignores the times. New times
+// load on the next counter zero. A module without a complementary pair is
+// answered with PROTOCOL_RESULT_BAD_MODULE. The DBRED and DBFED fields of a
+// STATUS frame count steps of the dead-band counter, which are half TBCLK
+// counts on such a module.
+//
+// PROTOCOL_OP_SET_DEADBAND is the raw form for the other modules: it
+// writes DBRED and DBFED as they are for an active-high complementary pair
+// from ePWMxA, or bypasses the dead band when both are 0. A module with a
+// complementary pair is answered with PROTOCOL_RESULT_BAD_MODULE, as the
+// command would undo its PROTOCOL_OP_SET_DEAD_TIME settings.
+//
+// Modules of a phase group run interleaved at one period (see
+// pwm_phase.h). PROTOCOL_OP_SET_PHASE_ANGLE sets how far a follower runs
+// behind the sync master of its group, below 36000; the phase loads at the
+// next counter zero of the master and holds through later period changes.
+// PROTOCOL_OP_SET_PERIOD on any module of a group changes the period of
+// all of them. A module that follows no master is answered with
+// PROTOCOL_RESULT_BAD_MODULE. PROTOCOL_OP_SET_PHASE writes TBPHS directly
+// and is overwritten by the next period change of a group.
+//
+// The module is the ePWM instance number, 1 for EPWM1 and so on.
+//
+//#############################################################################
+
+#ifndef PROTOCOL_H
+#define PROTOCOL_H
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//
+// Included Files
+//
+#include <stdbool.h>
+#include <stdint.h>
+
+//*****************************************************************************
+//
+// Frame layout
+//
+//*****************************************************************************
+#define PROTOCOL_SOF                0xA5U
+#define PROTOCOL_MAX_PAYLOAD        32U
+#define PROTOCOL_OVERHEAD           5U
+#define PROTOCOL_MAX_FRAME          (PROTOCOL_MAX_PAYLOAD + PROTOCOL_OVERHEAD)
+
+//*****************************************************************************
+//
+// Opcodes
+//
+//*****************************************************************************
+#define PROTOCOL_OP_SET_PERIOD      0x01U
+#define PROTOCOL_OP_SET_DUTY        0x02U
+#define PROTOCOL_OP_SET_PHASE       0x03U
+#define PROTOCOL_OP_SET_DEADBAND    0x04U
+#define PROTOCOL_OP_GET_STATUS      0x05U
+#define PROTOCOL_OP_SET_STREAM      0x06U
+#define PROTOCOL_OP_GET_TIMING      0x07U
+#define PROTOCOL_OP_GET_ISR_STATS   0x08U
+#define PROTOCOL_OP_GET_ISR_HISTOGRAM 0x09U
+#define PROTOCOL_OP_CLEAR_ISR_STATS 0x0AU
+#define PROTOCOL_OP_SET_LOOP        0x0BU
+#define PROTOCOL_OP_GET_LOOP        0x0CU
+#define PROTOCOL_OP_GET_FAULT       0x0DU
+#define PROTOCOL_OP_CLEAR_FAULT     0x0EU
+#define PROTOCOL_OP_SET_DEAD_TIME   0x0FU
+#define PROTOCOL_OP_SET_PHASE_ANGLE 0x10U
+#define PROTOCOL_OP_ACK             0x80U
+#define PROTOCOL_OP_STATUS          0x81U
+#define PROTOCOL_OP_TIMING          0x82U
+#define PROTOCOL_OP_ISR_STATS       0x83U
+#define PROTOCOL_OP_ISR_HISTOGRAM   0x84U
+#define PROTOCOL_OP_LOOP            0x85U
+#define PROTOCOL_OP_FAULT           0x86U
+
+//*****************************************************************************
+//
+// ISR measurement kinds and histogram bins per ISR_HISTOGRAM frame
+//
+//*****************************************************************************
+#define PROTOCOL_ISR_DURATION       0x00U
+#define PROTOCOL_ISR_LATENCY        0x01U
+#define PROTOCOL_ISR_BINS_PER_FRAME 7U
+
+//*****************************************************************************
+//
+// Flags of a LOOP frame
+//
+//*****************************************************************************
+#define PROTOCOL_LOOP_CLOSED        0x01U
+#define PROTOCOL_LOOP_CURRENT_FAULT 0x02U
+#define PROTOCOL_LOOP_VOLTAGE_FAULT 0x04U
+
+//*****************************************************************************
+//
+// Flags of a FAULT frame
+//
+//*****************************************************************************
+#define PROTOCOL_FAULT_LATCHED      0x01U
+#define PROTOCOL_FAULT_ACTIVE       0x02U
+#define PROTOCOL_FAULT_HIGH         0x04U
+#define PROTOCOL_FAULT_LOW          0x08U
+#define PROTOCOL_FAULT_FORCED       0x10U
+
+//*****************************************************************************
+//
+// Modes of PROTOCOL_OP_SET_DEAD_TIME
+//
+//*****************************************************************************
+#define PROTOCOL_DEAD_TIME_OFF      0x00U
+#define PROTOCOL_DEAD_TIME_ON       0x01U
+#define PROTOCOL_DEAD_TIME_HR       0x02U
+
+//*****************************************************************************
+//
+// Result codes carried by PROTOCOL_OP_ACK
+//
+//*****************************************************************************
+#define PROTOCOL_RESULT_OK          0x00U
+#define PROTOCOL_RESULT_BAD_LENGTH  0x01U
+#define PROTOCOL_RESULT_BAD_MODULE  0x02U
+#define PROTOCOL_RESULT_BAD_VALUE   0x03U
+#define PROTOCOL_RESULT_BAD_OPCODE  0x04U
+#define PROTOCOL_RESULT_FAULT_ACTIVE 0x05U
+
+//*****************************************************************************
+//
+//! A decoded frame.
+//
+//*****************************************************************************
+typedef struct
+{
+    uint16_t opcode;
+    uint16_t length;
+    uint16_t payload[PROTOCOL_MAX_PAYLOAD];
+} Protocol_Frame;
+
+//*****************************************************************************
+//
+//! Values returned by Protocol_decodeByte().
+//
+//*****************************************************************************
+typedef enum
+{
+    PROTOCOL_DECODE_IDLE,       //!< Byte is outside of any frame
+    PROTOCOL_DECODE_BUSY,       //!< Byte was consumed, frame incomplete
+    PROTOCOL_DECODE_FRAME,      //!< A valid frame is available
+    PROTOCOL_DECODE_ERROR       //!< Frame discarded (length or CRC)
+} Protocol_DecodeStatus;
+
+//*****************************************************************************
+//
+//! Receive state of one byte stream. Initialize with
+//! Protocol_initDecoder().
+//
+//*****************************************************************************
+typedef struct
+{
+    uint16_t state;
+    uint16_t index;
+    uint16_t crc;
+    uint16_t rxCrc;
+    Protocol_Frame frame;       //!< Last frame, valid after DECODE_FRAME
+    uint16_t errors;            //!< Discarded frames, saturating
+} Protocol_Decoder;
+
+//*****************************************************************************
+//
+//! Stores a 16-bit value into two payload bytes, low byte first.
+//
+//*****************************************************************************
+static inline void
+Protocol_putUint16(uint16_t *payload, uint16_t value)
+{
+    payload[0] = value & 0xFFU;
+    payload[1] = (value >> 8U) & 0xFFU;
+}
+
+//*****************************************************************************
+//
+//! Stores a 32-bit value into four payload bytes, low byte first.
+//
+//*****************************************************************************
+static inline void
+Protocol_putUint32(uint16_t *payload, uint32_t value)
+{
+    Protocol_putUint16(&payload[0], (uint16_t)(value & 0xFFFFU));
+    Protocol_putUint16(&payload[2], (uint16_t)(value >> 16U));
+}
+
+//*****************************************************************************
+//
+//! Reads a 16-bit value from two payload bytes, low byte first.
+//
+//*****************************************************************************
+static inline uint16_t
+Protocol_getUint16(const uint16_t *payload)
+{
+    return((payload[0] & 0xFFU) | ((payload[1] & 0xFFU) << 8U));
+}
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+//*****************************************************************************
+//
+//! Adds one byte to a running CRC16/CCITT-FALSE.
+//!
+//! \param crc is the CRC so far, 0xFFFF for the first byte.
+//! \param data is the byte.
+//!
+//! \return Returns the updated CRC.
+//
+//*****************************************************************************
+extern uint16_t
+Protocol_updateCRC(uint16_t crc, uint16_t data);
+
+//*****************************************************************************
+//
+//! Builds a frame.
+//!
+//! \param opcode is the opcode.
+//! \param payload is the payload, may be NULL if \e length is zero.
+//! \param length is the payload length, at most PROTOCOL_MAX_PAYLOAD.
+//! \param buffer receives the frame, PROTOCOL_MAX_FRAME words or
+//! \e length + PROTOCOL_OVERHEAD words.
+//!
+//! \return Returns the number of words written to \e buffer, or 0 if the
+//! payload is too long.
+//
+//*****************************************************************************
+extern uint16_t
+Protocol_encodeFrame(uint16_t opcode, const uint16_t *payload,
+                     uint16_t length, uint16_t *buffer);
+
+//*****************************************************************************
+//
+//! Resets a decoder.
+//!
+//! \param decoder is the decoder.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+Protocol_initDecoder(Protocol_Decoder *decoder);
+
+//*****************************************************************************
+//
+//! Feeds one received byte to a decoder.
+//!
+//! \param decoder is the decoder.
+//! \param data is the received byte.
+//!
+//! Bytes that arrive while no frame is in progress and are not the start of
+//! a frame are reported as PROTOCOL_DECODE_IDLE so that the caller can use
+//! them for something else, for example a text menu.
+//!
+//! \return Returns the decoder status after the byte.
+//
+//*****************************************************************************
+extern Protocol_DecodeStatus
+Protocol_decodeByte(Protocol_Decoder *decoder, uint16_t data);
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PROTOCOL_H
@@ -60,11 +60,70 @@
 #include "device.h"
 #include <stdio.h>
 #include "sci.h"
+#include "sci_buffer.h"
+#include "protocol.h"
+#include "pwm_duty.h"
+#include "pwm_update.h"
+#include "pwm_hr.h"
+#include "pwm_modulation.h"
+#include "pwm_stream.h"
+#include "pwm_cla.h"
+#include "isr_timing.h"
+#include "cpu_load.h"
+#include "pwm_loop.h"
+#include "adc_oversample.h"
+#include "pwm_protect.h"
+#include "pwm_ramp.h"
+#include "pwm_deadband.h"
+#include "pwm_phase.h"
+#include "pwm_channel.h"
+#include "pwm_timing.h"
+#include "sci_format.h"
+#include "pwm_readback.h"
 
 //
 // Defines
 //
-#define EPWM1_TIMER_TBPRD  2000U
+
+//
+// ePWM time base: every module counts up-down on TBCLK, SYSCLK through
+// both prescalers. The periods follow from the frequencies requested below;
+// the build stops if a frequency is more than EPWM_FREQUENCY_TOLERANCE off
+// after rounding TBPRD, or if compare limits do not fit the period.
+//
+#define EPWM_CLOCK_FREQ             DEVICE_SYSCLK_FREQ
+#define EPWM_CLOCK_DIV              1U
+#define EPWM_HSCLOCK_DIV            1U
+#define EPWM_COUNT_MODE             PWMTIMING_COUNT_UP_DOWN
+#define EPWM_PRESCALE               PWMTIMING_PRESCALE(EPWM_CLOCK_DIV,        \
+                                                       EPWM_HSCLOCK_DIV)
+#define EPWM_TBCLK_FREQ             (EPWM_CLOCK_FREQ / EPWM_PRESCALE)
+#define EPWM_FREQUENCY_TOLERANCE(frequency) ((frequency) / 100UL)
+
+#define EPWM_PERIOD(frequency)                                                \
+    PWMTIMING_PERIOD(EPWM_CLOCK_FREQ, EPWM_PRESCALE, EPWM_COUNT_MODE,         \
+                     frequency)
+#define EPWM_FREQUENCY(period)                                                \
+    PWMTIMING_FREQUENCY(EPWM_CLOCK_FREQ, EPWM_PRESCALE, EPWM_COUNT_MODE,      \
+                        period)
+#define EPWM_IS_FREQUENCY_REACHED(frequency)                                  \
+    PWMTIMING_IS_FREQUENCY_REACHED(EPWM_CLOCK_FREQ, EPWM_PRESCALE,            \
+                                   EPWM_COUNT_MODE, frequency,                \
+                                   EPWM_FREQUENCY_TOLERANCE(frequency))
+
+#if !PWMTIMING_IS_CLOCK_DIVIDER_VALID(EPWM_CLOCK_DIV)
+#error "EPWM_CLOCK_DIV must be a power of two from 1 to 128"
+#endif
+#if !PWMTIMING_IS_HSCLOCK_DIVIDER_VALID(EPWM_HSCLOCK_DIV)
+#error "EPWM_HSCLOCK_DIV must be 1 or even from 2 to 14"
+#endif
+
+//
+// ePWM1 and ePWM2 at 25 kHz; compare values stay within 50 counts of both
+// ends of the period
+//
+#define EPWM1_FREQUENCY    25000UL
+#define EPWM1_TIMER_TBPRD  EPWM_PERIOD(EPWM1_FREQUENCY)
 #define EPWM1_MAX_CMPA     1950U
 #define EPWM1_MIN_CMPA       50U
 //#define EPWM1_MAX_CMPA     1000U
@@ -74,17 +133,22 @@
 //#define EPWM1_MAX_CMPB     1000U
 //#define EPWM1_MIN_CMPB     1000U
 
-#define EPWM2_TIMER_TBPRD  2000U
+#define EPWM2_FREQUENCY    25000UL
+#define EPWM2_TIMER_TBPRD  EPWM_PERIOD(EPWM2_FREQUENCY)
 #define EPWM2_MAX_CMPA     1950U
 #define EPWM2_MIN_CMPA       50U
 #define EPWM2_MAX_CMPB     1950U
 #define EPWM2_MIN_CMPB       50U
 
-#define EPWM5_TIMER_TBPRD  850 // about 56kHz
-#define EPWM5_MAX_CMPA     425 // 50% duty cycle
-#define EPWM5_MIN_CMPA     425
-#define EPWM5_MAX_CMPB     425
-#define EPWM5_MIN_CMPB     425
+//
+// ePWM5 at 58.8 kHz (TBPRD 850, 58824 Hz), starting at 50% duty cycle
+//
+#define EPWM5_FREQUENCY    58800UL
+#define EPWM5_TIMER_TBPRD  EPWM_PERIOD(EPWM5_FREQUENCY)
+#define EPWM5_MAX_CMPA     (EPWM5_TIMER_TBPRD / 2U)
+#define EPWM5_MIN_CMPA     (EPWM5_TIMER_TBPRD / 2U)
+#define EPWM5_MAX_CMPB     (EPWM5_TIMER_TBPRD / 2U)
+#define EPWM5_MIN_CMPB     (EPWM5_TIMER_TBPRD / 2U)
 
 //#define EPWM5_TIMER_TBPRD  2000U
 //#define EPWM5_MAX_CMPA     1950U
@@ -101,42 +165,353 @@
 //#define EPWM5_MAX_CMPB     100U
 //#define EPWM5_MIN_CMPB     100U
 
-#define EPWM_CMP_UP           1U
-#define EPWM_CMP_DOWN         0U
+#if !PWMTIMING_IS_PERIOD_VALID(EPWM1_TIMER_TBPRD)
+#error "EPWM1_FREQUENCY is out of the range of TBPRD"
+#elif !EPWM_IS_FREQUENCY_REACHED(EPWM1_FREQUENCY)
+#error "EPWM1_FREQUENCY cannot be reached with this TBCLK"
+#elif !PWMTIMING_IS_COMPARE_VALID(EPWM1_TIMER_TBPRD, EPWM1_MIN_CMPA,        \
+                                  EPWM1_MAX_CMPA) ||                          \
+      !PWMTIMING_IS_COMPARE_VALID(EPWM1_TIMER_TBPRD, EPWM1_MIN_CMPB,        \
+                                  EPWM1_MAX_CMPB)
+#error "ePWM1 compare limits do not fit its period"
+#endif
+
+#if !PWMTIMING_IS_PERIOD_VALID(EPWM2_TIMER_TBPRD)
+#error "EPWM2_FREQUENCY is out of the range of TBPRD"
+#elif !EPWM_IS_FREQUENCY_REACHED(EPWM2_FREQUENCY)
+#error "EPWM2_FREQUENCY cannot be reached with this TBCLK"
+#elif !PWMTIMING_IS_COMPARE_VALID(EPWM2_TIMER_TBPRD, EPWM2_MIN_CMPA,        \
+                                  EPWM2_MAX_CMPA) ||                          \
+      !PWMTIMING_IS_COMPARE_VALID(EPWM2_TIMER_TBPRD, EPWM2_MIN_CMPB,        \
+                                  EPWM2_MAX_CMPB)
+#error "ePWM2 compare limits do not fit its period"
+#endif
+
+#if !PWMTIMING_IS_PERIOD_VALID(EPWM5_TIMER_TBPRD)
+#error "EPWM5_FREQUENCY is out of the range of TBPRD"
+#elif !EPWM_IS_FREQUENCY_REACHED(EPWM5_FREQUENCY)
+#error "EPWM5_FREQUENCY cannot be reached with this TBCLK"
+#elif !PWMTIMING_IS_COMPARE_VALID(EPWM5_TIMER_TBPRD, EPWM5_MIN_CMPA,        \
+                                  EPWM5_MAX_CMPA) ||                          \
+      !PWMTIMING_IS_COMPARE_VALID(EPWM5_TIMER_TBPRD, EPWM5_MIN_CMPB,        \
+                                  EPWM5_MAX_CMPB)
+#error "ePWM5 compare limits do not fit its period"
+#endif
+
+//
+// Frequency and duty resolution ePWM5 achieves: one compare count moves
+// the duty by EPWM5_DUTY_STEP_PPM millionths without the MEP
+//
+#define EPWM5_ACHIEVED_FREQUENCY    EPWM_FREQUENCY(EPWM5_TIMER_TBPRD)
+#define EPWM5_DUTY_STEP_PPM                                                   \
+    PWMTIMING_DUTY_STEP_PPM(EPWM_COUNT_MODE, EPWM5_TIMER_TBPRD)
+
+//
+// Compare modulation: table length and ePWM interrupts per table entry. At
+// the ePWM1/2 interrupt rate of 25 kHz this plays the tables at about 98 Hz.
+//
+#define MODULATION_TABLE_LENGTH     256U
+#define MODULATION_DIVIDER          1U
+
+//
+// Where the ePWM1 and ePWM2 compare modulation runs:
+// - MODULATION_ENGINE_ISR: PWMMod_step() in the C28x ePWM interrupts.
+// - MODULATION_ENGINE_DMA: DMA channels triggered by the SOCB events copy
+//   precomputed pairs, one table entry per period (MODULATION_DIVIDER does
+//   not apply).
+// - MODULATION_ENGINE_CLA: CLA tasks triggered by the ePWM interrupts; the
+//   counter-zero to compare write latency is reported over the protocol.
+//
+#define MODULATION_ENGINE_ISR       0U
+#define MODULATION_ENGINE_DMA       1U
+#define MODULATION_ENGINE_CLA       2U
+#define MODULATION_ENGINE           MODULATION_ENGINE_DMA
+
+#define EPWM1_STREAM_DMA_BASE       DMA_CH1_BASE
+#define EPWM2_STREAM_DMA_BASE       DMA_CH2_BASE
+#define EPWM1_CLA_CHANNEL           0U
+#define EPWM2_CLA_CHANNEL           1U
+
+//
+// Free-running CPU timer used as a SYSCLK time stamp, and the status stream
+// limits. The timer wraps after 2^32 cycles, which bounds the interval.
+//
+#define TIMESTAMP_TIMER_BASE        CPUTIMER1_BASE
+#define SYSCLK_CYCLES_PER_MS        (DEVICE_SYSCLK_FREQ / 1000U)
+#define STREAM_MAX_INTERVAL_MS      40000U
+
+//
+// Window of the CPU load meter
+//
+#define CPU_LOAD_WINDOW_MS          100U
+
+//
+// Distance between the register frames of two ePWM modules
+//
+#define EPWM_BASE_STEP              (EPWM2_BASE - EPWM1_BASE)
+#define EPWM_NUM_MODULES            8U
+
+//
+// Menu duty cycle step and limits, Q15
+//
+#define DUTY_STEP                   PWMDUTY_Q15(0.005)
+#define DUTY_MIN                    0U
+#define DUTY_MAX                    PWMDUTY_Q15(0.90)
+
+//
+// Setpoint slew rates in HR counts per PWM period. At 58.8 kHz ePWM5 moves
+// its period by 59 counts and its compare values by 15 counts per ms, so
+// a menu step settles within a few ms and the soft start in under 30 ms.
+// ePWM1 and ePWM2 only ramp their period, at 25 counts per ms.
+//
+#define RAMP_PERIOD_STEP            PWMHR_COUNT(1U)
+#define RAMP_COMPARE_STEP           (PWMHR_COUNT(1U) / 4U)
+
+//
+// Closed-loop regulation of the ePWM5 output. The SOCA event samples the
+// output current on ADCA and the output voltage on ADCB; signals and limits
+// are in ADC counts and must match the sensors of the power stage. The PI
+// gains are in HR counts per ADC count and the compare range is a Q15
+// fraction of the period. A higher compare value lowers the ePWM5A duty, so
+// the gains are negative and the safe setting is the top of the range.
+//
+#define LOOP_EPWM_BASE              EPWM5_BASE
+#define LOOP_KP                     PWMCOMP_Q16(-16.0)
+#define LOOP_KI                     PWMCOMP_Q16(-2.0)
+#define LOOP_MIN_COMPARE            PWMDUTY_Q15(0.05)
+#define LOOP_MAX_COMPARE            PWMDUTY_Q15(0.95)
+
+//
+// The output voltage is also oversampled for telemetry: SOCs 1 to 8 of ADCB
+// follow the loop sample on every SOCA of ePWM5, and a DMA channel moves
+// each batch into a ping-pong buffer in GS RAM
+//
+#define OVERSAMPLE_SAMPLES          8U
+#define OVERSAMPLE_DMA_BASE         DMA_CH3_BASE
+
+//
+// Hardware overcurrent protection: CMPSS1 watches the current sense input
+// A2 next to the ADC, with thresholds at the PPB limits of the loop, and
+// trips ePWM1, ePWM2 and ePWM5 within its filter delay of 4 SYSCLK cycles
+//
+#define PROTECT_CMPSS_BASE          CMPSS1_BASE
+#define PROTECT_CMPSS_INPUT         0U
+#define PROTECT_HIGH_THRESHOLD      3548U
+#define PROTECT_LOW_THRESHOLD       548U
+#define PROTECT_FILTER_PRESCALE     0U
+#define PROTECT_FILTER_WINDOW       4U
+#define PROTECT_NUM_EPWM            3U
+
+//
+// ePWM5B is the complement of ePWM5A: ePWM5A turns on DEADBAND_RISING_NS
+// after ePWM5B turned off, ePWM5B DEADBAND_FALLING_NS after ePWM5A turned
+// off. The dead-band counter runs on TBCLK.
+//
+#define DEADBAND_EPWM_BASE          EPWM5_BASE
+#define DEADBAND_CLOCK_FREQ         EPWM_TBCLK_FREQ
+#define DEADBAND_RISING_NS          100U
+#define DEADBAND_FALLING_NS         100U
+
+//
+// ePWM2 runs interleaved with ePWM1: ePWM1 is the sync master and ePWM2
+// follows PHASE_EPWM2 behind it, in hundredths of a degree. ePWM5 has a
+// period of its own and stays free-running.
+//
+#define PHASE_MASTER_BASE           EPWM1_BASE
+#define PHASE_NUM_FOLLOWERS         1U
+#define PHASE_EPWM2                 18000U
+
+//
+// The ePWM channels of this example, by index into channelConfig
+//
+#define CHANNEL_EPWM1               0U
+#define CHANNEL_EPWM2               1U
+#define CHANNEL_EPWM5               2U
+#define NUM_CHANNELS                3U
+
+//
+// Set-up of each ePWM used in this example. All of them share the time
+// base above, load CMPA and CMPB on counter zero and interrupt on every
+// counter zero. ePWM1 and ePWM2 interrupt for the C28x or CLA modulation engines
+// and otherwise only while their period ramps; the CLA steps no ramps.
+// The CMPB actions of ePWM5 only apply while its dead band is bypassed.
+//
+const PWMChannel_Config channelConfig[NUM_CHANNELS] =
+{
+    {
+        EPWM1_BASE, (EPWM_TimeBaseCountMode)EPWM_COUNT_MODE,
+        (EPWM_ClockDivider)PWMTIMING_CLOCK_DIVIDER(EPWM_CLOCK_DIV),
+        (EPWM_HSClockDivider)PWMTIMING_HSCLOCK_DIVIDER(EPWM_HSCLOCK_DIV),
+        EPWM1_TIMER_TBPRD,
+        EPWM1_MIN_CMPA, EPWM1_MAX_CMPB, EPWM1_MIN_CMPA, EPWM1_MAX_CMPA,
+        EPWM_COMP_LOAD_ON_CNTR_ZERO,
+        EPWM_AQ_OUTPUT_HIGH_UP_CMPA | EPWM_AQ_OUTPUT_LOW_DOWN_CMPA,
+        EPWM_AQ_OUTPUT_HIGH_UP_CMPB | EPWM_AQ_OUTPUT_LOW_DOWN_CMPB,
+        EPWM_INT_TBCTR_ZERO, 1U,
+        MODULATION_ENGINE != MODULATION_ENGINE_DMA,
+        (MODULATION_ENGINE != MODULATION_ENGINE_CLA) ? PWMRAMP_PERIOD : 0U
+    },
+    {
+        EPWM2_BASE, (EPWM_TimeBaseCountMode)EPWM_COUNT_MODE,
+        (EPWM_ClockDivider)PWMTIMING_CLOCK_DIVIDER(EPWM_CLOCK_DIV),
+        (EPWM_HSClockDivider)PWMTIMING_HSCLOCK_DIVIDER(EPWM_HSCLOCK_DIV),
+        EPWM2_TIMER_TBPRD,
+        EPWM2_MIN_CMPA, EPWM2_MIN_CMPB, EPWM2_MIN_CMPA, EPWM2_MAX_CMPA,
+        EPWM_COMP_LOAD_ON_CNTR_ZERO,
+        EPWM_AQ_OUTPUT_HIGH_UP_CMPA | EPWM_AQ_OUTPUT_LOW_DOWN_CMPB,
+        EPWM_AQ_OUTPUT_LOW_ZERO | EPWM_AQ_OUTPUT_HIGH_PERIOD,
+        EPWM_INT_TBCTR_ZERO, 1U,
+        MODULATION_ENGINE != MODULATION_ENGINE_DMA,
+        (MODULATION_ENGINE != MODULATION_ENGINE_CLA) ? PWMRAMP_PERIOD : 0U
+    },
+    {
+        EPWM5_BASE, (EPWM_TimeBaseCountMode)EPWM_COUNT_MODE,
+        (EPWM_ClockDivider)PWMTIMING_CLOCK_DIVIDER(EPWM_CLOCK_DIV),
+        (EPWM_HSClockDivider)PWMTIMING_HSCLOCK_DIVIDER(EPWM_HSCLOCK_DIV),
+        EPWM5_TIMER_TBPRD,
+        EPWM5_MIN_CMPA, EPWM5_MAX_CMPB, EPWM5_MIN_CMPA, EPWM5_MAX_CMPA,
+        EPWM_COMP_LOAD_ON_CNTR_ZERO,
+        EPWM_AQ_OUTPUT_HIGH_UP_CMPA | EPWM_AQ_OUTPUT_LOW_DOWN_CMPA,
+        EPWM_AQ_OUTPUT_LOW_UP_CMPB | EPWM_AQ_OUTPUT_HIGH_DOWN_CMPB,
+        EPWM_INT_TBCTR_ZERO, 1U, true, PWMRAMP_PERIOD | PWMRAMP_COMPARE
+    }
+};
+
+//
+// Compare modulation, setpoint ramp and ISR timing of each channel, and
+// the waveform tables ePWM1 and ePWM2 play
+//
+PWMChannel_State epwmChannels[NUM_CHANNELS];
+uint16_t sineTable[MODULATION_TABLE_LENGTH];
+uint16_t triangleTable[MODULATION_TABLE_LENGTH];
+
+#if MODULATION_ENGINE == MODULATION_ENGINE_DMA
+//
+// Interleaved CMPA/CMPB pairs streamed by the DMA, which only reaches GSx RAM
+//
+#ifndef HOST_SIM
+#pragma DATA_SECTION(epwm1StreamBuffer, "ramgs0");
+#pragma DATA_SECTION(epwm2StreamBuffer, "ramgs0");
+uint16_t epwm1StreamBuffer[2U * MODULATION_TABLE_LENGTH];
+uint16_t epwm2StreamBuffer[2U * MODULATION_TABLE_LENGTH];
+#else
+#define epwm1StreamBuffer   Sim_getRAMAddress(SIM_RAMGS0_BASE)
+#define epwm2StreamBuffer   Sim_getRAMAddress(SIM_RAMGS0_BASE +              \
+                                              (2U * MODULATION_TABLE_LENGTH))
+#endif
+#endif
+
+//
+// Binary protocol receive state and status streaming
+//
+Protocol_Decoder commandDecoder;
+uint32_t streamBase;
+uint32_t streamInterval;
+uint32_t streamStamp;
+
+//
+// Share of the core taken by interrupts and background work
+//
+CPULoad_Meter cpuLoad;
+
+//
+// Frequency and duty of every ePWM module as its registers set them
+//
+PWMReadback_Channel outputReadback[EPWM_NUM_MODULES];
+
+//
+// Output measurements and the regulator of the closed loop
+//
+const PWMLoop_Sense loopCurrentSense =
+{
+    ADCA_BASE, ADCARESULT_BASE, ADC_CH_ADCIN2, 2048U, 1500, -1500
+};
+const PWMLoop_Sense loopVoltageSense =
+{
+    ADCB_BASE, ADCBRESULT_BASE, ADC_CH_ADCIN2, 0U, 3800, -100
+};
+PWMLoop_Channel outputLoop;
+
+//
+// Oversampled output voltage
+//
+const ADCOversample_Source voltageOversampleSource =
+{
+    ADCB_BASE, ADCBRESULT_BASE, ADC_CH_ADCIN2, ADC_TRIGGER_EPWM5_SOCA,
+    ADC_SOC_NUMBER1, ADC_INT_NUMBER2, OVERSAMPLE_SAMPLES, PWMLOOP_SAMPLE_WINDOW
+};
+#ifndef HOST_SIM
+#pragma DATA_SECTION(voltageOversampleBuffer, "ramgs0");
+uint16_t voltageOversampleBuffer[2U * OVERSAMPLE_SAMPLES];
+#else
+#define voltageOversampleBuffer                                               \
+    Sim_getRAMAddress(SIM_RAMGS0_BASE + (4U * MODULATION_TABLE_LENGTH))
+#if ((4U * MODULATION_TABLE_LENGTH) + (2U * OVERSAMPLE_SAMPLES)) >           \
+    SIM_RAMGS0_WORDS
+#error "The DMA buffers do not fit the simulated RAMGS0"
+#endif
+#endif
+ADCOversample_Channel voltageOversample;
 
 //
-// Globals
+// Overcurrent trip of the outputs
 //
-typedef struct
+const PWMProtect_Comparator protectComparator =
 {
-    uint32_t epwmModule;
-    uint16_t epwmCompADirection;
-    uint16_t epwmCompBDirection;
-    uint16_t epwmTimerIntCount;
-    uint16_t epwmMaxCompA;
-    uint16_t epwmMinCompA;
-    uint16_t epwmMaxCompB;
-    uint16_t epwmMinCompB;
-}epwmInformation;
+    PROTECT_CMPSS_BASE, XBAR_EPWM_MUX00_CMPSS1_CTRIPH_OR_L,
+    PROTECT_HIGH_THRESHOLD, PROTECT_LOW_THRESHOLD, PROTECT_FILTER_PRESCALE,
+    PROTECT_FILTER_WINDOW
+};
+const uint32_t protectEPWMBase[PROTECT_NUM_EPWM] =
+{
+    EPWM1_BASE, EPWM2_BASE, EPWM5_BASE
+};
+PWMProtect_State outputProtect;
 
 //
-// Globals to hold the ePWM information used in this example
+// ePWM1 and ePWM2 locked in phase
 //
-epwmInformation epwm1Info;
-epwmInformation epwm2Info;
-epwmInformation epwm5Info;
+const uint32_t phaseFollowerBase[PHASE_NUM_FOLLOWERS] =
+{
+    EPWM2_BASE
+};
+PWMPhase_Group phaseGroup;
 
 //
 // Function Prototypes
 //
-void initEPWM1(void);
-void initEPWM2(void);
+void initModulation(void);
 void initEPWM5(void);
-void itoa(long unsigned int value, char* result, int base);
-__interrupt void epwm1ISR(void);
-__interrupt void epwm2ISR(void);
-__interrupt void epwm5ISR(void);
-void updateCompare(epwmInformation *epwmInfo);
+__interrupt void epwmISR(void);
+__interrupt void adcA1ISR(void);
+__interrupt void dmaCh3ISR(void);
+__interrupt void epwm1TZISR(void);
+
+//
+// The interrupt path runs from RAM in the flash builds; check_ramfuncs.py
+// verifies the placement after linking
+//
+#pragma CODE_SECTION(epwmISR, ".TI.ramfunc");
+#pragma CODE_SECTION(adcA1ISR, ".TI.ramfunc");
+#pragma CODE_SECTION(dmaCh3ISR, ".TI.ramfunc");
+#pragma CODE_SECTION(epwm1TZISR, ".TI.ramfunc");
+void initADC(uint32_t base);
+void initTimestampTimer(void);
+bool restartOutputs(void);
+PWMRamp_Channel *getRamp(uint32_t base);
+void setPeriod(uint32_t base, uint16_t period);
+uint32_t getEPWMBase(uint16_t module);
+void processFrame(const Protocol_Frame *frame);
+void sendAck(uint16_t opcode, uint16_t result);
+void sendStatus(uint32_t base);
+bool sendTiming(uint32_t base);
+ISRTiming_Probe *getISRProbe(uint32_t base);
+void sendISRStats(uint32_t base, const ISRTiming_Probe *probe, uint16_t kind);
+void sendISRHistogram(uint32_t base, const ISRTiming_Probe *probe,
+                      uint16_t kind, uint16_t first);
+void sendLoop(uint32_t base);
+void sendFault(uint32_t base);
+void serviceStatusStream(void);
 
 //
 // Main
@@ -145,15 +520,16 @@ void main(void)
 {
 
     uint16_t receivedChar;
-    unsigned char *msg;
-    char *test;
-
-    int dutyCycle = 425;
-    double dutyCycleTrack = 0.5;
-    int dutyCyclePrint = 0;
-    unsigned int period = 850;
-    int frequencyPrint = 0;
+    const char *msg;
+    uint16_t i;
+    PWMRamp_Channel *epwm5Ramp = &epwmChannels[CHANNEL_EPWM5].ramp;
+    PWMReadback_Channel *readback;
+
+    uint32_t dutyCycle = PWMHR_COUNT(EPWM5_MIN_CMPA);
+    uint16_t dutyCycleTrack = PWMDUTY_Q15(0.5);
+    unsigned int period = EPWM5_TIMER_TBPRD;
     int guiState = 0;
+    bool redraw = true;
 
     //
     // Initialize device clock and peripherals
@@ -177,11 +553,17 @@ void main(void)
     Interrupt_initVectorTable();
 
     //
-    // Assign the interrupt service routines to ePWM interrupts
+    // Assign the interrupt service routines to ePWM interrupts; every
+    // channel shares one
     //
-    Interrupt_register(INT_EPWM1, &epwm1ISR);
-    Interrupt_register(INT_EPWM2, &epwm2ISR);
-    Interrupt_register(INT_EPWM5, &epwm5ISR);
+    for(i = 0U; i < NUM_CHANNELS; i++)
+    {
+        Interrupt_register(PWMChannel_getInterruptNumber(channelConfig[i].base),
+                           &epwmISR);
+    }
+    Interrupt_register(INT_ADCA1, &adcA1ISR);
+    Interrupt_register(INT_DMA_CH3, &dmaCh3ISR);
+    Interrupt_register(INT_EPWM1_TZ, &epwm1TZISR);
 
     //
     // Configure GPIO0/1 , GPIO2/3 and GPIO4/5 as ePWM1A/1B, ePWM2A/2B and
@@ -248,6 +630,15 @@ void main(void)
     SCI_enableModule(SCIA_BASE);
     SCI_performSoftwareReset(SCIA_BASE);
 
+    //
+    // Menu output is queued in RAM and drained by the SCIA TX FIFO
+    // interrupt instead of waiting for the FIFO at 9600 baud.
+    //
+    SCIBuffer_init(SCIA_BASE);
+    Protocol_initDecoder(&commandDecoder);
+    initTimestampTimer();
+    ISRTiming_init(TIMESTAMP_TIMER_BASE);
+
     #ifdef AUTOBAUD
         //
         // Perform an autobaud lock.
@@ -264,21 +655,93 @@ void main(void)
     //
     SysCtl_disablePeripheral(SYSCTL_PERIPH_CLK_TBCLKSYNC);
 
-    initEPWM1();
-    initEPWM2();
+    //
+    // Put the DMA in a known state before the streaming and oversampling
+    // channels are set up
+    //
+    DMA_initController();
+    DMA_setEmulationMode(DMA_EMULATION_FREE_RUN);
+
+#if MODULATION_ENGINE == MODULATION_ENGINE_CLA
+    PWMCLA_init();
+#endif
+
+    //
+    // Measure the MEP scale factor for the ePWM5 high-resolution edges. The
+    // main loop keeps it up to date afterwards.
+    //
+    while(PWMHR_calibrate() == PWMHR_CAL_INCOMPLETE)
+    {
+    }
+
+    //
+    // Set every ePWM up from its table entry, then add what goes beyond it
+    //
+    PWMChannel_init(epwmChannels, channelConfig, NUM_CHANNELS);
+    initModulation();
     initEPWM5();
 
+    //
+    // Interleave ePWM2 with ePWM1 from the first period of ePWM1 on
+    //
+    PWMPhase_init(&phaseGroup, PHASE_MASTER_BASE, phaseFollowerBase,
+                  PHASE_NUM_FOLLOWERS);
+    PWMPhase_setPhase(&phaseGroup, 0U, PHASE_EPWM2);
+
+    //
+    // Soft start: ePWM5 comes up at the lowest ePWM5A duty, the safe
+    // setting of the loop, and ramps to the working point. Period changes
+    // on ePWM1 and ePWM2 and every setpoint change on ePWM5 slew.
+    //
+    dutyCycle = PWMHR_dutyToCount(PWMHR_COUNT(period), LOOP_MAX_COMPARE);
+    PWMHR_setCompare(EPWM5_BASE, dutyCycle, dutyCycle);
+    PWMChannel_initRamps(epwmChannels, NUM_CHANNELS, RAMP_PERIOD_STEP,
+                         RAMP_COMPARE_STEP);
+    dutyCycle = PWMHR_dutyToCount(PWMHR_COUNT(period), dutyCycleTrack);
+    PWMRamp_startCompare(epwm5Ramp, dutyCycle, dutyCycle);
+
+    //
+    // ePWM5 samples its output through ADCA and ADCB; the loop starts open
+    //
+    initADC(ADCA_BASE);
+    initADC(ADCB_BASE);
+    PWMLoop_initChannel(&outputLoop, LOOP_EPWM_BASE, &loopCurrentSense,
+                        &loopVoltageSense, LOOP_KP, LOOP_KI);
+    ADCOversample_init(&voltageOversample, &voltageOversampleSource,
+                       OVERSAMPLE_DMA_BASE, voltageOversampleBuffer);
+
+    //
+    // Arm the overcurrent trip before the outputs start switching
+    //
+    ASysCtl_selectCMPHPMux(ASYSCTL_CMPHPMUX_SELECT_1, PROTECT_CMPSS_INPUT);
+    ASysCtl_selectCMPLPMux(ASYSCTL_CMPLPMUX_SELECT_1, PROTECT_CMPSS_INPUT);
+    PWMProtect_init(&outputProtect, &protectComparator, protectEPWMBase,
+                    PROTECT_NUM_EPWM);
+
     //
     // Enable sync and clock to PWM
     //
     SysCtl_enablePeripheral(SYSCTL_PERIPH_CLK_TBCLKSYNC);
 
+    for(i = 0U; i < EPWM_NUM_MODULES; i++)
+    {
+        PWMReadback_init(&outputReadback[i],
+                         EPWM1_BASE + ((uint32_t)i * EPWM_BASE_STEP),
+                         EPWM_CLOCK_FREQ);
+    }
+
     //
-    // Enable ePWM interrupts
+    // Enable ePWM interrupts. Unless they are modulated by the C28x, ePWM1
+    // and ePWM2 only interrupt while their period ramps.
     //
+#if MODULATION_ENGINE != MODULATION_ENGINE_CLA
     Interrupt_enable(INT_EPWM1);
     Interrupt_enable(INT_EPWM2);
+#endif
     Interrupt_enable(INT_EPWM5);
+    Interrupt_enable(INT_ADCA1);
+    Interrupt_enable(INT_DMA_CH3);
+    Interrupt_enable(INT_EPWM1_TZ);
 
     //
     // Enable Global Interrupt (INTM) and realtime interrupt (DBGM)
@@ -286,39 +749,163 @@ void main(void)
     EINT;
     ERTM;
 
+    CPULoad_init(&cpuLoad, TIMESTAMP_TIMER_BASE,
+                 CPU_LOAD_WINDOW_MS * SYSCLK_CYCLES_PER_MS);
+
     //
-    // IDLE loop. Just sit and loop forever (optional):
+    // Main loop. Received bytes are first offered to the binary protocol
+    // decoder; bytes outside of a frame are menu key presses. The menu is
+    // redrawn after every key press; in between, the loop polls the SCI
+    // receive buffer without blocking and is free for background work.
     //
     for(;;)
     {
-        // print a bunch of new lines to clear out window
-        msg = "\r\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n\0";
-        SCI_writeCharArray(SCIA_BASE, (uint16_t*)msg, 25);
-        //itoa(50, test, 10);
-        //SCI_writeCharArray(SCIA_BASE, (uint16_t*)msg, 5);
+#ifdef HOST_SIM
+        //
+        // Simulated time only passes while the host build idles
+        //
+        Sim_idle();
+#endif
 
-        // print duty cycle and frequency
-        //dutyCyclePrint = 100 - (100 * dutyCycleTrack);
-        //TODO: convert int to string for printing. Unable to use sprintf or itoa.
-        //TODO: fix freq calculation getting overflow or something (get -9000 instead of 56000)
-        frequencyPrint = period * 66;  // 66 is the constant I calculated to find frequency from period. Since 850counts = ~56000Hz.
+        //
+        // The menu shows the registers, so it waits for a setpoint ramp to
+        // arrive
+        //
+        if(redraw && !PWMRamp_isActive(epwm5Ramp))
+        {
+            redraw = false;
+
+            // print a bunch of new lines to clear out window
+            msg = "\r\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n\0";
+            SCIBuffer_writeString(msg);
+
+            //
+            // Print the frequency and the ePWM5A duty cycle ePWM5 runs at
+            //
+            readback = &outputReadback[PWMChannel_getIndex(EPWM5_BASE)];
+            PWMReadback_update(readback);
+            msg = "\r\n Frequency: \0";
+            SCIBuffer_writeString(msg);
+            SCIFormat_writeUnsigned(readback->frequency, 0U, 0U);
+            msg = ".\0";
+            SCIBuffer_writeString(msg);
+            SCIFormat_writeUnsigned(readback->frequencyMilliHz, 3U,
+                                    SCIFORMAT_ZERO);
+            msg = " Hz\n\0";
+            SCIBuffer_writeString(msg);
+            msg = "\r\n Duty cycle: \0";
+            SCIBuffer_writeString(msg);
+            if(readback->dutyA == PWMREADBACK_DUTY_UNKNOWN)
+            {
+                msg = "n/a\n\0";
+            }
+            else
+            {
+                SCIFormat_writeQ((int32_t)readback->dutyA * 100L, PWMDUTY_Q,
+                                 1U, 0U, 0U);
+                msg = " %\n\0";
+            }
+            SCIBuffer_writeString(msg);
+
+            switch(guiState){
+            case 0:
+                msg = "\r\n\nChoose an option: \n\0";
+                SCIBuffer_writeString(msg);
+                msg = "\r\n 1. Change duty cycle \n\0";
+                SCIBuffer_writeString(msg);
+                msg = "\r\n 2. Change frequency \n\0";
+                SCIBuffer_writeString(msg);
+                msg = "\r\n 3. Power off \0";
+                SCIBuffer_writeString(msg);
+                if(PWMProtect_isLatched(&outputProtect))
+                {
+                    msg = "\r\n\n Outputs tripped \n\0";
+                    SCIBuffer_writeString(msg);
+                    msg = "\r\n 4. Restart outputs \0";
+                    SCIBuffer_writeString(msg);
+                }
+                break;
+
+            case 1:
+                msg = "\r\n 1. Increase duty cycle \n\0";
+                SCIBuffer_writeString(msg);
+                msg = "\r\n 2. Decrease duty cycle \n\0";
+                SCIBuffer_writeString(msg);
+                msg = "\r\n 3. Go back \n\0";
+                SCIBuffer_writeString(msg);
+                break;
+
+            case 2:
+                msg = "\r\n 1. Decrease frequency \n\0";
+                SCIBuffer_writeString(msg);
+                msg = "\r\n 2. Increase frequency \n\0";
+                SCIBuffer_writeString(msg);
+                msg = "\r\n 3. Go back \n\0";
+                SCIBuffer_writeString(msg);
+                break;
+
+            default:
+                guiState = 0;
+                break;
+            }
 
-        switch(guiState){
-        case 0:
-            msg = "\r\n\nChoose an option: \n\0";
-            SCI_writeCharArray(SCIA_BASE, (uint16_t*)msg, 23);
-            msg = "\r\n 1. Change duty cycle \n\0";
-            SCI_writeCharArray(SCIA_BASE, (uint16_t*)msg, 25);
-            msg = "\r\n 2. Change frequency \n\0";
-            SCI_writeCharArray(SCIA_BASE, (uint16_t*)msg, 24);
-            msg = "\r\n 3. Power off \0";
-            SCI_writeCharArray(SCIA_BASE, (uint16_t*)msg, 15);
             msg = "\r\n\nEnter number: \0";
-            SCI_writeCharArray(SCIA_BASE, (uint16_t*)msg, 17);
+            SCIBuffer_writeString(msg);
+        }
+
+        //
+        // Take the next received byte, if there is one
+        //
+        if(!SCIBuffer_readChar(&receivedChar))
+        {
+            CPULoad_idle(&cpuLoad);
+            serviceStatusStream();
+            PWMHR_calibrate();
+            continue;
+        }
+
+        switch(Protocol_decodeByte(&commandDecoder, receivedChar))
+        {
+            case PROTOCOL_DECODE_IDLE:
+                //
+                // Not part of a frame: a menu key press
+                //
+                break;
+
+            case PROTOCOL_DECODE_FRAME:
+                processFrame(&commandDecoder.frame);
+
+                //
+                // The menu steps on from the ePWM5 setpoints a command left
+                //
+                period = (uint16_t)(epwm5Ramp->targetPeriod >> PWMHR_COUNT_S);
+                dutyCycle = epwm5Ramp->targetA;
+                dutyCycleTrack = PWMDuty_fromCount(period,
+                                                   (uint16_t)(dutyCycle >>
+                                                              PWMHR_COUNT_S));
+                continue;
+
+            default:
+                continue;
+        }
 
-            // Read a character from the FIFO.
-            receivedChar = SCI_readCharBlockingFIFO(SCIA_BASE);
+        redraw = true;
+
+        //
+        // While the loop is closed it owns the ePWM5 compare values, and
+        // its compare range depends on the period
+        //
+        if(((guiState == 1) || (guiState == 2)) &&
+           ((receivedChar == 49U) || (receivedChar == 50U)) &&
+           PWMLoop_isEnabled(&outputLoop))
+        {
+            msg = "\r\nClosed loop active\n\0";
+            SCIBuffer_writeString(msg);
+            continue;
+        }
 
+        switch(guiState){
+        case 0:
             switch(receivedChar) {
                case 49  :
                    guiState = 1;
@@ -326,51 +913,64 @@ void main(void)
                case 50  :
                    guiState = 2;
                    break;
+               case 52  :
+                   if(!PWMProtect_isLatched(&outputProtect))
+                   {
+                       msg = "\r\nPlease choose one of the options\n\0";
+                   }
+                   else if(!restartOutputs())
+                   {
+                       msg = "\r\nOvercurrent still present\n\0";
+                   }
+                   else
+                   {
+                       break;
+                   }
+                   SCIBuffer_writeString(msg);
+                   break;
                case 51  :
-                   // Enter halt mode.
+                   // Drive the outputs low, let the prompt go out, then
+                   // enter halt mode.
+                   PWMProtect_force(&outputProtect);
+                   while(!SCIBuffer_isTxIdle())
+                   {
+                   }
                    SysCtl_enterHaltMode();
+                   break;
                default :
                    msg = "\r\nPlease choose one of the options\n\0";
-                   SCI_writeCharArray(SCIA_BASE, (uint16_t*)msg, 36);
+                   SCIBuffer_writeString(msg);
                    break;
             }
             break;
 
         case 1:
-            msg = "\r\n 1. Increase duty cycle \n\0";
-            SCI_writeCharArray(SCIA_BASE, (uint16_t*)msg, 27);
-            msg = "\r\n 2. Decrease duty cycle \n\0";
-            SCI_writeCharArray(SCIA_BASE, (uint16_t*)msg, 27);
-            msg = "\r\n 3. Go back \n\0";
-            SCI_writeCharArray(SCIA_BASE, (uint16_t*)msg, 13);
-            msg = "\r\n\nEnter number: \0";
-            SCI_writeCharArray(SCIA_BASE, (uint16_t*)msg, 17);
-
-            // Read a character from the FIFO.
-            receivedChar = SCI_readCharBlockingFIFO(SCIA_BASE);
-
             switch(receivedChar) {
                case 49  :
                    // Turn on LED
                    GPIO_writePin(DEVICE_GPIO_PIN_LED1, 0);
                    // decrease duty cycle
-                   if(dutyCycleTrack < .90){
-                       dutyCycleTrack = dutyCycleTrack + 0.005;
-                   }
-                   dutyCycle = period * dutyCycleTrack;
-                   EPWM_setCounterCompareValue(EPWM5_BASE, EPWM_COUNTER_COMPARE_A, dutyCycle);
-                   EPWM_setCounterCompareValue(EPWM5_BASE, EPWM_COUNTER_COMPARE_B, dutyCycle);
+                   dutyCycleTrack = PWMDuty_step(dutyCycleTrack,
+                                                 (int16_t)DUTY_STEP,
+                                                 DUTY_MIN, DUTY_MAX);
+                   dutyCycle = PWMHR_dutyToCount(PWMHR_COUNT(period),
+                                                 dutyCycleTrack);
+                   DINT;
+                   PWMRamp_startCompare(epwm5Ramp, dutyCycle, dutyCycle);
+                   EINT;
                    break;
                case 50  :
                    // Turn off LED
                    GPIO_writePin(DEVICE_GPIO_PIN_LED1, 1);
                    // increase duty cycle
-                   if(dutyCycleTrack > .001){
-                       dutyCycleTrack = dutyCycleTrack - 0.005;
-                   }
-                   dutyCycle = period * dutyCycleTrack;
-                   EPWM_setCounterCompareValue(EPWM5_BASE, EPWM_COUNTER_COMPARE_A, dutyCycle);
-                   EPWM_setCounterCompareValue(EPWM5_BASE, EPWM_COUNTER_COMPARE_B, dutyCycle);
+                   dutyCycleTrack = PWMDuty_step(dutyCycleTrack,
+                                                 -(int16_t)DUTY_STEP,
+                                                 DUTY_MIN, DUTY_MAX);
+                   dutyCycle = PWMHR_dutyToCount(PWMHR_COUNT(period),
+                                                 dutyCycleTrack);
+                   DINT;
+                   PWMRamp_startCompare(epwm5Ramp, dutyCycle, dutyCycle);
+                   EINT;
                    break;
                case 51  :
                    // return to home
@@ -378,524 +978,951 @@ void main(void)
                    break;
                default :
                    msg = "\r\nPlease choose one of the options\n\0";
-                   SCI_writeCharArray(SCIA_BASE, (uint16_t*)msg, 36);
+                   SCIBuffer_writeString(msg);
             }
-//            dutyCyclePrint = 100 - (int)(100 * dutyCycleTrack);
-//            frequencyPrint = (int)(period * 66);  // 66 is the constant I calculated to find frequency from period. Since 850counts = ~56000Hz.
             break;
 
         case 2:
-            msg = "\r\n 1. Decrease frequency \n\0";
-            SCI_writeCharArray(SCIA_BASE, (uint16_t*)msg, 26);
-            msg = "\r\n 2. Increase frequency \n\0";
-            SCI_writeCharArray(SCIA_BASE, (uint16_t*)msg, 26);
-            msg = "\r\n 3. Go back \n\0";
-            SCI_writeCharArray(SCIA_BASE, (uint16_t*)msg, 13);
-            msg = "\r\n\nEnter number: \0";
-            SCI_writeCharArray(SCIA_BASE, (uint16_t*)msg, 17);
-
-            // Read a character from the FIFO.
-            receivedChar = SCI_readCharBlockingFIFO(SCIA_BASE);
-
             switch(receivedChar) {
                case 49  :
                    if(period < 1500){
                        // decrease frequency increase period
                        period = period + 50;
                    }
-                   // update duty cycle to new period
-                   dutyCycle = period * dutyCycleTrack;
-                   EPWM_setCounterCompareValue(EPWM5_BASE, EPWM_COUNTER_COMPARE_A, dutyCycle);
-                   EPWM_setCounterCompareValue(EPWM5_BASE, EPWM_COUNTER_COMPARE_B, dutyCycle);
-                   // update period
-                   EPWM_setTimeBasePeriod(EPWM5_BASE, period);
+                   // ramp period and duty cycle together
+                   dutyCycle = PWMHR_dutyToCount(PWMHR_COUNT(period),
+                                                 dutyCycleTrack);
+                   DINT;
+                   PWMRamp_start(epwm5Ramp, PWMHR_COUNT(period), dutyCycle,
+                                 dutyCycle);
+                   EINT;
                    break;
                case 50  :
                    if(period > 500){
                        // increase frequency decrease period
                        period = period - 50;
                    }
-                   // update duty cycle to new period
-                   dutyCycle = period * dutyCycleTrack;
-                   EPWM_setCounterCompareValue(EPWM5_BASE, EPWM_COUNTER_COMPARE_A, dutyCycle);
-                   EPWM_setCounterCompareValue(EPWM5_BASE, EPWM_COUNTER_COMPARE_B, dutyCycle);
-                   // update period
-                   EPWM_setTimeBasePeriod(EPWM5_BASE, period);
+                   // ramp period and duty cycle together
+                   dutyCycle = PWMHR_dutyToCount(PWMHR_COUNT(period),
+                                                 dutyCycleTrack);
+                   DINT;
+                   PWMRamp_start(epwm5Ramp, PWMHR_COUNT(period), dutyCycle,
+                                 dutyCycle);
+                   EINT;
                    break;
                case 51  :
                    guiState = 0;
                    break;
                default :
                    msg = "\r\nPlease choose one of the options\n\0";
-                   SCI_writeCharArray(SCIA_BASE, (uint16_t*)msg, 36);
+                   SCIBuffer_writeString(msg);
             }
-//            dutyCyclePrint = 100 - (int)(100 * dutyCycleTrack);
-//            frequencyPrint = (int)(period * 66);  // 66 is the constant I calculated to find frequency from period. Since 850counts = ~56000Hz.
             break;
 
         default:
             guiState = 0;
             break;
         }
-
-        NOP;
     }
 }
 
 //
-// epwm1ISR - ePWM 1 ISR
+// epwmISR - ePWM ISR shared by all channels
 //
-__interrupt void epwm1ISR(void)
+__interrupt void epwmISR(void)
 {
+    PWMChannel_State *channel = PWMChannel_getInterrupting();
+
+    ISRTIMING_ENTER(&channel->probe);
+
     //
-    // Update the CMPA and CMPB values
+    // Write the next CMPA and CMPB values and the next ramp step
     //
-    updateCompare(&epwm1Info);
+    PWMMod_step(&channel->modulation);
+    PWMRamp_step(&channel->ramp);
 
     //
     // Clear INT flag for this timer
     //
-    EPWM_clearEventTriggerInterruptFlag(EPWM1_BASE);
+    EPWM_clearEventTriggerInterruptFlag(channel->base);
 
     //
     // Acknowledge interrupt group
     //
     Interrupt_clearACKGroup(INTERRUPT_ACK_GROUP3);
+
+    ISRTIMING_EXIT(&channel->probe);
 }
 
 //
-// epwm2ISR - ePWM 2 ISR
+// adcA1ISR - ADCA interrupt 1 ISR, runs the output regulation once both
+// samples of a period are in
 //
-__interrupt void epwm2ISR(void)
+__interrupt void adcA1ISR(void)
 {
-    //
-    // Update the CMPA and CMPB values
-    //
-    updateCompare(&epwm2Info);
+    PWMLoop_step(&outputLoop);
 
     //
-    // Clear INT flag for this timer
+    // Clear the interrupt flag so that the next conversion interrupts again
     //
-    EPWM_clearEventTriggerInterruptFlag(EPWM2_BASE);
+    ADC_clearInterruptStatus(ADCA_BASE, PWMLOOP_INT);
 
     //
     // Acknowledge interrupt group
     //
-    Interrupt_clearACKGroup(INTERRUPT_ACK_GROUP3);
+    Interrupt_clearACKGroup(INTERRUPT_ACK_GROUP1);
 }
 
 //
-// EPWM5ISR - ePWM 3 ISR
+// dmaCh3ISR - DMA channel 3 ISR, averages each oversampled voltage batch
 //
-__interrupt void epwm5ISR(void)
+__interrupt void dmaCh3ISR(void)
 {
-    //
-    // Update the CMPA and CMPB values
-    //
-    updateCompare(&epwm5Info);
+    ADCOversample_process(&voltageOversample);
 
     //
-    // Clear INT flag for this timer
+    // Acknowledge interrupt group
     //
-    EPWM_clearEventTriggerInterruptFlag(EPWM5_BASE);
+    Interrupt_clearACKGroup(INTERRUPT_ACK_GROUP7);
+}
+
+//
+// epwm1TZISR - ePWM1 trip zone ISR, records an overcurrent trip of the
+// outputs and opens the loop
+//
+__interrupt void epwm1TZISR(void)
+{
+    PWMProtect_tripISR(&outputProtect);
+    PWMLoop_disable(&outputLoop);
 
     //
     // Acknowledge interrupt group
     //
-    Interrupt_clearACKGroup(INTERRUPT_ACK_GROUP3);
+    Interrupt_clearACKGroup(INTERRUPT_ACK_GROUP2);
 }
 
-//// Implementation of itoa()
-//void itoa(long unsigned int value, char* result, int base)
-//{
-//    // check that the base if valid
-//    if (base < 2 || base > 36) { *result = '\0';}
-//
-//    char* ptr = result, *ptr1 = result, tmp_char;
-//    int tmp_value;
-//
-//    do {
-//    tmp_value = value;
-//    value /= base;
-//    *ptr++ = "zyxwvutsrqponmlkjihgfedcba9876543210123456789abcdefghijklmnopqrstuvwxyz" [35 + (tmp_value - value * base)];
-//    } while ( value );
 //
-//    // Apply negative sign
-//    if (tmp_value < 0) *ptr++ = '-';
-//    *ptr-- = '\0';
-//    while(ptr1 < ptr) {
-//    tmp_char = *ptr;
-//    *ptr--= *ptr1;
-//    *ptr1++ = tmp_char;
-//    }
+// initModulation - Start the compare modulation of ePWM1 and ePWM2 in the
+// selected engine
 //
-//}
+void initModulation(void)
+{
+    const PWMChannel_Config *epwm1 = &channelConfig[CHANNEL_EPWM1];
+    const PWMChannel_Config *epwm2 = &channelConfig[CHANNEL_EPWM2];
+
+    //
+    // ePWM1 plays a sine wave on CMPA and CMPB in anti-phase, ePWM2 the
+    // same triangle wave on both
+    //
+    PWMMod_fillSine(sineTable, MODULATION_TABLE_LENGTH,
+                    epwm1->minCompare, epwm1->maxCompare);
+    PWMMod_fillTriangle(triangleTable, MODULATION_TABLE_LENGTH,
+                        epwm2->minCompare, epwm2->maxCompare);
+#if MODULATION_ENGINE == MODULATION_ENGINE_DMA
+    PWMStream_fillFromTable(epwm1StreamBuffer, sineTable,
+                            MODULATION_TABLE_LENGTH,
+                            MODULATION_TABLE_LENGTH / 2U);
+    PWMStream_init(EPWM1_STREAM_DMA_BASE, epwm1->base, epwm1StreamBuffer,
+                   MODULATION_TABLE_LENGTH);
+    PWMStream_fillFromTable(epwm2StreamBuffer, triangleTable,
+                            MODULATION_TABLE_LENGTH, 0U);
+    PWMStream_init(EPWM2_STREAM_DMA_BASE, epwm2->base, epwm2StreamBuffer,
+                   MODULATION_TABLE_LENGTH);
+#elif MODULATION_ENGINE == MODULATION_ENGINE_CLA
+    PWMCLA_initChannel(EPWM1_CLA_CHANNEL, epwm1->base, sineTable,
+                       MODULATION_TABLE_LENGTH,
+                       MODULATION_TABLE_LENGTH / 2U, MODULATION_DIVIDER);
+    PWMCLA_initChannel(EPWM2_CLA_CHANNEL, epwm2->base, triangleTable,
+                       MODULATION_TABLE_LENGTH, 0U, MODULATION_DIVIDER);
+#else
+    PWMMod_initChannel(&epwmChannels[CHANNEL_EPWM1].modulation, epwm1->base,
+                       sineTable, MODULATION_TABLE_LENGTH,
+                       MODULATION_TABLE_LENGTH / 2U, MODULATION_DIVIDER);
+    PWMMod_initChannel(&epwmChannels[CHANNEL_EPWM2].modulation, epwm2->base,
+                       triangleTable, MODULATION_TABLE_LENGTH, 0U,
+                       MODULATION_DIVIDER);
+#endif
+}
 
 //
-// initEPWM1 - Configure ePWM1
+// initEPWM5 - Add global loads, high-resolution edges and dead time to the
+// ePWM5 channel
 //
-void initEPWM1()
+void initEPWM5(void)
 {
     //
-    // Set-up TBCLK
+    // Period and compare changes from the menu load together
     //
-    EPWM_setTimeBasePeriod(EPWM1_BASE, EPWM1_TIMER_TBPRD);
-    EPWM_setPhaseShift(EPWM1_BASE, 0U);
-    EPWM_setTimeBaseCounter(EPWM1_BASE, 0U);
+    PWMUpdate_init(EPWM5_BASE);
 
     //
-    // Set Compare values
+    // The MEP places both edges of ePWM5A/B to a fraction of a count
     //
-    EPWM_setCounterCompareValue(EPWM1_BASE,
-                                EPWM_COUNTER_COMPARE_A,
-                                EPWM1_MIN_CMPA);
-    EPWM_setCounterCompareValue(EPWM1_BASE,
-                                EPWM_COUNTER_COMPARE_B,
-                                EPWM1_MAX_CMPB);
+    PWMHR_init(EPWM5_BASE);
 
     //
-    // Set up counter mode
+    // Both outputs follow the CMPA edges of ePWM5A, with dead time between
+    // them
     //
-    EPWM_setTimeBaseCounterMode(EPWM1_BASE, EPWM_COUNTER_MODE_UP_DOWN);
-    EPWM_disablePhaseShiftLoad(EPWM1_BASE);
-    EPWM_setClockPrescaler(EPWM1_BASE,
-                           EPWM_CLOCK_DIVIDER_1,
-                           EPWM_HSCLOCK_DIVIDER_1);
+    PWMDeadband_init(EPWM5_BASE);
+    PWMDeadband_setDelay(EPWM5_BASE,
+                         PWMDeadband_nsToDelay(DEADBAND_CLOCK_FREQ,
+                                               DEADBAND_RISING_NS),
+                         PWMDeadband_nsToDelay(DEADBAND_CLOCK_FREQ,
+                                               DEADBAND_FALLING_NS),
+                         false);
+    PWMDeadband_enable(EPWM5_BASE);
+}
 
-    //
-    // Set up shadowing
-    //
-    EPWM_setCounterCompareShadowLoadMode(EPWM1_BASE,
-                                         EPWM_COUNTER_COMPARE_A,
-                                         EPWM_COMP_LOAD_ON_CNTR_ZERO);
-    EPWM_setCounterCompareShadowLoadMode(EPWM1_BASE,
-                                         EPWM_COUNTER_COMPARE_B,
-                                         EPWM_COMP_LOAD_ON_CNTR_ZERO);
+//
+// initADC - Power up an ADC on the internal 3.3 V reference
+//
+void initADC(uint32_t base)
+{
+    ADC_setVREF(base, ADC_REFERENCE_INTERNAL, ADC_REFERENCE_3_3V);
+    ADC_setPrescaler(base, ADC_CLK_DIV_2_0);
+    ADC_setInterruptPulseMode(base, ADC_PULSE_END_OF_CONV);
+    ADC_enableConverter(base);
 
     //
-    // Set actions
+    // Wait for the converter to power up before the first conversion
     //
-    EPWM_setActionQualifierAction(EPWM1_BASE,
-                                  EPWM_AQ_OUTPUT_A,
-                                  EPWM_AQ_OUTPUT_HIGH,
-                                  EPWM_AQ_OUTPUT_ON_TIMEBASE_UP_CMPA);
-    EPWM_setActionQualifierAction(EPWM1_BASE,
-                                  EPWM_AQ_OUTPUT_A,
-                                  EPWM_AQ_OUTPUT_LOW,
-                                  EPWM_AQ_OUTPUT_ON_TIMEBASE_DOWN_CMPA);
-    EPWM_setActionQualifierAction(EPWM1_BASE,
-                                  EPWM_AQ_OUTPUT_B,
-                                  EPWM_AQ_OUTPUT_HIGH,
-                                  EPWM_AQ_OUTPUT_ON_TIMEBASE_UP_CMPB);
-    EPWM_setActionQualifierAction(EPWM1_BASE,
-                                  EPWM_AQ_OUTPUT_B,
-                                  EPWM_AQ_OUTPUT_LOW,
-                                  EPWM_AQ_OUTPUT_ON_TIMEBASE_DOWN_CMPB);
+    DEVICE_DELAY_US(1000);
+}
 
-    //
-    // Interrupt where we will change the Compare Values
-    // Select INT on Time base counter zero event,
-    // Enable INT, generate INT on 3rd event
-    //
-    EPWM_setInterruptSource(EPWM1_BASE, EPWM_INT_TBCTR_ZERO);
-    EPWM_enableInterrupt(EPWM1_BASE);
-    EPWM_setInterruptEventCount(EPWM1_BASE, 3U);
+//
+// initTimestampTimer - Start the free-running SYSCLK time stamp timer
+//
+void initTimestampTimer(void)
+{
+    CPUTimer_stopTimer(TIMESTAMP_TIMER_BASE);
+    CPUTimer_setPeriod(TIMESTAMP_TIMER_BASE, 0xFFFFFFFFU);
+    CPUTimer_setPreScaler(TIMESTAMP_TIMER_BASE, 0U);
+    CPUTimer_startTimer(TIMESTAMP_TIMER_BASE);
+}
 
-    //
-    // Information this example uses to keep track of the direction the
-    // CMPA/CMPB values are moving, the min and max allowed values and
-    // a pointer to the correct ePWM registers
-    //
-    epwm1Info.epwmCompADirection = EPWM_CMP_UP;
-    epwm1Info.epwmCompBDirection = EPWM_CMP_DOWN;
-    epwm1Info.epwmTimerIntCount = 0U;
-    epwm1Info.epwmModule = EPWM1_BASE;
-    epwm1Info.epwmMaxCompA = EPWM1_MAX_CMPA;
-    epwm1Info.epwmMinCompA = EPWM1_MIN_CMPA;
-    epwm1Info.epwmMaxCompB = EPWM1_MAX_CMPB;
-    epwm1Info.epwmMinCompB = EPWM1_MIN_CMPB;
+//
+// restartOutputs - Release the outputs after a trip with the loop open and
+// ePWM5 at its lowest duty, false if the overcurrent is still present
+//
+bool restartOutputs(void)
+{
+    uint32_t compare;
+
+    DINT;
+    PWMLoop_disable(&outputLoop);
+    PWMRamp_stop(&epwmChannels[CHANNEL_EPWM5].ramp);
+    EINT;
+
+    compare = PWMHR_dutyToCount(PWMHR_COUNT(EPWM_getTimeBasePeriod(
+                                                    LOOP_EPWM_BASE)),
+                                LOOP_MAX_COMPARE);
+    PWMHR_setCompare(LOOP_EPWM_BASE, compare, compare);
+
+    return(PWMProtect_restart(&outputProtect));
 }
 
 //
-// initEPWM2 - Configure ePWM2
+// getRamp - Map an ePWM base to its setpoint ramp, NULL if the module has
+// none
 //
-void initEPWM2()
+PWMRamp_Channel *getRamp(uint32_t base)
 {
-    //
-    // Set-up TBCLK
-    //
-    EPWM_setTimeBasePeriod(EPWM2_BASE, EPWM2_TIMER_TBPRD);
-    EPWM_setPhaseShift(EPWM2_BASE, 0U);
-    EPWM_setTimeBaseCounter(EPWM2_BASE, 0U);
+    return(PWMChannel_findRamp(base));
+}
 
-    //
-    // Set Compare values
-    //
-    EPWM_setCounterCompareValue(EPWM2_BASE,
-                                EPWM_COUNTER_COMPARE_A,
-                                EPWM2_MIN_CMPA);
-    EPWM_setCounterCompareValue(EPWM2_BASE,
-                                EPWM_COUNTER_COMPARE_B,
-                                EPWM2_MIN_CMPB);
+//
+// setPeriod - Move a module to a new period, through its ramp if it has one
+//
+void setPeriod(uint32_t base, uint16_t period)
+{
+    PWMRamp_Channel *ramp = getRamp(base);
 
-    //
-    // Set-up counter mode
-    //
-    EPWM_setTimeBaseCounterMode(EPWM2_BASE, EPWM_COUNTER_MODE_UP_DOWN);
-    EPWM_disablePhaseShiftLoad(EPWM2_BASE);
-    EPWM_setClockPrescaler(EPWM2_BASE,
-                           EPWM_CLOCK_DIVIDER_1,
-                           EPWM_HSCLOCK_DIVIDER_1);
+    if(ramp != NULL)
+    {
+        DINT;
+        PWMRamp_startPeriod(ramp, PWMHR_COUNT(period));
+        EINT;
+    }
+    else if(PWMHR_isEnabled(base))
+    {
+        PWMHR_setPeriod(base, PWMHR_COUNT(period));
+    }
+    else
+    {
+        PWMUpdate_setPeriod(base, period);
+    }
+}
 
-    //
-    // Set-up shadowing
-    //
-    EPWM_setCounterCompareShadowLoadMode(EPWM2_BASE,
-                                         EPWM_COUNTER_COMPARE_A,
-                                         EPWM_COMP_LOAD_ON_CNTR_ZERO);
-    EPWM_setCounterCompareShadowLoadMode(EPWM2_BASE,
-                                         EPWM_COUNTER_COMPARE_B,
-                                         EPWM_COMP_LOAD_ON_CNTR_ZERO);
+//
+// getEPWMBase - Map a protocol module number to an ePWM base, 0 if invalid
+//
+uint32_t getEPWMBase(uint16_t module)
+{
+    if((module == 0U) || (module > EPWM_NUM_MODULES))
+    {
+        return(0U);
+    }
 
-    //
-    // Set Action qualifier
-    //
-    EPWM_setActionQualifierAction(EPWM2_BASE,
-                                  EPWM_AQ_OUTPUT_A,
-                                  EPWM_AQ_OUTPUT_HIGH,
-                                  EPWM_AQ_OUTPUT_ON_TIMEBASE_UP_CMPA);
-    EPWM_setActionQualifierAction(EPWM2_BASE,
-                                  EPWM_AQ_OUTPUT_A,
-                                  EPWM_AQ_OUTPUT_LOW,
-                                  EPWM_AQ_OUTPUT_ON_TIMEBASE_DOWN_CMPB);
-    EPWM_setActionQualifierAction(EPWM2_BASE,
-                                  EPWM_AQ_OUTPUT_B,
-                                  EPWM_AQ_OUTPUT_LOW,
-                                  EPWM_AQ_OUTPUT_ON_TIMEBASE_ZERO);
-    EPWM_setActionQualifierAction(EPWM2_BASE,
-                                  EPWM_AQ_OUTPUT_B,
-                                  EPWM_AQ_OUTPUT_HIGH,
-                                  EPWM_AQ_OUTPUT_ON_TIMEBASE_PERIOD);
+    return(EPWM1_BASE + ((uint32_t)(module - 1U) * EPWM_BASE_STEP));
+}
 
+//
+// processFrame - Execute a command received over the binary protocol
+//
+void processFrame(const Protocol_Frame *frame)
+{
     //
-    // Interrupt where we will change the Compare Values
-    // Select INT on Time base counter zero event,
-    // Enable INT, generate INT on 3rd event
+    // Expected payload length of each command, indexed by opcode
     //
-    EPWM_setInterruptSource(EPWM2_BASE, EPWM_INT_TBCTR_ZERO);
-    EPWM_enableInterrupt(EPWM2_BASE);
-    EPWM_setInterruptEventCount(EPWM2_BASE, 3U);
+    static const uint16_t commandLength[PROTOCOL_OP_SET_PHASE_ANGLE + 1U] =
+    {
+        0U, 3U, 5U, 3U, 5U, 1U, 3U, 1U, 2U, 3U, 1U, 4U, 1U, 1U, 1U, 6U, 3U
+    };
+    uint16_t result = PROTOCOL_RESULT_OK;
+    uint16_t value1 = 0U;
+    uint16_t value2 = 0U;
+    uint16_t period;
+    uint32_t base = 0U;
+    ISRTiming_Probe *probe;
+    PWMLoop_Limits limits;
+    PWMRamp_Channel *ramp;
+    uint32_t rising;
+    uint32_t falling;
+    uint16_t follower;
+
+    if((frame->opcode == 0U) ||
+       (frame->opcode > PROTOCOL_OP_SET_PHASE_ANGLE))
+    {
+        result = PROTOCOL_RESULT_BAD_OPCODE;
+    }
+    else if(frame->length != commandLength[frame->opcode])
+    {
+        result = PROTOCOL_RESULT_BAD_LENGTH;
+    }
+    else
+    {
+        base = getEPWMBase(frame->payload[0]);
+        if(base == 0U)
+        {
+            result = PROTOCOL_RESULT_BAD_MODULE;
+        }
+    }
+
+    if(result != PROTOCOL_RESULT_OK)
+    {
+        sendAck(frame->opcode, result);
+        return;
+    }
+
+    if(frame->length >= 3U)
+    {
+        value1 = Protocol_getUint16(&frame->payload[1]);
+    }
+    if(frame->length >= 5U)
+    {
+        value2 = Protocol_getUint16(&frame->payload[3]);
+    }
+    period = EPWM_getTimeBasePeriod(base);
 
     //
-    // Information this example uses to keep track of the direction the
-    // CMPA/CMPB values are moving, the min and max allowed values and
-    // a pointer to the correct ePWM registers
+    // Commands act on the period a running ramp is heading for
     //
-    epwm2Info.epwmCompADirection = EPWM_CMP_UP;
-    epwm2Info.epwmCompBDirection = EPWM_CMP_UP;
-    epwm2Info.epwmTimerIntCount = 0U;
-    epwm2Info.epwmModule = EPWM2_BASE;
-    epwm2Info.epwmMaxCompA = EPWM2_MAX_CMPA;
-    epwm2Info.epwmMinCompA = EPWM2_MIN_CMPA;
-    epwm2Info.epwmMaxCompB = EPWM2_MAX_CMPB;
-    epwm2Info.epwmMinCompB = EPWM2_MIN_CMPB;
+    ramp = getRamp(base);
+    if(ramp != NULL)
+    {
+        period = (uint16_t)(ramp->targetPeriod >> PWMHR_COUNT_S);
+    }
+
+    switch(frame->opcode)
+    {
+        case PROTOCOL_OP_SET_PERIOD:
+            if((value1 < 2U) ||
+               ((base == LOOP_EPWM_BASE) && PWMLoop_isEnabled(&outputLoop)))
+            {
+                result = PROTOCOL_RESULT_BAD_VALUE;
+                break;
+            }
+
+            //
+            // The modules of the phase group share one period
+            //
+            follower = PWMPhase_findFollower(&phaseGroup, base);
+            if((base != phaseGroup.masterBase) &&
+               (follower == PWMPHASE_NO_FOLLOWER))
+            {
+                setPeriod(base, value1);
+                break;
+            }
+            setPeriod(phaseGroup.masterBase, value1);
+            for(follower = 0U; follower < phaseGroup.numFollowers;
+                follower++)
+            {
+                setPeriod(phaseGroup.followerBase[follower], value1);
+            }
+            PWMPhase_setPeriod(&phaseGroup, value1);
+            break;
+
+        case PROTOCOL_OP_SET_DUTY:
+            if((value1 > period) || (value2 > period) ||
+               ((base == LOOP_EPWM_BASE) && PWMLoop_isEnabled(&outputLoop)))
+            {
+                result = PROTOCOL_RESULT_BAD_VALUE;
+                break;
+            }
+            if((ramp != NULL) && ((ramp->registers & PWMRAMP_COMPARE) != 0U))
+            {
+                DINT;
+                PWMRamp_startCompare(ramp, PWMHR_COUNT(value1),
+                                     PWMHR_COUNT(value2));
+                EINT;
+            }
+            else if(PWMHR_isEnabled(base))
+            {
+                PWMHR_setCompare(base, PWMHR_COUNT(value1),
+                                 PWMHR_COUNT(value2));
+            }
+            else
+            {
+                PWMUpdate_setCompare(base, value1, value2);
+            }
+            break;
+
+        case PROTOCOL_OP_SET_PHASE:
+            if(value1 > period)
+            {
+                result = PROTOCOL_RESULT_BAD_VALUE;
+                break;
+            }
+            EPWM_setPhaseShift(base, value1);
+            break;
+
+        case PROTOCOL_OP_SET_DEADBAND:
+            //
+            // The dead time of the complementary pair is set through
+            // PROTOCOL_OP_SET_DEAD_TIME only
+            //
+            if(base == DEADBAND_EPWM_BASE)
+            {
+                result = PROTOCOL_RESULT_BAD_MODULE;
+                break;
+            }
+            if((value1 > EPWM_DBRED_DBRED_M) || (value2 > EPWM_DBFED_DBFED_M))
+            {
+                result = PROTOCOL_RESULT_BAD_VALUE;
+                break;
+            }
+
+            //
+            // Active-high complementary pair derived from ePWMxA, or the
+            // dead-band submodule bypassed when both delays are zero
+            //
+            EPWM_setRisingEdgeDelayCount(base, value1);
+            EPWM_setFallingEdgeDelayCount(base, value2);
+            EPWM_setRisingEdgeDeadBandDelayInput(base, EPWM_DB_INPUT_EPWMA);
+            EPWM_setFallingEdgeDeadBandDelayInput(base, EPWM_DB_INPUT_EPWMA);
+            EPWM_setDeadBandDelayPolarity(base, EPWM_DB_RED,
+                                          EPWM_DB_POLARITY_ACTIVE_HIGH);
+            EPWM_setDeadBandDelayPolarity(base, EPWM_DB_FED,
+                                          EPWM_DB_POLARITY_ACTIVE_LOW);
+            EPWM_setDeadBandDelayMode(base, EPWM_DB_RED,
+                                      (value1 | value2) != 0U);
+            EPWM_setDeadBandDelayMode(base, EPWM_DB_FED,
+                                      (value1 | value2) != 0U);
+            break;
+
+        case PROTOCOL_OP_GET_STATUS:
+            //
+            // The status frame is the answer
+            //
+            sendStatus(base);
+            return;
+
+        case PROTOCOL_OP_GET_TIMING:
+            if(sendTiming(base))
+            {
+                return;
+            }
+            result = PROTOCOL_RESULT_BAD_MODULE;
+            break;
+
+        case PROTOCOL_OP_GET_ISR_STATS:
+        case PROTOCOL_OP_GET_ISR_HISTOGRAM:
+            probe = getISRProbe(base);
+            if(probe == NULL)
+            {
+                result = PROTOCOL_RESULT_BAD_MODULE;
+                break;
+            }
+            if((frame->payload[1] > PROTOCOL_ISR_LATENCY) ||
+               ((frame->opcode == PROTOCOL_OP_GET_ISR_HISTOGRAM) &&
+                (frame->payload[2] >= ISRTIMING_BINS)))
+            {
+                result = PROTOCOL_RESULT_BAD_VALUE;
+                break;
+            }
+            if(frame->opcode == PROTOCOL_OP_GET_ISR_STATS)
+            {
+                sendISRStats(base, probe, frame->payload[1]);
+            }
+            else
+            {
+                sendISRHistogram(base, probe, frame->payload[1],
+                                 frame->payload[2]);
+            }
+            return;
+
+        case PROTOCOL_OP_CLEAR_ISR_STATS:
+            probe = getISRProbe(base);
+            if(probe == NULL)
+            {
+                result = PROTOCOL_RESULT_BAD_MODULE;
+                break;
+            }
+            DINT;
+            ISRTiming_reset(probe);
+            EINT;
+            break;
+
+        case PROTOCOL_OP_SET_LOOP:
+            if(base != LOOP_EPWM_BASE)
+            {
+                result = PROTOCOL_RESULT_BAD_MODULE;
+                break;
+            }
+            if((frame->payload[3] > 1U) ||
+               ((int16_t)value1 > loopVoltageSense.tripHigh) ||
+               ((int16_t)value1 < loopVoltageSense.tripLow))
+            {
+                result = PROTOCOL_RESULT_BAD_VALUE;
+                break;
+            }
+            if(frame->payload[3] == 0U)
+            {
+                PWMLoop_disable(&outputLoop);
+                break;
+            }
+
+            //
+            // The compare range follows the period the loop starts with;
+            // on a fault the output falls back to the lowest duty
+            //
+            limits.min = PWMHR_dutyToCount(PWMHR_COUNT(period),
+                                           LOOP_MIN_COMPARE);
+            limits.max = PWMHR_dutyToCount(PWMHR_COUNT(period),
+                                           LOOP_MAX_COMPARE);
+            limits.safe = limits.max;
+
+            DINT;
+            PWMRamp_stop(&epwmChannels[CHANNEL_EPWM5].ramp);
+            PWMLoop_enable(&outputLoop, (int16_t)value1,
+                           HRPWM_getCounterCompareValue(base,
+                                                HRPWM_COUNTER_COMPARE_A),
+                           &limits);
+            EINT;
+            break;
+
+        case PROTOCOL_OP_GET_LOOP:
+            if(base != LOOP_EPWM_BASE)
+            {
+                result = PROTOCOL_RESULT_BAD_MODULE;
+                break;
+            }
+
+            //
+            // The LOOP frame is the answer
+            //
+            sendLoop(base);
+            return;
+
+        case PROTOCOL_OP_GET_FAULT:
+            //
+            // The FAULT frame is the answer
+            //
+            sendFault(base);
+            return;
+
+        case PROTOCOL_OP_CLEAR_FAULT:
+            if(!restartOutputs())
+            {
+                result = PROTOCOL_RESULT_FAULT_ACTIVE;
+            }
+            break;
+
+        case PROTOCOL_OP_SET_DEAD_TIME:
+            if(base != DEADBAND_EPWM_BASE)
+            {
+                result = PROTOCOL_RESULT_BAD_MODULE;
+                break;
+            }
+
+            rising = PWMDeadband_nsToDelay(DEADBAND_CLOCK_FREQ, value1);
+            falling = PWMDeadband_nsToDelay(DEADBAND_CLOCK_FREQ, value2);
+            if((frame->payload[5] > PROTOCOL_DEAD_TIME_HR) ||
+               (rising > PWMDEADBAND_DELAY_MAX) ||
+               (falling > PWMDEADBAND_DELAY_MAX))
+            {
+                result = PROTOCOL_RESULT_BAD_VALUE;
+                break;
+            }
+
+            if(frame->payload[5] == PROTOCOL_DEAD_TIME_OFF)
+            {
+                PWMDeadband_disable(base);
+            }
+            else
+            {
+                PWMDeadband_setDelay(base, rising, falling,
+                                     frame->payload[5] ==
+                                     PROTOCOL_DEAD_TIME_HR);
+                PWMDeadband_enable(base);
+            }
+            break;
+
+        case PROTOCOL_OP_SET_PHASE_ANGLE:
+            follower = PWMPhase_findFollower(&phaseGroup, base);
+            if(follower == PWMPHASE_NO_FOLLOWER)
+            {
+                result = PROTOCOL_RESULT_BAD_MODULE;
+                break;
+            }
+            if(value1 >= PWMPHASE_FULL_TURN)
+            {
+                result = PROTOCOL_RESULT_BAD_VALUE;
+                break;
+            }
+            PWMPhase_setPhase(&phaseGroup, follower, value1);
+            break;
+
+        default:
+            if(value1 > STREAM_MAX_INTERVAL_MS)
+            {
+                result = PROTOCOL_RESULT_BAD_VALUE;
+                break;
+            }
+            streamBase = base;
+            streamInterval = (uint32_t)value1 * SYSCLK_CYCLES_PER_MS;
+            streamStamp = CPUTimer_getTimerCount(TIMESTAMP_TIMER_BASE);
+            break;
+    }
+
+    sendAck(frame->opcode, result);
 }
 
 //
-// initEPWM5 - Configure EPWM5
+// sendAck - Answer a command
 //
-void initEPWM5(void)
+void sendAck(uint16_t opcode, uint16_t result)
 {
-    //
-    // Set-up TBCLK
-    //
-    EPWM_setTimeBasePeriod(EPWM5_BASE, EPWM5_TIMER_TBPRD);
-    EPWM_setPhaseShift(EPWM5_BASE, 0U);
-    EPWM_setTimeBaseCounter(EPWM5_BASE, 0U);
+    uint16_t payload[2];
+    uint16_t frame[2U + PROTOCOL_OVERHEAD];
 
-    //
-    // Set Compare values
-    //
-    EPWM_setCounterCompareValue(EPWM5_BASE,
-                                EPWM_COUNTER_COMPARE_A,
-                                EPWM5_MIN_CMPA);
-    EPWM_setCounterCompareValue(EPWM5_BASE,
-                                EPWM_COUNTER_COMPARE_B,
-                                EPWM5_MAX_CMPB);
+    payload[0] = opcode;
+    payload[1] = result;
 
-    //
-    // Set up counter mode
-    //
-    EPWM_setTimeBaseCounterMode(EPWM5_BASE, EPWM_COUNTER_MODE_UP_DOWN);
-    EPWM_disablePhaseShiftLoad(EPWM5_BASE);
-    EPWM_setClockPrescaler(EPWM5_BASE,
-                           EPWM_CLOCK_DIVIDER_1,
-                           EPWM_HSCLOCK_DIVIDER_1);
+    SCIBuffer_write(frame, Protocol_encodeFrame(PROTOCOL_OP_ACK, payload, 2U,
+                                                frame));
+}
 
-    //
-    // Set up shadowing
-    //
-    EPWM_setCounterCompareShadowLoadMode(EPWM5_BASE,
-                                         EPWM_COUNTER_COMPARE_A,
-                                         EPWM_COMP_LOAD_ON_CNTR_ZERO);
-    EPWM_setCounterCompareShadowLoadMode(EPWM5_BASE,
-                                         EPWM_COUNTER_COMPARE_B,
-                                         EPWM_COMP_LOAD_ON_CNTR_ZERO);
+//
+// sendStatus - Report the live configuration of one ePWM module
+//
+void sendStatus(uint32_t base)
+{
+    uint16_t payload[29];
+    uint16_t frame[29U + PROTOCOL_OVERHEAD];
+    PWMReadback_Channel *readback = &outputReadback[PWMChannel_getIndex(base)];
+
+    payload[0] = (uint16_t)((base - EPWM1_BASE) / EPWM_BASE_STEP) + 1U;
+    Protocol_putUint16(&payload[1], EPWM_getTimeBasePeriod(base));
+    Protocol_putUint16(&payload[3],
+                       EPWM_getCounterCompareValue(base,
+                                                   EPWM_COUNTER_COMPARE_A));
+    Protocol_putUint16(&payload[5],
+                       EPWM_getCounterCompareValue(base,
+                                                   EPWM_COUNTER_COMPARE_B));
+    Protocol_putUint16(&payload[7],
+                       (uint16_t)(HWREG(base + EPWM_O_TBPHS) >>
+                                  EPWM_TBPHS_TBPHS_S));
+    Protocol_putUint16(&payload[9],
+                       HWREGH(base + EPWM_O_DBRED) & EPWM_DBRED_DBRED_M);
+    Protocol_putUint16(&payload[11],
+                       HWREGH(base + EPWM_O_DBFED) & EPWM_DBFED_DBFED_M);
+    Protocol_putUint16(&payload[13], commandDecoder.errors);
+    Protocol_putUint16(&payload[15], CPULoad_getLoad(&cpuLoad));
+    Protocol_putUint16(&payload[17], CPULoad_getPeak(&cpuLoad));
+
+    PWMReadback_update(readback);
+    Protocol_putUint32(&payload[19], readback->frequency);
+    Protocol_putUint16(&payload[23], readback->frequencyMilliHz);
+    Protocol_putUint16(&payload[25], readback->dutyA);
+    Protocol_putUint16(&payload[27], readback->dutyB);
+
+    SCIBuffer_write(frame, Protocol_encodeFrame(PROTOCOL_OP_STATUS, payload,
+                                                29U, frame));
+}
 
-    //
-    // Set actions
-    //
-    EPWM_setActionQualifierAction(EPWM5_BASE,
-                                  EPWM_AQ_OUTPUT_A,
-                                  EPWM_AQ_OUTPUT_HIGH,
-                                  EPWM_AQ_OUTPUT_ON_TIMEBASE_UP_CMPA);
-    EPWM_setActionQualifierAction(EPWM5_BASE,
-                                  EPWM_AQ_OUTPUT_A,
-                                  EPWM_AQ_OUTPUT_LOW,
-                                  EPWM_AQ_OUTPUT_ON_TIMEBASE_DOWN_CMPA);
-    EPWM_setActionQualifierAction(EPWM5_BASE,
-                                  EPWM_AQ_OUTPUT_B,
-                                  EPWM_AQ_OUTPUT_LOW,
-                                  EPWM_AQ_OUTPUT_ON_TIMEBASE_UP_CMPB);
-    EPWM_setActionQualifierAction(EPWM5_BASE,
-                                  EPWM_AQ_OUTPUT_B,
-                                  EPWM_AQ_OUTPUT_HIGH,
-                                  EPWM_AQ_OUTPUT_ON_TIMEBASE_DOWN_CMPB);
+//
+// sendTiming - Report the compare update latency of one ePWM module, false
+// if the module has no measurements
+//
+bool sendTiming(uint32_t base)
+{
+    uint16_t payload[7];
+    uint16_t frame[7U + PROTOCOL_OVERHEAD];
+    uint16_t latency;
+    uint16_t maxLatency;
+    uint32_t runs;
+#if MODULATION_ENGINE == MODULATION_ENGINE_CLA
+    const volatile PWMCLA_State *state = NULL;
+
+    if(base == EPWM1_BASE)
+    {
+        state = PWMCLA_getState(EPWM1_CLA_CHANNEL);
+    }
+    else if(base == EPWM2_BASE)
+    {
+        state = PWMCLA_getState(EPWM2_CLA_CHANNEL);
+    }
+
+    if(state != NULL)
+    {
+        latency = state->latency;
+        maxLatency = state->maxLatency;
+        runs = state->runs;
+    }
+    else
+#endif
+    if(base == LOOP_EPWM_BASE)
+    {
+        //
+        // The control ISR updates the measurements; copy them in one piece
+        //
+        DINT;
+        latency = outputLoop.latency;
+        maxLatency = outputLoop.maxLatency;
+        runs = outputLoop.runs;
+        EINT;
+    }
+    else
+    {
+        return(false);
+    }
+
+    payload[0] = (uint16_t)((base - EPWM1_BASE) / EPWM_BASE_STEP) + 1U;
+    Protocol_putUint16(&payload[1], latency);
+    Protocol_putUint16(&payload[3], maxLatency);
+    Protocol_putUint16(&payload[5], (uint16_t)runs);
+
+    SCIBuffer_write(frame, Protocol_encodeFrame(PROTOCOL_OP_TIMING, payload,
+                                                7U, frame));
+    return(true);
+}
+
+//
+// sendLoop - Report the state of the closed loop of one ePWM module
+//
+void sendLoop(uint32_t base)
+{
+    uint16_t payload[14];
+    uint16_t frame[14U + PROTOCOL_OVERHEAD];
+    uint16_t flags = 0U;
+    uint16_t faults;
+    int16_t reference;
+    int16_t current;
+    int16_t voltage;
+    uint16_t trips;
 
     //
-    // Interrupt where we will change the Compare Values
-    // Select INT on Time base counter zero event,
-    // Enable INT, generate INT on 3rd event
+    // The control ISR updates the loop; copy it in one piece
     //
-    EPWM_setInterruptSource(EPWM5_BASE, EPWM_INT_TBCTR_ZERO);
-    EPWM_enableInterrupt(EPWM5_BASE);
-    EPWM_setInterruptEventCount(EPWM5_BASE, 3U);
+    DINT;
+    if(PWMLoop_isEnabled(&outputLoop))
+    {
+        flags |= PROTOCOL_LOOP_CLOSED;
+    }
+    faults = outputLoop.faults;
+    reference = outputLoop.reference;
+    current = outputLoop.lastCurrent;
+    voltage = outputLoop.lastVoltage;
+    trips = outputLoop.trips;
+    EINT;
+
+    if((faults & PWMLOOP_FAULT_CURRENT) != 0U)
+    {
+        flags |= PROTOCOL_LOOP_CURRENT_FAULT;
+    }
+    if((faults & PWMLOOP_FAULT_VOLTAGE) != 0U)
+    {
+        flags |= PROTOCOL_LOOP_VOLTAGE_FAULT;
+    }
+
+    payload[0] = (uint16_t)((base - EPWM1_BASE) / EPWM_BASE_STEP) + 1U;
+    payload[1] = flags;
+    Protocol_putUint16(&payload[2], (uint16_t)reference);
+    Protocol_putUint16(&payload[4], (uint16_t)current);
+    Protocol_putUint16(&payload[6], (uint16_t)voltage);
+    Protocol_putUint16(&payload[8],
+                       EPWM_getCounterCompareValue(base,
+                                                   EPWM_COUNTER_COMPARE_A));
+    Protocol_putUint16(&payload[10], trips);
+    Protocol_putUint16(&payload[12],
+                       ADCOversample_getValue(&voltageOversample));
+
+    SCIBuffer_write(frame, Protocol_encodeFrame(PROTOCOL_OP_LOOP, payload,
+                                                14U, frame));
+}
+
+//
+// sendFault - Report the overcurrent protection of the outputs
+//
+void sendFault(uint32_t base)
+{
+    uint16_t payload[4];
+    uint16_t frame[4U + PROTOCOL_OVERHEAD];
+    uint16_t flags = 0U;
+    uint16_t sources;
+    uint16_t faults;
 
     //
-    // Information this example uses to keep track of the direction the
-    // CMPA/CMPB values are moving, the min and max allowed values and
-    // a pointer to the correct ePWM registers
+    // The trip ISR updates the protection; copy it in one piece
     //
-    epwm5Info.epwmCompADirection = EPWM_CMP_UP;
-    epwm5Info.epwmCompBDirection = EPWM_CMP_DOWN;
-    epwm5Info.epwmTimerIntCount = 0U;
-    epwm5Info.epwmModule = EPWM5_BASE;
-    epwm5Info.epwmMaxCompA = EPWM5_MAX_CMPA;
-    epwm5Info.epwmMinCompA = EPWM5_MIN_CMPA;
-    epwm5Info.epwmMaxCompB = EPWM5_MAX_CMPB;
-    epwm5Info.epwmMinCompB = EPWM5_MIN_CMPB;
+    DINT;
+    if(PWMProtect_isLatched(&outputProtect))
+    {
+        flags |= PROTOCOL_FAULT_LATCHED;
+    }
+    sources = outputProtect.sources;
+    faults = outputProtect.faults;
+    EINT;
+
+    if(PWMProtect_isFaultActive(&outputProtect))
+    {
+        flags |= PROTOCOL_FAULT_ACTIVE;
+    }
+    if((sources & PWMPROTECT_SOURCE_HIGH) != 0U)
+    {
+        flags |= PROTOCOL_FAULT_HIGH;
+    }
+    if((sources & PWMPROTECT_SOURCE_LOW) != 0U)
+    {
+        flags |= PROTOCOL_FAULT_LOW;
+    }
+    if((sources & PWMPROTECT_SOURCE_FORCE) != 0U)
+    {
+        flags |= PROTOCOL_FAULT_FORCED;
+    }
+
+    payload[0] = (uint16_t)((base - EPWM1_BASE) / EPWM_BASE_STEP) + 1U;
+    payload[1] = flags;
+    Protocol_putUint16(&payload[2], faults);
+
+    SCIBuffer_write(frame, Protocol_encodeFrame(PROTOCOL_OP_FAULT, payload,
+                                                4U, frame));
 }
 
 //
-// updateCompare - Function to update the frequency
+// getISRProbe - Map an ePWM base to the probe of its ISR, NULL if the module
+// has no instrumented ISR
 //
-void updateCompare(epwmInformation *epwmInfo)
+ISRTiming_Probe *getISRProbe(uint32_t base)
 {
-    uint16_t compAValue;
-    uint16_t compBValue;
+    PWMChannel_State *channel = PWMChannel_find(base);
 
-    compAValue = EPWM_getCounterCompareValue(epwmInfo->epwmModule,
-                                             EPWM_COUNTER_COMPARE_A);
+    return((channel != NULL) ? &channel->probe : NULL);
+}
 
-    compBValue = EPWM_getCounterCompareValue(epwmInfo->epwmModule,
-                                             EPWM_COUNTER_COMPARE_B);
+//
+// sendISRStats - Report the count, minimum, maximum and mean of one ISR
+// measurement
+//
+void sendISRStats(uint32_t base, const ISRTiming_Probe *probe, uint16_t kind)
+{
+    uint16_t payload[18];
+    uint16_t frame[18U + PROTOCOL_OVERHEAD];
+    ISRTiming_Stats stats;
 
     //
-    //  Change the CMPA/CMPB values every 10th interrupt.
+    // The ISR updates the statistics; copy them in one piece
     //
-    if(epwmInfo->epwmTimerIntCount == 10U)
-    {
-        epwmInfo->epwmTimerIntCount = 0U;
+    DINT;
+    stats = (kind == PROTOCOL_ISR_DURATION) ? probe->duration :
+                                              probe->latency;
+    EINT;
 
-        //
-        // If we were increasing CMPA, check to see if we reached the max
-        // value.  If not, increase CMPA else, change directions and decrease
-        // CMPA
-        //
-        if(epwmInfo->epwmCompADirection == EPWM_CMP_UP)
-        {
-//            if(compAValue < (epwmInfo->epwmMaxCompA))
-//            {
-//                EPWM_setCounterCompareValue(epwmInfo->epwmModule,
-//                                            EPWM_COUNTER_COMPARE_A,
-//                                            ++compAValue);
-//            }
-//            else
-//            {
-//                epwmInfo->epwmCompADirection = EPWM_CMP_DOWN;
-//                EPWM_setCounterCompareValue(epwmInfo->epwmModule,
-//                                            EPWM_COUNTER_COMPARE_A,
-//                                            --compAValue);
-//            }
-        }
-        //
-        // If we were decreasing CMPA, check to see if we reached the min
-        // value.  If not, decrease CMPA else, change directions and increase
-        // CMPA
-        //
-        else
-        {
-//            if( compAValue == (epwmInfo->epwmMinCompA))
-//            {
-//                epwmInfo->epwmCompADirection = EPWM_CMP_UP;
-//                EPWM_setCounterCompareValue(epwmInfo->epwmModule,
-//                                            EPWM_COUNTER_COMPARE_A,
-//                                            ++compAValue);
-//            }
-//            else
-//            {
-//                EPWM_setCounterCompareValue(epwmInfo->epwmModule,
-//                                            EPWM_COUNTER_COMPARE_A,
-//                                            --compAValue);
-//            }
-        }
+    payload[0] = (uint16_t)((base - EPWM1_BASE) / EPWM_BASE_STEP) + 1U;
+    payload[1] = kind;
+    Protocol_putUint32(&payload[2], stats.count);
+    Protocol_putUint32(&payload[6], (stats.count != 0U) ? stats.min : 0U);
+    Protocol_putUint32(&payload[10], stats.max);
+    Protocol_putUint32(&payload[14], ISRTiming_getMean(&stats));
 
-        //
-        // If we were increasing CMPB, check to see if we reached the max
-        // value.  If not, increase CMPB else, change directions and decrease
-        // CMPB
-        //
-        if(epwmInfo->epwmCompBDirection == EPWM_CMP_UP)
-        {
-//            if(compBValue < (epwmInfo->epwmMaxCompB))
-//            {
-//                EPWM_setCounterCompareValue(epwmInfo->epwmModule,
-//                                            EPWM_COUNTER_COMPARE_B,
-//                                            ++compBValue);
-//            }
-//            else
-//            {
-//                epwmInfo->epwmCompBDirection = EPWM_CMP_DOWN;
-//                EPWM_setCounterCompareValue(epwmInfo->epwmModule,
-//                                            EPWM_COUNTER_COMPARE_B,
-//                                            --compBValue);
-//            }
-        }
-        //
-        // If we were decreasing CMPB, check to see if we reached the min
-        // value.  If not, decrease CMPB else, change directions and increase
-        // CMPB
-        //
-        else
-        {
-//            if(compBValue == (epwmInfo->epwmMinCompB))
-//            {
-//                epwmInfo->epwmCompBDirection = EPWM_CMP_UP;
-//                EPWM_setCounterCompareValue(epwmInfo->epwmModule,
-//                                            EPWM_COUNTER_COMPARE_B,
-//                                            ++compBValue);
-//            }
-//            else
-//            {
-//                EPWM_setCounterCompareValue(epwmInfo->epwmModule,
-//                                            EPWM_COUNTER_COMPARE_B,
-//                                            --compBValue);
-//            }
-        }
+    SCIBuffer_write(frame, Protocol_encodeFrame(PROTOCOL_OP_ISR_STATS,
+                                                payload, 18U, frame));
+}
+
+//
+// sendISRHistogram - Report the histogram bins of one ISR measurement from
+// bin 'first' on
+//
+void sendISRHistogram(uint32_t base, const ISRTiming_Probe *probe,
+                      uint16_t kind, uint16_t first)
+{
+    uint16_t payload[3U + (4U * PROTOCOL_ISR_BINS_PER_FRAME)];
+    uint16_t frame[3U + (4U * PROTOCOL_ISR_BINS_PER_FRAME) +
+                   PROTOCOL_OVERHEAD];
+    uint32_t bins[PROTOCOL_ISR_BINS_PER_FRAME];
+    const ISRTiming_Stats *stats;
+    uint16_t count;
+    uint16_t i;
+
+    stats = (kind == PROTOCOL_ISR_DURATION) ? &probe->duration :
+                                              &probe->latency;
+    count = ISRTIMING_BINS - first;
+    if(count > PROTOCOL_ISR_BINS_PER_FRAME)
+    {
+        count = PROTOCOL_ISR_BINS_PER_FRAME;
     }
-    else
+
+    DINT;
+    for(i = 0U; i < count; i++)
+    {
+        bins[i] = stats->histogram[first + i];
+    }
+    EINT;
+
+    payload[0] = (uint16_t)((base - EPWM1_BASE) / EPWM_BASE_STEP) + 1U;
+    payload[1] = kind;
+    payload[2] = first;
+    for(i = 0U; i < count; i++)
     {
-        epwmInfo->epwmTimerIntCount++;
+        Protocol_putUint32(&payload[3U + (4U * i)], bins[i]);
     }
+
+    SCIBuffer_write(frame, Protocol_encodeFrame(PROTOCOL_OP_ISR_HISTOGRAM,
+                                                payload, 3U + (4U * count),
+                                                frame));
 }
 
+//
+// serviceStatusStream - Send a status frame whenever the interval elapsed
+//
+void serviceStatusStream(void)
+{
+    uint32_t now;
+
+    if(streamInterval == 0U)
+    {
+        return;
+    }
+
+    //
+    // The time stamp timer counts down
+    //
+    now = CPUTimer_getTimerCount(TIMESTAMP_TIMER_BASE);
+    if((streamStamp - now) >= streamInterval)
+    {
+        streamStamp -= streamInterval;
+        sendStatus(streamBase);
+    }
+}
@@ -0,0 +1,146 @@
+//#############################################################################
+//
+// FILE:   pwm_channel.c
+//
+// TITLE:  Table-driven setup and interrupt dispatch of ePWM channels.
+//
+//#############################################################################
+
+//
+// Included Files
+//
+#include "pwm_channel.h"
+
+//
+// Globals
+//
+PWMChannel_State *PWMChannel_byModule[PWMCHANNEL_NUM_MODULES];
+
+//*****************************************************************************
+//
+// PWMChannel_initModule
+//
+// Writes the table entry of one module to its registers
+//
+//*****************************************************************************
+static void
+PWMChannel_initModule(const PWMChannel_Config *config)
+{
+    uint32_t base = config->base;
+
+    ASSERT((config->minCompare <= config->compareA) &&
+           (config->compareA <= config->maxCompare));
+    ASSERT((config->minCompare <= config->compareB) &&
+           (config->compareB <= config->maxCompare));
+    ASSERT(config->maxCompare <= config->period);
+
+    //
+    // Time base
+    //
+    EPWM_setTimeBasePeriod(base, config->period);
+    EPWM_setPhaseShift(base, 0U);
+    EPWM_setTimeBaseCounter(base, 0U);
+
+    //
+    // Compare values
+    //
+    EPWM_setCounterCompareValue(base, EPWM_COUNTER_COMPARE_A,
+                                config->compareA);
+    EPWM_setCounterCompareValue(base, EPWM_COUNTER_COMPARE_B,
+                                config->compareB);
+
+    //
+    // Counter mode
+    //
+    EPWM_setTimeBaseCounterMode(base, config->counterMode);
+    EPWM_disablePhaseShiftLoad(base);
+    EPWM_setClockPrescaler(base, config->clockDivider,
+                           config->highSpeedDivider);
+
+    //
+    // Shadowing
+    //
+    EPWM_setCounterCompareShadowLoadMode(base, EPWM_COUNTER_COMPARE_A,
+                                         config->compareLoad);
+    EPWM_setCounterCompareShadowLoadMode(base, EPWM_COUNTER_COMPARE_B,
+                                         config->compareLoad);
+
+    //
+    // Actions, all events of an output in one write
+    //
+    EPWM_setActionQualifierActionComplete(base, EPWM_AQ_OUTPUT_A,
+                        (EPWM_ActionQualifierEventAction)config->actionA);
+    EPWM_setActionQualifierActionComplete(base, EPWM_AQ_OUTPUT_B,
+                        (EPWM_ActionQualifierEventAction)config->actionB);
+
+    //
+    // Interrupt
+    //
+    EPWM_setInterruptSource(base, config->interruptSource);
+    EPWM_setInterruptEventCount(base, config->interruptCount);
+    if(config->interruptEnable)
+    {
+        EPWM_enableInterrupt(base);
+    }
+}
+
+//*****************************************************************************
+//
+// PWMChannel_init
+//
+//*****************************************************************************
+void
+PWMChannel_init(PWMChannel_State *states, const PWMChannel_Config *configs,
+                uint16_t numChannels)
+{
+    PWMChannel_State *state;
+    uint16_t index;
+    uint16_t i;
+
+    ASSERT(numChannels <= PWMCHANNEL_NUM_MODULES);
+
+    for(i = 0U; i < PWMCHANNEL_NUM_MODULES; i++)
+    {
+        PWMChannel_byModule[i] = NULL;
+    }
+
+    for(i = 0U; i < numChannels; i++)
+    {
+        state = &states[i];
+        index = PWMChannel_getIndex(configs[i].base);
+
+        ASSERT(EPWM_isBaseValid(configs[i].base));
+        ASSERT(PWMChannel_byModule[index] == NULL);
+
+        state->base = configs[i].base;
+        state->config = &configs[i];
+        PWMChannel_byModule[index] = state;
+
+        PWMChannel_initModule(&configs[i]);
+        PWMMod_initChannel(&state->modulation, state->base, NULL, 0U, 0U, 1U);
+        state->ramp.active = false;
+        ISRTiming_initProbe(&state->probe, state->base);
+    }
+}
+
+//*****************************************************************************
+//
+// PWMChannel_initRamps
+//
+//*****************************************************************************
+void
+PWMChannel_initRamps(PWMChannel_State *states, uint16_t numChannels,
+                     uint32_t periodStep, uint32_t compareStep)
+{
+    uint16_t i;
+
+    for(i = 0U; i < numChannels; i++)
+    {
+        if(states[i].config->rampRegisters != 0U)
+        {
+            PWMRamp_initChannel(&states[i].ramp, states[i].base,
+                                states[i].config->rampRegisters, periodStep,
+                                compareStep);
+        }
+    }
+}
@@ -0,0 +1,261 @@
+//#############################################################################
+//
+// FILE:   pwm_channel.h
+//
+// TITLE:  Table-driven setup and interrupt dispatch of ePWM channels.
+//
+//#############################################################################
+//
+// Each ePWM module the application drives is described by one constant
+// PWMChannel_Config entry: time base, start compare values and their
+// limits, shadow load event, action qualifier map and interrupt. A single
+// call of PWMChannel_init() sets all modules of a table up in the same
+// register order, so a module is added by adding a table entry, not code.
+//
+// The run-time state of a channel (compare modulation, setpoint ramp and
+// ISR timing probe) lives in a PWMChannel_State array parallel to the
+// table. All channels can share one ISR: on the C28x the PIE leaves the
+// address of the vector being fetched in PIECTRL, and
+// PWMChannel_getInterrupting() turns it into the state of the module that
+// raised the interrupt without any search.
+//
+// Features only some modules have, such as high-resolution edges, dead
+// time or DMA streaming, are set up by the application after
+// PWMChannel_init().
+//
+//#############################################################################
+
+#ifndef PWM_CHANNEL_H
+#define PWM_CHANNEL_H
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//
+// Included Files
+//
+#include <stdbool.h>
+#include <stdint.h>
+#include "driverlib.h"
+#include "pwm_modulation.h"
+#include "pwm_ramp.h"
+#include "isr_timing.h"
+
+//*****************************************************************************
+//
+// Number of ePWM modules on the device, ePWM1 to ePWM8
+//
+//*****************************************************************************
+#define PWMCHANNEL_NUM_MODULES  8U
+
+//*****************************************************************************
+//
+// Distance between the register frames, and between the PIE vector IDs, of
+// two ePWM modules
+//
+//*****************************************************************************
+#define PWMCHANNEL_BASE_STEP    (EPWM2_BASE - EPWM1_BASE)
+#define PWMCHANNEL_INT_STEP     (INT_EPWM2 - INT_EPWM1)
+#define PWMCHANNEL_EPWM1_VECTOR ((uint16_t)(INT_EPWM1 >> 16U))
+
+//*****************************************************************************
+//
+//! Set-up of one ePWM module.
+//
+//*****************************************************************************
+typedef struct
+{
+    uint32_t base;                          //!< ePWM base address
+    EPWM_TimeBaseCountMode counterMode;     //!< Up, down or up-down
+    EPWM_ClockDivider clockDivider;         //!< TBCLK prescaler
+    EPWM_HSClockDivider highSpeedDivider;   //!< TBCLK high-speed prescaler
+    uint16_t period;                        //!< TBPRD
+    uint16_t compareA;                      //!< CMPA at start
+    uint16_t compareB;                      //!< CMPB at start
+    uint16_t minCompare;                    //!< Lowest compare value in use
+    uint16_t maxCompare;                    //!< Highest compare value in use
+    EPWM_CounterCompareLoadMode compareLoad; //!< CMPA/CMPB shadow load event
+    uint16_t actionA;                       //!< EPWM_AQ_OUTPUT_* of output A
+    uint16_t actionB;                       //!< EPWM_AQ_OUTPUT_* of output B
+    uint16_t interruptSource;               //!< EPWM_INT_TBCTR_* event
+    uint16_t interruptCount;                //!< Events per interrupt, 1 to 3
+    bool interruptEnable;                   //!< Interrupt enabled at init
+    uint16_t rampRegisters;                 //!< PWMRAMP_* ramped, 0 for none
+} PWMChannel_Config;
+
+//*****************************************************************************
+//
+//! Run-time state of one ePWM module. Initialize with PWMChannel_init().
+//
+//*****************************************************************************
+typedef struct
+{
+    uint32_t base;                          //!< ePWM base address
+    const PWMChannel_Config *config;        //!< Table entry of the module
+    PWMMod_Channel modulation;              //!< Compare modulation
+    PWMRamp_Channel ramp;                   //!< Setpoint ramp
+    ISRTiming_Probe probe;                  //!< Timing of the ISR
+} PWMChannel_State;
+
+//*****************************************************************************
+//
+// State of each ePWM module by module number less one, NULL for modules
+// without a channel; set by PWMChannel_init()
+//
+//*****************************************************************************
+extern PWMChannel_State *PWMChannel_byModule[PWMCHANNEL_NUM_MODULES];
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+//*****************************************************************************
+//
+//! Sets up the ePWM modules of a channel table.
+//!
+//! \param states is the array of channel states, one per table entry.
+//! \param configs is the channel table.
+//! \param numChannels is the number of entries in both arrays.
+//!
+//! Writes the time base, compare values, shadow load modes, action
+//! qualifier and interrupt of every module and enables its interrupt if the
+//! table asks for it. Each channel starts with an idle compare modulation,
+//! an idle ramp and a cleared ISR probe.
+//!
+//! Call with the time-base clocks stopped.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+PWMChannel_init(PWMChannel_State *states, const PWMChannel_Config *configs,
+                uint16_t numChannels);
+
+//*****************************************************************************
+//
+//! Sets up the setpoint ramps of a channel table.
+//!
+//! \param states is the array of channel states.
+//! \param numChannels is the number of entries in \e states.
+//! \param periodStep is the largest period change per step in HR counts.
+//! \param compareStep is the largest compare change per step in HR counts.
+//!
+//! Initializes the ramp of every channel whose table entry has ramped
+//! registers. A ramp follows the high-resolution mode and interrupt enable
+//! of its module as it finds them, so call this once the modules are
+//! complete.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+PWMChannel_initRamps(PWMChannel_State *states, uint16_t numChannels,
+                     uint32_t periodStep, uint32_t compareStep);
+
+//*****************************************************************************
+//
+//! Returns the module number of an ePWM module less one.
+//!
+//! \param base is the base address of the ePWM module.
+//!
+//! \return Returns 0 for ePWM1 to 7 for ePWM8.
+//
+//*****************************************************************************
+static inline uint16_t
+PWMChannel_getIndex(uint32_t base)
+{
+    return((uint16_t)((base - EPWM1_BASE) / PWMCHANNEL_BASE_STEP));
+}
+
+//*****************************************************************************
+//
+//! Finds the channel of an ePWM module.
+//!
+//! \param base is the base address of an ePWM module.
+//!
+//! \return Returns the state of the channel, or NULL if the module has
+//! none.
+//
+//*****************************************************************************
+static inline PWMChannel_State *
+PWMChannel_find(uint32_t base)
+{
+    uint16_t index = PWMChannel_getIndex(base);
+
+    return((index < PWMCHANNEL_NUM_MODULES) ?
+           PWMChannel_byModule[index] : NULL);
+}
+
+//*****************************************************************************
+//
+//! Returns the setpoint ramp of an ePWM module.
+//!
+//! \param base is the base address of an ePWM module.
+//!
+//! \return Returns the ramp, or NULL if the module has no channel or its
+//! table entry has no ramped registers.
+//
+//*****************************************************************************
+static inline PWMRamp_Channel *
+PWMChannel_findRamp(uint32_t base)
+{
+    PWMChannel_State *state = PWMChannel_find(base);
+
+    return(((state != NULL) && (state->config->rampRegisters != 0U)) ?
+           &state->ramp : NULL);
+}
+
+//*****************************************************************************
+//
+//! Returns the PIE interrupt number of an ePWM module.
+//!
+//! \param base is the base address of the ePWM module.
+//!
+//! \return Returns the INT_EPWMx value to register the channel ISR with.
+//
+//*****************************************************************************
+static inline uint32_t
+PWMChannel_getInterruptNumber(uint32_t base)
+{
+    return(INT_EPWM1 + ((uint32_t)PWMChannel_getIndex(base) *
+                        PWMCHANNEL_INT_STEP));
+}
+
+//*****************************************************************************
+//
+//! Returns the channel whose interrupt is being serviced.
+//!
+//! Reads the vector address the PIE left in PIECTRL, so it must be called
+//! from an ISR registered with Interrupt_register() on the INT_EPWMx
+//! vector of a module with a channel, before interrupts are re-enabled.
+//!
+//! \return Returns the state of the interrupting channel.
+//
+//*****************************************************************************
+static inline PWMChannel_State *
+PWMChannel_getInterrupting(void)
+{
+    uint16_t vector = (HWREGH(PIECTRL_BASE + PIE_O_CTRL) & 0xFEU) >> 1U;
+
+    return(PWMChannel_byModule[vector - PWMCHANNEL_EPWM1_VECTOR]);
+}
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PWM_CHANNEL_H
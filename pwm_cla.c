@@ -0,0 +1,131 @@
+//#############################################################################
+//
+// FILE:   pwm_cla.c
+//
+// TITLE:  CLA-offloaded table-driven compare modulation.
+//
+//#############################################################################
+
+//
+// Included Files
+//
+#include <string.h>
+#include "pwm_cla.h"
+
+//
+// Defines
+//
+#define PWMCLA_EPWM_BASE_STEP   (EPWM2_BASE - EPWM1_BASE)
+#define PWMCLA_MSGRAM_SECTIONS  (MEMCFG_SECT_MSGCPUTOCLA1 |                   \
+                                 MEMCFG_SECT_MSGCLA1TOCPU)
+
+//
+// Shared variables, see pwm_cla_shared.h
+//
+#pragma DATA_SECTION(pwmClaParams, "CpuToCla1MsgRAM");
+#pragma DATA_SECTION(pwmClaInitChannel, "CpuToCla1MsgRAM");
+#pragma DATA_SECTION(pwmClaState, "Cla1ToCpuMsgRAM");
+#pragma DATA_SECTION(pwmClaTable, "Cla1DataRam");
+PWMCLA_Params pwmClaParams[PWMCLA_NUM_CHANNELS];
+uint16_t pwmClaInitChannel;
+PWMCLA_State pwmClaState[PWMCLA_NUM_CHANNELS];
+uint16_t pwmClaTable[PWMCLA_NUM_CHANNELS][PWMCLA_TABLE_LENGTH];
+
+#ifdef _FLASH
+//
+// CLA program load and run addresses, defined by the linker command file
+//
+extern uint16_t Cla1ProgLoadStart;
+extern uint16_t Cla1ProgLoadSize;
+extern uint16_t Cla1ProgRunStart;
+#endif
+
+//*****************************************************************************
+//
+// PWMCLA_init
+//
+//*****************************************************************************
+void
+PWMCLA_init(void)
+{
+#ifdef _FLASH
+    memcpy(&Cla1ProgRunStart, &Cla1ProgLoadStart, (size_t)&Cla1ProgLoadSize);
+#endif
+
+    MemCfg_initSections(PWMCLA_MSGRAM_SECTIONS);
+    while(!MemCfg_getInitStatus(PWMCLA_MSGRAM_SECTIONS))
+    {
+    }
+
+    MemCfg_setLSRAMMasterSel(MEMCFG_SECT_LS4, MEMCFG_LSRAMMASTER_CPU_CLA1);
+    MemCfg_setCLAMemType(MEMCFG_SECT_LS4, MEMCFG_CLA_MEM_PROGRAM);
+    MemCfg_setLSRAMMasterSel(MEMCFG_SECT_LS6, MEMCFG_LSRAMMASTER_CPU_CLA1);
+    MemCfg_setCLAMemType(MEMCFG_SECT_LS6, MEMCFG_CLA_MEM_DATA);
+
+#ifndef HOST_SIM
+    //
+    // The tasks are CLA object code, which host builds do not contain
+    //
+    CLA_mapTaskVector(CLA1_BASE, CLA_MVECT_1, (uint16_t)&Cla1Task1);
+    CLA_mapTaskVector(CLA1_BASE, CLA_MVECT_2, (uint16_t)&Cla1Task2);
+    CLA_mapTaskVector(CLA1_BASE, CLA_MVECT_8, (uint16_t)&Cla1Task8);
+#endif
+
+    CLA_enableIACK(CLA1_BASE);
+    CLA_enableTasks(CLA1_BASE, CLA_TASKFLAG_8);
+}
+
+//*****************************************************************************
+//
+// PWMCLA_initChannel
+//
+//*****************************************************************************
+void
+PWMCLA_initChannel(uint16_t channel, uint32_t base, const uint16_t *table,
+                   uint16_t length, uint16_t offsetB, uint16_t divider)
+{
+    uint16_t module = (uint16_t)((base - EPWM1_BASE) / PWMCLA_EPWM_BASE_STEP);
+    uint16_t taskFlag = CLA_TASKFLAG_1 << channel;
+
+    ASSERT(channel < PWMCLA_NUM_CHANNELS);
+    ASSERT((length != 0U) && (length <= PWMCLA_TABLE_LENGTH));
+    ASSERT(offsetB < length);
+    ASSERT(divider != 0U);
+
+    CLA_disableTasks(CLA1_BASE, taskFlag);
+
+    memcpy(pwmClaTable[channel], table, length * sizeof(table[0]));
+    pwmClaParams[channel].base = (uint16_t)base;
+    pwmClaParams[channel].length = length;
+    pwmClaParams[channel].offsetB = offsetB;
+    pwmClaParams[channel].divider = divider;
+
+    //
+    // Only the CLA may write its state, so task 8 resets it
+    //
+    pwmClaInitChannel = channel;
+    CLA_forceTasks(CLA1_BASE, CLA_TASKFLAG_8);
+    while(CLA_getPendingTaskFlag(CLA1_BASE, CLA_TASK_8) ||
+          CLA_getTaskRunStatus(CLA1_BASE, CLA_TASK_8))
+    {
+    }
+
+    CLA_setTriggerSource((CLA_TaskNumber)((uint16_t)CLA_TASK_1 + channel),
+                         (CLA_Trigger)((uint16_t)CLA_TRIGGER_EPWM1INT +
+                                       module));
+    CLA_clearTaskFlags(CLA1_BASE, taskFlag);
+    CLA_enableTasks(CLA1_BASE, taskFlag);
+}
+
+//*****************************************************************************
+//
+// PWMCLA_getState
+//
+//*****************************************************************************
+const volatile PWMCLA_State *
+PWMCLA_getState(uint16_t channel)
+{
+    ASSERT(channel < PWMCLA_NUM_CHANNELS);
+
+    return(&pwmClaState[channel]);
+}
@@ -0,0 +1,111 @@
+//#############################################################################
+//
+// FILE:   pwm_cla.h
+//
+// TITLE:  CLA-offloaded table-driven compare modulation.
+//
+//#############################################################################
+//
+// Runs the work of PWMMod_step() as CLA tasks triggered directly by the ePWM
+// interrupts, so the C28x takes no interrupt for the modulation. The CLA
+// clears the ePWM interrupt flag itself; the PIE interrupt of the module
+// must stay disabled.
+//
+// LS4 RAM becomes CLA program memory and LS6 RAM CLA data memory, matching
+// the Cla1Prog and Cla1DataRam sections of the linker command files.
+//
+// The host simulator has no CLA. HOST_SIM builds set the memories and
+// channels up but map no task vectors, so the tasks never run there.
+//
+//#############################################################################
+
+#ifndef PWM_CLA_H
+#define PWM_CLA_H
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//
+// Included Files
+//
+#include <stdbool.h>
+#include <stdint.h>
+#include "driverlib.h"
+#include "pwm_cla_shared.h"
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+//*****************************************************************************
+//
+//! Hands the CLA its memory and task vectors.
+//!
+//! Copies the CLA program to LS4 RAM in flash builds, initializes the message
+//! RAMs and maps tasks 1, 2 and 8. Call once before PWMCLA_initChannel().
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+PWMCLA_init(void);
+
+//*****************************************************************************
+//
+//! Starts modulating an ePWM module from a CLA task.
+//!
+//! \param channel is the channel, less than PWMCLA_NUM_CHANNELS. Channel N
+//! runs as CLA task N + 1.
+//! \param base is the base address of the ePWM module.
+//! \param table is the table of compare values, copied to CLA data RAM.
+//! \param length is the number of entries in \e table, at most
+//! PWMCLA_TABLE_LENGTH.
+//! \param offsetB is the number of entries CMPB leads CMPA by, less than
+//! \e length.
+//! \param divider is the number of interrupts per table entry, at least 1.
+//!
+//! Plays the same sequence as a PWMMod_Channel with the same arguments. The
+//! ePWM interrupt of the module becomes the task trigger; its event source
+//! and count must be configured and the interrupt enabled in the ePWM.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+PWMCLA_initChannel(uint16_t channel, uint32_t base, const uint16_t *table,
+                   uint16_t length, uint16_t offsetB, uint16_t divider);
+
+//*****************************************************************************
+//
+//! Returns the state of a channel.
+//!
+//! \param channel is the channel.
+//!
+//! The state, including the counter-zero to compare write latency, is
+//! updated by the CLA and may change between two reads of its members.
+//!
+//! \return Returns a pointer to the state in CLA-to-CPU message RAM.
+//
+//*****************************************************************************
+extern const volatile PWMCLA_State *
+PWMCLA_getState(uint16_t channel);
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PWM_CLA_H
@@ -0,0 +1,107 @@
+//#############################################################################
+//
+// FILE:   pwm_cla_shared.h
+//
+// TITLE:  Data shared between the C28x and the CLA compare modulation tasks.
+//
+//#############################################################################
+//
+// Included by both pwm_cla.c (C28x) and pwm_cla_tasks.cla (CLA), so it only
+// uses types both compilers lay out the same way: no pointers and 32-bit
+// members first.
+//
+// CLA task N modulates channel N - 1. The C28x owns the parameters in the
+// CPU-to-CLA message RAM and the tables in CLA data RAM; the CLA owns the
+// channel state in the CLA-to-CPU message RAM, which the C28x only reads.
+//
+//#############################################################################
+
+#ifndef PWM_CLA_SHARED_H
+#define PWM_CLA_SHARED_H
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//
+// Included Files
+//
+#include <stdint.h>
+
+//*****************************************************************************
+//
+// Number of channels, one CLA task each, and the capacity of their tables.
+// Task 8 is reserved for initialization.
+//
+//*****************************************************************************
+#define PWMCLA_NUM_CHANNELS     2U
+#define PWMCLA_TABLE_LENGTH     256U
+
+//*****************************************************************************
+//
+//! Parameters of one channel, written by the C28x.
+//
+//*****************************************************************************
+typedef struct
+{
+    uint16_t base;              //!< ePWM base address
+    uint16_t length;            //!< Number of entries in the table
+    uint16_t offsetB;           //!< Entries CMPB leads CMPA by
+    uint16_t divider;           //!< Interrupts per table entry
+} PWMCLA_Params;
+
+//*****************************************************************************
+//
+//! State of one channel, written by the CLA.
+//!
+//! The latencies are time-base counts from the counter-zero event that
+//! triggered the task to the compare write. They assume the counter counts
+//! up after zero, which holds in up and up-down count modes.
+//
+//*****************************************************************************
+typedef struct
+{
+    uint32_t runs;              //!< Compare writes since initialization
+    uint16_t indexA;            //!< Next CMPA entry
+    uint16_t indexB;            //!< Next CMPB entry
+    uint16_t count;             //!< Interrupts since the last entry
+    uint16_t latency;           //!< Latency of the most recent write
+    uint16_t maxLatency;        //!< Largest latency seen
+} PWMCLA_State;
+
+//*****************************************************************************
+//
+// Shared variables, defined in pwm_cla.c
+//
+//*****************************************************************************
+extern PWMCLA_Params pwmClaParams[PWMCLA_NUM_CHANNELS];
+extern uint16_t pwmClaInitChannel;
+extern PWMCLA_State pwmClaState[PWMCLA_NUM_CHANNELS];
+extern uint16_t pwmClaTable[PWMCLA_NUM_CHANNELS][PWMCLA_TABLE_LENGTH];
+
+//*****************************************************************************
+//
+// CLA tasks, defined in pwm_cla_tasks.cla
+//
+//*****************************************************************************
+__interrupt void Cla1Task1(void);
+__interrupt void Cla1Task2(void);
+__interrupt void Cla1Task8(void);
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PWM_CLA_SHARED_H
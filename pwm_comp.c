@@ -0,0 +1,281 @@
+//#############################################################################
+//
+// FILE:   pwm_comp.c
+//
+// TITLE:  Fixed-point PI and 2P2Z/3P3Z compensators.
+//
+//#############################################################################
+
+//
+// Included Files
+//
+#include "pwm_comp.h"
+#include "debug.h"
+
+#ifndef __cplusplus
+#pragma CODE_SECTION(PWMComp_runPI, ".TI.ramfunc");
+#pragma CODE_SECTION(PWMComp_run2P2Z, ".TI.ramfunc");
+#pragma CODE_SECTION(PWMComp_run3P3Z, ".TI.ramfunc");
+#endif
+
+//
+// Rounding constant of a Q16 sum
+//
+#define PWMCOMP_HALF            ((int64_t)1 << (PWMCOMP_Q - 1U))
+
+//*****************************************************************************
+//
+// PWMComp_limit
+//
+// Limits a Q16 sum, rounded to nearest, to min .. max
+//
+//*****************************************************************************
+static inline int32_t
+PWMComp_limit(int64_t sum, int32_t min, int32_t max)
+{
+    sum = (sum + PWMCOMP_HALF) >> PWMCOMP_Q;
+
+    if(sum < (int64_t)min)
+    {
+        return(min);
+    }
+    else if(sum > (int64_t)max)
+    {
+        return(max);
+    }
+
+    return((int32_t)sum);
+}
+
+//*****************************************************************************
+//
+// PWMComp_toQ16
+//
+// Scales an output value to a Q16 sum. A multiply, as shifting a negative
+// value left is undefined.
+//
+//*****************************************************************************
+static inline int64_t
+PWMComp_toQ16(int32_t value)
+{
+    return((int64_t)value * PWMCOMP_ONE);
+}
+
+//*****************************************************************************
+//
+// PWMComp_clamp
+//
+//*****************************************************************************
+static inline int32_t
+PWMComp_clamp(int32_t value, int32_t min, int32_t max)
+{
+    if(value < min)
+    {
+        return(min);
+    }
+    else if(value > max)
+    {
+        return(max);
+    }
+
+    return(value);
+}
+
+//*****************************************************************************
+//
+// PWMComp_initPI
+//
+//*****************************************************************************
+void
+PWMComp_initPI(PWMComp_PI *pi, int32_t kp, int32_t ki, int32_t min,
+               int32_t max)
+{
+    ASSERT(min <= max);
+
+    pi->kp = kp;
+    pi->ki = ki;
+    pi->min = min;
+    pi->max = max;
+    pi->integral = PWMComp_toQ16(min);
+}
+
+//*****************************************************************************
+//
+// PWMComp_setPILimits
+//
+//*****************************************************************************
+void
+PWMComp_setPILimits(PWMComp_PI *pi, int32_t min, int32_t max)
+{
+    ASSERT(min <= max);
+
+    pi->min = min;
+    pi->max = max;
+    if(pi->integral < PWMComp_toQ16(min))
+    {
+        pi->integral = PWMComp_toQ16(min);
+    }
+    else if(pi->integral > PWMComp_toQ16(max))
+    {
+        pi->integral = PWMComp_toQ16(max);
+    }
+}
+
+//*****************************************************************************
+//
+// PWMComp_resetPI
+//
+//*****************************************************************************
+void
+PWMComp_resetPI(PWMComp_PI *pi, int32_t output)
+{
+    pi->integral = PWMComp_toQ16(PWMComp_clamp(output, pi->min, pi->max));
+}
+
+//*****************************************************************************
+//
+// PWMComp_runPI
+//
+//*****************************************************************************
+int32_t
+PWMComp_runPI(PWMComp_PI *pi, int32_t error)
+{
+    int64_t integral;
+    int32_t output;
+
+    integral = pi->integral + ((int64_t)pi->ki * error);
+    if(integral < PWMComp_toQ16(pi->min))
+    {
+        integral = PWMComp_toQ16(pi->min);
+    }
+    else if(integral > PWMComp_toQ16(pi->max))
+    {
+        integral = PWMComp_toQ16(pi->max);
+    }
+
+    output = PWMComp_limit(integral + ((int64_t)pi->kp * error), pi->min,
+                           pi->max);
+
+    //
+    // Hold the integrator while the output is pinned at the limit it is
+    // moving towards
+    //
+    if(((output == pi->max) && (integral > pi->integral)) ||
+       ((output == pi->min) && (integral < pi->integral)))
+    {
+        return(output);
+    }
+
+    pi->integral = integral;
+
+    return(output);
+}
+
+//*****************************************************************************
+//
+// PWMComp_initFilter
+//
+//*****************************************************************************
+void
+PWMComp_initFilter(PWMComp_Filter *filter, const PWMComp_Coeffs *coeffs,
+                   int32_t min, int32_t max)
+{
+    ASSERT(min <= max);
+
+    filter->coeffs = *coeffs;
+    filter->min = min;
+    filter->max = max;
+
+    PWMComp_resetFilter(filter, min);
+}
+
+//*****************************************************************************
+//
+// PWMComp_setFilterLimits
+//
+//*****************************************************************************
+void
+PWMComp_setFilterLimits(PWMComp_Filter *filter, int32_t min, int32_t max)
+{
+    ASSERT(min <= max);
+
+    filter->min = min;
+    filter->max = max;
+    filter->u1 = PWMComp_clamp(filter->u1, min, max);
+    filter->u2 = PWMComp_clamp(filter->u2, min, max);
+    filter->u3 = PWMComp_clamp(filter->u3, min, max);
+}
+
+//*****************************************************************************
+//
+// PWMComp_resetFilter
+//
+//*****************************************************************************
+void
+PWMComp_resetFilter(PWMComp_Filter *filter, int32_t output)
+{
+    output = PWMComp_clamp(output, filter->min, filter->max);
+
+    filter->e1 = 0;
+    filter->e2 = 0;
+    filter->e3 = 0;
+    filter->u1 = output;
+    filter->u2 = output;
+    filter->u3 = output;
+}
+
+//*****************************************************************************
+//
+// PWMComp_run2P2Z
+//
+//*****************************************************************************
+int32_t
+PWMComp_run2P2Z(PWMComp_Filter *filter, int32_t error)
+{
+    const PWMComp_Coeffs *coeffs = &filter->coeffs;
+    int32_t output;
+
+    output = PWMComp_limit(((int64_t)coeffs->b0 * error) +
+                           ((int64_t)coeffs->b1 * filter->e1) +
+                           ((int64_t)coeffs->b2 * filter->e2) +
+                           ((int64_t)coeffs->a1 * filter->u1) +
+                           ((int64_t)coeffs->a2 * filter->u2),
+                           filter->min, filter->max);
+
+    filter->e2 = filter->e1;
+    filter->e1 = error;
+    filter->u2 = filter->u1;
+    filter->u1 = output;
+
+    return(output);
+}
+
+//*****************************************************************************
+//
+// PWMComp_run3P3Z
+//
+//*****************************************************************************
+int32_t
+PWMComp_run3P3Z(PWMComp_Filter *filter, int32_t error)
+{
+    const PWMComp_Coeffs *coeffs = &filter->coeffs;
+    int32_t output;
+
+    output = PWMComp_limit(((int64_t)coeffs->b0 * error) +
+                           ((int64_t)coeffs->b1 * filter->e1) +
+                           ((int64_t)coeffs->b2 * filter->e2) +
+                           ((int64_t)coeffs->b3 * filter->e3) +
+                           ((int64_t)coeffs->a1 * filter->u1) +
+                           ((int64_t)coeffs->a2 * filter->u2) +
+                           ((int64_t)coeffs->a3 * filter->u3),
+                           filter->min, filter->max);
+
+    filter->e3 = filter->e2;
+    filter->e2 = filter->e1;
+    filter->e1 = error;
+    filter->u3 = filter->u2;
+    filter->u2 = filter->u1;
+    filter->u1 = output;
+
+    return(output);
+}
@@ -0,0 +1,297 @@
+//#############################################################################
+//
+// FILE:   pwm_comp.h
+//
+// TITLE:  Fixed-point PI and 2P2Z/3P3Z compensators.
+//
+//#############################################################################
+//
+// Discrete compensators for regulating a compare value against a feedback
+// signal. The input is the error, reference minus feedback, in the units of
+// the feedback (ADC counts, for example); the output is in the units of the
+// actuator (HR counts for the compare values of pwm_hr.h) and is always
+// limited to a range given at initialization.
+//
+// Gains and coefficients are signed Q16 values in an int32_t, so they cover
+// -32768.0 to +32767.99998 with a resolution of 1/65536. Use PWMCOMP_Q16()
+// to convert constants. Each product is formed in 64 bits and the sum is
+// rounded once, so no intermediate result overflows for errors and outputs
+// of up to 24 bits.
+//
+// The PI compensator is in parallel form:
+//
+//   u(n) = Kp * e(n) + i(n),   i(n) = i(n-1) + Ki * e(n)
+//
+// Its integrator keeps the Q16 fraction, so small errors still integrate.
+// The integrator stays within the output range, and it stops integrating
+// while the output is saturated in the direction the error is pushing it
+// (conditional integration), so the output leaves the limit as soon as the
+// error changes sign.
+//
+// The 2P2Z and 3P3Z compensators are direct form I filters:
+//
+//   u(n) = b0 e(n) + b1 e(n-1) + b2 e(n-2) + b3 e(n-3)
+//        + a1 u(n-1) + a2 u(n-2) + a3 u(n-3)
+//
+// with b3 and a3 unused by the 2P2Z. The output history holds the limited
+// outputs, which keeps a compensator with an integrator (a1 + a2 + a3 = 1)
+// from winding up. The history is kept in whole output units, so each step
+// rounds the state by up to half a unit; with HR counts as the output that
+// is 1/512 of a TBCLK.
+//
+// A step is a fixed sequence of 32 x 32 bit multiply-accumulates into a
+// 64-bit sum, 2 for the PI, 5 for the 2P2Z and 7 for the 3P3Z, with no
+// loops and no division, and runs from RAM in the flash builds. This keeps
+// a control ISR built around it under a microsecond on the C28x. The CLA
+// has no 64-bit integer arithmetic; a CLA task would use a floating-point
+// port of the same structure.
+//
+//#############################################################################
+
+#ifndef PWM_COMP_H
+#define PWM_COMP_H
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//
+// Included Files
+//
+#include <stdint.h>
+
+//*****************************************************************************
+//
+// Q16 gain and coefficient scale
+//
+//*****************************************************************************
+#define PWMCOMP_Q               16U
+#define PWMCOMP_ONE             ((int32_t)1 << PWMCOMP_Q)
+
+//*****************************************************************************
+//
+//! Converts a constant gain or coefficient to Q16, rounded to nearest.
+//!
+//! Intended for compile-time constants only, where the compiler folds the
+//! floating-point expression away.
+//
+//*****************************************************************************
+#define PWMCOMP_Q16(value)                                                    \
+    ((int32_t)(((value) * (float)PWMCOMP_ONE) +                               \
+               (((value) < 0.0F) ? -0.5F : 0.5F)))
+
+//*****************************************************************************
+//
+//! State of a PI compensator. Initialize with PWMComp_initPI().
+//
+//*****************************************************************************
+typedef struct
+{
+    int32_t kp;                 //!< Proportional gain, Q16
+    int32_t ki;                 //!< Integral gain per step, Q16
+    int32_t min;                //!< Lowest output
+    int32_t max;                //!< Highest output
+    int64_t integral;           //!< Integrator, Q16, within min .. max
+} PWMComp_PI;
+
+//*****************************************************************************
+//
+//! Coefficients of a 2P2Z or 3P3Z compensator, Q16. The 2P2Z ignores b3
+//! and a3.
+//
+//*****************************************************************************
+typedef struct
+{
+    int32_t b0;                 //!< Coefficient of e(n)
+    int32_t b1;                 //!< Coefficient of e(n-1)
+    int32_t b2;                 //!< Coefficient of e(n-2)
+    int32_t b3;                 //!< Coefficient of e(n-3)
+    int32_t a1;                 //!< Coefficient of u(n-1)
+    int32_t a2;                 //!< Coefficient of u(n-2)
+    int32_t a3;                 //!< Coefficient of u(n-3)
+} PWMComp_Coeffs;
+
+//*****************************************************************************
+//
+//! State of a 2P2Z or 3P3Z compensator. Initialize with
+//! PWMComp_initFilter().
+//
+//*****************************************************************************
+typedef struct
+{
+    PWMComp_Coeffs coeffs;      //!< Coefficients
+    int32_t min;                //!< Lowest output
+    int32_t max;                //!< Highest output
+    int32_t e1;                 //!< e(n-1)
+    int32_t e2;                 //!< e(n-2)
+    int32_t e3;                 //!< e(n-3)
+    int32_t u1;                 //!< u(n-1), limited
+    int32_t u2;                 //!< u(n-2), limited
+    int32_t u3;                 //!< u(n-3), limited
+} PWMComp_Filter;
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+//*****************************************************************************
+//
+//! Initializes a PI compensator.
+//!
+//! \param pi is the compensator.
+//! \param kp is the proportional gain in Q16.
+//! \param ki is the integral gain per step in Q16.
+//! \param min is the lowest output.
+//! \param max is the highest output, not below \e min.
+//!
+//! The integrator starts at \e min; call PWMComp_resetPI() to start from
+//! another output.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+PWMComp_initPI(PWMComp_PI *pi, int32_t kp, int32_t ki, int32_t min,
+               int32_t max);
+
+//*****************************************************************************
+//
+//! Changes the output range of a PI compensator.
+//!
+//! \param pi is the compensator.
+//! \param min is the lowest output.
+//! \param max is the highest output, not below \e min.
+//!
+//! The integrator is moved into the new range.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+PWMComp_setPILimits(PWMComp_PI *pi, int32_t min, int32_t max);
+
+//*****************************************************************************
+//
+//! Presets a PI compensator for a bumpless start.
+//!
+//! \param pi is the compensator.
+//! \param output is the output to continue from, normally the one the
+//! actuator runs with.
+//!
+//! With zero error the next step returns \e output limited to the range.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+PWMComp_resetPI(PWMComp_PI *pi, int32_t output);
+
+//*****************************************************************************
+//
+//! Runs one step of a PI compensator.
+//!
+//! \param pi is the compensator.
+//! \param error is the error, reference minus feedback.
+//!
+//! \return Returns the output, within the output range.
+//
+//*****************************************************************************
+extern int32_t
+PWMComp_runPI(PWMComp_PI *pi, int32_t error);
+
+//*****************************************************************************
+//
+//! Initializes a 2P2Z or 3P3Z compensator.
+//!
+//! \param filter is the compensator.
+//! \param coeffs is the set of coefficients; it is copied.
+//! \param min is the lowest output.
+//! \param max is the highest output, not below \e min.
+//!
+//! The history starts with zero error and the output at \e min; call
+//! PWMComp_resetFilter() to start from another output.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+PWMComp_initFilter(PWMComp_Filter *filter, const PWMComp_Coeffs *coeffs,
+                   int32_t min, int32_t max);
+
+//*****************************************************************************
+//
+//! Changes the output range of a 2P2Z or 3P3Z compensator.
+//!
+//! \param filter is the compensator.
+//! \param min is the lowest output.
+//! \param max is the highest output, not below \e min.
+//!
+//! The output history is moved into the new range.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+PWMComp_setFilterLimits(PWMComp_Filter *filter, int32_t min, int32_t max);
+
+//*****************************************************************************
+//
+//! Presets a 2P2Z or 3P3Z compensator for a bumpless start.
+//!
+//! \param filter is the compensator.
+//! \param output is the output to continue from.
+//!
+//! Clears the error history and fills the output history with \e output
+//! limited to the range. A compensator with an integrator then continues
+//! from \e output.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+PWMComp_resetFilter(PWMComp_Filter *filter, int32_t output);
+
+//*****************************************************************************
+//
+//! Runs one step of a 2P2Z compensator.
+//!
+//! \param filter is the compensator.
+//! \param error is the error, reference minus feedback.
+//!
+//! \return Returns the output, within the output range.
+//
+//*****************************************************************************
+extern int32_t
+PWMComp_run2P2Z(PWMComp_Filter *filter, int32_t error);
+
+//*****************************************************************************
+//
+//! Runs one step of a 3P3Z compensator.
+//!
+//! \param filter is the compensator.
+//! \param error is the error, reference minus feedback.
+//!
+//! \return Returns the output, within the output range.
+//
+//*****************************************************************************
+extern int32_t
+PWMComp_run3P3Z(PWMComp_Filter *filter, int32_t error);
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PWM_COMP_H
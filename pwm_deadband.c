@@ -0,0 +1,124 @@
+//#############################################################################
+//
+// FILE:   pwm_deadband.c
+//
+// TITLE:  Complementary outputs with dead time from the dead-band submodule.
+//
+//#############################################################################
+
+//
+// Included Files
+//
+#include "pwm_deadband.h"
+#include "pwm_hr.h"
+
+//
+// Rounds an HR count to half counts, the step of the dead-band counter
+//
+#define PWMDEADBAND_HALF_ONE    (PWMHR_COUNT_ONE / 2U)
+#define PWMDEADBAND_ROUND(delay)                                              \
+    (((delay) + (PWMDEADBAND_HALF_ONE / 2U)) & ~(PWMDEADBAND_HALF_ONE - 1U))
+
+#define PWMDEADBAND_NS_PER_S    1000000000UL
+
+//*****************************************************************************
+//
+// PWMDeadband_init
+//
+//*****************************************************************************
+void
+PWMDeadband_init(uint32_t base)
+{
+    //
+    // Active-high complementary: ePWMxA delayed on its rising edge, ePWMxB
+    // its inverse delayed on its own rising edge
+    //
+    EPWM_setRisingEdgeDeadBandDelayInput(base, EPWM_DB_INPUT_EPWMA);
+    EPWM_setFallingEdgeDeadBandDelayInput(base, EPWM_DB_INPUT_EPWMA);
+    EPWM_setDeadBandDelayPolarity(base, EPWM_DB_RED,
+                                  EPWM_DB_POLARITY_ACTIVE_HIGH);
+    EPWM_setDeadBandDelayPolarity(base, EPWM_DB_FED,
+                                  EPWM_DB_POLARITY_ACTIVE_LOW);
+    PWMDeadband_disable(base);
+
+    //
+    // Half-count steps; the MEP needs them for high-resolution delays
+    //
+    EPWM_setDeadBandCounterClock(base, EPWM_DB_COUNTER_CLOCK_HALF_CYCLE);
+    EPWM_setRisingEdgeDelayCountShadowLoadMode(base,
+                                               EPWM_RED_LOAD_ON_CNTR_ZERO);
+    EPWM_setFallingEdgeDelayCountShadowLoadMode(base,
+                                                EPWM_FED_LOAD_ON_CNTR_ZERO);
+    HRPWM_setRisingEdgeDelayLoadMode(base, HRPWM_LOAD_ON_CNTR_ZERO);
+    HRPWM_setFallingEdgeDelayLoadMode(base, HRPWM_LOAD_ON_CNTR_ZERO);
+
+    PWMDeadband_setDelay(base, 0U, 0U, false);
+}
+
+//*****************************************************************************
+//
+// PWMDeadband_nsToDelay
+//
+//*****************************************************************************
+uint32_t
+PWMDeadband_nsToDelay(uint32_t clockFreq, uint32_t ns)
+{
+    return((uint32_t)((((uint64_t)ns * clockFreq << PWMHR_COUNT_S) +
+                       (PWMDEADBAND_NS_PER_S / 2U)) / PWMDEADBAND_NS_PER_S));
+}
+
+//*****************************************************************************
+//
+// PWMDeadband_setDelay
+//
+//*****************************************************************************
+void
+PWMDeadband_setDelay(uint32_t base, uint32_t rising, uint32_t falling,
+                     bool highResolution)
+{
+    ASSERT((rising <= PWMDEADBAND_DELAY_MAX) &&
+           (falling <= PWMDEADBAND_DELAY_MAX));
+    ASSERT(!highResolution ||
+           ((HWREGH(base + HRPWM_O_HRCNFG) & HRPWM_HRCNFG_AUTOCONV) != 0U));
+
+    if(!highResolution)
+    {
+        rising = PWMDEADBAND_ROUND(rising);
+        falling = PWMDEADBAND_ROUND(falling);
+    }
+
+    //
+    // DBRED:DBREDHR hold half counts with a 7-bit fraction, which is the HR
+    // count itself; one write per delay, so a zero load never sees half of
+    // a change
+    //
+    HRPWM_setRisingEdgeDelay(base, rising);
+    HRPWM_setFallingEdgeDelay(base, falling);
+    HRPWM_setDeadbandMEPEdgeSelect(base, highResolution ?
+                                         HRPWM_DB_MEP_CTRL_RED_FED :
+                                         HRPWM_DB_MEP_CTRL_DISABLE);
+}
+
+//*****************************************************************************
+//
+// PWMDeadband_enable
+//
+//*****************************************************************************
+void
+PWMDeadband_enable(uint32_t base)
+{
+    EPWM_setDeadBandDelayMode(base, EPWM_DB_RED, true);
+    EPWM_setDeadBandDelayMode(base, EPWM_DB_FED, true);
+}
+
+//*****************************************************************************
+//
+// PWMDeadband_disable
+//
+//*****************************************************************************
+void
+PWMDeadband_disable(uint32_t base)
+{
+    EPWM_setDeadBandDelayMode(base, EPWM_DB_RED, false);
+    EPWM_setDeadBandDelayMode(base, EPWM_DB_FED, false);
+}
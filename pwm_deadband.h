@@ -0,0 +1,171 @@
+//#############################################################################
+//
+// FILE:   pwm_deadband.h
+//
+// TITLE:  Complementary outputs with dead time from the dead-band submodule.
+//
+//#############################################################################
+//
+// A half bridge driven from ePWMxA and ePWMxB must never have both switches
+// on: while one turns off the other has to wait for it. In complementary
+// mode both outputs come from the action qualifier output A. The dead-band
+// submodule delays its rising edge on ePWMxA by the rising-edge delay (RED)
+// and drives ePWMxB with its inverse, delaying the rising edge of ePWMxB by
+// the falling-edge delay (FED). Each output therefore turns on only a fixed
+// time after the other turned off, whatever the compare values are, and
+// the action qualifier settings of output B are no longer used.
+//
+// Delays are in HR counts, the 16.8 fixed-point TBCLK counts of pwm_hr.h.
+// The dead-band counter is clocked on both TBCLK edges, so without high
+// resolution a delay is rounded to half a count, 5 ns at 100 MHz; with it
+// the MEP places the delayed edges to the same 1/256 count as the compare
+// edges. PWMDeadband_nsToDelay() converts a time in ns.
+//
+// Delays load from their shadows on counter zero, so changes at run time
+// take effect between two periods and never shorten a pulse already under
+// way. A pulse on output A shorter than RED, or a gap shorter than FED, is
+// swallowed completely.
+//
+//#############################################################################
+
+#ifndef PWM_DEADBAND_H
+#define PWM_DEADBAND_H
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//
+// Included Files
+//
+#include <stdbool.h>
+#include <stdint.h>
+#include "driverlib.h"
+
+//*****************************************************************************
+//
+// Longest delay in HR counts: 14 bits of half counts
+//
+//*****************************************************************************
+#define PWMDEADBAND_DELAY_MAX   0x1FFF80UL
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+//*****************************************************************************
+//
+//! Sets up complementary outputs with dead time on an ePWM module.
+//!
+//! \param base is the base address of the ePWM module.
+//!
+//! Selects output A as the input of both delays, active high on ePWMxA and
+//! active low on ePWMxB, clocks the dead-band counter on both TBCLK edges
+//! and loads the delays on counter zero. The delays start at zero and
+//! the submodule bypassed, so the outputs follow the action qualifier until
+//! PWMDeadband_enable().
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+PWMDeadband_init(uint32_t base);
+
+//*****************************************************************************
+//
+//! Converts a time to a dead-band delay.
+//!
+//! \param clockFreq is the TBCLK frequency in Hz.
+//! \param ns is the time in ns.
+//!
+//! \return Returns the delay in HR counts, rounded to the nearest 1/256
+//! count.
+//
+//*****************************************************************************
+extern uint32_t
+PWMDeadband_nsToDelay(uint32_t clockFreq, uint32_t ns);
+
+//*****************************************************************************
+//
+//! Sets the dead time of a module.
+//!
+//! \param base is the base address of the ePWM module.
+//! \param rising is the delay of the rising edge of ePWMxA in HR counts, at
+//! most \b PWMDEADBAND_DELAY_MAX.
+//! \param falling is the delay of the rising edge of ePWMxB in HR counts, at
+//! most \b PWMDEADBAND_DELAY_MAX.
+//! \param highResolution places the delayed edges with the MEP instead of
+//! rounding the delays to half counts. The module must be set up with
+//! PWMHR_init().
+//!
+//! The new delays load on the next counter zero.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+PWMDeadband_setDelay(uint32_t base, uint32_t rising, uint32_t falling,
+                     bool highResolution);
+
+//*****************************************************************************
+//
+//! Switches a module to complementary outputs.
+//!
+//! \param base is the base address of the ePWM module.
+//!
+//! Takes effect at once; set the delays first.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+PWMDeadband_enable(uint32_t base);
+
+//*****************************************************************************
+//
+//! Returns a module to the action qualifier outputs.
+//!
+//! \param base is the base address of the ePWM module.
+//!
+//! Takes effect at once. The delays are kept.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+PWMDeadband_disable(uint32_t base);
+
+//*****************************************************************************
+//
+//! Returns whether a module has complementary outputs.
+//!
+//! \param base is the base address of the ePWM module.
+//!
+//! \return Returns \b true after PWMDeadband_enable().
+//
+//*****************************************************************************
+static inline bool
+PWMDeadband_isEnabled(uint32_t base)
+{
+    return((HWREGH(base + EPWM_O_DBCTL) & EPWM_DBCTL_OUT_MODE_M) ==
+           EPWM_DBCTL_OUT_MODE_M);
+}
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PWM_DEADBAND_H
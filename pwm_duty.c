@@ -0,0 +1,59 @@
+//#############################################################################
+//
+// FILE:   pwm_duty.c
+//
+// TITLE:  Fixed-point duty cycle and compare count conversion.
+//
+//#############################################################################
+
+//
+// Included Files
+//
+#include "pwm_duty.h"
+
+//*****************************************************************************
+//
+// PWMDuty_step
+//
+//*****************************************************************************
+uint16_t
+PWMDuty_step(uint16_t duty, int16_t step, uint16_t minDuty, uint16_t maxDuty)
+{
+    int32_t next = (int32_t)duty + step;
+
+    if(next < (int32_t)minDuty)
+    {
+        next = minDuty;
+    }
+    else if(next > (int32_t)maxDuty)
+    {
+        next = maxDuty;
+    }
+
+    return((uint16_t)next);
+}
+
+//*****************************************************************************
+//
+// PWMDuty_fromCount
+//
+//*****************************************************************************
+uint16_t
+PWMDuty_fromCount(uint16_t period, uint16_t count)
+{
+    uint32_t duty;
+
+    if(period == 0U)
+    {
+        return(0U);
+    }
+
+    if(count >= period)
+    {
+        return(PWMDUTY_ONE);
+    }
+
+    duty = (((uint32_t)count << PWMDUTY_Q) + (period >> 1U)) / period;
+
+    return((uint16_t)duty);
+}
@@ -0,0 +1,132 @@
+//#############################################################################
+//
+// FILE:   pwm_duty.h
+//
+// TITLE:  Fixed-point duty cycle and compare count conversion.
+//
+//#############################################################################
+//
+// Duty cycles are unsigned Q15 fractions held in a uint16_t: 0 is 0% and
+// PWMDUTY_ONE (0x8000) is 100%. Converting a duty cycle to a compare count
+// takes one 16 x 16 bit multiply, an add and a shift, with no floating point
+// and no run-time support library calls.
+//
+// Compare counts are rounded to the nearest count, ties away from zero, and
+// never exceed the period. The result depends only on the period and the
+// duty cycle, so stepping the duty up and back down returns to exactly the
+// same count.
+//
+//#############################################################################
+
+#ifndef PWM_DUTY_H
+#define PWM_DUTY_H
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//
+// Included Files
+//
+#include <stdint.h>
+
+//*****************************************************************************
+//
+// Q15 duty cycle scale
+//
+//*****************************************************************************
+#define PWMDUTY_Q               15U
+#define PWMDUTY_ONE             ((uint16_t)1U << PWMDUTY_Q)
+
+//*****************************************************************************
+//
+//! Converts a constant fraction between 0.0 and 1.0 to a Q15 duty cycle.
+//!
+//! Intended for compile-time constants only, where the compiler folds the
+//! floating-point expression away.
+//
+//*****************************************************************************
+#define PWMDUTY_Q15(fraction)                                                 \
+    ((uint16_t)(((fraction) * (float)PWMDUTY_ONE) + 0.5F))
+
+//*****************************************************************************
+//
+//! Converts a duty cycle to a compare count.
+//!
+//! \param period is the time-base period in counts.
+//! \param duty is the duty cycle in Q15, at most \b PWMDUTY_ONE.
+//!
+//! \return Returns \e period * \e duty rounded to the nearest count and
+//! limited to \e period.
+//
+//*****************************************************************************
+static inline uint16_t
+PWMDuty_toCount(uint16_t period, uint16_t duty)
+{
+    uint32_t count;
+
+    if(duty > PWMDUTY_ONE)
+    {
+        duty = PWMDUTY_ONE;
+    }
+
+    count = (((uint32_t)period * duty) + (PWMDUTY_ONE >> 1U)) >> PWMDUTY_Q;
+
+    return((uint16_t)count);
+}
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+//*****************************************************************************
+//
+//! Moves a duty cycle by a signed step, staying within limits.
+//!
+//! \param duty is the current duty cycle in Q15.
+//! \param step is the signed change in Q15.
+//! \param minDuty is the lowest allowed duty cycle in Q15.
+//! \param maxDuty is the highest allowed duty cycle in Q15, at most
+//! \b PWMDUTY_ONE.
+//!
+//! \return Returns \e duty + \e step limited to \e minDuty .. \e maxDuty.
+//
+//*****************************************************************************
+extern uint16_t
+PWMDuty_step(uint16_t duty, int16_t step, uint16_t minDuty, uint16_t maxDuty);
+
+//*****************************************************************************
+//
+//! Converts a compare count back to a duty cycle.
+//!
+//! \param period is the time-base period in counts.
+//! \param count is the compare count.
+//!
+//! This needs a division and is meant for reporting, not for the control
+//! path.
+//!
+//! \return Returns \e count / \e period in Q15, rounded to nearest and
+//! limited to \b PWMDUTY_ONE, or 0 if \e period is 0.
+//
+//*****************************************************************************
+extern uint16_t
+PWMDuty_fromCount(uint16_t period, uint16_t count);
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PWM_DUTY_H
@@ -0,0 +1,203 @@
+//#############################################################################
+//
+// FILE:   pwm_hr.c
+//
+// TITLE:  High-resolution duty cycle and period control through HRPWM.
+//
+//#############################################################################
+
+//
+// Included Files
+//
+#include "pwm_hr.h"
+
+#ifndef __cplusplus
+#pragma CODE_SECTION(PWMHR_setPeriodAndCompare, ".TI.ramfunc");
+#pragma CODE_SECTION(PWMHR_setCompare, ".TI.ramfunc");
+#pragma CODE_SECTION(PWMHR_setPeriod, ".TI.ramfunc");
+#endif
+
+//
+// Scale factor optimizer of the C2000Ware HRPWM calibration library
+// (SFO_V8.h). The library reads the ePWM base table and leaves its result in
+// MEP_ScaleFactor, both of which the application provides. Host builds link
+// the simulator's stand-in instead (device/sim/sim_sfo.c).
+//
+#define PWMHR_SFO_COMPLETE      1
+
+extern int SFO(void);
+
+int MEP_ScaleFactor;
+volatile uint32_t ePWM[] =
+{
+    0U, EPWM1_BASE, EPWM2_BASE, EPWM3_BASE, EPWM4_BASE, EPWM5_BASE,
+    EPWM6_BASE, EPWM7_BASE, EPWM8_BASE
+};
+
+//
+// Scale factor of the last complete calibration
+//
+static uint16_t PWMHR_scaleFactor;
+
+//*****************************************************************************
+//
+// PWMHR_init
+//
+//*****************************************************************************
+void
+PWMHR_init(uint32_t base)
+{
+    HRPWM_setMEPEdgeSelect(base, HRPWM_CHANNEL_A,
+                           HRPWM_MEP_CTRL_RISING_AND_FALLING_EDGE);
+    HRPWM_setMEPEdgeSelect(base, HRPWM_CHANNEL_B,
+                           HRPWM_MEP_CTRL_RISING_AND_FALLING_EDGE);
+    HRPWM_setMEPControlMode(base, HRPWM_CHANNEL_A, HRPWM_MEP_DUTY_PERIOD_CTRL);
+    HRPWM_setMEPControlMode(base, HRPWM_CHANNEL_B, HRPWM_MEP_DUTY_PERIOD_CTRL);
+    HRPWM_setCounterCompareShadowLoadEvent(base, HRPWM_CHANNEL_A,
+                                           HRPWM_LOAD_ON_CNTR_ZERO);
+    HRPWM_setCounterCompareShadowLoadEvent(base, HRPWM_CHANNEL_B,
+                                           HRPWM_LOAD_ON_CNTR_ZERO);
+
+    //
+    // Fractions are in 1/256 count; HRMSTEP turns them into MEP steps
+    //
+    HRPWM_enableAutoConversion(base);
+    HRPWM_enablePeriodControl(base);
+}
+
+//*****************************************************************************
+//
+// PWMHR_calibrate
+//
+//*****************************************************************************
+uint16_t
+PWMHR_calibrate(void)
+{
+    int status = SFO();
+
+    if(status == PWMHR_SFO_COMPLETE)
+    {
+        PWMHR_scaleFactor = (uint16_t)MEP_ScaleFactor;
+    }
+
+    return((uint16_t)status);
+}
+
+//*****************************************************************************
+//
+// PWMHR_getScaleFactor
+//
+//*****************************************************************************
+uint16_t
+PWMHR_getScaleFactor(void)
+{
+    return(PWMHR_scaleFactor);
+}
+
+//*****************************************************************************
+//
+// PWMHR_periodFromFrequency
+//
+//*****************************************************************************
+uint32_t
+PWMHR_periodFromFrequency(uint32_t clockFreq, uint32_t frequency)
+{
+    uint32_t quotient;
+    uint32_t remainder;
+
+    if(frequency == 0U)
+    {
+        return(PWMHR_COUNT_MAX);
+    }
+
+    //
+    // period = clockFreq * 256 / (2 * frequency), split so that no product
+    // exceeds 32 bits
+    //
+    quotient = clockFreq / frequency;
+    remainder = clockFreq % frequency;
+
+    if(quotient > (PWMHR_COUNT_MAX >> 7U))
+    {
+        return(PWMHR_COUNT_MAX);
+    }
+    if(quotient < 4U)
+    {
+        return(PWMHR_COUNT(2U));
+    }
+
+    return((quotient << 7U) +
+           (((remainder << 7U) + (frequency >> 1U)) / frequency));
+}
+
+//*****************************************************************************
+//
+// PWMHR_dutyToCount
+//
+//*****************************************************************************
+uint32_t
+PWMHR_dutyToCount(uint32_t period, uint16_t duty)
+{
+    uint32_t high;
+    uint32_t low;
+
+    if(duty > PWMDUTY_ONE)
+    {
+        duty = PWMDUTY_ONE;
+    }
+
+    //
+    // period * duty needs 39 bits; multiply the integer and fractional
+    // counts separately
+    //
+    high = (period >> PWMHR_COUNT_S) * duty;
+    low = (period & (PWMHR_COUNT_ONE - 1U)) * duty;
+
+    return((high + (low >> PWMHR_COUNT_S) +
+            (1UL << (PWMDUTY_Q - PWMHR_COUNT_S - 1U))) >>
+           (PWMDUTY_Q - PWMHR_COUNT_S));
+}
+
+//*****************************************************************************
+//
+// PWMHR_setPeriodAndCompare
+//
+//*****************************************************************************
+void
+PWMHR_setPeriodAndCompare(uint32_t base, uint32_t period, uint32_t compareA,
+                          uint32_t compareB)
+{
+    HRPWM_setTimeBasePeriod(base, period);
+    HRPWM_setCounterCompareValue(base, HRPWM_COUNTER_COMPARE_A, compareA);
+    HRPWM_setCounterCompareValue(base, HRPWM_COUNTER_COMPARE_B, compareB);
+
+    //
+    // Arm the global load only after every shadow holds its new value
+    //
+    EPWM_setGlobalLoadOneShotLatch(base);
+}
+
+//*****************************************************************************
+//
+// PWMHR_setCompare
+//
+//*****************************************************************************
+void
+PWMHR_setCompare(uint32_t base, uint32_t compareA, uint32_t compareB)
+{
+    HRPWM_setCounterCompareValue(base, HRPWM_COUNTER_COMPARE_A, compareA);
+    HRPWM_setCounterCompareValue(base, HRPWM_COUNTER_COMPARE_B, compareB);
+    EPWM_setGlobalLoadOneShotLatch(base);
+}
+
+//*****************************************************************************
+//
+// PWMHR_setPeriod
+//
+//*****************************************************************************
+void
+PWMHR_setPeriod(uint32_t base, uint32_t period)
+{
+    HRPWM_setTimeBasePeriod(base, period);
+    EPWM_setGlobalLoadOneShotLatch(base);
+}
@@ -0,0 +1,227 @@
+//#############################################################################
+//
+// FILE:   pwm_hr.h
+//
+// TITLE:  High-resolution duty cycle and period control through HRPWM.
+//
+//#############################################################################
+//
+// The ePWM places edges on whole TBCLK counts, 10 ns at 100 MHz. At
+// 56 kHz (TBPRD = 850, up-down) one count of CMPA is 0.12% of duty and one
+// count of TBPRD moves the frequency by about 66 Hz. The HRPWM micro edge
+// positioner (MEP) delays the edges in steps of roughly 150 ps, which takes
+// the resolution down to about 1/66 of a count.
+//
+// Periods and compare values here are "HR counts": 16.8 fixed-point TBCLK
+// counts, integer count in bits 23:8 and fraction in bits 7:0, which is the
+// TBPRD:TBPRDHR and CMPx:CMPxHR register layout. With auto-conversion
+// enabled the hardware turns the 8-bit fraction into MEP steps using the
+// scale factor in HRMSTEP, so the fraction is independent of the silicon.
+//
+// The MEP step size drifts with temperature and voltage. PWMHR_calibrate()
+// runs the scale factor optimizer (SFO) of the C2000Ware HRPWM calibration
+// library one slice at a time and, when a measurement completes, updates
+// HRMSTEP. Call it from the background loop; a stale scale factor shows as
+// an error of up to a few percent of a count in the fractional edges.
+//
+// The module is meant for up-down counting with the outputs set and cleared
+// on the CMPx up and down matches, as ePWM5 is configured: the MEP moves both
+// edges and the high-resolution period is applied on each slope. The MEP
+// cannot place edges within three counts of zero or the period; the
+// fractional part of compare values in that range is not meaningful.
+//
+//#############################################################################
+
+#ifndef PWM_HR_H
+#define PWM_HR_H
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//
+// Included Files
+//
+#include <stdbool.h>
+#include <stdint.h>
+#include "driverlib.h"
+#include "pwm_duty.h"
+
+//*****************************************************************************
+//
+// HR count format
+//
+//*****************************************************************************
+#define PWMHR_COUNT_S           8U
+#define PWMHR_COUNT_ONE         ((uint32_t)1U << PWMHR_COUNT_S)
+#define PWMHR_COUNT_MAX         0xFFFFFFUL
+
+//*****************************************************************************
+//
+//! Converts whole TBCLK counts to HR counts.
+//
+//*****************************************************************************
+#define PWMHR_COUNT(counts)     ((uint32_t)(counts) << PWMHR_COUNT_S)
+
+//*****************************************************************************
+//
+// Values returned by PWMHR_calibrate(), equal to the SFO() return values.
+//
+//*****************************************************************************
+#define PWMHR_CAL_INCOMPLETE    0U
+#define PWMHR_CAL_COMPLETE      1U
+#define PWMHR_CAL_ERROR         2U
+
+//*****************************************************************************
+//
+//! Tells whether the MEP drives the outputs of an ePWM module.
+//!
+//! \param base is the base address of the ePWM module.
+//!
+//! \return Returns \b true after PWMHR_init() on the module.
+//
+//*****************************************************************************
+static inline bool
+PWMHR_isEnabled(uint32_t base)
+{
+    return((HWREGH(base + HRPWM_O_HRCNFG) & HRPWM_HRCNFG_EDGMODE_M) != 0U);
+}
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+//*****************************************************************************
+//
+//! Enables high-resolution duty cycle and period control on an ePWM module.
+//!
+//! \param base is the base address of the ePWM module.
+//!
+//! The module must be in up-down count mode and set up with PWMUpdate_init(),
+//! whose global load also carries the TBPRDHR, CMPAHR and CMPBHR fractions.
+//! Both outputs get MEP control of both edges from CMPAHR and CMPBHR, and
+//! TBPRDHR is enabled. Afterwards the period and compare values must be
+//! written through the PWMHR functions, which keep the fractions coherent.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+PWMHR_init(uint32_t base);
+
+//*****************************************************************************
+//
+//! Runs one slice of the MEP scale factor calibration.
+//!
+//! A complete measurement takes several calls. When it completes, HRMSTEP
+//! holds the new scale factor, which every module using auto-conversion
+//! picks up at once. On error the previous scale factor stays in use.
+//!
+//! \return Returns \b PWMHR_CAL_INCOMPLETE while measuring,
+//! \b PWMHR_CAL_COMPLETE when a new scale factor is in place or
+//! \b PWMHR_CAL_ERROR if the measured scale factor is out of range.
+//
+//*****************************************************************************
+extern uint16_t
+PWMHR_calibrate(void);
+
+//*****************************************************************************
+//
+//! Returns the last measured MEP scale factor.
+//!
+//! \return Returns the number of MEP steps per TBCLK, or 0 before the first
+//! calibration completed.
+//
+//*****************************************************************************
+extern uint16_t
+PWMHR_getScaleFactor(void);
+
+//*****************************************************************************
+//
+//! Converts a frequency to an up-down count period.
+//!
+//! \param clockFreq is the TBCLK frequency in Hz.
+//! \param frequency is the PWM frequency in Hz.
+//!
+//! \return Returns \e clockFreq / (2 * \e frequency) in HR counts, rounded to
+//! nearest and limited to 2 .. \b PWMHR_COUNT_MAX.
+//
+//*****************************************************************************
+extern uint32_t
+PWMHR_periodFromFrequency(uint32_t clockFreq, uint32_t frequency);
+
+//*****************************************************************************
+//
+//! Converts a duty cycle to a compare value.
+//!
+//! \param period is the period in HR counts.
+//! \param duty is the duty cycle in Q15 (see pwm_duty.h), at most
+//! \b PWMDUTY_ONE.
+//!
+//! \return Returns \e period * \e duty in HR counts, rounded to nearest.
+//
+//*****************************************************************************
+extern uint32_t
+PWMHR_dutyToCount(uint32_t period, uint16_t duty);
+
+//*****************************************************************************
+//
+//! Stages a new period and compare values to load together.
+//!
+//! \param base is the base address of the ePWM module.
+//! \param period is the new period in HR counts.
+//! \param compareA is the new CMPA:CMPAHR value in HR counts.
+//! \param compareB is the new CMPB:CMPBHR value in HR counts.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+PWMHR_setPeriodAndCompare(uint32_t base, uint32_t period, uint32_t compareA,
+                          uint32_t compareB);
+
+//*****************************************************************************
+//
+//! Stages new compare values to load together, keeping the period.
+//!
+//! \param base is the base address of the ePWM module.
+//! \param compareA is the new CMPA:CMPAHR value in HR counts.
+//! \param compareB is the new CMPB:CMPBHR value in HR counts.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+PWMHR_setCompare(uint32_t base, uint32_t compareA, uint32_t compareB);
+
+//*****************************************************************************
+//
+//! Stages a new period, keeping the compare values.
+//!
+//! \param base is the base address of the ePWM module.
+//! \param period is the new period in HR counts.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+PWMHR_setPeriod(uint32_t base, uint32_t period);
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PWM_HR_H
@@ -0,0 +1,226 @@
+//#############################################################################
+//
+// FILE:   pwm_loop.c
+//
+// TITLE:  Closed-loop output regulation from ePWM-synchronous ADC samples.
+//
+//#############################################################################
+
+//
+// Included Files
+//
+#include "pwm_loop.h"
+#include "pwm_hr.h"
+
+#ifndef __cplusplus
+#pragma CODE_SECTION(PWMLoop_step, ".TI.ramfunc");
+#pragma CODE_SECTION(PWMLoop_disable, ".TI.ramfunc");
+#endif
+
+//
+// Distance between the SOCA triggers of two ePWM modules in the ADC trigger
+// selection
+//
+#define PWMLOOP_TRIGGER_STEP                                                  \
+    ((uint16_t)ADC_TRIGGER_EPWM2_SOCA - (uint16_t)ADC_TRIGGER_EPWM1_SOCA)
+
+//*****************************************************************************
+//
+// PWMLoop_initSense
+//
+// Converts a signal with SOC0 on the ePWM SOCA trigger and checks it with
+// PPB1
+//
+//*****************************************************************************
+static void
+PWMLoop_initSense(const PWMLoop_Sense *sense, ADC_Trigger trigger)
+{
+    ADC_setupSOC(sense->adcBase, PWMLOOP_SOC, trigger, sense->channel,
+                 PWMLOOP_SAMPLE_WINDOW);
+
+    ADC_setupPPB(sense->adcBase, PWMLOOP_PPB, PWMLOOP_SOC);
+    ADC_setPPBReferenceOffset(sense->adcBase, PWMLOOP_PPB, sense->offset);
+    ADC_setPPBTripLimits(sense->adcBase, PWMLOOP_PPB, sense->tripHigh,
+                         sense->tripLow);
+    ADC_clearPPBEventStatus(sense->adcBase, PWMLOOP_PPB,
+                            ADC_EVT_TRIPHI | ADC_EVT_TRIPLO | ADC_EVT_ZERO);
+}
+
+//*****************************************************************************
+//
+// PWMLoop_initChannel
+//
+//*****************************************************************************
+void
+PWMLoop_initChannel(PWMLoop_Channel *channel, uint32_t epwmBase,
+                    const PWMLoop_Sense *current,
+                    const PWMLoop_Sense *voltage, int32_t kp, int32_t ki)
+{
+    ADC_Trigger trigger;
+
+    channel->epwmBase = epwmBase;
+    channel->current = *current;
+    channel->voltage = *voltage;
+    channel->limits.min = 0U;
+    channel->limits.max = 0U;
+    channel->limits.safe = 0U;
+    channel->enabled = false;
+    channel->reference = 0;
+    channel->compare = 0U;
+    channel->lastCurrent = 0;
+    channel->lastVoltage = 0;
+    channel->faults = 0U;
+    channel->trips = 0U;
+    channel->latency = 0U;
+    channel->maxLatency = 0U;
+    channel->runs = 0U;
+    PWMComp_initPI(&channel->regulator, kp, ki, 0, 0);
+
+    trigger = (ADC_Trigger)((uint16_t)ADC_TRIGGER_EPWM1_SOCA +
+                            ((uint16_t)((epwmBase - EPWM1_BASE) /
+                                        (EPWM2_BASE - EPWM1_BASE)) *
+                             PWMLOOP_TRIGGER_STEP));
+
+    PWMLoop_initSense(current, trigger);
+    PWMLoop_initSense(voltage, trigger);
+
+    //
+    // Both conversions end together; the current ADC interrupts once its
+    // result is in
+    //
+    ADC_setInterruptPulseMode(current->adcBase, ADC_PULSE_END_OF_CONV);
+    ADC_setInterruptSource(current->adcBase, PWMLOOP_INT, PWMLOOP_SOC);
+    ADC_disableContinuousMode(current->adcBase, PWMLOOP_INT);
+    ADC_clearInterruptStatus(current->adcBase, PWMLOOP_INT);
+    ADC_enableInterrupt(current->adcBase, PWMLOOP_INT);
+
+    //
+    // Sample at counter zero, the middle of the low time of an up-down
+    // counted ePWMxA, every period
+    //
+    EPWM_setADCTriggerSource(epwmBase, EPWM_SOC_A, EPWM_SOC_TBCTR_ZERO);
+    EPWM_setADCTriggerEventPrescale(epwmBase, EPWM_SOC_A, 1U);
+    EPWM_enableADCTrigger(epwmBase, EPWM_SOC_A);
+}
+
+//*****************************************************************************
+//
+// PWMLoop_enable
+//
+//*****************************************************************************
+void
+PWMLoop_enable(PWMLoop_Channel *channel, int16_t reference, uint32_t compare,
+               const PWMLoop_Limits *limits)
+{
+    channel->reference = reference;
+    channel->limits = *limits;
+    channel->compare = (compare < limits->min) ? limits->min :
+                       ((compare > limits->max) ? limits->max : compare);
+    channel->faults = 0U;
+    channel->latency = 0U;
+    channel->maxLatency = 0U;
+    channel->runs = 0U;
+
+    PWMComp_setPILimits(&channel->regulator, (int32_t)limits->min,
+                        (int32_t)limits->max);
+    PWMComp_resetPI(&channel->regulator, (int32_t)channel->compare);
+
+    //
+    // Trips of the open loop do not count against the closed one
+    //
+    ADC_clearPPBEventStatus(channel->current.adcBase, PWMLOOP_PPB,
+                            ADC_EVT_TRIPHI | ADC_EVT_TRIPLO);
+    ADC_clearPPBEventStatus(channel->voltage.adcBase, PWMLOOP_PPB,
+                            ADC_EVT_TRIPHI | ADC_EVT_TRIPLO);
+
+    channel->enabled = true;
+}
+
+//*****************************************************************************
+//
+// PWMLoop_disable
+//
+//*****************************************************************************
+void
+PWMLoop_disable(PWMLoop_Channel *channel)
+{
+    channel->enabled = false;
+}
+
+//*****************************************************************************
+//
+// PWMLoop_step
+//
+//*****************************************************************************
+void
+PWMLoop_step(PWMLoop_Channel *channel)
+{
+    uint16_t currentEvents;
+    uint16_t voltageEvents;
+    uint16_t latency;
+
+    channel->lastCurrent = (int16_t)ADC_readPPBResult(
+                                        channel->current.resultBase,
+                                        PWMLOOP_PPB);
+    channel->lastVoltage = (int16_t)ADC_readPPBResult(
+                                        channel->voltage.resultBase,
+                                        PWMLOOP_PPB);
+
+    //
+    // The PPBs have already compared the samples against their limits
+    //
+    currentEvents = ADC_getPPBEventStatus(channel->current.adcBase,
+                                          PWMLOOP_PPB) &
+                    (ADC_EVT_TRIPHI | ADC_EVT_TRIPLO);
+    voltageEvents = ADC_getPPBEventStatus(channel->voltage.adcBase,
+                                          PWMLOOP_PPB) &
+                    (ADC_EVT_TRIPHI | ADC_EVT_TRIPLO);
+
+    if((currentEvents | voltageEvents) != 0U)
+    {
+        if(currentEvents != 0U)
+        {
+            ADC_clearPPBEventStatus(channel->current.adcBase, PWMLOOP_PPB,
+                                    currentEvents);
+            channel->faults |= PWMLOOP_FAULT_CURRENT;
+        }
+        if(voltageEvents != 0U)
+        {
+            ADC_clearPPBEventStatus(channel->voltage.adcBase, PWMLOOP_PPB,
+                                    voltageEvents);
+            channel->faults |= PWMLOOP_FAULT_VOLTAGE;
+        }
+        if(channel->trips != UINT16_MAX)
+        {
+            channel->trips++;
+        }
+
+        if(channel->enabled)
+        {
+            channel->enabled = false;
+            channel->compare = channel->limits.safe;
+            PWMHR_setCompare(channel->epwmBase, channel->compare,
+                             channel->compare);
+        }
+        return;
+    }
+
+    if(!channel->enabled)
+    {
+        return;
+    }
+
+    channel->compare = (uint32_t)PWMComp_runPI(&channel->regulator,
+                                               (int32_t)channel->reference -
+                                               channel->lastVoltage);
+
+    PWMHR_setCompare(channel->epwmBase, channel->compare, channel->compare);
+
+    latency = HWREGH(channel->epwmBase + EPWM_O_TBCTR);
+    channel->latency = latency;
+    if(latency > channel->maxLatency)
+    {
+        channel->maxLatency = latency;
+    }
+    channel->runs++;
+}
@@ -0,0 +1,232 @@
+//#############################################################################
+//
+// FILE:   pwm_loop.h
+//
+// TITLE:  Closed-loop output regulation from ePWM-synchronous ADC samples.
+//
+//#############################################################################
+//
+// The SOCA event of the ePWM module at counter zero starts SOC0 on two ADCs
+// at once, one converting the output current and one the output voltage,
+// so both samples are taken at the same point of the switching period.
+// Both SOCs use the same acquisition window, so both results are ready when
+// the current ADC raises ADCINT1 at the end of its conversion. The control
+// ISR calls PWMLoop_step().
+//
+// PPB1 of each ADC subtracts the zero offset of its signal and compares the
+// result against the limits of the signal in hardware. A sample out of
+// range opens the loop, moves the compare value to its safe setting and
+// latches a fault until the loop is enabled again. The step reads the
+// flags the PPBs set and does not compare the samples itself.
+//
+// The regulator is a PI compensator (see pwm_comp.h) on the voltage error,
+// in ADC counts, with the compare value as its output, limited to the range
+// given to PWMLoop_enable(). The sign of the gains follows the action
+// qualifier setup: with the output set on the up match and cleared on the
+// down match, as ePWM5A, a higher compare value lowers the duty, so the
+// gains are negative. Compare values are HR counts (see pwm_hr.h) and are
+// written to CMPA and CMPB through PWMHR_setCompare(). Enabling the loop
+// presets the integrator with the compare value the output runs with, so
+// the loop takes over without a step.
+//
+// The step also measures the sample-to-update latency: TBCTR right after
+// the compare write, the TBCLK counts from the SOC event at counter zero.
+// Like the ISR latency of isr_timing.h this assumes the update happens
+// while the counter is still counting up.
+//
+//#############################################################################
+
+#ifndef PWM_LOOP_H
+#define PWM_LOOP_H
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//
+// Included Files
+//
+#include <stdbool.h>
+#include <stdint.h>
+#include "driverlib.h"
+#include "pwm_comp.h"
+
+//*****************************************************************************
+//
+// SOC, PPB and interrupt used on both ADCs, and the acquisition window in
+// SYSCLK cycles
+//
+//*****************************************************************************
+#define PWMLOOP_SOC             ADC_SOC_NUMBER0
+#define PWMLOOP_PPB             ADC_PPB_NUMBER1
+#define PWMLOOP_INT             ADC_INT_NUMBER1
+#define PWMLOOP_SAMPLE_WINDOW   15U
+
+//*****************************************************************************
+//
+// Values in the faults field of PWMLoop_Channel
+//
+//*****************************************************************************
+#define PWMLOOP_FAULT_CURRENT   0x0001U
+#define PWMLOOP_FAULT_VOLTAGE   0x0002U
+
+//*****************************************************************************
+//
+//! One measured signal.
+//
+//*****************************************************************************
+typedef struct
+{
+    uint32_t adcBase;           //!< ADC converting the signal
+    uint32_t resultBase;        //!< Result registers of that ADC
+    ADC_Channel channel;        //!< ADC input
+    uint16_t offset;            //!< ADC result of a zero signal
+    int16_t tripHigh;           //!< Highest in-range signal, ADC counts
+    int16_t tripLow;            //!< Lowest in-range signal, ADC counts
+} PWMLoop_Sense;
+
+//*****************************************************************************
+//
+//! Compare value range of a closed loop, in HR counts.
+//
+//*****************************************************************************
+typedef struct
+{
+    uint32_t min;               //!< Lowest compare value the loop may set
+    uint32_t max;               //!< Highest compare value the loop may set
+    uint32_t safe;              //!< Compare value set on a fault
+} PWMLoop_Limits;
+
+//*****************************************************************************
+//
+//! State of one regulated output. Initialize with PWMLoop_initChannel().
+//
+//*****************************************************************************
+typedef struct
+{
+    uint32_t epwmBase;          //!< ePWM module driving the output
+    PWMLoop_Sense current;      //!< Output current measurement
+    PWMLoop_Sense voltage;      //!< Output voltage measurement
+    PWMComp_PI regulator;       //!< Voltage regulator
+    PWMLoop_Limits limits;      //!< Compare value range
+    volatile bool enabled;      //!< Loop closed
+    int16_t reference;          //!< Voltage setpoint, ADC counts
+    uint32_t compare;           //!< Compare value last set, HR counts
+    int16_t lastCurrent;        //!< Latest current sample, ADC counts
+    int16_t lastVoltage;        //!< Latest voltage sample, ADC counts
+    uint16_t faults;            //!< PWMLOOP_FAULT_* since the last enable
+    uint16_t trips;             //!< Samples out of range, saturating
+    uint16_t latency;           //!< Latency of the last update, TBCLK
+    uint16_t maxLatency;        //!< Largest latency seen, TBCLK
+    uint32_t runs;              //!< Compare updates made
+} PWMLoop_Channel;
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+//*****************************************************************************
+//
+//! Sets up the sampling and limit checking of a regulated output.
+//!
+//! \param channel is the channel to initialize.
+//! \param epwmBase is the base address of the ePWM module.
+//! \param current is the output current measurement.
+//! \param voltage is the output voltage measurement, on a different ADC
+//! than the current.
+//! \param kp is the proportional gain in Q16 HR counts per ADC count.
+//! \param ki is the integral gain per sample in Q16 HR counts per ADC
+//! count.
+//!
+//! Configures SOCA of the ePWM module, SOC0 and PPB1 of both ADCs and
+//! ADCINT1 of the current ADC. The ADCs must be powered up. The loop starts
+//! open.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+PWMLoop_initChannel(PWMLoop_Channel *channel, uint32_t epwmBase,
+                    const PWMLoop_Sense *current,
+                    const PWMLoop_Sense *voltage, int32_t kp, int32_t ki);
+
+//*****************************************************************************
+//
+//! Closes the loop.
+//!
+//! \param channel is the channel.
+//! \param reference is the voltage setpoint in ADC counts.
+//! \param compare is the compare value to start from, normally the one the
+//! output runs with, in HR counts.
+//! \param limits is the compare value range.
+//!
+//! Presets the regulator with \e compare and clears the faults and the
+//! latency statistics. Call with the control interrupt disabled.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+PWMLoop_enable(PWMLoop_Channel *channel, int16_t reference, uint32_t compare,
+               const PWMLoop_Limits *limits);
+
+//*****************************************************************************
+//
+//! Opens the loop. The compare value stays where the loop left it.
+//!
+//! \param channel is the channel.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+PWMLoop_disable(PWMLoop_Channel *channel);
+
+//*****************************************************************************
+//
+//! Runs one control step on the latest samples.
+//!
+//! \param channel is the channel.
+//!
+//! Call from the ADCINT1 ISR of the current ADC. The ISR clears the ADC
+//! interrupt flag.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+PWMLoop_step(PWMLoop_Channel *channel);
+
+//*****************************************************************************
+//
+//! Returns whether the loop is closed.
+//!
+//! \param channel is the channel.
+//!
+//! \return Returns \b true if the loop is closed.
+//
+//*****************************************************************************
+static inline bool
+PWMLoop_isEnabled(const PWMLoop_Channel *channel)
+{
+    return(channel->enabled);
+}
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PWM_LOOP_H
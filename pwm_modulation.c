@@ -0,0 +1,91 @@
+//#############################################################################
+//
+// FILE:   pwm_modulation.c
+//
+// TITLE:  Table-driven compare modulation for ePWM interrupts.
+//
+//#############################################################################
+
+//
+// Included Files
+//
+#include <math.h>
+#include "pwm_modulation.h"
+
+//
+// Defines
+//
+#define PWMMOD_TWO_PI           6.28318531F
+
+//*****************************************************************************
+//
+// PWMMod_initChannel
+//
+//*****************************************************************************
+void
+PWMMod_initChannel(PWMMod_Channel *channel, uint32_t base,
+                   const uint16_t *table, uint16_t length, uint16_t offsetB,
+                   uint16_t divider)
+{
+    ASSERT((table == NULL) || (offsetB < length));
+    ASSERT(divider != 0U);
+
+    channel->base = base;
+    channel->table = table;
+    channel->length = length;
+    channel->indexA = 0U;
+    channel->indexB = offsetB;
+    channel->divider = divider;
+    channel->count = 0U;
+}
+
+//*****************************************************************************
+//
+// PWMMod_fillSine
+//
+//*****************************************************************************
+void
+PWMMod_fillSine(uint16_t *table, uint16_t length, uint16_t minValue,
+                uint16_t maxValue)
+{
+    float mid = ((float)minValue + (float)maxValue) * 0.5F;
+    float amplitude = ((float)maxValue - (float)minValue) * 0.5F;
+    float step = PWMMOD_TWO_PI / (float)length;
+    uint16_t i;
+
+    for(i = 0U; i < length; i++)
+    {
+        table[i] = (uint16_t)(mid + (amplitude * sinf(step * (float)i)) +
+                              0.5F);
+    }
+}
+
+//*****************************************************************************
+//
+// PWMMod_fillTriangle
+//
+//*****************************************************************************
+void
+PWMMod_fillTriangle(uint16_t *table, uint16_t length, uint16_t minValue,
+                    uint16_t maxValue)
+{
+    uint32_t span = (uint32_t)maxValue - minValue;
+    uint16_t half = length / 2U;
+    uint16_t i;
+
+    ASSERT(length >= 2U);
+
+    //
+    // Rising half from minValue, falling half back towards it
+    //
+    for(i = 0U; i < half; i++)
+    {
+        table[i] = minValue + (uint16_t)(((span * i) + (half / 2U)) / half);
+    }
+    for(i = half; i < length; i++)
+    {
+        table[i] = maxValue -
+                   (uint16_t)(((span * (i - half)) + ((length - half) / 2U)) /
+                              (length - half));
+    }
+}
@@ -0,0 +1,186 @@
+//#############################################################################
+//
+// FILE:   pwm_modulation.h
+//
+// TITLE:  Table-driven compare modulation for ePWM interrupts.
+//
+//#############################################################################
+//
+// Each channel plays a precomputed table of compare values into CMPA and
+// CMPB of one ePWM module, one entry per interrupt or every few interrupts.
+// The tables are filled once at start-up, so the interrupt only copies two
+// words from RAM to the shadow registers and advances an index; it never
+// reads a peripheral register back.
+//
+// CMPB plays the same table as CMPA, shifted by a fixed number of entries,
+// so a single table yields in-phase, anti-phase or quadrature outputs.
+//
+//#############################################################################
+
+#ifndef PWM_MODULATION_H
+#define PWM_MODULATION_H
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//
+// Included Files
+//
+#include <stdbool.h>
+#include <stdint.h>
+#include "driverlib.h"
+
+#ifndef __cplusplus
+#pragma CODE_SECTION(PWMMod_step, ".TI.ramfunc");
+#endif
+
+//*****************************************************************************
+//
+//! State of one modulated ePWM module. Initialize with
+//! PWMMod_initChannel().
+//
+//*****************************************************************************
+typedef struct
+{
+    uint32_t base;              //!< ePWM base address
+    const uint16_t *table;      //!< Compare values, NULL when idle
+    uint16_t length;            //!< Number of entries in the table
+    uint16_t indexA;            //!< Next CMPA entry
+    uint16_t indexB;            //!< Next CMPB entry
+    uint16_t divider;           //!< Interrupts per table entry
+    uint16_t count;             //!< Interrupts since the last entry
+} PWMMod_Channel;
+
+//*****************************************************************************
+//
+//! Writes the next compare values of a channel.
+//!
+//! \param channel is the channel.
+//!
+//! Call once per ePWM interrupt. With the compare registers in shadow mode
+//! the values take effect at the next shadow load.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static inline void
+PWMMod_step(PWMMod_Channel *channel)
+{
+    uint16_t indexA;
+    uint16_t indexB;
+
+    if(channel->table == NULL)
+    {
+        return;
+    }
+
+    channel->count++;
+    if(channel->count < channel->divider)
+    {
+        return;
+    }
+    channel->count = 0U;
+
+    indexA = channel->indexA;
+    indexB = channel->indexB;
+
+    HWREGH(channel->base + EPWM_O_CMPA + 1U) = channel->table[indexA];
+    HWREGH(channel->base + EPWM_O_CMPB + 1U) = channel->table[indexB];
+
+    indexA++;
+    if(indexA == channel->length)
+    {
+        indexA = 0U;
+    }
+    indexB++;
+    if(indexB == channel->length)
+    {
+        indexB = 0U;
+    }
+
+    channel->indexA = indexA;
+    channel->indexB = indexB;
+}
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+//*****************************************************************************
+//
+//! Initializes a channel.
+//!
+//! \param channel is the channel.
+//! \param base is the base address of the ePWM module.
+//! \param table is the table of compare values, or NULL to leave the
+//! compare registers alone.
+//! \param length is the number of entries in \e table.
+//! \param offsetB is the number of entries CMPB leads CMPA by, less than
+//! \e length.
+//! \param divider is the number of interrupts per table entry, at least 1.
+//!
+//! The table must stay valid while the channel is in use and every entry
+//! must fit the period of the module.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+PWMMod_initChannel(PWMMod_Channel *channel, uint32_t base,
+                   const uint16_t *table, uint16_t length, uint16_t offsetB,
+                   uint16_t divider);
+
+//*****************************************************************************
+//
+//! Fills a table with one period of a sine wave.
+//!
+//! \param table is the table.
+//! \param length is the number of entries.
+//! \param minValue is the value at the negative peak.
+//! \param maxValue is the value at the positive peak.
+//!
+//! The wave starts at its midpoint, rising. Uses floating point and is
+//! meant to run once at start-up.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+PWMMod_fillSine(uint16_t *table, uint16_t length, uint16_t minValue,
+                uint16_t maxValue);
+
+//*****************************************************************************
+//
+//! Fills a table with one period of a triangle wave.
+//!
+//! \param table is the table.
+//! \param length is the number of entries, at least 2.
+//! \param minValue is the value of the first entry.
+//! \param maxValue is the value half-way through the table.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+PWMMod_fillTriangle(uint16_t *table, uint16_t length, uint16_t minValue,
+                    uint16_t maxValue);
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PWM_MODULATION_H
@@ -0,0 +1,161 @@
+//#############################################################################
+//
+// FILE:   pwm_phase.c
+//
+// TITLE:  Phase-shifted ePWM modules locked to a sync master.
+//
+//#############################################################################
+
+//
+// Included Files
+//
+#include "pwm_phase.h"
+
+//*****************************************************************************
+//
+// PWMPhase_load
+//
+// Writes TBPHS and PHSDIR of a follower for its phase
+//
+//*****************************************************************************
+static void
+PWMPhase_load(const PWMPhase_Group *group, uint16_t index)
+{
+    uint32_t base = group->followerBase[index];
+    uint32_t period = group->period;
+    uint32_t cycle;
+    uint32_t lag;
+    uint32_t position;
+    bool up = true;
+    bool wasUp;
+
+    //
+    // TBCLK counts per PWM period, and how many of them the follower lags
+    //
+    cycle = group->upDown ? (2UL * period) : (period + 1UL);
+    lag = (uint32_t)((((uint64_t)group->phase[index] * cycle) +
+                      (PWMPHASE_FULL_TURN / 2U)) / PWMPHASE_FULL_TURN);
+
+    //
+    // Where the follower is when the master is at zero; counting up-down,
+    // the second half of the period is the way back down
+    //
+    position = (cycle - lag) % cycle;
+    if(group->upDown && (position >= period))
+    {
+        position = cycle - position;
+        up = false;
+    }
+
+    wasUp = (HWREGH(base + EPWM_O_TBCTL) & EPWM_TBCTL_PHSDIR) != 0U;
+    if(!group->upDown || (up == wasUp))
+    {
+        EPWM_setPhaseShift(base, (uint16_t)position);
+    }
+    else
+    {
+        //
+        // A sync between the two writes would load the count with the old
+        // direction; skip syncs until both are in
+        //
+        EPWM_disablePhaseShiftLoad(base);
+        EPWM_setPhaseShift(base, (uint16_t)position);
+        EPWM_setCountModeAfterSync(base, up ? EPWM_COUNT_MODE_UP_AFTER_SYNC :
+                                              EPWM_COUNT_MODE_DOWN_AFTER_SYNC);
+        EPWM_enablePhaseShiftLoad(base);
+    }
+}
+
+//*****************************************************************************
+//
+// PWMPhase_init
+//
+//*****************************************************************************
+void
+PWMPhase_init(PWMPhase_Group *group, uint32_t masterBase,
+              const uint32_t *followerBase, uint16_t numFollowers)
+{
+    uint16_t i;
+
+    ASSERT((numFollowers != 0U) && (numFollowers <= PWMPHASE_MAX_FOLLOWERS));
+
+    group->masterBase = masterBase;
+    group->numFollowers = numFollowers;
+    group->period = EPWM_getTimeBasePeriod(masterBase);
+    group->upDown = (HWREGH(masterBase + EPWM_O_TBCTL) &
+                     EPWM_TBCTL_CTRMODE_M) ==
+                    (uint16_t)EPWM_COUNTER_MODE_UP_DOWN;
+
+    EPWM_disablePhaseShiftLoad(masterBase);
+    EPWM_setSyncOutPulseMode(masterBase, EPWM_SYNC_OUT_PULSE_ON_COUNTER_ZERO);
+
+    for(i = 0U; i < numFollowers; i++)
+    {
+        ASSERT(EPWM_getTimeBasePeriod(followerBase[i]) == group->period);
+
+        group->followerBase[i] = followerBase[i];
+        group->phase[i] = 0U;
+
+        EPWM_setSyncOutPulseMode(followerBase[i],
+                                 EPWM_SYNC_OUT_PULSE_ON_EPWMxSYNCIN);
+        EPWM_setCountModeAfterSync(followerBase[i],
+                                   EPWM_COUNT_MODE_UP_AFTER_SYNC);
+        PWMPhase_load(group, i);
+        EPWM_enablePhaseShiftLoad(followerBase[i]);
+    }
+}
+
+//*****************************************************************************
+//
+// PWMPhase_setPhase
+//
+//*****************************************************************************
+void
+PWMPhase_setPhase(PWMPhase_Group *group, uint16_t index, uint16_t phase)
+{
+    ASSERT(index < group->numFollowers);
+    ASSERT(phase < PWMPHASE_FULL_TURN);
+
+    group->phase[index] = phase;
+    PWMPhase_load(group, index);
+}
+
+//*****************************************************************************
+//
+// PWMPhase_setPeriod
+//
+//*****************************************************************************
+void
+PWMPhase_setPeriod(PWMPhase_Group *group, uint16_t period)
+{
+    uint16_t i;
+
+    ASSERT(period != 0U);
+
+    group->period = period;
+    for(i = 0U; i < group->numFollowers; i++)
+    {
+        PWMPhase_load(group, i);
+    }
+}
+
+//*****************************************************************************
+//
+// PWMPhase_findFollower
+//
+//*****************************************************************************
+uint16_t
+PWMPhase_findFollower(const PWMPhase_Group *group, uint32_t base)
+{
+    uint16_t i;
+
+    for(i = 0U; i < group->numFollowers; i++)
+    {
+        if(group->followerBase[i] == base)
+        {
+            return(i);
+        }
+    }
+
+    return(PWMPHASE_NO_FOLLOWER);
+}
@@ -0,0 +1,197 @@
+//#############################################################################
+//
+// FILE:   pwm_phase.h
+//
+// TITLE:  Phase-shifted ePWM modules locked to a sync master.
+//
+//#############################################################################
+//
+// Interleaved stages share one switching frequency and switch at evenly
+// spread points of the period, so the ripple currents they draw partly
+// cancel and the sum switches at a multiple of the frequency. A phase group
+// locks follower modules to a master: the master sends a sync pulse at
+// each counter zero, and every follower loads its counter from TBPHS on
+// that pulse. The followers therefore run exactly as far behind the master
+// as their phase says, and any drift is corrected once per period.
+//
+// Phases are in hundredths of a degree of the period, a follower at 9000
+// switching a quarter period after the master. The counter position that
+// gives the phase depends on the period and the counter mode of the group;
+// in up-down mode it includes the direction the follower counts in after
+// the sync (PHSDIR).
+//
+// TBPHS only acts on the next sync pulse, so it works as a shadow: a phase
+// change is a single write per module and takes effect at the next counter
+// zero of the master, whatever the counters are doing when it is written.
+// A change that turns the direction of an up-down follower disables the
+// phase load around the two writes instead, and the follower keeps its old
+// phase for at most one more period. The counter jumps at the sync, so a
+// large change may stretch or cut the pulse under way at that moment.
+//
+// All modules of a group run with the same period and counter mode. The
+// followers must sit below the master in the sync chain, with every module
+// in between passing its sync input on; ePWM4 and ePWM7 take theirs from
+// SysCtl_setSyncInputConfig(). Followers pass the sync on themselves.
+//
+//#############################################################################
+
+#ifndef PWM_PHASE_H
+#define PWM_PHASE_H
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//
+// Included Files
+//
+#include <stdbool.h>
+#include <stdint.h>
+#include "driverlib.h"
+
+//*****************************************************************************
+//
+// Largest number of followers in a group
+//
+//*****************************************************************************
+#define PWMPHASE_MAX_FOLLOWERS  3U
+
+//*****************************************************************************
+//
+// Phase of a full period, in hundredths of a degree
+//
+//*****************************************************************************
+#define PWMPHASE_FULL_TURN      36000U
+
+//*****************************************************************************
+//
+// Returned by PWMPhase_findFollower() for a module that is not a follower
+//
+//*****************************************************************************
+#define PWMPHASE_NO_FOLLOWER    0xFFFFU
+
+//*****************************************************************************
+//
+//! State of a phase group. Initialize with PWMPhase_init().
+//
+//*****************************************************************************
+typedef struct
+{
+    uint32_t masterBase;                //!< Module sending the sync pulse
+    uint32_t followerBase[PWMPHASE_MAX_FOLLOWERS]; //!< Phase-locked modules
+    uint16_t phase[PWMPHASE_MAX_FOLLOWERS]; //!< Phases in 0.01 degree
+    uint16_t numFollowers;              //!< Entries in followerBase
+    uint16_t period;                    //!< TBPRD of every module
+    bool upDown;                        //!< Counting up-down
+} PWMPhase_Group;
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+//*****************************************************************************
+//
+//! Locks follower modules to a master.
+//!
+//! \param group is the group to initialize.
+//! \param masterBase is the base address of the master ePWM module.
+//! \param followerBase is the array of follower ePWM base addresses.
+//! \param numFollowers is the number of entries in \e followerBase, 1 to
+//! \b PWMPHASE_MAX_FOLLOWERS.
+//!
+//! Call with the period and counter mode of every module set up. The master
+//! sends its sync pulse on counter zero and ignores its sync input; the
+//! followers load TBPHS on each pulse, starting at a phase of zero. Called
+//! before the time-base clocks start, the followers fall into phase at the
+//! first counter zero of the master.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+PWMPhase_init(PWMPhase_Group *group, uint32_t masterBase,
+              const uint32_t *followerBase, uint16_t numFollowers);
+
+//*****************************************************************************
+//
+//! Sets the phase of a follower.
+//!
+//! \param group is the group.
+//! \param index is the follower, an index into the \e followerBase array
+//! the group was initialized with.
+//! \param phase is how far the follower runs behind the master, in
+//! hundredths of a degree, below \b PWMPHASE_FULL_TURN.
+//!
+//! The new phase takes effect at the next counter zero of the master.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+PWMPhase_setPhase(PWMPhase_Group *group, uint16_t index, uint16_t phase);
+
+//*****************************************************************************
+//
+//! Keeps the phases of a group with a new period.
+//!
+//! \param group is the group.
+//! \param period is the new TBPRD value.
+//!
+//! Recomputes TBPHS of every follower for the period. The caller changes
+//! TBPRD of all modules of the group; while a ramp moves them to the
+//! period, the phases are off by the distance still to go.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+PWMPhase_setPeriod(PWMPhase_Group *group, uint16_t period);
+
+//*****************************************************************************
+//
+//! Finds a follower of a group.
+//!
+//! \param group is the group.
+//! \param base is the base address of an ePWM module.
+//!
+//! \return Returns the index of the module in the group, or
+//! \b PWMPHASE_NO_FOLLOWER if it is not a follower.
+//
+//*****************************************************************************
+extern uint16_t
+PWMPhase_findFollower(const PWMPhase_Group *group, uint32_t base);
+
+//*****************************************************************************
+//
+//! Returns the phase of a follower.
+//!
+//! \param group is the group.
+//! \param index is the follower.
+//!
+//! \return Returns the phase last set, in hundredths of a degree.
+//
+//*****************************************************************************
+static inline uint16_t
+PWMPhase_getPhase(const PWMPhase_Group *group, uint16_t index)
+{
+    return(group->phase[index]);
+}
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PWM_PHASE_H
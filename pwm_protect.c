@@ -0,0 +1,209 @@
+//#############################################################################
+//
+// FILE:   pwm_protect.c
+//
+// TITLE:  Comparator trip-zone protection of ePWM outputs.
+//
+//#############################################################################
+
+//
+// Included Files
+//
+#include "pwm_protect.h"
+
+#ifndef __cplusplus
+#pragma CODE_SECTION(PWMProtect_tripISR, ".TI.ramfunc");
+#endif
+
+//
+// Trip-zone flags of a one-shot trip from DCAEVT1 or from software
+//
+#define PWMPROTECT_TZ_FLAGS                                                   \
+    (EPWM_TZ_INTERRUPT | EPWM_TZ_FLAG_OST | EPWM_TZ_FLAG_DCAEVT1)
+
+//*****************************************************************************
+//
+// PWMProtect_init
+//
+//*****************************************************************************
+void
+PWMProtect_init(PWMProtect_State *protect,
+                const PWMProtect_Comparator *comparator,
+                const uint32_t *epwmBase, uint16_t numEPWM)
+{
+    uint32_t cmpssBase = comparator->cmpssBase;
+    uint16_t threshold = (comparator->filterWindow / 2U) + 1U;
+    uint16_t i;
+
+    ASSERT((numEPWM != 0U) && (numEPWM <= PWMPROTECT_MAX_EPWM));
+    ASSERT(comparator->lowThreshold < comparator->highThreshold);
+
+    protect->cmpssBase = cmpssBase;
+    protect->numEPWM = numEPWM;
+    protect->latched = false;
+    protect->sources = 0U;
+    protect->faults = 0U;
+
+    //
+    // Both comparators against their DACs; the low one inverted so that
+    // each trip output is high on a fault
+    //
+    CMPSS_enableModule(cmpssBase);
+    CMPSS_configHighComparator(cmpssBase, CMPSS_INSRC_DAC);
+    CMPSS_configLowComparator(cmpssBase, CMPSS_INSRC_DAC | CMPSS_INV_INVERTED);
+    CMPSS_configDAC(cmpssBase, CMPSS_DACREF_VDDA | CMPSS_DACVAL_SYSCLK |
+                               CMPSS_DACSRC_SHDW);
+    CMPSS_setDACValueHigh(cmpssBase, comparator->highThreshold);
+    CMPSS_setDACValueLow(cmpssBase, comparator->lowThreshold);
+
+    //
+    // A majority vote over the window rejects switching noise
+    //
+    CMPSS_configFilterHigh(cmpssBase, comparator->filterPrescale,
+                           comparator->filterWindow, threshold);
+    CMPSS_configFilterLow(cmpssBase, comparator->filterPrescale,
+                          comparator->filterWindow, threshold);
+    CMPSS_initFilterHigh(cmpssBase);
+    CMPSS_initFilterLow(cmpssBase);
+    CMPSS_configOutputsHigh(cmpssBase, CMPSS_TRIP_FILTER |
+                                       CMPSS_TRIPOUT_FILTER);
+    CMPSS_configOutputsLow(cmpssBase, CMPSS_TRIP_FILTER |
+                                      CMPSS_TRIPOUT_FILTER);
+    CMPSS_clearFilterLatchHigh(cmpssBase);
+    CMPSS_clearFilterLatchLow(cmpssBase);
+
+    //
+    // The mux number is in the upper bits of the mux configuration
+    //
+    XBAR_setEPWMMuxConfig(XBAR_TRIP4, comparator->muxConfig);
+    XBAR_enableEPWMMux(XBAR_TRIP4, (uint32_t)1U <<
+                                   ((uint16_t)comparator->muxConfig >> 9U));
+
+    for(i = 0U; i < numEPWM; i++)
+    {
+        protect->epwmBase[i] = epwmBase[i];
+
+        //
+        // TRIP4 high is DCAEVT1, unfiltered and asynchronous, and DCAEVT1
+        // is a one-shot trip driving both outputs low
+        //
+        EPWM_selectDigitalCompareTripInput(epwmBase[i], EPWM_DC_TRIP_TRIPIN4,
+                                           EPWM_DC_TYPE_DCAH);
+        EPWM_setTripZoneDigitalCompareEventCondition(epwmBase[i],
+                                                     EPWM_TZ_DC_OUTPUT_A1,
+                                                     EPWM_TZ_EVENT_DCXH_HIGH);
+        EPWM_setDigitalCompareEventSource(epwmBase[i], EPWM_DC_MODULE_A,
+                                          EPWM_DC_EVENT_1,
+                                          EPWM_DC_EVENT_SOURCE_ORIG_SIGNAL);
+        EPWM_setDigitalCompareEventSyncMode(epwmBase[i], EPWM_DC_MODULE_A,
+                                            EPWM_DC_EVENT_1,
+                                            EPWM_DC_EVENT_INPUT_NOT_SYNCED);
+        EPWM_setTripZoneAction(epwmBase[i], EPWM_TZ_ACTION_EVENT_TZA,
+                               EPWM_TZ_ACTION_LOW);
+        EPWM_setTripZoneAction(epwmBase[i], EPWM_TZ_ACTION_EVENT_TZB,
+                               EPWM_TZ_ACTION_LOW);
+
+        EPWM_clearOneShotTripZoneFlag(epwmBase[i], EPWM_TZ_OST_FLAG_DCAEVT1);
+        EPWM_clearTripZoneFlag(epwmBase[i], PWMPROTECT_TZ_FLAGS);
+        EPWM_enableTripZoneSignals(epwmBase[i], EPWM_TZ_SIGNAL_DCAEVT1);
+    }
+
+    EPWM_enableTripZoneInterrupt(epwmBase[0], EPWM_TZ_INTERRUPT_OST);
+}
+
+//*****************************************************************************
+//
+// PWMProtect_tripISR
+//
+//*****************************************************************************
+void
+PWMProtect_tripISR(PWMProtect_State *protect)
+{
+    uint16_t status = CMPSS_getStatus(protect->cmpssBase);
+    uint16_t sources = protect->sources;
+
+    if((status & CMPSS_STS_HI_LATCHFILTOUT) != 0U)
+    {
+        sources |= PWMPROTECT_SOURCE_HIGH;
+    }
+    if((status & CMPSS_STS_LO_LATCHFILTOUT) != 0U)
+    {
+        sources |= PWMPROTECT_SOURCE_LOW;
+    }
+
+    protect->sources = sources;
+    protect->latched = true;
+    if(protect->faults != UINT16_MAX)
+    {
+        protect->faults++;
+    }
+}
+
+//*****************************************************************************
+//
+// PWMProtect_force
+//
+//*****************************************************************************
+void
+PWMProtect_force(PWMProtect_State *protect)
+{
+    uint16_t i;
+
+    for(i = 0U; i < protect->numEPWM; i++)
+    {
+        EPWM_forceTripZoneEvent(protect->epwmBase[i],
+                                EPWM_TZ_FORCE_EVENT_OST);
+    }
+
+    protect->sources |= PWMPROTECT_SOURCE_FORCE;
+    protect->latched = true;
+}
+
+//*****************************************************************************
+//
+// PWMProtect_isFaultActive
+//
+//*****************************************************************************
+bool
+PWMProtect_isFaultActive(const PWMProtect_State *protect)
+{
+    return((CMPSS_getStatus(protect->cmpssBase) &
+            (CMPSS_STS_HI_FILTOUT | CMPSS_STS_LO_FILTOUT)) != 0U);
+}
+
+//*****************************************************************************
+//
+// PWMProtect_restart
+//
+//*****************************************************************************
+bool
+PWMProtect_restart(PWMProtect_State *protect)
+{
+    uint16_t i;
+
+    if(PWMProtect_isFaultActive(protect))
+    {
+        return(false);
+    }
+
+    CMPSS_clearFilterLatchHigh(protect->cmpssBase);
+    CMPSS_clearFilterLatchLow(protect->cmpssBase);
+
+    //
+    // Release all modules back to back, so they restart in step
+    //
+    for(i = 0U; i < protect->numEPWM; i++)
+    {
+        EPWM_clearOneShotTripZoneFlag(protect->epwmBase[i],
+                                      EPWM_TZ_OST_FLAG_DCAEVT1);
+    }
+    for(i = 0U; i < protect->numEPWM; i++)
+    {
+        EPWM_clearTripZoneFlag(protect->epwmBase[i], PWMPROTECT_TZ_FLAGS);
+    }
+
+    protect->sources = 0U;
+    protect->latched = false;
+
+    return(true);
+}
@@ -0,0 +1,208 @@
+//#############################################################################
+//
+// FILE:   pwm_protect.h
+//
+// TITLE:  Comparator trip-zone protection of ePWM outputs.
+//
+//#############################################################################
+//
+// A CMPSS module watches an analog signal against a high and a low
+// threshold set on its DACs, the low comparator inverted so that both trip
+// outputs go high on a fault. Their OR is routed through the ePWM X-BAR to
+// TRIP4, where it raises DCAEVT1 of every protected ePWM module as a
+// one-shot trip that drives both outputs low. The path from the comparator
+// to the pins is pure hardware: the outputs are forced off a digital
+// filter delay plus a few SYSCLK cycles after the signal crosses a
+// threshold, whatever the CPU is doing.
+//
+// The one-shot trip holds the outputs off until software clears it. The
+// trip-zone interrupt of the first protected module records the fault;
+// the ISR calls PWMProtect_tripISR(). The interrupt flag stays set until
+// the restart, so a trip interrupts once however long the fault lasts.
+// PWMProtect_force() trips all modules from software, for an emergency
+// stop or before powering down.
+//
+// PWMProtect_restart() is the controlled way back: it refuses while the
+// signal is still beyond a threshold, and otherwise clears the comparator
+// latches and then the trips of all modules at once. The caller puts the
+// compare values into a safe state first, since the outputs follow them
+// again from the next action qualifier event on.
+//
+//#############################################################################
+
+#ifndef PWM_PROTECT_H
+#define PWM_PROTECT_H
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//
+// Included Files
+//
+#include <stdbool.h>
+#include <stdint.h>
+#include "driverlib.h"
+
+//*****************************************************************************
+//
+// Largest number of protected ePWM modules
+//
+//*****************************************************************************
+#define PWMPROTECT_MAX_EPWM     4U
+
+//*****************************************************************************
+//
+// Values in the sources field of PWMProtect_State
+//
+//*****************************************************************************
+#define PWMPROTECT_SOURCE_HIGH  0x0001U     //!< Above the high threshold
+#define PWMPROTECT_SOURCE_LOW   0x0002U     //!< Below the low threshold
+#define PWMPROTECT_SOURCE_FORCE 0x0004U     //!< PWMProtect_force()
+
+//*****************************************************************************
+//
+//! Comparator setup of a protected signal.
+//
+//*****************************************************************************
+typedef struct
+{
+    uint32_t cmpssBase;                 //!< CMPSS module
+    XBAR_EPWMMuxConfig muxConfig;       //!< Its CTRIPH_OR_L on the X-BAR
+    uint16_t highThreshold;             //!< High DAC value, 12 bits
+    uint16_t lowThreshold;              //!< Low DAC value, 12 bits
+    uint16_t filterPrescale;            //!< Filter sample clock divider
+    uint16_t filterWindow;              //!< Filter window in samples
+} PWMProtect_Comparator;
+
+//*****************************************************************************
+//
+//! State of the protection. Initialize with PWMProtect_init().
+//
+//*****************************************************************************
+typedef struct
+{
+    uint32_t cmpssBase;                 //!< CMPSS module
+    uint32_t epwmBase[PWMPROTECT_MAX_EPWM]; //!< Protected ePWM modules
+    uint16_t numEPWM;                   //!< Entries in epwmBase
+    volatile bool latched;              //!< Outputs held off by a trip
+    volatile uint16_t sources;          //!< PWMPROTECT_SOURCE_* latched
+    volatile uint16_t faults;           //!< Trips since reset, saturating
+} PWMProtect_State;
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+//*****************************************************************************
+//
+//! Sets up the comparator, the X-BAR and the trip zones of the protected
+//! modules.
+//!
+//! \param protect is the state to initialize.
+//! \param comparator is the comparator setup. The analog input of the CMPSS
+//! must already be selected with ASysCtl_selectCMPHPMux() and
+//! ASysCtl_selectCMPLPMux().
+//! \param epwmBase is the array of protected ePWM base addresses.
+//! \param numEPWM is the number of entries in \e epwmBase, 1 to
+//! \b PWMPROTECT_MAX_EPWM.
+//!
+//! Uses TRIP4 of the ePWM X-BAR and digital compare A of each module, and
+//! enables the one-shot trip-zone interrupt of the first module. The caller
+//! registers and enables that interrupt in the PIE.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+PWMProtect_init(PWMProtect_State *protect,
+                const PWMProtect_Comparator *comparator,
+                const uint32_t *epwmBase, uint16_t numEPWM);
+
+//*****************************************************************************
+//
+//! Records a trip.
+//!
+//! \param protect is the protection.
+//!
+//! Call from the trip-zone ISR of the first protected module. The outputs
+//! and the trip-zone interrupt flag stay set until PWMProtect_restart().
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+PWMProtect_tripISR(PWMProtect_State *protect);
+
+//*****************************************************************************
+//
+//! Trips all protected modules from software.
+//!
+//! \param protect is the protection.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+PWMProtect_force(PWMProtect_State *protect);
+
+//*****************************************************************************
+//
+//! Returns whether the signal is beyond a threshold right now.
+//!
+//! \param protect is the protection.
+//!
+//! \return Returns \b true while a comparator filter output is high.
+//
+//*****************************************************************************
+extern bool
+PWMProtect_isFaultActive(const PWMProtect_State *protect);
+
+//*****************************************************************************
+//
+//! Releases the outputs after a trip.
+//!
+//! \param protect is the protection.
+//!
+//! Put the compare values into a safe state before the call.
+//!
+//! \return Returns \b false, leaving the outputs off, if the signal is
+//! still beyond a threshold, and \b true once the trips are cleared.
+//
+//*****************************************************************************
+extern bool
+PWMProtect_restart(PWMProtect_State *protect);
+
+//*****************************************************************************
+//
+//! Returns whether the outputs are held off by a trip.
+//!
+//! \param protect is the protection.
+//!
+//! \return Returns \b true from a trip until PWMProtect_restart().
+//
+//*****************************************************************************
+static inline bool
+PWMProtect_isLatched(const PWMProtect_State *protect)
+{
+    return(protect->latched);
+}
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PWM_PROTECT_H
@@ -0,0 +1,276 @@
+//#############################################################################
+//
+// FILE:   pwm_ramp.c
+//
+// TITLE:  Slew-rate limited period and compare setpoints.
+//
+//#############################################################################
+
+//
+// Included Files
+//
+#include "pwm_ramp.h"
+#include "pwm_hr.h"
+#include "pwm_update.h"
+
+#ifndef __cplusplus
+#pragma CODE_SECTION(PWMRamp_stop, ".TI.ramfunc");
+#pragma CODE_SECTION(PWMRamp_step, ".TI.ramfunc");
+#endif
+
+//
+// Rounds an HR count to whole counts
+//
+#define PWMRAMP_WHOLE(count)                                                  \
+    ((uint16_t)(((count) + (PWMHR_COUNT_ONE / 2U)) >> PWMHR_COUNT_S))
+
+//*****************************************************************************
+//
+// PWMRamp_move
+//
+// Moves a value towards a target by at most step
+//
+//*****************************************************************************
+static inline uint32_t
+PWMRamp_move(uint32_t value, uint32_t target, uint32_t step)
+{
+    if(value < target)
+    {
+        return(((target - value) > step) ? (value + step) : target);
+    }
+
+    return(((value - target) > step) ? (value - step) : target);
+}
+
+//*****************************************************************************
+//
+// PWMRamp_begin
+//
+// Prepares new targets; an idle channel restarts from the registers
+//
+//*****************************************************************************
+static void
+PWMRamp_begin(PWMRamp_Channel *channel)
+{
+    if(channel->active)
+    {
+        return;
+    }
+
+    channel->period = HRPWM_getTimeBasePeriod(channel->base);
+    channel->compareA = HRPWM_getCounterCompareValue(channel->base,
+                                                     HRPWM_COUNTER_COMPARE_A);
+    channel->compareB = HRPWM_getCounterCompareValue(channel->base,
+                                                     HRPWM_COUNTER_COMPARE_B);
+    channel->targetPeriod = channel->period;
+    channel->targetA = channel->compareA;
+    channel->targetB = channel->compareB;
+}
+
+//*****************************************************************************
+//
+// PWMRamp_activate
+//
+//*****************************************************************************
+static void
+PWMRamp_activate(PWMRamp_Channel *channel)
+{
+    channel->active = true;
+    if(channel->ownsInterrupt)
+    {
+        EPWM_enableInterrupt(channel->base);
+    }
+}
+
+//*****************************************************************************
+//
+// PWMRamp_initChannel
+//
+//*****************************************************************************
+void
+PWMRamp_initChannel(PWMRamp_Channel *channel, uint32_t base,
+                    uint16_t registers, uint32_t periodStep,
+                    uint32_t compareStep)
+{
+    ASSERT(EPWM_isBaseValid(base));
+    ASSERT((registers != 0U) &&
+           ((registers & ~(PWMRAMP_PERIOD | PWMRAMP_COMPARE)) == 0U));
+
+    channel->base = base;
+    channel->registers = registers;
+    channel->highResolution = PWMHR_isEnabled(base);
+    channel->ownsInterrupt = (HWREGH(base + EPWM_O_ETSEL) &
+                              EPWM_ETSEL_INTEN) == 0U;
+    channel->active = false;
+
+    PWMRamp_setRate(channel, periodStep, compareStep);
+    PWMRamp_begin(channel);
+}
+
+//*****************************************************************************
+//
+// PWMRamp_setRate
+//
+//*****************************************************************************
+void
+PWMRamp_setRate(PWMRamp_Channel *channel, uint32_t periodStep,
+                uint32_t compareStep)
+{
+    ASSERT((periodStep != 0U) && (compareStep != 0U));
+
+    channel->periodStep = periodStep;
+    channel->compareStep = compareStep;
+}
+
+//*****************************************************************************
+//
+// PWMRamp_start
+//
+//*****************************************************************************
+void
+PWMRamp_start(PWMRamp_Channel *channel, uint32_t period, uint32_t compareA,
+              uint32_t compareB)
+{
+    PWMRamp_begin(channel);
+    if((channel->registers & PWMRAMP_PERIOD) != 0U)
+    {
+        ASSERT(period <= PWMHR_COUNT_MAX);
+        channel->targetPeriod = period;
+    }
+    if((channel->registers & PWMRAMP_COMPARE) != 0U)
+    {
+        ASSERT((compareA <= PWMHR_COUNT_MAX) && (compareB <= PWMHR_COUNT_MAX));
+        channel->targetA = compareA;
+        channel->targetB = compareB;
+    }
+    PWMRamp_activate(channel);
+}
+
+//*****************************************************************************
+//
+// PWMRamp_startPeriod
+//
+//*****************************************************************************
+void
+PWMRamp_startPeriod(PWMRamp_Channel *channel, uint32_t period)
+{
+    PWMRamp_begin(channel);
+    PWMRamp_start(channel, period, channel->targetA, channel->targetB);
+}
+
+//*****************************************************************************
+//
+// PWMRamp_startCompare
+//
+//*****************************************************************************
+void
+PWMRamp_startCompare(PWMRamp_Channel *channel, uint32_t compareA,
+                     uint32_t compareB)
+{
+    PWMRamp_begin(channel);
+    PWMRamp_start(channel, channel->targetPeriod, compareA, compareB);
+}
+
+//*****************************************************************************
+//
+// PWMRamp_stop
+//
+//*****************************************************************************
+void
+PWMRamp_stop(PWMRamp_Channel *channel)
+{
+    channel->active = false;
+    channel->targetPeriod = channel->period;
+    channel->targetA = channel->compareA;
+    channel->targetB = channel->compareB;
+    if(channel->ownsInterrupt)
+    {
+        EPWM_disableInterrupt(channel->base);
+    }
+}
+
+//*****************************************************************************
+//
+// PWMRamp_step
+//
+//*****************************************************************************
+void
+PWMRamp_step(PWMRamp_Channel *channel)
+{
+    uint32_t base = channel->base;
+    uint32_t period;
+    uint32_t compareA;
+    uint32_t compareB;
+
+    if(!channel->active)
+    {
+        return;
+    }
+
+    period = PWMRamp_move(channel->period, channel->targetPeriod,
+                          channel->periodStep);
+    compareA = PWMRamp_move(channel->compareA, channel->targetA,
+                            channel->compareStep);
+    compareB = PWMRamp_move(channel->compareB, channel->targetB,
+                            channel->compareStep);
+
+    channel->period = period;
+    channel->compareA = compareA;
+    channel->compareB = compareB;
+
+    if((period == channel->targetPeriod) &&
+       (compareA == channel->targetA) && (compareB == channel->targetB))
+    {
+        PWMRamp_stop(channel);
+    }
+
+    switch(channel->registers)
+    {
+        case PWMRAMP_PERIOD:
+            if(channel->highResolution)
+            {
+                PWMHR_setPeriod(base, period);
+            }
+            else
+            {
+                PWMUpdate_setPeriod(base, PWMRAMP_WHOLE(period));
+            }
+            break;
+
+        case PWMRAMP_COMPARE:
+            if(channel->highResolution)
+            {
+                PWMHR_setCompare(base, compareA, compareB);
+            }
+            else
+            {
+                PWMUpdate_setCompare(base, PWMRAMP_WHOLE(compareA),
+                                     PWMRAMP_WHOLE(compareB));
+            }
+            break;
+
+        default:
+            //
+            // Compare values beyond the period would never match
+            //
+            if(compareA > period)
+            {
+                compareA = period;
+            }
+            if(compareB > period)
+            {
+                compareB = period;
+            }
+            if(channel->highResolution)
+            {
+                PWMHR_setPeriodAndCompare(base, period, compareA, compareB);
+            }
+            else
+            {
+                PWMUpdate_setPeriodAndCompare(base, PWMRAMP_WHOLE(period),
+                                              PWMRAMP_WHOLE(compareA),
+                                              PWMRAMP_WHOLE(compareB));
+            }
+            break;
+    }
+}
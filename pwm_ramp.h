@@ -0,0 +1,249 @@
+//#############################################################################
+//
+// FILE:   pwm_ramp.h
+//
+// TITLE:  Slew-rate limited period and compare setpoints.
+//
+//#############################################################################
+//
+// A new period or duty cycle written in one step changes the output
+// voltage at once, which draws an inrush current into the load and makes
+// magnetics sing. A ramp channel moves TBPRD, CMPA and CMPB of one ePWM
+// module from their present values to a target by at most a fixed step per
+// PWM period instead, so every change becomes a straight line of a known
+// slope. Starting the outputs at the lowest duty and ramping to the working
+// point gives a soft start.
+//
+// PWMRamp_step() runs in the ePWM interrupt of the module, once per period.
+// Each call moves the three values by one step with a fixed sequence of
+// compares and writes them through the global load of pwm_update.h, or of
+// pwm_hr.h when the module has high-resolution edges, so a step costs the
+// same whatever the targets are and all three registers load together.
+// Channels are independent, so any number of modules ramp at the same time.
+//
+// Values are in HR counts (see pwm_hr.h) for every module; modules without
+// the MEP get them rounded to whole counts. A channel may own only the
+// period or only the compare values of its module, and then leaves the
+// others to whoever else writes them, such as a modulation table.
+//
+// While a channel owns both, compare values are limited to the period
+// written with them, so a period ramping down faster than its compare
+// values never leaves a compare match out of reach.
+//
+// The ePWM interrupt of the module must be routed to the ISR. If it is off
+// when the channel is initialized, the channel turns it on for the length
+// of each ramp only, so an idle channel costs no interrupts.
+//
+//#############################################################################
+
+#ifndef PWM_RAMP_H
+#define PWM_RAMP_H
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//
+// Included Files
+//
+#include <stdbool.h>
+#include <stdint.h>
+#include "driverlib.h"
+
+//*****************************************************************************
+//
+// Values that can be passed to PWMRamp_initChannel() as the registers
+// parameter
+//
+//*****************************************************************************
+#define PWMRAMP_PERIOD          0x0001U     //!< The channel ramps TBPRD
+#define PWMRAMP_COMPARE         0x0002U     //!< The channel ramps CMPA/CMPB
+
+//*****************************************************************************
+//
+//! State of one ramped ePWM module. Initialize with PWMRamp_initChannel().
+//
+//*****************************************************************************
+typedef struct
+{
+    uint32_t base;              //!< ePWM base address
+    uint16_t registers;         //!< PWMRAMP_PERIOD and/or PWMRAMP_COMPARE
+    bool highResolution;        //!< Written through pwm_hr.h
+    bool ownsInterrupt;         //!< Turns the ePWM interrupt on and off
+    volatile bool active;       //!< A ramp is in progress
+    uint32_t periodStep;        //!< Largest period change per step
+    uint32_t compareStep;       //!< Largest compare change per step
+    uint32_t period;            //!< Period last written
+    uint32_t compareA;          //!< CMPA last written
+    uint32_t compareB;          //!< CMPB last written
+    uint32_t targetPeriod;      //!< Period to ramp to
+    uint32_t targetA;           //!< CMPA to ramp to
+    uint32_t targetB;           //!< CMPB to ramp to
+} PWMRamp_Channel;
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+//*****************************************************************************
+//
+//! Initializes a ramp channel.
+//!
+//! \param channel is the channel.
+//! \param base is the base address of the ePWM module.
+//! \param registers is the logical OR of \b PWMRAMP_PERIOD and
+//! \b PWMRAMP_COMPARE, the registers the channel ramps.
+//! \param periodStep is the largest period change per PWM period in HR
+//! counts, at least 1.
+//! \param compareStep is the largest compare change per PWM period in HR
+//! counts, at least 1.
+//!
+//! Call once the period and compare registers hold their start values and
+//! the interrupt source of the module is selected. Registers the channel
+//! owns must load from their shadows on counter zero, directly or through
+//! PWMUpdate_init(); a module with high-resolution edges must be set up
+//! with PWMHR_init(). The channel starts idle, with the targets at the
+//! present register values.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+PWMRamp_initChannel(PWMRamp_Channel *channel, uint32_t base,
+                    uint16_t registers, uint32_t periodStep,
+                    uint32_t compareStep);
+
+//*****************************************************************************
+//
+//! Changes the slew rates of a ramp channel.
+//!
+//! \param channel is the channel.
+//! \param periodStep is the largest period change per PWM period in HR
+//! counts, at least 1.
+//! \param compareStep is the largest compare change per PWM period in HR
+//! counts, at least 1.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+PWMRamp_setRate(PWMRamp_Channel *channel, uint32_t periodStep,
+                uint32_t compareStep);
+
+//*****************************************************************************
+//
+//! Starts a ramp towards new targets.
+//!
+//! \param channel is the channel.
+//! \param period is the target period in HR counts.
+//! \param compareA is the target CMPA value in HR counts.
+//! \param compareB is the target CMPB value in HR counts.
+//!
+//! Targets of registers the channel does not own are ignored. An idle
+//! channel starts from the values in the registers, so writes made around
+//! it are picked up; a running ramp turns towards the new targets from
+//! where it is. The ePWM interrupt must not run during the call.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+PWMRamp_start(PWMRamp_Channel *channel, uint32_t period, uint32_t compareA,
+              uint32_t compareB);
+
+//*****************************************************************************
+//
+//! Starts a ramp towards a new period, keeping the compare targets.
+//!
+//! \param channel is the channel.
+//! \param period is the target period in HR counts.
+//!
+//! See PWMRamp_start().
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+PWMRamp_startPeriod(PWMRamp_Channel *channel, uint32_t period);
+
+//*****************************************************************************
+//
+//! Starts a ramp towards new compare values, keeping the period target.
+//!
+//! \param channel is the channel.
+//! \param compareA is the target CMPA value in HR counts.
+//! \param compareB is the target CMPB value in HR counts.
+//!
+//! See PWMRamp_start().
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+PWMRamp_startCompare(PWMRamp_Channel *channel, uint32_t compareA,
+                     uint32_t compareB);
+
+//*****************************************************************************
+//
+//! Stops a ramp where it is.
+//!
+//! \param channel is the channel.
+//!
+//! The registers keep the values last written, which become the targets.
+//! Stop the channel before writing its registers by other means.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+PWMRamp_stop(PWMRamp_Channel *channel);
+
+//*****************************************************************************
+//
+//! Moves the registers of a channel one step towards the targets.
+//!
+//! \param channel is the channel.
+//!
+//! Call once per period from the ePWM interrupt of the module. Returns at
+//! once when the channel is idle.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+PWMRamp_step(PWMRamp_Channel *channel);
+
+//*****************************************************************************
+//
+//! Tells whether a ramp is in progress.
+//!
+//! \param channel is the channel.
+//!
+//! \return Returns \b true from PWMRamp_start() until the targets are
+//! written or the ramp is stopped.
+//
+//*****************************************************************************
+static inline bool
+PWMRamp_isActive(const PWMRamp_Channel *channel)
+{
+    return(channel->active);
+}
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PWM_RAMP_H
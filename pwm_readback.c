@@ -0,0 +1,688 @@
+//#############################################################################
+//
+// FILE:   pwm_readback.c
+//
+// TITLE:  Output frequency and duty read back from ePWM registers.
+//
+//#############################################################################
+
+//
+// Included Files
+//
+#include "pwm_readback.h"
+
+//
+// Defines
+//
+#define PWMREADBACK_TIME_BASE_M (EPWM_TBCTL_CTRMODE_M |                       \
+                                 EPWM_TBCTL_HSPCLKDIV_M |                     \
+                                 EPWM_TBCTL_CLKDIV_M)
+#define PWMREADBACK_HR_CONFIG_M (HRPWM_HRCNFG_EDGMODE_M |                    \
+                                 HRPWM_HRCNFG_CTLMODE |                      \
+                                 HRPWM_HRCNFG_EDGMODEB_M |                   \
+                                 HRPWM_HRCNFG_CTLMODEB |                     \
+                                 HRPWM_HRCNFG_AUTOCONV)
+#define PWMREADBACK_DEAD_BAND_M (EPWM_DBCTL_OUT_MODE_M |                      \
+                                 EPWM_DBCTL_POLSEL_M |                        \
+                                 EPWM_DBCTL_IN_MODE_M |                       \
+                                 EPWM_DBCTL_OUTSWAP_M |                       \
+                                 EPWM_DBCTL_DEDB_MODE |                       \
+                                 EPWM_DBCTL_HALFCYCLE)
+#define PWMREADBACK_NUM_EVENTS  6U      // ZRO, PRD, CAU, CAD, CBU, CBD
+#define PWMREADBACK_NEVER       0xFFFFU // Rank of an event a mode lacks
+#define PWMREADBACK_MILLI_DIGITS 3U
+#define PWMREADBACK_FINE_S      8U      // Fine time: 1/256 TBCLK count
+#define PWMREADBACK_DUTY_BITS   15U
+
+//
+// DBCTL fields: OUT_MODE bit 1 takes ePWMxA from the rising-edge delay
+// path and bit 0 ePWMxB from the falling-edge delay path; POLSEL inverts
+// the paths and IN_MODE feeds them from ePWMxB instead of ePWMxA
+//
+#define PWMREADBACK_DB_OUT_A    0x0002U
+#define PWMREADBACK_DB_OUT_B    0x0001U
+#define PWMREADBACK_DB_INV_RED  0x0004U
+#define PWMREADBACK_DB_INV_FED  0x0008U
+#define PWMREADBACK_DB_IN_RED_B 0x0010U
+#define PWMREADBACK_DB_IN_FED_B 0x0020U
+
+//
+// Typedefs
+//
+typedef struct
+{
+    uint32_t time;                  // TBCLK counts after the period start
+    uint16_t event;                 // Index in AQCTL field order
+    uint16_t rank;                  // Priority, lowest wins
+    uint16_t action;                // EPWM_AQ_OUTPUT_* action
+} PWMReadback_Event;
+
+typedef struct
+{
+    uint16_t count;                 // Number of edges in the period
+    uint16_t startLevel;            // Level at the start of the period
+    uint32_t time[PWMREADBACK_NUM_EVENTS]; // Fine time of each edge
+    uint16_t level[PWMREADBACK_NUM_EVENTS]; // Level after each edge
+} PWMReadback_Waveform;
+
+//
+// Globals
+//
+// Priority of the events that coincide, per counter mode and in AQCTL field
+// order. Counting up, a compare at TBPRD loses to PRD but one at 0 wins
+// over ZRO; counting down the other way round; counting up-down both lose.
+//
+static const uint16_t PWMReadback_rank[3][PWMREADBACK_NUM_EVENTS] =
+{
+    { 5U, 2U, 4U, PWMREADBACK_NEVER, 3U, PWMREADBACK_NEVER },
+    { 2U, 5U, PWMREADBACK_NEVER, 4U, PWMREADBACK_NEVER, 3U },
+    { 4U, 4U, 3U, 3U, 2U, 2U }
+};
+
+//*****************************************************************************
+//
+// PWMReadback_getEventTime
+//
+// Returns when in the period a counter event happens, or false if it
+// never does
+//
+//*****************************************************************************
+static bool
+PWMReadback_getEventTime(uint16_t mode, uint16_t event, uint16_t period,
+                         uint16_t compareA, uint16_t compareB, uint32_t *time)
+{
+    uint16_t compare = ((event == 4U) || (event == 5U)) ? compareB : compareA;
+
+    if(event == 0U)
+    {
+        //
+        // ZRO starts the period, except counting down where it ends it
+        //
+        *time = (mode == (uint16_t)EPWM_COUNTER_MODE_DOWN) ? period : 0U;
+        return(true);
+    }
+
+    if(event == 1U)
+    {
+        *time = (mode == (uint16_t)EPWM_COUNTER_MODE_DOWN) ? 0U : period;
+        return(true);
+    }
+
+    if(compare > period)
+    {
+        return(false);
+    }
+
+    if(mode == (uint16_t)EPWM_COUNTER_MODE_UP)
+    {
+        *time = compare;
+    }
+    else if(mode == (uint16_t)EPWM_COUNTER_MODE_DOWN)
+    {
+        *time = (uint32_t)period - compare;
+    }
+    else if((event == 2U) || (event == 4U))
+    {
+        //
+        // Counting up-down, the counter rises from 0 and falls from TBPRD:
+        // a compare at TBPRD happens on the way down, one at 0 on the way up
+        //
+        if(compare == period)
+        {
+            return(false);
+        }
+        *time = compare;
+    }
+    else
+    {
+        if(compare == 0U)
+        {
+            return(false);
+        }
+        *time = (2UL * period) - compare;
+    }
+
+    return(true);
+}
+
+//*****************************************************************************
+//
+// PWMReadback_getEdgeOffset
+//
+// Returns how far, in fine time, the MEP moves an edge of an output from
+// its TBCLK count. Only fractions the hardware auto-converts are in 1/256
+// count; without auto-conversion they are MEP steps of unknown size and
+// are left out.
+//
+//*****************************************************************************
+static int32_t
+PWMReadback_getEdgeOffset(const PWMReadback_Channel *channel, uint16_t output,
+                          uint16_t event, uint16_t level)
+{
+    uint16_t edgeMode;
+    int32_t fraction;
+
+    if((channel->hrConfig & HRPWM_HRCNFG_AUTOCONV) == 0U)
+    {
+        return(0);
+    }
+
+    if(output == 0U)
+    {
+        if((channel->hrConfig & HRPWM_HRCNFG_CTLMODE) != 0U)
+        {
+            return(0);
+        }
+        edgeMode = channel->hrConfig & HRPWM_HRCNFG_EDGMODE_M;
+        fraction = (int32_t)channel->compareAHR;
+    }
+    else
+    {
+        if((channel->hrConfig & HRPWM_HRCNFG_CTLMODEB) != 0U)
+        {
+            return(0);
+        }
+        edgeMode = (channel->hrConfig & HRPWM_HRCNFG_EDGMODEB_M) >>
+                   HRPWM_HRCNFG_EDGMODEB_S;
+        fraction = (int32_t)channel->compareBHR;
+    }
+
+    //
+    // Controlling both edges, meant for up-down counting, delays the edges
+    // of the up-count compare events and advances those of the down-count
+    // ones; controlling one edge delays every edge of that direction
+    //
+    if(edgeMode == (uint16_t)HRPWM_MEP_CTRL_RISING_AND_FALLING_EDGE)
+    {
+        if((event == 2U) || (event == 4U))
+        {
+            return(fraction);
+        }
+        if((event == 3U) || (event == 5U))
+        {
+            return(-fraction);
+        }
+        return(0);
+    }
+
+    if(((edgeMode == (uint16_t)HRPWM_MEP_CTRL_RISING_EDGE) && (level != 0U)) ||
+       ((edgeMode == (uint16_t)HRPWM_MEP_CTRL_FALLING_EDGE) && (level == 0U)))
+    {
+        return(fraction);
+    }
+
+    return(0);
+}
+
+//*****************************************************************************
+//
+// PWMReadback_getWaveform
+//
+// Works out the edges one action qualifier output makes in a period
+//
+//*****************************************************************************
+static void
+PWMReadback_getWaveform(const PWMReadback_Channel *channel, uint16_t mode,
+                        uint16_t output, PWMReadback_Waveform *waveform)
+{
+    PWMReadback_Event events[PWMREADBACK_NUM_EVENTS];
+    uint16_t actions = (output == 0U) ? channel->actionA : channel->actionB;
+    uint16_t count = 0U;
+    uint16_t action;
+    uint16_t rank;
+    uint16_t level;
+    uint16_t next;
+    uint16_t i;
+    uint16_t j;
+    uint32_t time;
+
+    //
+    // The events of the period that act on the output, sorted by time;
+    // of those at the same time only the highest priority one acts
+    //
+    for(i = 0U; i < PWMREADBACK_NUM_EVENTS; i++)
+    {
+        action = (actions >> (2U * i)) & 0x3U;
+        rank = PWMReadback_rank[mode][i];
+        if((action == (uint16_t)EPWM_AQ_OUTPUT_NO_CHANGE) ||
+           (rank == PWMREADBACK_NEVER) ||
+           !PWMReadback_getEventTime(mode, i, channel->period,
+                                     channel->compareA, channel->compareB,
+                                     &time))
+        {
+            continue;
+        }
+
+        for(j = 0U; (j < count) && (events[j].time != time); j++)
+        {
+        }
+        if(j < count)
+        {
+            if(rank < events[j].rank)
+            {
+                events[j].event = i;
+                events[j].rank = rank;
+                events[j].action = action;
+            }
+            continue;
+        }
+
+        for(j = count; (j > 0U) && (events[j - 1U].time > time); j--)
+        {
+            events[j] = events[j - 1U];
+        }
+        events[j].time = time;
+        events[j].event = i;
+        events[j].rank = rank;
+        events[j].action = action;
+        count++;
+    }
+
+    //
+    // One period settles the level the output enters the next one with,
+    // the second records where it changes
+    //
+    level = 0U;
+    for(i = 0U; i < count; i++)
+    {
+        level = (events[i].action == (uint16_t)EPWM_AQ_OUTPUT_TOGGLE) ?
+                (level ^ 1U) :
+                ((events[i].action == (uint16_t)EPWM_AQ_OUTPUT_HIGH) ? 1U :
+                                                                       0U);
+    }
+
+    //
+    // Counting up and down, the MEP stretches the period where the counter
+    // turns at TBPRD, so every edge of the down count comes that much later
+    //
+    waveform->startLevel = level;
+    waveform->count = 0U;
+    for(i = 0U; i < count; i++)
+    {
+        next = (events[i].action == (uint16_t)EPWM_AQ_OUTPUT_TOGGLE) ?
+               (level ^ 1U) :
+               ((events[i].action == (uint16_t)EPWM_AQ_OUTPUT_HIGH) ? 1U :
+                                                                      0U);
+        if(next != level)
+        {
+            time = events[i].time << PWMREADBACK_FINE_S;
+            if((mode == (uint16_t)EPWM_COUNTER_MODE_UP_DOWN) &&
+               (events[i].time > channel->period))
+            {
+                time += 2UL * channel->periodHR;
+            }
+            waveform->time[waveform->count] =
+                (uint32_t)((int32_t)time +
+                           PWMReadback_getEdgeOffset(channel, output,
+                                                     events[i].event, next));
+            waveform->level[waveform->count] = next;
+            waveform->count++;
+            level = next;
+        }
+    }
+}
+
+//*****************************************************************************
+//
+// PWMReadback_getTime
+//
+// Returns the fine time per period an output spends at one level, with
+// every stretch at that level shortened by a delay. The stretch that runs
+// across the end of the period counts as one.
+//
+//*****************************************************************************
+static uint32_t
+PWMReadback_getTime(const PWMReadback_Waveform *waveform, uint32_t cycle,
+                    uint16_t level, uint32_t delay)
+{
+    uint32_t total = 0U;
+    uint32_t end;
+    uint16_t i;
+
+    if(waveform->count == 0U)
+    {
+        return((waveform->startLevel == level) ? cycle : 0U);
+    }
+
+    for(i = 0U; i < waveform->count; i++)
+    {
+        end = ((i + 1U) < waveform->count) ? waveform->time[i + 1U] :
+                                             (cycle + waveform->time[0]);
+        if((waveform->level[i] == level) &&
+           (end > (waveform->time[i] + delay)))
+        {
+            total += end - waveform->time[i] - delay;
+        }
+    }
+
+    return(total);
+}
+
+//*****************************************************************************
+//
+// PWMReadback_toDuty
+//
+// Divides a high time by the period, Q15 rounded to nearest, one bit at a
+// time so that no intermediate value exceeds 32 bits
+//
+//*****************************************************************************
+static uint16_t
+PWMReadback_toDuty(uint32_t high, uint32_t cycle)
+{
+    uint32_t remainder;
+    uint16_t duty = 0U;
+    uint16_t i;
+
+    if(high >= cycle)
+    {
+        return(PWMREADBACK_DUTY_ONE);
+    }
+
+    remainder = high;
+    for(i = 0U; i < PWMREADBACK_DUTY_BITS; i++)
+    {
+        remainder <<= 1U;
+        duty <<= 1U;
+        if(remainder >= cycle)
+        {
+            remainder -= cycle;
+            duty |= 1U;
+        }
+    }
+    if((2UL * remainder) >= cycle)
+    {
+        duty++;
+    }
+
+    return(duty);
+}
+
+//*****************************************************************************
+//
+// PWMReadback_computeDuties
+//
+// Derives the duty of both outputs from the action qualifier outputs as
+// the dead band passes them on
+//
+//*****************************************************************************
+static void
+PWMReadback_computeDuties(PWMReadback_Channel *channel, uint16_t mode,
+                          uint32_t cycle)
+{
+    PWMReadback_Waveform waveforms[2];
+    const PWMReadback_Waveform *source;
+    uint16_t deadBand = channel->deadBand;
+    uint32_t risingDelay;
+    uint32_t fallingDelay;
+    uint32_t time;
+
+    if((deadBand & (EPWM_DBCTL_OUTSWAP_M | EPWM_DBCTL_DEDB_MODE)) != 0U)
+    {
+        channel->dutyA = PWMREADBACK_DUTY_UNKNOWN;
+        channel->dutyB = PWMREADBACK_DUTY_UNKNOWN;
+        return;
+    }
+
+    PWMReadback_getWaveform(channel, mode, 0U, &waveforms[0]);
+    PWMReadback_getWaveform(channel, mode, 1U, &waveforms[1]);
+
+    //
+    // The delay counters count TBCLK cycles, or half cycles
+    //
+    risingDelay = (uint32_t)channel->risingDelay << PWMREADBACK_FINE_S;
+    fallingDelay = (uint32_t)channel->fallingDelay << PWMREADBACK_FINE_S;
+    if((deadBand & EPWM_DBCTL_HALFCYCLE) != 0U)
+    {
+        risingDelay >>= 1U;
+        fallingDelay >>= 1U;
+    }
+
+    //
+    // The rising-edge delay shortens every high stretch of its input, the
+    // falling-edge delay every low one
+    //
+    if((deadBand & PWMREADBACK_DB_OUT_A) != 0U)
+    {
+        source = &waveforms[((deadBand & PWMREADBACK_DB_IN_RED_B) != 0U) ?
+                            1U : 0U];
+        time = PWMReadback_getTime(source, cycle, 1U, risingDelay);
+        if((deadBand & PWMREADBACK_DB_INV_RED) != 0U)
+        {
+            time = cycle - time;
+        }
+    }
+    else
+    {
+        time = PWMReadback_getTime(&waveforms[0], cycle, 1U, 0U);
+    }
+    channel->dutyA = PWMReadback_toDuty(time, cycle);
+
+    if((deadBand & PWMREADBACK_DB_OUT_B) != 0U)
+    {
+        source = &waveforms[((deadBand & PWMREADBACK_DB_IN_FED_B) != 0U) ?
+                            1U : 0U];
+        time = PWMReadback_getTime(source, cycle, 0U, fallingDelay);
+        if((deadBand & PWMREADBACK_DB_INV_FED) == 0U)
+        {
+            time = cycle - time;
+        }
+    }
+    else
+    {
+        time = PWMReadback_getTime(&waveforms[1], cycle, 1U, 0U);
+    }
+    channel->dutyB = PWMReadback_toDuty(time, cycle);
+}
+
+//*****************************************************************************
+//
+// PWMReadback_compute
+//
+// Derives frequency and duties from the cached register values
+//
+//*****************************************************************************
+static void
+PWMReadback_compute(PWMReadback_Channel *channel)
+{
+    uint16_t mode = channel->timeBase & EPWM_TBCTL_CTRMODE_M;
+    uint16_t highSpeed = (channel->timeBase & EPWM_TBCTL_HSPCLKDIV_M) >>
+                         EPWM_TBCTL_HSPCLKDIV_S;
+    uint32_t cycle;
+    uint32_t divider;
+    uint32_t remainder;
+    uint32_t stretch;
+    uint32_t scale;
+    uint16_t milliHz;
+    uint16_t fineBits;
+    uint16_t i;
+
+    if(mode == (uint16_t)EPWM_COUNTER_MODE_UP_DOWN)
+    {
+        cycle = 2UL * channel->period;
+        stretch = 2UL * channel->periodHR;
+    }
+    else if(mode != (uint16_t)EPWM_COUNTER_MODE_STOP_FREEZE)
+    {
+        cycle = (uint32_t)channel->period + 1UL;
+        stretch = channel->periodHR;
+    }
+    else
+    {
+        cycle = 0U;
+        stretch = 0U;
+    }
+
+    if(cycle == 0U)
+    {
+        channel->frequency = 0U;
+        channel->frequencyMilliHz = 0U;
+        channel->dutyA = 0U;
+        channel->dutyB = 0U;
+        return;
+    }
+
+    //
+    // Module clocks per period: TBCLK counts times CLKDIV (1 to 128) times
+    // HSPCLKDIV (1 to 14), below 2^28. The MEP stretch of the period is
+    // counted in fine time as long as that stays below 2^28 as well.
+    //
+    scale = 1UL << ((channel->timeBase & EPWM_TBCTL_CLKDIV_M) >>
+                    EPWM_TBCTL_CLKDIV_S);
+    if(highSpeed != 0U)
+    {
+        scale *= 2U * highSpeed;
+    }
+    divider = cycle * scale;
+    cycle = (cycle << PWMREADBACK_FINE_S) + stretch;
+    if((stretch != 0U) && ((divider >> (28U - PWMREADBACK_FINE_S)) == 0U))
+    {
+        divider = cycle * scale;
+        fineBits = PWMREADBACK_FINE_S;
+    }
+    else
+    {
+        fineBits = 0U;
+    }
+
+    //
+    // Whole Hz, then the mHz one decimal digit at a time so that no
+    // intermediate value exceeds 32 bits; rounded to the nearest mHz
+    //
+    channel->frequency = channel->clockFreq / divider;
+    remainder = channel->clockFreq % divider;
+    for(i = 0U; i < fineBits; i++)
+    {
+        remainder <<= 1U;
+        channel->frequency <<= 1U;
+        if(remainder >= divider)
+        {
+            remainder -= divider;
+            channel->frequency |= 1U;
+        }
+    }
+    milliHz = 0U;
+    for(i = 0U; i < PWMREADBACK_MILLI_DIGITS; i++)
+    {
+        remainder *= 10U;
+        milliHz = (milliHz * 10U) + (uint16_t)(remainder / divider);
+        remainder %= divider;
+    }
+    if((2UL * remainder) >= divider)
+    {
+        milliHz++;
+        if(milliHz == 1000U)
+        {
+            milliHz = 0U;
+            channel->frequency++;
+        }
+    }
+    channel->frequencyMilliHz = milliHz;
+
+    PWMReadback_computeDuties(channel, mode, cycle);
+}
+
+//*****************************************************************************
+//
+// PWMReadback_init
+//
+//*****************************************************************************
+void
+PWMReadback_init(PWMReadback_Channel *channel, uint32_t base,
+                 uint32_t clockFreq)
+{
+    ASSERT(EPWM_isBaseValid(base));
+    ASSERT(clockFreq != 0U);
+
+    channel->base = base;
+    channel->clockFreq = clockFreq;
+
+    //
+    // No TBCTL reads back with bits outside the mask set, so the first
+    // update always computes
+    //
+    channel->timeBase = (uint16_t)~PWMREADBACK_TIME_BASE_M;
+    (void)PWMReadback_update(channel);
+}
+
+//*****************************************************************************
+//
+// PWMReadback_update
+//
+//*****************************************************************************
+bool
+PWMReadback_update(PWMReadback_Channel *channel)
+{
+    uint32_t base = channel->base;
+    uint16_t timeBase;
+    uint16_t period;
+    uint16_t compareA;
+    uint16_t compareB;
+    uint16_t actionA;
+    uint16_t actionB;
+    uint16_t hrConfig;
+    uint16_t periodHR;
+    uint16_t compareAHR;
+    uint16_t compareBHR;
+    uint16_t deadBand;
+    uint16_t risingDelay;
+    uint16_t fallingDelay;
+
+    timeBase = HWREGH(base + EPWM_O_TBCTL) & PWMREADBACK_TIME_BASE_M;
+    period = EPWM_getTimeBasePeriod(base);
+    compareA = EPWM_getCounterCompareValue(base, EPWM_COUNTER_COMPARE_A);
+    compareB = EPWM_getCounterCompareValue(base, EPWM_COUNTER_COMPARE_B);
+    actionA = HWREGH(base + EPWM_O_AQCTLA);
+    actionB = HWREGH(base + EPWM_O_AQCTLB);
+
+    //
+    // High-resolution fractions, in the upper byte of CMPAHR, CMPBHR and
+    // TBPRDHR; the period one only counts while the MEP extends the period
+    //
+    hrConfig = HWREGH(base + HRPWM_O_HRCNFG) & PWMREADBACK_HR_CONFIG_M;
+    compareAHR = HWREGH(base + EPWM_O_CMPA) >> 8U;
+    compareBHR = HWREGH(base + EPWM_O_CMPB) >> 8U;
+    if(((hrConfig & HRPWM_HRCNFG_AUTOCONV) != 0U) &&
+       ((HWREGH(base + HRPWM_O_HRPCTL) & HRPWM_HRPCTL_HRPE) != 0U))
+    {
+        periodHR = HWREGH(base + HRPWM_O_TBPRDHR) >> 8U;
+    }
+    else
+    {
+        periodHR = 0U;
+    }
+
+    deadBand = HWREGH(base + EPWM_O_DBCTL) & PWMREADBACK_DEAD_BAND_M;
+    risingDelay = HWREGH(base + EPWM_O_DBRED) & EPWM_DBRED_DBRED_M;
+    fallingDelay = HWREGH(base + EPWM_O_DBFED) & EPWM_DBFED_DBFED_M;
+
+    if((timeBase == channel->timeBase) && (period == channel->period) &&
+       (compareA == channel->compareA) && (compareB == channel->compareB) &&
+       (actionA == channel->actionA) && (actionB == channel->actionB) &&
+       (hrConfig == channel->hrConfig) && (periodHR == channel->periodHR) &&
+       (compareAHR == channel->compareAHR) &&
+       (compareBHR == channel->compareBHR) &&
+       (deadBand == channel->deadBand) &&
+       (risingDelay == channel->risingDelay) &&
+       (fallingDelay == channel->fallingDelay))
+    {
+        return(false);
+    }
+
+    channel->timeBase = timeBase;
+    channel->period = period;
+    channel->compareA = compareA;
+    channel->compareB = compareB;
+    channel->actionA = actionA;
+    channel->actionB = actionB;
+    channel->hrConfig = hrConfig;
+    channel->periodHR = periodHR;
+    channel->compareAHR = compareAHR;
+    channel->compareBHR = compareBHR;
+    channel->deadBand = deadBand;
+    channel->risingDelay = risingDelay;
+    channel->fallingDelay = fallingDelay;
+
+    PWMReadback_compute(channel);
+
+    return(true);
+}
@@ -0,0 +1,160 @@
+//#############################################################################
+//
+// FILE:   pwm_readback.h
+//
+// TITLE:  Output frequency and duty read back from ePWM registers.
+//
+//#############################################################################
+//
+// The frequency and duty an ePWM module produces follow from its registers:
+// TBPRD, the counter mode and the two TBCLK prescalers in TBCTL give the
+// length of a PWM period, and the action qualifier decides where in that
+// period each output goes high and low on the CMPA and CMPB events. A
+// PWMReadback_Channel works both out from the live registers of one module
+// in 32-bit integer arithmetic, whoever last wrote them.
+//
+// The results are cached together with the register values they came
+// from. PWMReadback_update() reads the registers back and recomputes only
+// when one of them differs, so telemetry can call it for every frame at the
+// cost of a few register reads. A module whose compare values are
+// modulated every period, as ePWM1 and ePWM2 of the example are, misses
+// the cache on almost every call and reports the duty of the period the
+// registers were read in, not an average.
+//
+// Edges fall on whole TBCLK counts as the CPU reads TBPRD, CMPA and CMPB,
+// moved by the CMPAHR and CMPBHR fractions as HRCNFG has the MEP move them
+// and with the period stretched by TBPRDHR while HRPCTL enables it,
+// counting up and down at the turn at TBPRD. The fractions are only
+// included with auto-conversion enabled, where they are in 1/256 count;
+// MEP steps have no fixed size otherwise.
+//
+// The outputs are ePWMxA and ePWMxB as the dead band passes them on: a
+// path with a rising-edge delay shortens each high pulse of its input by
+// DBRED, one with a falling-edge delay each low pulse by DBFED, pulses
+// shorter than the delay disappear, and POLSEL inverts the result. With
+// the complementary pair of pwm_deadband.h, ePWMxB reports the inverse of
+// the ePWMxA actions less the falling-edge delay. Output swap and dual-edge
+// B mode are not worked out; both duties then read
+// PWMREADBACK_DUTY_UNKNOWN. The high-resolution dead-band fractions,
+// chopper, trip zone and the T1/T2 events are not included.
+//
+// Coincident events resolve by the action qualifier priorities of the
+// counter mode. An output whose actions toggle it an odd number of times
+// per period reports the duty of one period. A module with a frozen
+// counter or a zero period in up-down mode reports a frequency and duties
+// of 0.
+//
+//#############################################################################
+
+#ifndef PWM_READBACK_H
+#define PWM_READBACK_H
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//
+// Included Files
+//
+#include <stdbool.h>
+#include <stdint.h>
+#include "driverlib.h"
+
+//*****************************************************************************
+//
+// Duty of an output that is high for the whole period, Q15
+//
+//*****************************************************************************
+#define PWMREADBACK_DUTY_ONE    32768U
+
+//*****************************************************************************
+//
+// Duty of an output whose dead-band routing is not worked out
+//
+//*****************************************************************************
+#define PWMREADBACK_DUTY_UNKNOWN 0xFFFFU
+
+//*****************************************************************************
+//
+//! Cached readback of one ePWM module. Initialize with PWMReadback_init().
+//
+//*****************************************************************************
+typedef struct
+{
+    uint32_t base;                  //!< ePWM base address
+    uint32_t clockFreq;             //!< ePWM module clock in Hz
+    uint16_t timeBase;              //!< TBCTL counter mode and prescalers
+    uint16_t period;                //!< TBPRD
+    uint16_t compareA;              //!< CMPA
+    uint16_t compareB;              //!< CMPB
+    uint16_t actionA;               //!< AQCTLA
+    uint16_t actionB;               //!< AQCTLB
+    uint16_t hrConfig;              //!< HRCNFG edge and control modes
+    uint16_t periodHR;              //!< TBPRDHR fraction, 0 unless HRPE
+    uint16_t compareAHR;            //!< CMPAHR fraction
+    uint16_t compareBHR;            //!< CMPBHR fraction
+    uint16_t deadBand;              //!< DBCTL
+    uint16_t risingDelay;           //!< DBRED
+    uint16_t fallingDelay;          //!< DBFED
+    uint32_t frequency;             //!< Output frequency, whole Hz
+    uint16_t frequencyMilliHz;      //!< Output frequency, mHz above whole Hz
+    uint16_t dutyA;                 //!< High time of ePWMxA per period, Q15
+    uint16_t dutyB;                 //!< High time of ePWMxB per period, Q15
+} PWMReadback_Channel;
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+//*****************************************************************************
+//
+//! Sets up the readback of an ePWM module.
+//!
+//! \param channel is the readback state.
+//! \param base is the base address of the ePWM module.
+//! \param clockFreq is the clock of the ePWM module, before the TBCLK
+//! prescalers, in Hz.
+//!
+//! Reads the registers and computes frequency and duties.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+PWMReadback_init(PWMReadback_Channel *channel, uint32_t base,
+                 uint32_t clockFreq);
+
+//*****************************************************************************
+//
+//! Brings the readback of an ePWM module up to date.
+//!
+//! \param channel is the readback state.
+//!
+//! Reads TBCTL, TBPRD, CMPA, CMPB, AQCTLA and AQCTLB, the high-resolution
+//! and the dead-band registers, and recomputes frequency and duties if any
+//! of them changed since the last call.
+//!
+//! \return Returns \b true if the values were recomputed.
+//
+//*****************************************************************************
+extern bool
+PWMReadback_update(PWMReadback_Channel *channel);
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PWM_READBACK_H
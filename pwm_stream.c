@@ -0,0 +1,109 @@
+//#############################################################################
+//
+// FILE:   pwm_stream.c
+//
+// TITLE:  DMA-fed compare streaming for ePWM modulation.
+//
+//#############################################################################
+
+//
+// Included Files
+//
+#include "pwm_stream.h"
+
+//
+// Defines
+//
+#define PWMSTREAM_EPWM_BASE_STEP    (EPWM2_BASE - EPWM1_BASE)
+
+//
+// Distance between the CMPA and CMPB shadow registers
+//
+#define PWMSTREAM_CMP_STEP          (EPWM_O_CMPB - EPWM_O_CMPA)
+
+//*****************************************************************************
+//
+// PWMStream_init
+//
+//*****************************************************************************
+void
+PWMStream_init(uint32_t dmaBase, uint32_t epwmBase, const uint16_t *buffer,
+               uint16_t pairs)
+{
+    uint16_t module = (uint16_t)((epwmBase - EPWM1_BASE) /
+                                 PWMSTREAM_EPWM_BASE_STEP);
+
+    ASSERT(pairs != 0U);
+
+    DMA_stopChannel(dmaBase);
+
+    //
+    // One pair per burst: CMPA, then CMPB two words further. After the
+    // burst the destination steps back to CMPA and the source moves on.
+    //
+    DMA_configAddresses(dmaBase,
+                        (const void *)(uintptr_t)(epwmBase + EPWM_O_CMPA + 1U),
+                        buffer);
+    DMA_configBurst(dmaBase, 2U, 1, (int16_t)PWMSTREAM_CMP_STEP);
+    DMA_configTransfer(dmaBase, pairs, 1, -(int16_t)PWMSTREAM_CMP_STEP);
+    DMA_configWrap(dmaBase, 0x10000U, 0, 0x10000U, 0);
+    DMA_configMode(dmaBase,
+                   (DMA_Trigger)((uint16_t)DMA_TRIGGER_EPWM1SOCB +
+                                 (module * 2U)),
+                   DMA_CFG_ONESHOT_DISABLE | DMA_CFG_CONTINUOUS_ENABLE |
+                   DMA_CFG_SIZE_16BIT);
+
+    DMA_clearTriggerFlag(dmaBase);
+    DMA_clearErrorFlag(dmaBase);
+    DMA_enableTrigger(dmaBase);
+    DMA_startChannel(dmaBase);
+
+    //
+    // SOCB on every counter-zero event, the same event that loads the
+    // compare shadows
+    //
+    EPWM_setADCTriggerSource(epwmBase, EPWM_SOC_B, EPWM_SOC_TBCTR_ZERO);
+    EPWM_setADCTriggerEventPrescale(epwmBase, EPWM_SOC_B, 1U);
+    EPWM_clearADCTriggerFlag(epwmBase, EPWM_SOC_B);
+    EPWM_enableADCTrigger(epwmBase, EPWM_SOC_B);
+}
+
+//*****************************************************************************
+//
+// PWMStream_stop
+//
+//*****************************************************************************
+void
+PWMStream_stop(uint32_t dmaBase, uint32_t epwmBase)
+{
+    EPWM_disableADCTrigger(epwmBase, EPWM_SOC_B);
+    DMA_disableTrigger(dmaBase);
+    DMA_stopChannel(dmaBase);
+}
+
+//*****************************************************************************
+//
+// PWMStream_fillFromTable
+//
+//*****************************************************************************
+void
+PWMStream_fillFromTable(uint16_t *buffer, const uint16_t *table,
+                        uint16_t length, uint16_t offsetB)
+{
+    uint16_t indexB = offsetB;
+    uint16_t i;
+
+    ASSERT(offsetB < length);
+
+    for(i = 0U; i < length; i++)
+    {
+        buffer[2U * i] = table[i];
+        buffer[(2U * i) + 1U] = table[indexB];
+
+        indexB++;
+        if(indexB == length)
+        {
+            indexB = 0U;
+        }
+    }
+}
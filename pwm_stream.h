@@ -0,0 +1,114 @@
+//#############################################################################
+//
+// FILE:   pwm_stream.h
+//
+// TITLE:  DMA-fed compare streaming for ePWM modulation.
+//
+//#############################################################################
+//
+// A DMA channel copies the next CMPA/CMPB pair from a circular buffer into
+// the compare shadow registers of one ePWM module on every SOCB event of
+// that module, so the modulation runs without any CPU interrupt. SOCA is
+// left free for ADC conversions.
+//
+// The buffer holds interleaved pairs: CMPA0, CMPB0, CMPA1, CMPB1, ... Each
+// trigger moves one pair as a two-word burst; a transfer covers the whole
+// buffer and the channel runs in continuous mode, so the next transfer
+// starts over at the top of the buffer.
+//
+// The DMA only reaches GSx RAM and peripheral frame 1/2, so the buffer must
+// be placed in a GSx RAM section.
+//
+//#############################################################################
+
+#ifndef PWM_STREAM_H
+#define PWM_STREAM_H
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//
+// Included Files
+//
+#include <stdbool.h>
+#include <stdint.h>
+#include "driverlib.h"
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+//*****************************************************************************
+//
+//! Starts streaming a buffer of compare pairs into an ePWM module.
+//!
+//! \param dmaBase is the DMA channel base address.
+//! \param epwmBase is the base address of the ePWM module.
+//! \param buffer is the buffer of interleaved CMPA/CMPB pairs, in GSx RAM.
+//! \param pairs is the number of pairs in \e buffer, at least 1.
+//!
+//! Configures the channel and the SOCB event of the module (counter zero,
+//! every event) and starts the channel. The compare registers should be in
+//! shadow mode so each pair takes effect at the next shadow load. The DMA
+//! controller must have been initialized with DMA_initController().
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+PWMStream_init(uint32_t dmaBase, uint32_t epwmBase, const uint16_t *buffer,
+               uint16_t pairs);
+
+//*****************************************************************************
+//
+//! Stops streaming.
+//!
+//! \param dmaBase is the DMA channel base address.
+//! \param epwmBase is the base address of the ePWM module.
+//!
+//! The compare registers keep the last pair written.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+PWMStream_stop(uint32_t dmaBase, uint32_t epwmBase);
+
+//*****************************************************************************
+//
+//! Fills a stream buffer from a table of compare values.
+//!
+//! \param buffer is the buffer, 2 * \e length words.
+//! \param table is the table of compare values.
+//! \param length is the number of entries in \e table.
+//! \param offsetB is the number of entries CMPB leads CMPA by, less than
+//! \e length.
+//!
+//! Produces the same sequence PWMMod_step() plays from the table.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+PWMStream_fillFromTable(uint16_t *buffer, const uint16_t *table,
+                        uint16_t length, uint16_t offsetB);
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PWM_STREAM_H
@@ -0,0 +1,145 @@
+//#############################################################################
+//
+// FILE:   pwm_timing.h
+//
+// TITLE:  Compile-time ePWM period and frequency arithmetic.
+//
+//#############################################################################
+//
+// The period of an ePWM module follows from the frequency it should switch
+// at, the clock of the module, its two TBCLK prescalers and its counter
+// mode. Counting up (or down), one PWM period lasts TBPRD + 1 TBCLK
+// counts; counting up-down, it lasts 2 * TBPRD counts. The macros below
+// derive TBPRD from a requested frequency and give back the frequency and
+// duty resolution the rounded TBPRD actually achieves.
+//
+// Everything here is integer arithmetic on constants, usable in #if
+// directives: configurations check their values there and stop the build
+// with #error instead of failing at run time. Pass the prescalers as
+// divide ratios (1, 2, 4, ...) and the counter mode as one of the
+// PWMTIMING_COUNT_* values, which equal the EPWM_TimeBaseCountMode values
+// of driverlib. PWMTIMING_CLOCK_DIVIDER() and PWMTIMING_HSCLOCK_DIVIDER()
+// turn the ratios into the driverlib encodings.
+//
+// Frequencies are in Hz and are rounded to the nearest Hz, or mHz for
+// PWMTIMING_FREQUENCY_MILLIHZ(). Constants are unsigned long, as products
+// of frequencies overflow the 16-bit int of the C28x.
+//
+//#############################################################################
+
+#ifndef PWM_TIMING_H
+#define PWM_TIMING_H
+
+//*****************************************************************************
+//
+// Counter modes, equal to the EPWM_TimeBaseCountMode values
+//
+//*****************************************************************************
+#define PWMTIMING_COUNT_UP          0U
+#define PWMTIMING_COUNT_DOWN        1U
+#define PWMTIMING_COUNT_UP_DOWN     2U
+
+//*****************************************************************************
+//
+// Largest TBPRD
+//
+//*****************************************************************************
+#define PWMTIMING_PERIOD_MAX        0xFFFFUL
+
+//*****************************************************************************
+//
+// n / d rounded to the nearest integer
+//
+//*****************************************************************************
+#define PWMTIMING_ROUND_DIV(n, d)   (((n) + ((d) / 2UL)) / (d))
+
+//*****************************************************************************
+//
+// Total division from the ePWM module clock to TBCLK
+//
+//*****************************************************************************
+#define PWMTIMING_PRESCALE(clockDiv, hsClockDiv)                              \
+    (1UL * (clockDiv) * (hsClockDiv))
+
+//*****************************************************************************
+//
+// The EPWM_ClockDivider and EPWM_HSClockDivider encodings of divide ratios
+//
+//*****************************************************************************
+#define PWMTIMING_CLOCK_DIVIDER(clockDiv)                                     \
+    (((clockDiv) >= 2U) + ((clockDiv) >= 4U) + ((clockDiv) >= 8U) +           \
+     ((clockDiv) >= 16U) + ((clockDiv) >= 32U) + ((clockDiv) >= 64U) +        \
+     ((clockDiv) >= 128U))
+#define PWMTIMING_HSCLOCK_DIVIDER(hsClockDiv)   ((hsClockDiv) / 2U)
+
+//*****************************************************************************
+//
+// TBPRD for a frequency
+//
+//*****************************************************************************
+#define PWMTIMING_PERIOD(clockFreq, prescale, mode, frequency)                \
+    (((mode) == PWMTIMING_COUNT_UP_DOWN) ?                                    \
+     PWMTIMING_ROUND_DIV((clockFreq), 2UL * (prescale) * (frequency)) :       \
+     (PWMTIMING_ROUND_DIV((clockFreq), (prescale) * (frequency)) - 1UL))
+
+//*****************************************************************************
+//
+// TBCLK counts per PWM period
+//
+//*****************************************************************************
+#define PWMTIMING_PERIOD_COUNTS(mode, period)                                 \
+    (((mode) == PWMTIMING_COUNT_UP_DOWN) ? (2UL * (period)) :                 \
+                                           ((period) + 1UL))
+
+//*****************************************************************************
+//
+// Frequency a TBPRD gives, in Hz and in mHz
+//
+//*****************************************************************************
+#define PWMTIMING_FREQUENCY(clockFreq, prescale, mode, period)                \
+    PWMTIMING_ROUND_DIV((clockFreq),                                          \
+                        (prescale) * PWMTIMING_PERIOD_COUNTS(mode, period))
+#define PWMTIMING_FREQUENCY_MILLIHZ(clockFreq, prescale, mode, period)        \
+    PWMTIMING_ROUND_DIV(1000ULL * (clockFreq),                                \
+                        (prescale) * PWMTIMING_PERIOD_COUNTS(mode, period))
+
+//*****************************************************************************
+//
+// Duty resolution: distinct compare steps between 0 and 100 % duty, and the
+// duty change of one step in parts per million
+//
+//*****************************************************************************
+#define PWMTIMING_DUTY_STEPS(mode, period)                                    \
+    (((mode) == PWMTIMING_COUNT_UP_DOWN) ? (1UL * (period)) :                 \
+                                           ((period) + 1UL))
+#define PWMTIMING_DUTY_STEP_PPM(mode, period)                                 \
+    PWMTIMING_ROUND_DIV(1000000UL, PWMTIMING_DUTY_STEPS(mode, period))
+
+//*****************************************************************************
+//
+// Checks for #if directives
+//
+//*****************************************************************************
+#define PWMTIMING_IS_CLOCK_DIVIDER_VALID(clockDiv)                            \
+    (((clockDiv) >= 1U) && ((clockDiv) <= 128U) &&                            \
+     (((clockDiv) & ((clockDiv) - 1U)) == 0U))
+#define PWMTIMING_IS_HSCLOCK_DIVIDER_VALID(hsClockDiv)                        \
+    (((hsClockDiv) == 1U) ||                                                  \
+     (((hsClockDiv) >= 2U) && ((hsClockDiv) <= 14U) &&                        \
+      (((hsClockDiv) % 2U) == 0U)))
+#define PWMTIMING_IS_FREQUENCY_REACHED(clockFreq, prescale, mode, frequency,  \
+                                       tolerance)                             \
+    ((PWMTIMING_FREQUENCY((clockFreq), (prescale), (mode),                    \
+                          PWMTIMING_PERIOD((clockFreq), (prescale), (mode),   \
+                                           (frequency))) + (tolerance) >=     \
+      (frequency)) &&                                                         \
+     (PWMTIMING_FREQUENCY((clockFreq), (prescale), (mode),                    \
+                          PWMTIMING_PERIOD((clockFreq), (prescale), (mode),   \
+                                           (frequency))) <=                   \
+      (frequency) + (tolerance)))
+#define PWMTIMING_IS_PERIOD_VALID(period)                                     \
+    (((period) >= 1UL) && ((period) <= PWMTIMING_PERIOD_MAX))
+#define PWMTIMING_IS_COMPARE_VALID(period, minCompare, maxCompare)            \
+    (((minCompare) <= (maxCompare)) && ((maxCompare) <= (period)))
+
+#endif // PWM_TIMING_H
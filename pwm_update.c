@@ -0,0 +1,89 @@
+//#############################################################################
+//
+// FILE:   pwm_update.c
+//
+// TITLE:  Glitch-free period and compare updates through the global load.
+//
+//#############################################################################
+
+//
+// Included Files
+//
+#include "pwm_update.h"
+
+#ifndef __cplusplus
+#pragma CODE_SECTION(PWMUpdate_setPeriodAndCompare, ".TI.ramfunc");
+#pragma CODE_SECTION(PWMUpdate_setCompare, ".TI.ramfunc");
+#pragma CODE_SECTION(PWMUpdate_setPeriod, ".TI.ramfunc");
+#endif
+
+//*****************************************************************************
+//
+// PWMUpdate_init
+//
+//*****************************************************************************
+void
+PWMUpdate_init(uint32_t base)
+{
+    EPWM_setPeriodLoadMode(base, EPWM_PERIOD_SHADOW_LOAD);
+    EPWM_setCounterCompareShadowLoadMode(base, EPWM_COUNTER_COMPARE_A,
+                                         EPWM_COMP_LOAD_ON_CNTR_ZERO);
+    EPWM_setCounterCompareShadowLoadMode(base, EPWM_COUNTER_COMPARE_B,
+                                         EPWM_COMP_LOAD_ON_CNTR_ZERO);
+
+    //
+    // Every counter-zero event produces a strobe, which only loads once the
+    // one-shot latch is armed
+    //
+    EPWM_setGlobalLoadTrigger(base, EPWM_GL_LOAD_PULSE_CNTR_ZERO);
+    EPWM_setGlobalLoadEventPrescale(base, 1U);
+    EPWM_enableGlobalLoadOneShotMode(base);
+    EPWM_enableGlobalLoadRegisters(base, EPWM_GL_REGISTER_TBPRD_TBPRDHR |
+                                         EPWM_GL_REGISTER_CMPA_CMPAHR |
+                                         EPWM_GL_REGISTER_CMPB_CMPBHR);
+    EPWM_enableGlobalLoad(base);
+}
+
+//*****************************************************************************
+//
+// PWMUpdate_setPeriodAndCompare
+//
+//*****************************************************************************
+void
+PWMUpdate_setPeriodAndCompare(uint32_t base, uint16_t period,
+                              uint16_t compareA, uint16_t compareB)
+{
+    EPWM_setTimeBasePeriod(base, period);
+    EPWM_setCounterCompareValue(base, EPWM_COUNTER_COMPARE_A, compareA);
+    EPWM_setCounterCompareValue(base, EPWM_COUNTER_COMPARE_B, compareB);
+
+    //
+    // Arm the load only after every shadow holds its new value
+    //
+    EPWM_setGlobalLoadOneShotLatch(base);
+}
+
+//*****************************************************************************
+//
+// PWMUpdate_setCompare
+//
+//*****************************************************************************
+void
+PWMUpdate_setCompare(uint32_t base, uint16_t compareA, uint16_t compareB)
+{
+    EPWM_setCounterCompareValue(base, EPWM_COUNTER_COMPARE_A, compareA);
+    EPWM_setCounterCompareValue(base, EPWM_COUNTER_COMPARE_B, compareB);
+    EPWM_setGlobalLoadOneShotLatch(base);
+}
+
+//*****************************************************************************
+//
+// PWMUpdate_setPeriod
+//
+//*****************************************************************************
+void
+PWMUpdate_setPeriod(uint32_t base, uint16_t period)
+{
+    EPWM_setTimeBasePeriod(base, period);
+    EPWM_setGlobalLoadOneShotLatch(base);
+}
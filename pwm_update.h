@@ -0,0 +1,122 @@
+//#############################################################################
+//
+// FILE:   pwm_update.h
+//
+// TITLE:  Glitch-free period and compare updates through the global load.
+//
+//#############################################################################
+//
+// TBPRD, CMPA and CMPB each have their own shadow register and load event.
+// Writing them one after the other from software races the counter: if a
+// load event falls between two writes, one PWM period runs with a new
+// compare value against the old period, or the other way round, which can
+// produce a runt pulse or drop a pulse entirely.
+//
+// PWMUpdate_init() routes all three registers through the ePWM global load
+// strobe in one-shot mode. The update functions write the shadow registers
+// and only then arm the one-shot latch, so the next counter-zero event
+// transfers every staged value in the same instant, no matter when the
+// writes happened relative to the counter.
+//
+// Only one update can be staged per PWM period: a second update started
+// before the first one has loaded may partly overwrite it. Updates from the
+// main loop, paced by user input or serial commands, are far slower than
+// the PWM period.
+//
+//#############################################################################
+
+#ifndef PWM_UPDATE_H
+#define PWM_UPDATE_H
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//
+// Included Files
+//
+#include <stdint.h>
+#include "driverlib.h"
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+//*****************************************************************************
+//
+//! Configures an ePWM module for one-shot global loads of TBPRD, CMPA and
+//! CMPB on counter zero.
+//!
+//! \param base is the base address of the ePWM module.
+//!
+//! Puts the three registers in shadow mode. Afterwards their shadow values
+//! only reach the active registers through the PWMUpdate functions, so any
+//! other code changing them must use those as well.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+PWMUpdate_init(uint32_t base);
+
+//*****************************************************************************
+//
+//! Stages a new period and compare values to load together.
+//!
+//! \param base is the base address of the ePWM module.
+//! \param period is the new TBPRD value.
+//! \param compareA is the new CMPA value.
+//! \param compareB is the new CMPB value.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+PWMUpdate_setPeriodAndCompare(uint32_t base, uint16_t period,
+                              uint16_t compareA, uint16_t compareB);
+
+//*****************************************************************************
+//
+//! Stages new compare values to load together, keeping the period.
+//!
+//! \param base is the base address of the ePWM module.
+//! \param compareA is the new CMPA value.
+//! \param compareB is the new CMPB value.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+PWMUpdate_setCompare(uint32_t base, uint16_t compareA, uint16_t compareB);
+
+//*****************************************************************************
+//
+//! Stages a new period, keeping the compare values.
+//!
+//! \param base is the base address of the ePWM module.
+//! \param period is the new TBPRD value.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+PWMUpdate_setPeriod(uint32_t base, uint16_t period);
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PWM_UPDATE_H
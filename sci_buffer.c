@@ -0,0 +1,468 @@
+//#############################################################################
+//
+// FILE:   sci_buffer.c
+//
+// TITLE:  Interrupt-driven SCI transmit and receive buffering.
+//
+//#############################################################################
+
+//
+// Included Files
+//
+#include "sci_buffer.h"
+
+//
+// The interrupt routines and what they call run from RAM (see
+// check_ramfuncs.py)
+//
+#ifndef __cplusplus
+#pragma CODE_SECTION(SCIBuffer_isLineEnd, ".TI.ramfunc");
+#pragma CODE_SECTION(SCIBuffer_txISR, ".TI.ramfunc");
+#pragma CODE_SECTION(SCIBuffer_rxISR, ".TI.ramfunc");
+#endif
+
+//
+// Defines
+//
+#define SCIBUFFER_TX_MASK       (SCIBUFFER_TX_SIZE - 1U)
+#define SCIBUFFER_RX_MASK       (SCIBUFFER_RX_SIZE - 1U)
+
+//
+// Globals
+//
+static uint32_t SCIBuffer_base = SCIA_BASE;
+static uint16_t SCIBuffer_txRing[SCIBUFFER_TX_SIZE];
+
+//
+// Free-running indices; the fill level is their difference. txHead is only
+// written by the producer, txTail only by the TXFF interrupt.
+//
+static volatile uint16_t SCIBuffer_txHead;
+static volatile uint16_t SCIBuffer_txTail;
+static uint32_t SCIBuffer_txOverflowCount;
+
+//
+// Receive ring, filled by the RXFF interrupt. The interrupt also counts the
+// line terminators it stores so that SCIBuffer_readLine() can tell whether a
+// complete line is waiting without scanning the ring.
+//
+static uint16_t SCIBuffer_rxRing[SCIBUFFER_RX_SIZE];
+static volatile uint16_t SCIBuffer_rxHead;
+static volatile uint16_t SCIBuffer_rxTail;
+static volatile uint16_t SCIBuffer_rxLinesIn;
+static uint16_t SCIBuffer_rxLinesOut;
+static volatile uint32_t SCIBuffer_rxOverrunCount;
+
+//*****************************************************************************
+//
+// Returns whether a character ends a line
+//
+//*****************************************************************************
+static inline bool
+SCIBuffer_isLineEnd(uint16_t data)
+{
+    return((data == (uint16_t)'\r') || (data == (uint16_t)'\n'));
+}
+
+//*****************************************************************************
+//
+// Re-enables the TXFF interrupt after new characters were queued. FFTX is
+// also modified by the interrupt, so the read-modify-write is done with
+// interrupts held off.
+//
+//*****************************************************************************
+static void
+SCIBuffer_startTx(void)
+{
+    bool intsOff = Interrupt_disableMaster();
+
+    SCI_enableInterrupt(SCIBuffer_base, SCI_INT_TXFF);
+
+    if(!intsOff)
+    {
+        Interrupt_enableMaster();
+    }
+}
+
+//*****************************************************************************
+//
+// SCIBuffer_init
+//
+//*****************************************************************************
+void
+SCIBuffer_init(uint32_t base)
+{
+    uint32_t txInterrupt = (base == SCIB_BASE) ? INT_SCIB_TX : INT_SCIA_TX;
+    uint32_t rxInterrupt = (base == SCIB_BASE) ? INT_SCIB_RX : INT_SCIA_RX;
+
+    SCIBuffer_base = base;
+    SCIBuffer_txHead = 0U;
+    SCIBuffer_txTail = 0U;
+    SCIBuffer_txOverflowCount = 0U;
+    SCIBuffer_rxHead = 0U;
+    SCIBuffer_rxTail = 0U;
+    SCIBuffer_rxLinesIn = 0U;
+    SCIBuffer_rxLinesOut = 0U;
+    SCIBuffer_rxOverrunCount = 0U;
+
+    //
+    // The TX interrupt stays disabled while there is nothing to send. The RX
+    // interrupt fires for every received character.
+    //
+    SCI_disableInterrupt(base, SCI_INT_TXFF | SCI_INT_RXFF);
+    SCI_setFIFOInterruptLevel(base, SCIBUFFER_TX_FIFO_LEVEL, SCI_FIFO_RX1);
+    SCI_clearOverflowStatus(base);
+    SCI_clearInterruptStatus(base, SCI_INT_TXFF | SCI_INT_RXFF);
+    SCI_enableInterrupt(base, SCI_INT_RXFF);
+
+    Interrupt_register(txInterrupt, &SCIBuffer_txISR);
+    Interrupt_register(rxInterrupt, &SCIBuffer_rxISR);
+    Interrupt_enable(txInterrupt);
+    Interrupt_enable(rxInterrupt);
+}
+
+//*****************************************************************************
+//
+// SCIBuffer_write
+//
+//*****************************************************************************
+uint16_t
+SCIBuffer_write(const uint16_t *data, uint16_t length)
+{
+    uint16_t head = SCIBuffer_txHead;
+    uint16_t count;
+    uint16_t i;
+
+    count = SCIBuffer_getTxFree();
+    if(length < count)
+    {
+        count = length;
+    }
+
+    for(i = 0U; i < count; i++)
+    {
+        SCIBuffer_txRing[head & SCIBUFFER_TX_MASK] = data[i];
+        head++;
+    }
+
+    //
+    // Publish the characters only once they are in the ring
+    //
+    SCIBuffer_txHead = head;
+    SCIBuffer_txOverflowCount += (uint32_t)(length - count);
+
+    if(count != 0U)
+    {
+        SCIBuffer_startTx();
+    }
+
+    return(count);
+}
+
+//*****************************************************************************
+//
+// SCIBuffer_writeString
+//
+//*****************************************************************************
+uint16_t
+SCIBuffer_writeString(const char *string)
+{
+    uint16_t head = SCIBuffer_txHead;
+    uint16_t space = SCIBuffer_getTxFree();
+    uint16_t count = 0U;
+
+    for(; *string != '\0'; string++)
+    {
+        if(count == space)
+        {
+            SCIBuffer_txOverflowCount++;
+        }
+        else
+        {
+            SCIBuffer_txRing[head & SCIBUFFER_TX_MASK] =
+                (uint16_t)*string & SCI_TXBUF_TXDT_M;
+            head++;
+            count++;
+        }
+    }
+
+    SCIBuffer_txHead = head;
+
+    if(count != 0U)
+    {
+        SCIBuffer_startTx();
+    }
+
+    return(count);
+}
+
+//*****************************************************************************
+//
+// SCIBuffer_getTxFree
+//
+//*****************************************************************************
+uint16_t
+SCIBuffer_getTxFree(void)
+{
+    return(SCIBUFFER_TX_SIZE -
+           (uint16_t)(SCIBuffer_txHead - SCIBuffer_txTail));
+}
+
+//*****************************************************************************
+//
+// SCIBuffer_isTxIdle
+//
+//*****************************************************************************
+bool
+SCIBuffer_isTxIdle(void)
+{
+    //
+    // SCI_isTransmitterBusy() only reports a full FIFO in FIFO mode, so check
+    // TXEMPTY, which covers both the FIFO and the shift register.
+    //
+    return((SCIBuffer_txHead == SCIBuffer_txTail) &&
+           ((HWREGH(SCIBuffer_base + SCI_O_CTL2) & SCI_CTL2_TXEMPTY) != 0U));
+}
+
+//*****************************************************************************
+//
+// SCIBuffer_getTxOverflowCount
+//
+//*****************************************************************************
+uint32_t
+SCIBuffer_getTxOverflowCount(void)
+{
+    return(SCIBuffer_txOverflowCount);
+}
+
+//*****************************************************************************
+//
+// SCIBuffer_readChar
+//
+//*****************************************************************************
+bool
+SCIBuffer_readChar(uint16_t *data)
+{
+    uint16_t tail = SCIBuffer_rxTail;
+
+    if(tail == SCIBuffer_rxHead)
+    {
+        return(false);
+    }
+
+    *data = SCIBuffer_rxRing[tail & SCIBUFFER_RX_MASK];
+    if(SCIBuffer_isLineEnd(*data))
+    {
+        SCIBuffer_rxLinesOut++;
+    }
+    SCIBuffer_rxTail = tail + 1U;
+
+    return(true);
+}
+
+//*****************************************************************************
+//
+// SCIBuffer_peekChar
+//
+//*****************************************************************************
+bool
+SCIBuffer_peekChar(uint16_t *data)
+{
+    uint16_t tail = SCIBuffer_rxTail;
+
+    if(tail == SCIBuffer_rxHead)
+    {
+        return(false);
+    }
+
+    *data = SCIBuffer_rxRing[tail & SCIBUFFER_RX_MASK];
+
+    return(true);
+}
+
+//*****************************************************************************
+//
+// SCIBuffer_read
+//
+//*****************************************************************************
+uint16_t
+SCIBuffer_read(uint16_t *data, uint16_t length)
+{
+    uint16_t count = 0U;
+
+    while((count < length) && SCIBuffer_readChar(&data[count]))
+    {
+        count++;
+    }
+
+    return(count);
+}
+
+//*****************************************************************************
+//
+// SCIBuffer_readLine
+//
+//*****************************************************************************
+bool
+SCIBuffer_readLine(char *line, uint16_t size)
+{
+    uint16_t data;
+    uint16_t length = 0U;
+    bool ringFull;
+
+    for(;;)
+    {
+        ringFull = (uint16_t)(SCIBuffer_rxHead - SCIBuffer_rxTail) ==
+                   SCIBUFFER_RX_SIZE;
+
+        if((SCIBuffer_rxLinesIn == SCIBuffer_rxLinesOut) && !ringFull)
+        {
+            return(false);
+        }
+
+        //
+        // Copy up to the end of the line, or the whole ring if it filled up
+        // without one
+        //
+        while(SCIBuffer_readChar(&data) && !SCIBuffer_isLineEnd(data))
+        {
+            if((length + 1U) < size)
+            {
+                line[length] = (char)data;
+                length++;
+            }
+
+            if(ringFull && (SCIBuffer_rxTail == SCIBuffer_rxHead))
+            {
+                break;
+            }
+        }
+
+        if((length != 0U) || ringFull)
+        {
+            break;
+        }
+    }
+
+    if(size != 0U)
+    {
+        line[length] = '\0';
+    }
+
+    return(true);
+}
+
+//*****************************************************************************
+//
+// SCIBuffer_getRxCount
+//
+//*****************************************************************************
+uint16_t
+SCIBuffer_getRxCount(void)
+{
+    return((uint16_t)(SCIBuffer_rxHead - SCIBuffer_rxTail));
+}
+
+//*****************************************************************************
+//
+// SCIBuffer_getRxOverrunCount
+//
+//*****************************************************************************
+uint32_t
+SCIBuffer_getRxOverrunCount(void)
+{
+    return(SCIBuffer_rxOverrunCount);
+}
+
+//*****************************************************************************
+//
+// SCIBuffer_txISR - Moves queued characters into the TX FIFO
+//
+//*****************************************************************************
+__interrupt void
+SCIBuffer_txISR(void)
+{
+    uint16_t tail = SCIBuffer_txTail;
+    uint16_t head = SCIBuffer_txHead;
+    uint16_t space;
+
+    space = (uint16_t)SCI_FIFO_TX16 -
+            (uint16_t)SCI_getTxFIFOStatus(SCIBuffer_base);
+
+    while((space != 0U) && (tail != head))
+    {
+        SCI_writeCharNonBlocking(SCIBuffer_base,
+                                 SCIBuffer_txRing[tail & SCIBUFFER_TX_MASK]);
+        tail++;
+        space--;
+    }
+
+    SCIBuffer_txTail = tail;
+
+    //
+    // Nothing left to send: stay quiet until the next write
+    //
+    if(tail == head)
+    {
+        SCI_disableInterrupt(SCIBuffer_base, SCI_INT_TXFF);
+    }
+
+    SCI_clearInterruptStatus(SCIBuffer_base, SCI_INT_TXFF);
+
+    //
+    // Acknowledge interrupt group
+    //
+    Interrupt_clearACKGroup(INTERRUPT_ACK_GROUP9);
+}
+
+//*****************************************************************************
+//
+// SCIBuffer_rxISR - Moves received characters out of the RX FIFO
+//
+//*****************************************************************************
+__interrupt void
+SCIBuffer_rxISR(void)
+{
+    uint16_t head = SCIBuffer_rxHead;
+    uint16_t count;
+    uint16_t data;
+
+    for(count = (uint16_t)SCI_getRxFIFOStatus(SCIBuffer_base); count != 0U;
+        count--)
+    {
+        data = SCI_readCharNonBlocking(SCIBuffer_base);
+
+        if((uint16_t)(head - SCIBuffer_rxTail) == SCIBUFFER_RX_SIZE)
+        {
+            SCIBuffer_rxOverrunCount++;
+        }
+        else
+        {
+            SCIBuffer_rxRing[head & SCIBUFFER_RX_MASK] = data;
+            head++;
+
+            if(SCIBuffer_isLineEnd(data))
+            {
+                SCIBuffer_rxLinesIn++;
+            }
+        }
+    }
+
+    SCIBuffer_rxHead = head;
+
+    //
+    // The hardware FIFO overflowed before the interrupt was serviced
+    //
+    if(SCI_getOverflowStatus(SCIBuffer_base))
+    {
+        SCIBuffer_rxOverrunCount++;
+        SCI_clearOverflowStatus(SCIBuffer_base);
+    }
+
+    SCI_clearInterruptStatus(SCIBuffer_base, SCI_INT_RXFF);
+
+    //
+    // Acknowledge interrupt group
+    //
+    Interrupt_clearACKGroup(INTERRUPT_ACK_GROUP9);
+}
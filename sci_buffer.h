@@ -0,0 +1,268 @@
+//#############################################################################
+//
+// FILE:   sci_buffer.h
+//
+// TITLE:  Interrupt-driven SCI transmit and receive buffering.
+//
+//#############################################################################
+//
+// SCIBuffer_write() and SCIBuffer_writeString() copy characters into a RAM
+// ring buffer and return immediately. The SCI TX FIFO level interrupt
+// (TXFF) drains the ring into the 16-deep hardware FIFO whenever the FIFO
+// runs low, so the caller never waits on the baud rate.
+//
+// In the other direction the RX FIFO level interrupt (RXFF) moves received
+// characters into a second ring, from which the main loop polls single
+// characters or complete lines without ever blocking.
+//
+// Each ring has a single producer and a single consumer, one of them the
+// interrupt; neither index is written by both sides, so no locking is
+// needed around the copies.
+//
+//#############################################################################
+
+#ifndef SCI_BUFFER_H
+#define SCI_BUFFER_H
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//
+// Included Files
+//
+#include <stdbool.h>
+#include <stdint.h>
+#include "driverlib.h"
+
+//*****************************************************************************
+//
+// Size of the transmit ring buffer in characters. Must be a power of two no
+// larger than 32768.
+//
+//*****************************************************************************
+#ifndef SCIBUFFER_TX_SIZE
+#define SCIBUFFER_TX_SIZE       256U
+#endif
+
+#if (SCIBUFFER_TX_SIZE & (SCIBUFFER_TX_SIZE - 1U)) != 0U
+#error "SCIBUFFER_TX_SIZE must be a power of two"
+#endif
+
+//*****************************************************************************
+//
+// Size of the receive ring buffer in characters. Must be a power of two no
+// larger than 32768.
+//
+//*****************************************************************************
+#ifndef SCIBUFFER_RX_SIZE
+#define SCIBUFFER_RX_SIZE       64U
+#endif
+
+#if (SCIBUFFER_RX_SIZE & (SCIBUFFER_RX_SIZE - 1U)) != 0U
+#error "SCIBUFFER_RX_SIZE must be a power of two"
+#endif
+
+//*****************************************************************************
+//
+// TX FIFO level at or below which the TXFF interrupt refills the FIFO.
+// Refilling before the FIFO is completely empty keeps the line busy even if
+// the interrupt is held off for a few character times.
+//
+//*****************************************************************************
+#ifndef SCIBUFFER_TX_FIFO_LEVEL
+#define SCIBUFFER_TX_FIFO_LEVEL SCI_FIFO_TX2
+#endif
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+//*****************************************************************************
+//
+//! Initializes transmit and receive buffering on an SCI port.
+//!
+//! \param base is the base address of the SCI port, \b SCIA_BASE or
+//! \b SCIB_BASE.
+//!
+//! The port must already be configured and have its FIFO enabled. The TXFF
+//! and RXFF interrupt service routines are registered in the PIE vector
+//! table and enabled, so this must be called after
+//! Interrupt_initVectorTable(). Characters are sent and received once
+//! global interrupts are enabled.
+//!
+//! \return None.
+//
+//*****************************************************************************
+extern void
+SCIBuffer_init(uint32_t base);
+
+//*****************************************************************************
+//
+//! Queues characters for transmission.
+//!
+//! \param data is a pointer to the characters to send. Only the low 8 bits
+//! of each word are transmitted.
+//! \param length is the number of characters.
+//!
+//! Copies as many characters as fit into the transmit ring and returns
+//! without waiting. Characters that do not fit are dropped and counted, see
+//! SCIBuffer_getTxOverflowCount().
+//!
+//! \return Returns the number of characters queued.
+//
+//*****************************************************************************
+extern uint16_t
+SCIBuffer_write(const uint16_t *data, uint16_t length);
+
+//*****************************************************************************
+//
+//! Queues a NUL-terminated string for transmission.
+//!
+//! \param string is the string to send.
+//!
+//! Behaves like SCIBuffer_write() for the characters up to, but not
+//! including, the terminating NUL.
+//!
+//! \return Returns the number of characters queued.
+//
+//*****************************************************************************
+extern uint16_t
+SCIBuffer_writeString(const char *string);
+
+//*****************************************************************************
+//
+//! Returns the number of characters that can currently be queued.
+//
+//*****************************************************************************
+extern uint16_t
+SCIBuffer_getTxFree(void);
+
+//*****************************************************************************
+//
+//! Returns whether every queued character has left the transmitter.
+//
+//*****************************************************************************
+extern bool
+SCIBuffer_isTxIdle(void);
+
+//*****************************************************************************
+//
+//! Returns the number of characters dropped because the ring was full.
+//
+//*****************************************************************************
+extern uint32_t
+SCIBuffer_getTxOverflowCount(void);
+
+//*****************************************************************************
+//
+//! Takes the next received character, if any.
+//!
+//! \param data receives the character.
+//!
+//! \return Returns \b true if a character was returned or \b false if the
+//! receive ring is empty.
+//
+//*****************************************************************************
+extern bool
+SCIBuffer_readChar(uint16_t *data);
+
+//*****************************************************************************
+//
+//! Returns the next received character without removing it.
+//!
+//! \param data receives the character.
+//!
+//! \return Returns \b true if a character was returned or \b false if the
+//! receive ring is empty.
+//
+//*****************************************************************************
+extern bool
+SCIBuffer_peekChar(uint16_t *data);
+
+//*****************************************************************************
+//
+//! Takes up to \e length received characters.
+//!
+//! \param data is the buffer that receives the characters.
+//! \param length is the size of the buffer.
+//!
+//! \return Returns the number of characters copied, which may be zero.
+//
+//*****************************************************************************
+extern uint16_t
+SCIBuffer_read(uint16_t *data, uint16_t length);
+
+//*****************************************************************************
+//
+//! Takes one complete line of received text.
+//!
+//! \param line is the buffer that receives the line.
+//! \param size is the size of the buffer, including the terminating NUL.
+//!
+//! A line ends at a carriage return or line feed, which is removed. Empty
+//! lines, such as the second half of a CR/LF pair, are skipped. A line that
+//! is longer than the buffer is truncated and the rest of it discarded. If
+//! the receive ring fills up without an end of line, its contents are
+//! returned as one line so that reception can continue.
+//!
+//! \return Returns \b true if a line was copied to \e line or \b false if
+//! no complete line has been received yet.
+//
+//*****************************************************************************
+extern bool
+SCIBuffer_readLine(char *line, uint16_t size);
+
+//*****************************************************************************
+//
+//! Returns the number of received characters waiting in the receive ring.
+//
+//*****************************************************************************
+extern uint16_t
+SCIBuffer_getRxCount(void);
+
+//*****************************************************************************
+//
+//! Returns the number of received characters that were lost.
+//!
+//! This counts characters dropped because the receive ring was full as well
+//! as hardware RX FIFO overruns, which each lose at least one character.
+//
+//*****************************************************************************
+extern uint32_t
+SCIBuffer_getRxOverrunCount(void);
+
+//*****************************************************************************
+//
+//! SCI TX FIFO interrupt service routine. Registered by SCIBuffer_init().
+//
+//*****************************************************************************
+extern __interrupt void
+SCIBuffer_txISR(void);
+
+//*****************************************************************************
+//
+//! SCI RX FIFO interrupt service routine. Registered by SCIBuffer_init().
+//
+//*****************************************************************************
+extern __interrupt void
+SCIBuffer_rxISR(void);
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SCI_BUFFER_H
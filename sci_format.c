@@ -0,0 +1,368 @@
+//#############################################################################
+//
+// FILE:   sci_format.c
+//
+// TITLE:  Number formatting for SCI output without printf.
+//
+//#############################################################################
+
+//
+// Included Files
+//
+#include "sci_format.h"
+#include "sci_buffer.h"
+
+//
+// Defines
+//
+#define SCIFORMAT_MAX_DIGITS    10U     // Decimal digits of a 32-bit number
+
+//
+// Globals
+//
+static const uint32_t SCIFormat_powers[SCIFORMAT_MAX_DIGITS] =
+{
+    1000000000UL, 100000000UL, 10000000UL, 1000000UL, 100000UL,
+    10000UL, 1000UL, 100UL, 10UL, 1UL
+};
+
+//*****************************************************************************
+//
+// SCIFormat_decimal
+//
+// Writes the decimal digits of a number, most significant first and at
+// least minDigits of them, and returns how many it wrote
+//
+//*****************************************************************************
+static uint16_t
+SCIFormat_decimal(char *digits, uint32_t value, uint16_t minDigits)
+{
+    uint16_t count = 0U;
+    uint16_t i;
+    char digit;
+
+    for(i = 0U; i < SCIFORMAT_MAX_DIGITS; i++)
+    {
+        digit = '0';
+        while(value >= SCIFormat_powers[i])
+        {
+            value -= SCIFormat_powers[i];
+            digit++;
+        }
+
+        if((count != 0U) || (digit != '0') ||
+           ((i + minDigits) >= SCIFORMAT_MAX_DIGITS))
+        {
+            digits[count] = digit;
+            count++;
+        }
+    }
+
+    return(count);
+}
+
+//*****************************************************************************
+//
+// SCIFormat_field
+//
+// Writes sign and digits padded to the field width and terminated, and
+// returns the number of characters
+//
+//*****************************************************************************
+static uint16_t
+SCIFormat_field(char *out, char sign, const char *digits, uint16_t count,
+                uint16_t width, uint16_t flags)
+{
+    uint16_t length = count + ((sign != '\0') ? 1U : 0U);
+    uint16_t pad = 0U;
+    uint16_t n = 0U;
+    uint16_t i;
+
+    ASSERT(width <= SCIFORMAT_MAX_WIDTH);
+
+    if(width > length)
+    {
+        pad = width - length;
+    }
+
+    //
+    // Spaces before a right-justified field; SCIFORMAT_LEFT wins over
+    // SCIFORMAT_ZERO, as '-' wins over '0' in printf
+    //
+    if((flags & (SCIFORMAT_LEFT | SCIFORMAT_ZERO)) == 0U)
+    {
+        for(i = 0U; i < pad; i++)
+        {
+            out[n++] = ' ';
+        }
+    }
+
+    if(sign != '\0')
+    {
+        out[n++] = sign;
+    }
+
+    if((flags & (SCIFORMAT_LEFT | SCIFORMAT_ZERO)) == SCIFORMAT_ZERO)
+    {
+        for(i = 0U; i < pad; i++)
+        {
+            out[n++] = '0';
+        }
+    }
+
+    for(i = 0U; i < count; i++)
+    {
+        out[n++] = digits[i];
+    }
+
+    if((flags & SCIFORMAT_LEFT) != 0U)
+    {
+        for(i = 0U; i < pad; i++)
+        {
+            out[n++] = ' ';
+        }
+    }
+
+    out[n] = '\0';
+
+    return(n);
+}
+
+//*****************************************************************************
+//
+// SCIFormat_getSign
+//
+// Returns the sign character of a number and its magnitude
+//
+//*****************************************************************************
+static char
+SCIFormat_getSign(int32_t value, uint16_t flags, uint32_t *magnitude)
+{
+    if(value < 0)
+    {
+        //
+        // Negating in unsigned arithmetic also covers INT32_MIN
+        //
+        *magnitude = 0UL - (uint32_t)value;
+        return('-');
+    }
+
+    *magnitude = (uint32_t)value;
+    return(((flags & SCIFORMAT_PLUS) != 0U) ? '+' : '\0');
+}
+
+//*****************************************************************************
+//
+// SCIFormat_unsigned
+//
+//*****************************************************************************
+uint16_t
+SCIFormat_unsigned(char *out, uint32_t value, uint16_t width, uint16_t flags)
+{
+    char digits[SCIFORMAT_MAX_DIGITS];
+    uint16_t count;
+
+    count = SCIFormat_decimal(digits, value, 1U);
+
+    return(SCIFormat_field(out, '\0', digits, count, width, flags));
+}
+
+//*****************************************************************************
+//
+// SCIFormat_signed
+//
+//*****************************************************************************
+uint16_t
+SCIFormat_signed(char *out, int32_t value, uint16_t width, uint16_t flags)
+{
+    return(SCIFormat_fixed(out, value, 0U, width, flags));
+}
+
+//*****************************************************************************
+//
+// SCIFormat_hex
+//
+//*****************************************************************************
+uint16_t
+SCIFormat_hex(char *out, uint32_t value, uint16_t width, uint16_t flags)
+{
+    const char *set = ((flags & SCIFORMAT_UPPER) != 0U) ?
+                      "0123456789ABCDEF" : "0123456789abcdef";
+    char digits[8];
+    uint16_t count = 0U;
+    uint16_t nibble;
+    int16_t shift;
+
+    for(shift = 28; shift >= 0; shift -= 4)
+    {
+        nibble = (uint16_t)(value >> shift) & 0xFU;
+        if((count != 0U) || (nibble != 0U) || (shift == 0))
+        {
+            digits[count] = set[nibble];
+            count++;
+        }
+    }
+
+    return(SCIFormat_field(out, '\0', digits, count, width, flags));
+}
+
+//*****************************************************************************
+//
+// SCIFormat_fixed
+//
+//*****************************************************************************
+uint16_t
+SCIFormat_fixed(char *out, int32_t value, uint16_t fraction, uint16_t width,
+                uint16_t flags)
+{
+    char digits[SCIFORMAT_MAX_DIGITS + 1U];
+    uint32_t magnitude;
+    uint16_t count;
+    uint16_t i;
+    char sign;
+
+    ASSERT(fraction <= SCIFORMAT_MAX_FRACTION);
+
+    sign = SCIFormat_getSign(value, flags, &magnitude);
+
+    //
+    // At least one digit before the point; move the fractional digits one
+    // place up to make room for it
+    //
+    count = SCIFormat_decimal(digits, magnitude, fraction + 1U);
+    if(fraction != 0U)
+    {
+        for(i = count; i > (count - fraction); i--)
+        {
+            digits[i] = digits[i - 1U];
+        }
+        digits[count - fraction] = '.';
+        count++;
+    }
+
+    return(SCIFormat_field(out, sign, digits, count, width, flags));
+}
+
+//*****************************************************************************
+//
+// SCIFormat_q
+//
+//*****************************************************************************
+uint16_t
+SCIFormat_q(char *out, int32_t value, uint16_t qBits, uint16_t fraction,
+            uint16_t width, uint16_t flags)
+{
+    char digits[SCIFORMAT_MAX_DIGITS + 1U + SCIFORMAT_MAX_Q_FRACTION];
+    uint32_t magnitude;
+    uint32_t whole;
+    uint32_t part;
+    uint32_t scale;
+    uint16_t count;
+    char sign;
+
+    ASSERT(qBits <= SCIFORMAT_MAX_Q);
+    ASSERT(fraction <= SCIFORMAT_MAX_Q_FRACTION);
+
+    sign = SCIFormat_getSign(value, flags, &magnitude);
+
+    //
+    // The fractional bits times 10^fraction fit 32 bits for the limits
+    // above. Rounding up to the next whole number carries over.
+    //
+    scale = SCIFormat_powers[(SCIFORMAT_MAX_DIGITS - 1U) - fraction];
+    whole = magnitude >> qBits;
+    part = (((magnitude & ((1UL << qBits) - 1UL)) * scale) +
+            ((1UL << qBits) >> 1U)) >> qBits;
+    if(part == scale)
+    {
+        whole++;
+        part = 0UL;
+    }
+
+    count = SCIFormat_decimal(digits, whole, 1U);
+    if(fraction != 0U)
+    {
+        digits[count] = '.';
+        count++;
+        count += SCIFormat_decimal(&digits[count], part, fraction);
+    }
+
+    return(SCIFormat_field(out, sign, digits, count, width, flags));
+}
+
+//*****************************************************************************
+//
+// SCIFormat_writeUnsigned
+//
+//*****************************************************************************
+uint16_t
+SCIFormat_writeUnsigned(uint32_t value, uint16_t width, uint16_t flags)
+{
+    char text[SCIFORMAT_BUFFER_SIZE];
+
+    SCIFormat_unsigned(text, value, width, flags);
+
+    return(SCIBuffer_writeString(text));
+}
+
+//*****************************************************************************
+//
+// SCIFormat_writeSigned
+//
+//*****************************************************************************
+uint16_t
+SCIFormat_writeSigned(int32_t value, uint16_t width, uint16_t flags)
+{
+    char text[SCIFORMAT_BUFFER_SIZE];
+
+    SCIFormat_signed(text, value, width, flags);
+
+    return(SCIBuffer_writeString(text));
+}
+
+//*****************************************************************************
+//
+// SCIFormat_writeHex
+//
+//*****************************************************************************
+uint16_t
+SCIFormat_writeHex(uint32_t value, uint16_t width, uint16_t flags)
+{
+    char text[SCIFORMAT_BUFFER_SIZE];
+
+    SCIFormat_hex(text, value, width, flags);
+
+    return(SCIBuffer_writeString(text));
+}
+
+//*****************************************************************************
+//
+// SCIFormat_writeFixed
+//
+//*****************************************************************************
+uint16_t
+SCIFormat_writeFixed(int32_t value, uint16_t fraction, uint16_t width,
+                     uint16_t flags)
+{
+    char text[SCIFORMAT_BUFFER_SIZE];
+
+    SCIFormat_fixed(text, value, fraction, width, flags);
+
+    return(SCIBuffer_writeString(text));
+}
+
+//*****************************************************************************
+//
+// SCIFormat_writeQ
+//
+//*****************************************************************************
+uint16_t
+SCIFormat_writeQ(int32_t value, uint16_t qBits, uint16_t fraction,
+                 uint16_t width, uint16_t flags)
+{
+    char text[SCIFORMAT_BUFFER_SIZE];
+
+    SCIFormat_q(text, value, qBits, fraction, width, flags);
+
+    return(SCIBuffer_writeString(text));
+}
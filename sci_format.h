@@ -0,0 +1,260 @@
+//#############################################################################
+//
+// FILE:   sci_format.h
+//
+// TITLE:  Number formatting for SCI output without printf.
+//
+//#############################################################################
+//
+// The run-time support printf family pulls several kB of code and a large
+// stack into the image and is not reentrant, so the menu and telemetry use
+// these formatters instead. Each one converts a single number into a
+// caller-supplied character array and returns the number of characters,
+// like snprintf() with one conversion:
+//
+//   SCIFormat_unsigned()  %lu   unsigned decimal
+//   SCIFormat_signed()    %ld   signed decimal
+//   SCIFormat_hex()       %lx   hexadecimal, %lX with SCIFORMAT_UPPER
+//   SCIFormat_fixed()     decimal fixed point: 1234 with two fractional
+//                         digits is "12.34"
+//   SCIFormat_q()         binary fixed point: a Q15 value with three
+//                         fractional digits is printed like %.3f of
+//                         value / 32768, halves rounded away from zero
+//
+// A field width pads the result with spaces on the left, or with zeros
+// after the sign (SCIFORMAT_ZERO), or with spaces on the right
+// (SCIFORMAT_LEFT), as the corresponding printf flags do. Results are
+// never truncated. An array of SCIFORMAT_BUFFER_SIZE characters holds any
+// result, including the terminating NUL.
+//
+// The formatters use no static data other than a constant table and no
+// division: decimal digits come from subtracting powers of ten, at most
+// nine subtractions per digit. They may be called from interrupts. The
+// SCIFormat_write*() variants format into a stack array and queue the
+// result with SCIBuffer_writeString(), so they share the single-producer
+// rule of the SCI transmit buffer.
+//
+//#############################################################################
+
+#ifndef SCI_FORMAT_H
+#define SCI_FORMAT_H
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//
+// Included Files
+//
+#include <stdint.h>
+
+//*****************************************************************************
+//
+// Values that can be passed as the flags parameter, ORed together
+//
+//*****************************************************************************
+#define SCIFORMAT_LEFT          0x0001U //!< Pad on the right
+#define SCIFORMAT_ZERO          0x0002U //!< Pad with zeros after the sign
+#define SCIFORMAT_PLUS          0x0004U //!< '+' before non-negative values
+#define SCIFORMAT_UPPER         0x0008U //!< A-F in hexadecimal
+
+//*****************************************************************************
+//
+// Limits of the width and fraction parameters
+//
+//*****************************************************************************
+#define SCIFORMAT_MAX_WIDTH     20U
+#define SCIFORMAT_MAX_FRACTION  9U
+#define SCIFORMAT_MAX_Q         16U
+#define SCIFORMAT_MAX_Q_FRACTION 4U
+
+//*****************************************************************************
+//
+// Size of an array that holds any result with its terminating NUL
+//
+//*****************************************************************************
+#define SCIFORMAT_BUFFER_SIZE   (SCIFORMAT_MAX_WIDTH + 1U)
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+//*****************************************************************************
+//
+//! Formats an unsigned decimal number.
+//!
+//! \param out is the array receiving the NUL-terminated result, at least
+//! \b SCIFORMAT_BUFFER_SIZE characters.
+//! \param value is the number.
+//! \param width is the smallest number of characters, at most
+//! \b SCIFORMAT_MAX_WIDTH; 0 for no padding.
+//! \param flags is \b SCIFORMAT_LEFT or \b SCIFORMAT_ZERO, or 0.
+//!
+//! \return Returns the number of characters, without the NUL.
+//
+//*****************************************************************************
+extern uint16_t
+SCIFormat_unsigned(char *out, uint32_t value, uint16_t width,
+                   uint16_t flags);
+
+//*****************************************************************************
+//
+//! Formats a signed decimal number.
+//!
+//! \param out is the array receiving the NUL-terminated result.
+//! \param value is the number.
+//! \param width is the smallest number of characters.
+//! \param flags is any of \b SCIFORMAT_LEFT, \b SCIFORMAT_ZERO and
+//! \b SCIFORMAT_PLUS.
+//!
+//! \return Returns the number of characters, without the NUL.
+//
+//*****************************************************************************
+extern uint16_t
+SCIFormat_signed(char *out, int32_t value, uint16_t width, uint16_t flags);
+
+//*****************************************************************************
+//
+//! Formats a hexadecimal number.
+//!
+//! \param out is the array receiving the NUL-terminated result.
+//! \param value is the number.
+//! \param width is the smallest number of characters. With
+//! \b SCIFORMAT_ZERO it is the number of digits, 8 for a full 32-bit word.
+//! \param flags is any of \b SCIFORMAT_LEFT, \b SCIFORMAT_ZERO and
+//! \b SCIFORMAT_UPPER.
+//!
+//! There is no "0x" prefix.
+//!
+//! \return Returns the number of characters, without the NUL.
+//
+//*****************************************************************************
+extern uint16_t
+SCIFormat_hex(char *out, uint32_t value, uint16_t width, uint16_t flags);
+
+//*****************************************************************************
+//
+//! Formats a decimal fixed-point number.
+//!
+//! \param out is the array receiving the NUL-terminated result.
+//! \param value is the number in units of the last fractional digit.
+//! \param fraction is the number of fractional digits, at most
+//! \b SCIFORMAT_MAX_FRACTION; 0 formats like SCIFormat_signed().
+//! \param width is the smallest number of characters.
+//! \param flags is any of \b SCIFORMAT_LEFT, \b SCIFORMAT_ZERO and
+//! \b SCIFORMAT_PLUS.
+//!
+//! \return Returns the number of characters, without the NUL.
+//
+//*****************************************************************************
+extern uint16_t
+SCIFormat_fixed(char *out, int32_t value, uint16_t fraction, uint16_t width,
+                uint16_t flags);
+
+//*****************************************************************************
+//
+//! Formats a binary fixed-point number.
+//!
+//! \param out is the array receiving the NUL-terminated result.
+//! \param value is the number with \e qBits fractional bits.
+//! \param qBits is the number of fractional bits, at most
+//! \b SCIFORMAT_MAX_Q.
+//! \param fraction is the number of fractional digits printed, at most
+//! \b SCIFORMAT_MAX_Q_FRACTION.
+//! \param width is the smallest number of characters.
+//! \param flags is any of \b SCIFORMAT_LEFT, \b SCIFORMAT_ZERO and
+//! \b SCIFORMAT_PLUS.
+//!
+//! The value is rounded to the last printed digit, halves away from zero.
+//!
+//! \return Returns the number of characters, without the NUL.
+//
+//*****************************************************************************
+extern uint16_t
+SCIFormat_q(char *out, int32_t value, uint16_t qBits, uint16_t fraction,
+            uint16_t width, uint16_t flags);
+
+//*****************************************************************************
+//
+//! Queues an unsigned decimal number for transmission.
+//!
+//! \param value, \param width and \param flags are as for
+//! SCIFormat_unsigned().
+//!
+//! \return Returns the number of characters queued.
+//
+//*****************************************************************************
+extern uint16_t
+SCIFormat_writeUnsigned(uint32_t value, uint16_t width, uint16_t flags);
+
+//*****************************************************************************
+//
+//! Queues a signed decimal number for transmission.
+//!
+//! \param value, \param width and \param flags are as for
+//! SCIFormat_signed().
+//!
+//! \return Returns the number of characters queued.
+//
+//*****************************************************************************
+extern uint16_t
+SCIFormat_writeSigned(int32_t value, uint16_t width, uint16_t flags);
+
+//*****************************************************************************
+//
+//! Queues a hexadecimal number for transmission.
+//!
+//! \param value, \param width and \param flags are as for SCIFormat_hex().
+//!
+//! \return Returns the number of characters queued.
+//
+//*****************************************************************************
+extern uint16_t
+SCIFormat_writeHex(uint32_t value, uint16_t width, uint16_t flags);
+
+//*****************************************************************************
+//
+//! Queues a decimal fixed-point number for transmission.
+//!
+//! \param value, \param fraction, \param width and \param flags are as for
+//! SCIFormat_fixed().
+//!
+//! \return Returns the number of characters queued.
+//
+//*****************************************************************************
+extern uint16_t
+SCIFormat_writeFixed(int32_t value, uint16_t fraction, uint16_t width,
+                     uint16_t flags);
+
+//*****************************************************************************
+//
+//! Queues a binary fixed-point number for transmission.
+//!
+//! \param value, \param qBits, \param fraction, \param width and
+//! \param flags are as for SCIFormat_q().
+//!
+//! \return Returns the number of characters queued.
+//
+//*****************************************************************************
+extern uint16_t
+SCIFormat_writeQ(int32_t value, uint16_t qBits, uint16_t fraction,
+                 uint16_t width, uint16_t flags);
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SCI_FORMAT_H